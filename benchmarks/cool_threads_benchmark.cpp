@@ -0,0 +1,711 @@
+// cool_threads_benchmark.cpp
+// License <http://unlicense.org/> (statement below at the end of the file)
+
+// micro-benchmarks of threads_sq / threads_mq / threads_ws, of the algorithms of cool_parallel.hpp and of the queues of cool_queues.hpp, the results are written
+// as JSON (default) or CSV so that they can be compared across versions
+
+// usage : cool_threads_benchmark [--format=json|csv] [--output=<file>] [--threads=<n>,<n>,...] [--filter=<benchmark name>] [--quick]
+
+#define COOL_QUEUES_ATOMIC
+#define COOL_QUEUES_THREAD
+
+#include "cool_threads.hpp"
+#include "cool_parallel.hpp"
+#include "cool_queues.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+	constexpr std::size_t cache_line_size = 64;
+	constexpr std::size_t arg_buffer_size = 48;
+
+	using threads_sq_type = cool::threads_sq<cache_line_size, arg_buffer_size>;
+	using threads_mq_type = cool::threads_mq<cache_line_size, arg_buffer_size>;
+	using threads_ws_type = cool::threads_ws<cache_line_size, arg_buffer_size>;
+
+	using clock_type = std::chrono::steady_clock;
+
+	double elapsed_ns(clock_type::time_point start, clock_type::time_point stop)
+	{
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+	}
+
+
+	// options and results
+
+	class options
+	{
+	public:
+		std::string format = "json";
+		std::string output;
+		std::string filter;
+		std::vector<unsigned int> thread_counts;
+		bool quick = false;
+	};
+
+	class result
+	{
+	public:
+		std::string benchmark;
+		std::string pool;
+		std::string config;
+		unsigned int threads;
+		std::uint64_t param;
+		std::string metric;
+		double value;
+		std::string unit;
+	};
+
+	class recorder
+	{
+	public:
+		explicit recorder(const options& opt) : m_opt(opt) {}
+
+		bool enabled(const char* benchmark) const
+		{
+			return m_opt.filter.empty() || (m_opt.filter == benchmark);
+		}
+
+		void add(const char* benchmark, const std::string& pool, const std::string& config, unsigned int threads,
+			std::uint64_t param, const char* metric, double value, const char* unit)
+		{
+			m_results.push_back(result{ benchmark, pool, config, threads, param, metric, value, unit });
+			std::fprintf(stderr, "%-16s %-8s %-24s threads %-3u param %-8llu %-16s %14.2f %s\n", benchmark, pool.c_str(), config.c_str(),
+				threads, static_cast<unsigned long long>(param), metric, value, unit);
+		}
+
+		void write(std::ostream& os) const
+		{
+			os.precision(12);
+
+			if (m_opt.format == "csv")
+			{
+				os << "benchmark,pool,config,threads,param,metric,value,unit\n";
+				for (const result& r : m_results)
+				{
+					os << r.benchmark << ',' << r.pool << ',' << r.config << ',' << r.threads << ',' << r.param << ','
+						<< r.metric << ',' << r.value << ',' << r.unit << '\n';
+				}
+			}
+			else
+			{
+				os << "{\n  \"schema\": 1,\n  \"hardware_concurrency\": " << std::thread::hardware_concurrency()
+					<< ",\n  \"quick\": " << (m_opt.quick ? "true" : "false") << ",\n  \"results\": [";
+				for (std::size_t k = 0; k < m_results.size(); k++)
+				{
+					const result& r = m_results[k];
+					os << ((k == 0) ? "\n" : ",\n") << "    { \"benchmark\": \"" << r.benchmark << "\", \"pool\": \"" << r.pool
+						<< "\", \"config\": \"" << r.config << "\", \"threads\": " << r.threads << ", \"param\": " << r.param
+						<< ", \"metric\": \"" << r.metric << "\", \"value\": " << r.value << ", \"unit\": \"" << r.unit << "\" }";
+				}
+				os << "\n  ]\n}\n";
+			}
+		}
+
+	private:
+		const options& m_opt;
+		std::vector<result> m_results;
+	};
+
+
+	// workloads
+
+	std::atomic<std::uint64_t> g_sink{ 0 };
+
+	inline std::uint64_t spin_work(std::uint64_t iterations) noexcept
+	{
+		std::uint64_t x = iterations ^ 0x9E3779B97F4A7C15ull;
+		for (std::uint64_t k = 0; k < iterations; k++)
+		{
+			x = x * 6364136223846793005ull + 1442695040888963407ull;
+		}
+		return x;
+	}
+
+	void task_noop(std::uint64_t) noexcept {}
+
+	void task_work(std::uint64_t iterations) noexcept
+	{
+		if (spin_work(iterations) == 0)
+		{
+			g_sink.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+
+	// pool configurations : every benchmark runs on threads_sq and on threads_mq with several 'try_pop_count' / 'dispatch_interval'
+	// settings, 'run_pools' initializes each pool on the stack (pools must be aligned on cache lines) and calls 'body(pool, name, config)'
+
+	constexpr std::size_t task_buffer_size = 1 << 14;
+
+	template <class body_Ty> void run_pools(unsigned int threads, body_Ty&& body)
+	{
+		{
+			alignas(cache_line_size) threads_sq_type pool;
+			if (pool.init_new_threads(cool::thread_count(static_cast<std::uint16_t>(threads)), cool::task_buffer_size(task_buffer_size)))
+			{
+				body(pool, "sq", "default");
+			}
+		}
+
+		std::vector<unsigned int> try_pop_counts = { 1u };
+		if (threads > 1) { try_pop_counts.push_back(threads); }
+		const std::uint16_t dispatch_intervals[] = { 0, 1 };
+
+		for (unsigned int try_pop : try_pop_counts)
+		{
+			for (std::uint16_t dispatch : dispatch_intervals)
+			{
+				alignas(cache_line_size) threads_mq_type pool;
+				if (pool.init_new_threads(cool::thread_count(static_cast<std::uint16_t>(threads)), cool::task_buffer_size(task_buffer_size),
+					cool::try_pop_count(try_pop), cool::dispatch_interval(dispatch)))
+				{
+					std::string config = "try_pop=" + std::to_string(try_pop) + ((dispatch == 0) ? " dispatch=auto:" : " dispatch=")
+						+ std::to_string(pool.dispatch_interval());
+					body(pool, "mq", config);
+				}
+			}
+		}
+	}
+
+
+	// submit_latency : time spent in 'async' by a single submitting thread, the tasks do nothing
+
+	void bench_submit_latency(recorder& rec, const options& opt, unsigned int threads)
+	{
+		const std::size_t task_count = opt.quick ? 20000 : 200000;
+
+		run_pools(threads, [&](auto& pool, const char* name, const std::string& config)
+		{
+			std::vector<double> samples(task_count);
+			cool::async_end end;
+			end.add_awaited(task_count);
+
+			for (std::size_t k = 0; k < task_count; k++)
+			{
+				clock_type::time_point start = clock_type::now();
+				pool.async(end, task_noop, static_cast<std::uint64_t>(k));
+				samples[k] = elapsed_ns(start, clock_type::now());
+			}
+
+			end.finish();
+
+			double sum = 0.0;
+			for (double s : samples) { sum += s; }
+			std::sort(samples.begin(), samples.end());
+
+			rec.add("submit_latency", name, config, threads, task_count, "mean", sum / static_cast<double>(task_count), "ns");
+			rec.add("submit_latency", name, config, threads, task_count, "p50", samples[task_count / 2], "ns");
+			rec.add("submit_latency", name, config, threads, task_count, "p99", samples[(task_count * 99) / 100], "ns");
+		});
+	}
+
+
+	// throughput : tasks of about 'iterations' multiply-adds submitted from one thread and awaited with an async_end
+
+	void bench_throughput(recorder& rec, const options& opt, unsigned int threads)
+	{
+		const std::size_t task_count = opt.quick ? 50000 : 500000;
+		const std::uint64_t iteration_counts[] = { 0, 100, 1000 };
+
+		for (std::uint64_t iterations : iteration_counts)
+		{
+			run_pools(threads, [&](auto& pool, const char* name, const std::string& config)
+			{
+				cool::async_end end;
+				end.add_awaited(task_count);
+
+				clock_type::time_point start = clock_type::now();
+				for (std::size_t k = 0; k < task_count; k++)
+				{
+					pool.async(end, task_work, iterations);
+				}
+				end.finish();
+				double ns = elapsed_ns(start, clock_type::now());
+
+				rec.add("throughput", name, config, threads, iterations, "tasks_per_s", 1e9 * static_cast<double>(task_count) / ns, "1/s");
+			});
+		}
+	}
+
+
+	// fan_out_in : a round queues 'fan' empty tasks on one async_end and waits on it, the cost per round and per task is measured
+
+	void bench_fan_out_in(recorder& rec, const options& opt, unsigned int threads)
+	{
+		const std::size_t fans[] = { 1, 64, 4096 };
+
+		for (std::size_t fan : fans)
+		{
+			const std::size_t round_count = std::max<std::size_t>((opt.quick ? 100000 : 1000000) / (fan * 4), 20);
+
+			run_pools(threads, [&](auto& pool, const char* name, const std::string& config)
+			{
+				clock_type::time_point start = clock_type::now();
+				for (std::size_t round = 0; round < round_count; round++)
+				{
+					cool::async_end end;
+					end.add_awaited(fan);
+					for (std::size_t k = 0; k < fan; k++)
+					{
+						pool.async(end, task_noop, static_cast<std::uint64_t>(k));
+					}
+					end.finish();
+				}
+				double ns = elapsed_ns(start, clock_type::now());
+
+				rec.add("fan_out_in", name, config, threads, fan, "round", ns / static_cast<double>(round_count), "ns");
+				rec.add("fan_out_in", name, config, threads, fan, "per_task", ns / static_cast<double>(round_count * fan), "ns");
+			});
+		}
+	}
+
+
+	// uneven : one task in 64 is 100 times longer than the others, threads_ws is compared to the queue per thread of threads_mq
+
+	void bench_uneven(recorder& rec, const options& opt, unsigned int threads)
+	{
+		const std::size_t task_count = opt.quick ? 20000 : 200000;
+		constexpr std::uint64_t short_iterations = 200;
+		constexpr std::uint64_t long_iterations = 20000;
+
+		auto body = [&](auto& pool, const char* name, const std::string& config)
+		{
+			cool::async_end end;
+			end.add_awaited(task_count);
+
+			clock_type::time_point start = clock_type::now();
+			for (std::size_t k = 0; k < task_count; k++)
+			{
+				pool.async(end, task_work, (k % 64 == 0) ? long_iterations : short_iterations);
+			}
+			end.finish();
+			double ns = elapsed_ns(start, clock_type::now());
+
+			rec.add("uneven", name, config, threads, task_count, "tasks_per_s", 1e9 * static_cast<double>(task_count) / ns, "1/s");
+		};
+
+		run_pools(threads, body);
+
+		alignas(cache_line_size) threads_ws_type pool;
+		if (pool.init_new_threads(cool::thread_count(static_cast<std::uint16_t>(threads)), cool::task_buffer_size(task_buffer_size)))
+		{
+			body(pool, "ws", "try_pop=" + std::to_string(pool.try_pop_count()));
+		}
+	}
+
+
+	// parallel : cool::parallel::reduce / inclusive_scan / sort over an array of 64 bit integers, compared to the serial std algorithms
+
+	void bench_parallel(recorder& rec, const options& opt, unsigned int threads)
+	{
+		const std::size_t size = opt.quick ? (std::size_t(1) << 18) : (std::size_t(1) << 22);
+
+		std::vector<std::uint64_t> input(size);
+		for (std::size_t k = 0; k < size; k++)
+		{
+			input[k] = spin_work(k % 8) >> 16;
+		}
+		std::vector<std::uint64_t> output(size);
+
+		auto body = [&](auto&& reduce, auto&& scan, auto&& sort, const char* name, const std::string& config)
+		{
+			clock_type::time_point start = clock_type::now();
+			g_sink.fetch_add(reduce(), std::memory_order_relaxed);
+			rec.add("parallel", name, config, threads, size, "reduce", elapsed_ns(start, clock_type::now()) / static_cast<double>(size), "ns");
+
+			start = clock_type::now();
+			scan();
+			rec.add("parallel", name, config, threads, size, "inclusive_scan", elapsed_ns(start, clock_type::now()) / static_cast<double>(size), "ns");
+
+			output = input;
+			start = clock_type::now();
+			sort();
+			rec.add("parallel", name, config, threads, size, "sort", elapsed_ns(start, clock_type::now()) / static_cast<double>(size), "ns");
+		};
+
+		body([&]() { return std::accumulate(input.begin(), input.end(), std::uint64_t(0)); },
+			[&]() { std::partial_sum(input.begin(), input.end(), output.begin()); },
+			[&]() { std::sort(output.begin(), output.end()); },
+			"serial", "std");
+
+		run_pools(threads, [&](auto& pool, const char* name, const std::string& config)
+		{
+			body([&]() { return cool::parallel::reduce(pool, input.begin(), input.end(), std::uint64_t(0)); },
+				[&]() { cool::parallel::inclusive_scan(pool, input.begin(), input.end(), output.begin()); },
+				[&]() { cool::parallel::sort(pool, output.begin(), output.end()); },
+				name, config);
+		});
+	}
+
+
+	// timer : tasks queued with 'async_after' on threads_sq / threads_mq, one run per kind of target, the mean time from the requested
+	// deadline to the run of each task is measured
+
+	inline std::int64_t now_ns() noexcept
+	{
+		return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count());
+	}
+
+	std::atomic<std::int64_t> g_lateness_ns{ 0 };
+
+	std::int64_t task_lateness(std::int64_t deadline_ns) noexcept
+	{
+		std::int64_t lateness_ns = now_ns() - deadline_ns;
+		g_lateness_ns.fetch_add(lateness_ns, std::memory_order_relaxed);
+		return lateness_ns;
+	}
+
+	void bench_timer(recorder& rec, const options& opt, unsigned int threads)
+	{
+		const std::size_t task_count = opt.quick ? 64 : 512;
+		constexpr std::int64_t delay_us = 2000;
+		const cool::duration<clock_type> delay = cool::make_duration<clock_type>(delay_us, cool::duration_unit::us);
+
+		auto body = [&](auto& pool, const char* name)
+		{
+			const char* targets[] = { "no_target", "async_end", "async_end_incr", "async_result_to", "async_result_incr" };
+			std::vector<std::int64_t> storage(task_count);
+
+			for (std::size_t target = 0; target < 5; target++)
+			{
+				cool::async_end end;
+				cool::async_result<std::int64_t> result(storage.data());
+				std::size_t queued_count = 0;
+
+				if (target == 1) { end.add_awaited(task_count); }
+				if (target == 3) { result.add_awaited(task_count); }
+				g_lateness_ns.store(0, std::memory_order_relaxed);
+
+				for (std::size_t k = 0; k < task_count; k++)
+				{
+					std::int64_t deadline_ns = now_ns() + delay_us * 1000;
+					bool queued = false;
+
+					switch (target)
+					{
+					case 0: queued = pool.async_after(delay, cool::no_target, task_lateness, deadline_ns); break;
+					case 1: queued = pool.async_after(delay, end, task_lateness, deadline_ns); break;
+					case 2: queued = pool.async_after(delay, end.try_incr_awaited(), task_lateness, deadline_ns); break;
+					case 3: queued = pool.async_after(delay, result.to(k), task_lateness, deadline_ns); break;
+					default: queued = pool.async_after(delay, result.to(k).try_incr_awaited(), task_lateness, deadline_ns); break;
+					}
+
+					if (queued) { queued_count++; }
+					else if (target == 1) { end.sub_awaited(1); }
+					else if (target == 3) { result.sub_awaited(1); }
+				}
+
+				if (target == 0) { std::this_thread::sleep_for(std::chrono::microseconds(delay_us * 4)); }
+				end.finish();
+				result.finish();
+
+				if (queued_count != 0)
+				{
+					rec.add("timer", name, targets[target], threads, task_count, "lateness_mean",
+						static_cast<double>(g_lateness_ns.load(std::memory_order_relaxed)) / static_cast<double>(queued_count), "ns");
+				}
+			}
+		};
+
+		{
+			alignas(cache_line_size) threads_sq_type pool;
+			if (pool.init_new_threads(cool::thread_count(static_cast<std::uint16_t>(threads)), cool::task_buffer_size(task_buffer_size),
+				cool::thread_affinity(cool::thread_affinity::none), cool::elastic_policy(0), cool::timer_wheel(task_count, 100)))
+			{
+				body(pool, "sq");
+			}
+		}
+
+		{
+			alignas(cache_line_size) threads_mq_type pool;
+			if (pool.init_new_threads(cool::thread_count(static_cast<std::uint16_t>(threads)), cool::task_buffer_size(task_buffer_size),
+				cool::threads_mq_options().timer_wheel(cool::timer_wheel(task_count, 100))))
+			{
+				body(pool, "mq");
+			}
+		}
+	}
+
+
+	// queues : items per second through queue_spsc (1 producer, 1 consumer), queue_mpmc and queue_wlock (2 producers, 2 consumers)
+
+	template <class queue_Ty> double queue_items_per_s(queue_Ty& queue, unsigned int producers, unsigned int consumers, std::size_t item_count)
+	{
+		std::vector<std::thread> workers;
+		std::atomic<bool> go{ false };
+		std::size_t per_producer = item_count / producers;
+		std::size_t per_consumer = (per_producer * producers) / consumers;
+
+		for (unsigned int p = 0; p < producers; p++)
+		{
+			workers.emplace_back([&]()
+			{
+				while (!go.load(std::memory_order_acquire)) {}
+				for (std::size_t k = 0; k < per_producer; k++)
+				{
+					while (!queue.try_push(static_cast<std::uint64_t>(k))) { std::this_thread::yield(); }
+				}
+			});
+		}
+
+		for (unsigned int c = 0; c < consumers; c++)
+		{
+			workers.emplace_back([&]()
+			{
+				std::uint64_t item;
+				std::uint64_t sum = 0;
+				while (!go.load(std::memory_order_acquire)) {}
+				for (std::size_t k = 0; k < per_consumer; k++)
+				{
+					while (!queue.try_pop(item)) { std::this_thread::yield(); }
+					sum += item;
+				}
+				g_sink.fetch_add(sum, std::memory_order_relaxed);
+			});
+		}
+
+		clock_type::time_point start = clock_type::now();
+		go.store(true, std::memory_order_release);
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+
+		return 1e9 * static_cast<double>(per_consumer * consumers) / elapsed_ns(start, clock_type::now());
+	}
+
+	// same with 'try_push_n' / 'try_pop_n' moving up to 'batch_size' items per call
+
+	template <class queue_Ty> double queue_bulk_items_per_s(queue_Ty& queue, unsigned int producers, unsigned int consumers, std::size_t item_count, std::size_t batch_size)
+	{
+		std::vector<std::thread> workers;
+		std::atomic<bool> go{ false };
+		std::size_t per_producer = item_count / producers;
+		std::size_t per_consumer = (per_producer * producers) / consumers;
+
+		for (unsigned int p = 0; p < producers; p++)
+		{
+			workers.emplace_back([&]()
+			{
+				std::vector<std::uint64_t> items(batch_size);
+				while (!go.load(std::memory_order_acquire)) {}
+				for (std::size_t k = 0; k < per_producer;)
+				{
+					std::size_t count = (per_producer - k < batch_size) ? per_producer - k : batch_size;
+					for (std::size_t n = 0; n < count; n++)
+					{
+						items[n] = static_cast<std::uint64_t>(k + n);
+					}
+					std::size_t pushed = 0;
+					while ((pushed += queue.try_push_n(items.data() + pushed, count - pushed)) != count) { std::this_thread::yield(); }
+					k += count;
+				}
+			});
+		}
+
+		for (unsigned int c = 0; c < consumers; c++)
+		{
+			workers.emplace_back([&]()
+			{
+				std::vector<std::uint64_t> items(batch_size);
+				std::uint64_t sum = 0;
+				while (!go.load(std::memory_order_acquire)) {}
+				for (std::size_t k = 0; k < per_consumer;)
+				{
+					std::size_t max_count = (per_consumer - k < batch_size) ? per_consumer - k : batch_size;
+					std::size_t count = queue.try_pop_n(items.data(), max_count);
+					if (count == 0)
+					{
+						std::this_thread::yield();
+						continue;
+					}
+					for (std::size_t n = 0; n < count; n++)
+					{
+						sum += items[n];
+					}
+					k += count;
+				}
+				g_sink.fetch_add(sum, std::memory_order_relaxed);
+			});
+		}
+
+		clock_type::time_point start = clock_type::now();
+		go.store(true, std::memory_order_release);
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+
+		return 1e9 * static_cast<double>(per_consumer * consumers) / elapsed_ns(start, clock_type::now());
+	}
+
+	void bench_queues(recorder& rec, const options& opt)
+	{
+		const std::size_t item_count = opt.quick ? 200000 : 4000000;
+		constexpr std::size_t queue_size = 1024;
+
+		{
+			alignas(cache_line_size) cool::queue_spsc<std::uint64_t, cache_line_size> queue;
+			if (queue.init_queue_new_buffer(cool::item_buffer_size(queue_size)))
+			{
+				rec.add("queue", "spsc", "1p1c", 2, queue_size, "items_per_s", queue_items_per_s(queue, 1, 1, item_count), "1/s");
+			}
+			if (queue.init_queue_new_buffer(cool::item_buffer_size(queue_size)))
+			{
+				rec.add("queue", "spsc", "1p1c_n64", 2, queue_size, "items_per_s", queue_bulk_items_per_s(queue, 1, 1, item_count, 64), "1/s");
+			}
+		}
+		{
+			alignas(cache_line_size) cool::queue_mpmc<std::uint64_t, cache_line_size> queue;
+			if (queue.init_queue_new_buffer(cool::item_buffer_size(queue_size)))
+			{
+				rec.add("queue", "mpmc", "1p1c", 2, queue_size, "items_per_s", queue_items_per_s(queue, 1, 1, item_count), "1/s");
+			}
+			if (queue.init_queue_new_buffer(cool::item_buffer_size(queue_size)))
+			{
+				rec.add("queue", "mpmc", "2p2c", 4, queue_size, "items_per_s", queue_items_per_s(queue, 2, 2, item_count), "1/s");
+			}
+			if (queue.init_queue_new_buffer(cool::item_buffer_size(queue_size)))
+			{
+				rec.add("queue", "mpmc", "2p2c_n64", 4, queue_size, "items_per_s", queue_bulk_items_per_s(queue, 2, 2, item_count, 64), "1/s");
+			}
+		}
+		{
+			alignas(cache_line_size) cool::queue_wlock<std::uint64_t, cache_line_size> queue;
+			if (queue.init_queue_new_buffer(cool::item_buffer_size(queue_size)))
+			{
+				rec.add("queue", "wlock", "2p2c", 4, queue_size, "items_per_s", queue_items_per_s(queue, 2, 2, item_count), "1/s");
+			}
+		}
+	}
+
+
+	// command line
+
+	bool parse_options(int argc, char** argv, options& opt)
+	{
+		for (int k = 1; k < argc; k++)
+		{
+			std::string arg = argv[k];
+
+			if (arg.compare(0, 9, "--format=") == 0)
+			{
+				opt.format = arg.substr(9);
+				if ((opt.format != "json") && (opt.format != "csv")) { return false; }
+			}
+			else if (arg.compare(0, 9, "--output=") == 0)
+			{
+				opt.output = arg.substr(9);
+			}
+			else if (arg.compare(0, 9, "--filter=") == 0)
+			{
+				opt.filter = arg.substr(9);
+			}
+			else if (arg.compare(0, 10, "--threads=") == 0)
+			{
+				std::stringstream list(arg.substr(10));
+				std::string item;
+				while (std::getline(list, item, ','))
+				{
+					unsigned long value = std::strtoul(item.c_str(), nullptr, 10);
+					if ((value == 0) || (value > 1024)) { return false; }
+					opt.thread_counts.push_back(static_cast<unsigned int>(value));
+				}
+			}
+			else if (arg == "--quick")
+			{
+				opt.quick = true;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		if (opt.thread_counts.empty())
+		{
+			unsigned int hardware = std::max(std::thread::hardware_concurrency(), 1u);
+			for (unsigned int count = 1; count < hardware; count *= 2)
+			{
+				opt.thread_counts.push_back(count);
+			}
+			opt.thread_counts.push_back(hardware);
+		}
+
+		return true;
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	options opt;
+
+	if (!parse_options(argc, argv, opt))
+	{
+		std::fprintf(stderr, "usage : %s [--format=json|csv] [--output=<file>] [--threads=<n>,<n>,...] "
+			"[--filter=submit_latency|throughput|fan_out_in|uneven|parallel|timer|queue] [--quick]\n", argv[0]);
+		return 2;
+	}
+
+	recorder rec(opt);
+
+	for (unsigned int threads : opt.thread_counts)
+	{
+		if (rec.enabled("submit_latency")) { bench_submit_latency(rec, opt, threads); }
+		if (rec.enabled("throughput")) { bench_throughput(rec, opt, threads); }
+		if (rec.enabled("fan_out_in")) { bench_fan_out_in(rec, opt, threads); }
+		if (rec.enabled("uneven")) { bench_uneven(rec, opt, threads); }
+		if (rec.enabled("parallel")) { bench_parallel(rec, opt, threads); }
+		if (rec.enabled("timer")) { bench_timer(rec, opt, threads); }
+	}
+
+	if (rec.enabled("queue")) { bench_queues(rec, opt); }
+
+	if (opt.output.empty())
+	{
+		rec.write(std::cout);
+	}
+	else
+	{
+		std::ofstream file(opt.output);
+		if (!file)
+		{
+			std::fprintf(stderr, "cannot open %s\n", opt.output.c_str());
+			return 1;
+		}
+		rec.write(file);
+	}
+
+	return 0;
+}
+
+
+// cool_threads_benchmark.cpp
+//
+// This is free software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software for any purpose and by any means.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY IN CONNECTION WITH THE SOFTWARE.
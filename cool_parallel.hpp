@@ -0,0 +1,578 @@
+// cool_parallel.hpp
+// License <http://unlicense.org/> (statement below at the end of the file)
+// Feel free to Ctrl+F/replace the silly namespace and rename the file if convenient
+
+#ifndef xCOOL_PARALLEL_HPP
+#define xCOOL_PARALLEL_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <exception>
+#include <cassert>
+
+#include "cool_threads.hpp"
+
+
+// number of chunks queued per thread of the pool by the algorithms of cool::parallel (the actual chunk count may be lower for small ranges) :
+// #define COOL_PARALLEL_CHUNKS_PER_THREAD 4
+
+#ifndef COOL_PARALLEL_CHUNKS_PER_THREAD
+#define COOL_PARALLEL_CHUNKS_PER_THREAD 4
+#endif // COOL_PARALLEL_CHUNKS_PER_THREAD
+
+
+// minimum number of cache lines of input per chunk (a chunk is never smaller than one cache line worth of elements) :
+// #define COOL_PARALLEL_MIN_CHUNK_CACHE_LINES 32
+
+#ifndef COOL_PARALLEL_MIN_CHUNK_CACHE_LINES
+#define COOL_PARALLEL_MIN_CHUNK_CACHE_LINES 32
+#endif // COOL_PARALLEL_MIN_CHUNK_CACHE_LINES
+
+
+namespace cool
+{
+	// cool::parallel
+
+	// fork-join algorithms that split ['first', 'last') in chunks, queue all chunks but the first on 'threads' and run the first
+	// one on the calling thread before waiting for the others, chunk results are combined through the slots of an async_result
+
+	// 'threads_Ty' can be any of threads_sq, threads_mq, threads_lq or threads_ws, the pool must have been initialized
+	// the chunk size is a multiple of threads_Ty::cache_line_size / sizeof(value type) elements so that neighbouring chunks write
+	// to different cache lines when the range is aligned, and at least COOL_PARALLEL_MIN_CHUNK_CACHE_LINES cache lines long
+	// iterators must be random access, functions are called concurrently from several threads and must be safe to call that way
+
+	// if a function throws an std::exception, the algorithm waits for all the chunks already queued and then rethrows the first
+	// exception caught (on the calling thread in priority), other types of exceptions thrown from a queued chunk are not caught
+	// if COOL_THREADS_NO_EXCEPTIONS is defined, exceptions thrown from queued chunks are reported to the exception handler of 'threads'
+
+	// the calling thread runs the tasks queued on 'threads' while it waits for the chunks (see 'finish(threads)' of async_result),
+	// and runs a chunk itself instead of waiting for space if all queues are full, so that the algorithms can be called from a task
+	// running on 'threads', including from another algorithm
+
+	namespace parallel
+	{
+		// 'function(element)' is called for every element of ['first', 'last')
+
+		template <class threads_Ty, class iterator_Ty, class function_Ty>
+		inline void for_each(threads_Ty& threads, iterator_Ty first, iterator_Ty last, function_Ty function);
+
+		// 'function(element)' is stored in 'out_first[i]' for every element first[i] of ['first', 'last'), returns 'out_first + (last - first)'
+		// 'out_first' may be equal to 'first' but the two ranges must not otherwise overlap
+
+		template <class threads_Ty, class iterator_Ty, class out_iterator_Ty, class function_Ty>
+		inline out_iterator_Ty transform(threads_Ty& threads, iterator_Ty first, iterator_Ty last, out_iterator_Ty out_first, function_Ty function);
+
+		// returns 'init' combined with all the elements of ['first', 'last') with 'reduce_function', which must be associative
+		// and commutative as the grouping and order of the operations is unspecified
+
+		template <class threads_Ty, class iterator_Ty, class Ty, class reduce_function_Ty = std::plus<>>
+		inline Ty reduce(threads_Ty& threads, iterator_Ty first, iterator_Ty last, Ty init, reduce_function_Ty reduce_function = reduce_function_Ty());
+
+		// returns 'init' combined with 'transform_function(element)' for all the elements of ['first', 'last') with 'reduce_function',
+		// with the same requirements as 'reduce'
+
+		template <class threads_Ty, class iterator_Ty, class Ty, class reduce_function_Ty, class transform_function_Ty>
+		inline Ty transform_reduce(threads_Ty& threads, iterator_Ty first, iterator_Ty last, Ty init, reduce_function_Ty reduce_function, transform_function_Ty transform_function);
+
+		// stores in 'out_first[i]' the combination of first[0] to first[i] with 'scan_function', which must be associative, returns
+		// 'out_first + (last - first)', the range is read twice (once to compute the sum of every chunk, once to write the scan)
+		// 'out_first' may be equal to 'first' but the two ranges must not otherwise overlap
+
+		template <class threads_Ty, class iterator_Ty, class out_iterator_Ty, class scan_function_Ty = std::plus<>>
+		inline out_iterator_Ty inclusive_scan(threads_Ty& threads, iterator_Ty first, iterator_Ty last, out_iterator_Ty out_first, scan_function_Ty scan_function = scan_function_Ty());
+
+		// sorts ['first', 'last') with 'compare', chunks are sorted with std::sort and then merged pairwise with std::inplace_merge,
+		// the number of merges running concurrently halves at every round, the sort is not stable
+
+		template <class threads_Ty, class iterator_Ty, class compare_Ty = std::less<>>
+		inline void sort(threads_Ty& threads, iterator_Ty first, iterator_Ty last, compare_Ty compare = compare_Ty());
+	}
+
+
+	// cool::parallel detail
+
+	template <class iterator_Ty> class _parallel_chunks
+	{
+
+	public:
+
+		using value_type = typename std::iterator_traits<iterator_Ty>::value_type;
+
+		static_assert(std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<iterator_Ty>::iterator_category>::value,
+			"cool::parallel : iterators must be random access");
+
+		_parallel_chunks() = delete;
+
+		template <class threads_Ty>
+		inline _parallel_chunks(const threads_Ty& threads, iterator_Ty first, iterator_Ty last) noexcept;
+
+		inline std::size_t size() const noexcept { return m_size; }
+		inline std::size_t count() const noexcept { return m_chunk_count; }
+		inline iterator_Ty begin(std::size_t chunk) const noexcept;
+		inline iterator_Ty end(std::size_t chunk) const noexcept;
+		inline std::size_t offset(std::size_t chunk) const noexcept { return chunk * m_chunk_size; }
+
+	private:
+
+		iterator_Ty m_first;
+		std::size_t m_size;
+		std::size_t m_chunk_size;
+		std::size_t m_chunk_count;
+	};
+
+	class _parallel_base
+	{
+
+	public:
+
+		// queues 'task(context_ptr, chunk)' on 'threads' for every chunk in [1, 'chunk_count') and runs 'task(context_ptr, 0)' on the calling
+		// thread, as well as every chunk that 'try_async' fails to queue, the results are stored in ['storage_ptr', 'storage_ptr' + 'chunk_count'),
+		// returns once all chunks have been executed
+
+		template <class threads_Ty, class return_Ty, class context_Ty>
+		static inline void run(threads_Ty& threads, std::size_t chunk_count, return_Ty(*task)(context_Ty*, std::size_t), context_Ty* context_ptr, return_Ty* storage_ptr);
+	};
+
+	template <class iterator_Ty, class function_Ty> class _parallel_for_each
+	{
+
+	public:
+
+		const cool::_parallel_chunks<iterator_Ty>* m_chunks_ptr;
+		function_Ty* m_function_ptr;
+
+		static inline std::size_t chunk(cool::_parallel_for_each<iterator_Ty, function_Ty>* context_ptr, std::size_t chunk);
+	};
+
+	template <class iterator_Ty, class out_iterator_Ty, class function_Ty> class _parallel_transform
+	{
+
+	public:
+
+		const cool::_parallel_chunks<iterator_Ty>* m_chunks_ptr;
+		out_iterator_Ty m_out_first;
+		function_Ty* m_function_ptr;
+
+		static inline std::size_t chunk(cool::_parallel_transform<iterator_Ty, out_iterator_Ty, function_Ty>* context_ptr, std::size_t chunk);
+	};
+
+	template <class iterator_Ty, class Ty, class reduce_function_Ty, class transform_function_Ty> class _parallel_transform_reduce
+	{
+
+	public:
+
+		const cool::_parallel_chunks<iterator_Ty>* m_chunks_ptr;
+		reduce_function_Ty* m_reduce_function_ptr;
+		transform_function_Ty* m_transform_function_ptr;
+
+		static inline Ty chunk(cool::_parallel_transform_reduce<iterator_Ty, Ty, reduce_function_Ty, transform_function_Ty>* context_ptr, std::size_t chunk);
+	};
+
+	template <class Ty> class _parallel_identity
+	{
+
+	public:
+
+		inline const Ty& operator()(const Ty& rhs) const noexcept { return rhs; }
+	};
+
+	template <class iterator_Ty, class out_iterator_Ty, class Ty, class scan_function_Ty> class _parallel_inclusive_scan
+	{
+
+	public:
+
+		const cool::_parallel_chunks<iterator_Ty>* m_chunks_ptr;
+		out_iterator_Ty m_out_first;
+		scan_function_Ty* m_scan_function_ptr;
+		const Ty* m_carries_ptr;
+
+		static inline std::size_t chunk(cool::_parallel_inclusive_scan<iterator_Ty, out_iterator_Ty, Ty, scan_function_Ty>* context_ptr, std::size_t chunk);
+	};
+
+	template <class iterator_Ty, class compare_Ty> class _parallel_sort
+	{
+
+	public:
+
+		const cool::_parallel_chunks<iterator_Ty>* m_chunks_ptr;
+		compare_Ty* m_compare_ptr;
+		std::size_t m_width; // in chunks, 0 for the std::sort pass
+
+		static inline std::size_t chunk(cool::_parallel_sort<iterator_Ty, compare_Ty>* context_ptr, std::size_t chunk);
+	};
+}
+
+
+// detail
+
+template <class iterator_Ty> template <class threads_Ty>
+inline cool::_parallel_chunks<iterator_Ty>::_parallel_chunks(const threads_Ty& threads, iterator_Ty first, iterator_Ty last) noexcept
+	: m_first(first)
+{
+	constexpr std::size_t elements_per_line = (threads_Ty::cache_line_size > sizeof(value_type)) ? (threads_Ty::cache_line_size / sizeof(value_type)) : 1;
+	constexpr std::size_t min_chunk_size = elements_per_line * ((COOL_PARALLEL_MIN_CHUNK_CACHE_LINES > 0) ? COOL_PARALLEL_MIN_CHUNK_CACHE_LINES : 1);
+
+	m_size = (first < last) ? static_cast<std::size_t>(last - first) : 0;
+
+	std::size_t thread_count = threads.thread_count();
+
+	if ((m_size == 0) || (thread_count == 0))
+	{
+		m_chunk_size = (m_size != 0) ? m_size : 1;
+		m_chunk_count = (m_size != 0) ? 1 : 0;
+		return;
+	}
+
+	std::size_t target_chunk_count = (thread_count + 1) * ((COOL_PARALLEL_CHUNKS_PER_THREAD > 0) ? COOL_PARALLEL_CHUNKS_PER_THREAD : 1);
+	std::size_t chunk_size = m_size / target_chunk_count + static_cast<std::size_t>(m_size % target_chunk_count != 0);
+	chunk_size = ((chunk_size + elements_per_line - 1) / elements_per_line) * elements_per_line;
+
+	m_chunk_size = (chunk_size > min_chunk_size) ? chunk_size : min_chunk_size;
+	m_chunk_count = m_size / m_chunk_size + static_cast<std::size_t>(m_size % m_chunk_size != 0);
+}
+
+template <class iterator_Ty>
+inline iterator_Ty cool::_parallel_chunks<iterator_Ty>::begin(std::size_t chunk) const noexcept
+{
+	using _difference_type = typename std::iterator_traits<iterator_Ty>::difference_type;
+
+	return m_first + static_cast<_difference_type>(chunk * m_chunk_size);
+}
+
+template <class iterator_Ty>
+inline iterator_Ty cool::_parallel_chunks<iterator_Ty>::end(std::size_t chunk) const noexcept
+{
+	using _difference_type = typename std::iterator_traits<iterator_Ty>::difference_type;
+
+	return m_first + static_cast<_difference_type>((chunk + 1 < m_chunk_count) ? (chunk + 1) * m_chunk_size : m_size);
+}
+
+template <class threads_Ty, class return_Ty, class context_Ty>
+inline void cool::_parallel_base::run(threads_Ty& threads, std::size_t chunk_count, return_Ty(*task)(context_Ty*, std::size_t), context_Ty* context_ptr, return_Ty* storage_ptr)
+{
+	if (chunk_count == 0)
+	{
+		return;
+	}
+
+	cool::async_result<return_Ty> result(storage_ptr);
+
+	// chunks are queued with 'try_async' : a chunk that finds all queues full runs on the calling thread instead of waiting for space
+
+#ifndef COOL_THREADS_NO_EXCEPTIONS
+	result.capture_exceptions(true);
+
+	std::exception_ptr exception_ptr;
+
+	for (std::size_t chunk = 1; chunk < chunk_count; chunk++)
+	{
+		if (!threads.try_async(result.to(chunk).try_incr_awaited(), task, context_ptr, chunk))
+		{
+			try
+			{
+				*(storage_ptr + chunk) = task(context_ptr, chunk);
+			}
+			catch (...)
+			{
+				if (!exception_ptr)
+				{
+					exception_ptr = std::current_exception();
+				}
+			}
+		}
+	}
+
+	try
+	{
+		*storage_ptr = task(context_ptr, 0);
+	}
+	catch (...)
+	{
+		if (!exception_ptr)
+		{
+			exception_ptr = std::current_exception();
+		}
+	}
+
+	result.finish(threads);
+
+	if (exception_ptr)
+	{
+		std::rethrow_exception(exception_ptr);
+	}
+
+	result.rethrow_exception();
+#else // COOL_THREADS_NO_EXCEPTIONS
+	for (std::size_t chunk = 1; chunk < chunk_count; chunk++)
+	{
+		if (!threads.try_async(result.to(chunk).try_incr_awaited(), task, context_ptr, chunk))
+		{
+			*(storage_ptr + chunk) = task(context_ptr, chunk);
+		}
+	}
+
+	*storage_ptr = task(context_ptr, 0);
+
+	result.finish(threads);
+#endif // COOL_THREADS_NO_EXCEPTIONS
+}
+
+template <class iterator_Ty, class function_Ty>
+inline std::size_t cool::_parallel_for_each<iterator_Ty, function_Ty>::chunk(cool::_parallel_for_each<iterator_Ty, function_Ty>* context_ptr, std::size_t chunk)
+{
+	iterator_Ty chunk_last = context_ptr->m_chunks_ptr->end(chunk);
+
+	for (iterator_Ty it = context_ptr->m_chunks_ptr->begin(chunk); it != chunk_last; ++it)
+	{
+		(*context_ptr->m_function_ptr)(*it);
+	}
+
+	return chunk;
+}
+
+template <class iterator_Ty, class out_iterator_Ty, class function_Ty>
+inline std::size_t cool::_parallel_transform<iterator_Ty, out_iterator_Ty, function_Ty>::chunk(cool::_parallel_transform<iterator_Ty, out_iterator_Ty, function_Ty>* context_ptr, std::size_t chunk)
+{
+	using _difference_type = typename std::iterator_traits<out_iterator_Ty>::difference_type;
+
+	iterator_Ty chunk_last = context_ptr->m_chunks_ptr->end(chunk);
+	out_iterator_Ty out = context_ptr->m_out_first + static_cast<_difference_type>(context_ptr->m_chunks_ptr->offset(chunk));
+
+	for (iterator_Ty it = context_ptr->m_chunks_ptr->begin(chunk); it != chunk_last; ++it, ++out)
+	{
+		*out = (*context_ptr->m_function_ptr)(*it);
+	}
+
+	return chunk;
+}
+
+template <class iterator_Ty, class Ty, class reduce_function_Ty, class transform_function_Ty>
+inline Ty cool::_parallel_transform_reduce<iterator_Ty, Ty, reduce_function_Ty, transform_function_Ty>::chunk(
+	cool::_parallel_transform_reduce<iterator_Ty, Ty, reduce_function_Ty, transform_function_Ty>* context_ptr, std::size_t chunk)
+{
+	iterator_Ty it = context_ptr->m_chunks_ptr->begin(chunk);
+	iterator_Ty chunk_last = context_ptr->m_chunks_ptr->end(chunk);
+
+	Ty ret = (*context_ptr->m_transform_function_ptr)(*it);
+
+	for (++it; it != chunk_last; ++it)
+	{
+		ret = (*context_ptr->m_reduce_function_ptr)(std::move(ret), (*context_ptr->m_transform_function_ptr)(*it));
+	}
+
+	return ret;
+}
+
+template <class iterator_Ty, class out_iterator_Ty, class Ty, class scan_function_Ty>
+inline std::size_t cool::_parallel_inclusive_scan<iterator_Ty, out_iterator_Ty, Ty, scan_function_Ty>::chunk(
+	cool::_parallel_inclusive_scan<iterator_Ty, out_iterator_Ty, Ty, scan_function_Ty>* context_ptr, std::size_t chunk)
+{
+	using _difference_type = typename std::iterator_traits<out_iterator_Ty>::difference_type;
+
+	iterator_Ty it = context_ptr->m_chunks_ptr->begin(chunk);
+	iterator_Ty chunk_last = context_ptr->m_chunks_ptr->end(chunk);
+	out_iterator_Ty out = context_ptr->m_out_first + static_cast<_difference_type>(context_ptr->m_chunks_ptr->offset(chunk));
+
+	Ty acc = (chunk == 0) ? Ty(*it) : (*context_ptr->m_scan_function_ptr)(context_ptr->m_carries_ptr[chunk], *it);
+	*out = acc;
+
+	for (++it, ++out; it != chunk_last; ++it, ++out)
+	{
+		acc = (*context_ptr->m_scan_function_ptr)(std::move(acc), *it);
+		*out = acc;
+	}
+
+	return chunk;
+}
+
+template <class iterator_Ty, class compare_Ty>
+inline std::size_t cool::_parallel_sort<iterator_Ty, compare_Ty>::chunk(cool::_parallel_sort<iterator_Ty, compare_Ty>* context_ptr, std::size_t chunk)
+{
+	const cool::_parallel_chunks<iterator_Ty>& chunks = *context_ptr->m_chunks_ptr;
+	std::size_t width = context_ptr->m_width;
+
+	if (width == 0)
+	{
+		std::sort(chunks.begin(chunk), chunks.end(chunk), *context_ptr->m_compare_ptr);
+	}
+	else
+	{
+		std::size_t first_chunk = 2 * width * chunk;
+		std::size_t middle_chunk = first_chunk + width;
+
+		if (middle_chunk < chunks.count())
+		{
+			std::size_t last_chunk = (middle_chunk + width < chunks.count()) ? middle_chunk + width : chunks.count();
+
+			std::inplace_merge(chunks.begin(first_chunk), chunks.begin(middle_chunk), chunks.end(last_chunk - 1), *context_ptr->m_compare_ptr);
+		}
+	}
+
+	return chunk;
+}
+
+
+// cool::parallel
+
+template <class threads_Ty, class iterator_Ty, class function_Ty>
+inline void cool::parallel::for_each(threads_Ty& threads, iterator_Ty first, iterator_Ty last, function_Ty function)
+{
+	using _cool_for_each = cool::_parallel_for_each<iterator_Ty, function_Ty>;
+
+	cool::_parallel_chunks<iterator_Ty> chunks(threads, first, last);
+
+	if (chunks.count() == 0)
+	{
+		return;
+	}
+
+	_cool_for_each context{ &chunks, &function };
+	std::vector<std::size_t> chunk_results(chunks.count());
+
+	cool::_parallel_base::run(threads, chunks.count(), &_cool_for_each::chunk, &context, chunk_results.data());
+}
+
+template <class threads_Ty, class iterator_Ty, class out_iterator_Ty, class function_Ty>
+inline out_iterator_Ty cool::parallel::transform(threads_Ty& threads, iterator_Ty first, iterator_Ty last, out_iterator_Ty out_first, function_Ty function)
+{
+	using _cool_transform = cool::_parallel_transform<iterator_Ty, out_iterator_Ty, function_Ty>;
+	using _difference_type = typename std::iterator_traits<out_iterator_Ty>::difference_type;
+
+	static_assert(std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<out_iterator_Ty>::iterator_category>::value,
+		"cool::parallel::transform : output iterator must be random access");
+
+	cool::_parallel_chunks<iterator_Ty> chunks(threads, first, last);
+
+	if (chunks.count() == 0)
+	{
+		return out_first;
+	}
+
+	_cool_transform context{ &chunks, out_first, &function };
+	std::vector<std::size_t> chunk_results(chunks.count());
+
+	cool::_parallel_base::run(threads, chunks.count(), &_cool_transform::chunk, &context, chunk_results.data());
+
+	return out_first + static_cast<_difference_type>(chunks.size());
+}
+
+template <class threads_Ty, class iterator_Ty, class Ty, class reduce_function_Ty>
+inline Ty cool::parallel::reduce(threads_Ty& threads, iterator_Ty first, iterator_Ty last, Ty init, reduce_function_Ty reduce_function)
+{
+	return cool::parallel::transform_reduce(threads, first, last, std::move(init), std::move(reduce_function),
+		cool::_parallel_identity<typename std::iterator_traits<iterator_Ty>::value_type>());
+}
+
+template <class threads_Ty, class iterator_Ty, class Ty, class reduce_function_Ty, class transform_function_Ty>
+inline Ty cool::parallel::transform_reduce(threads_Ty& threads, iterator_Ty first, iterator_Ty last, Ty init, reduce_function_Ty reduce_function, transform_function_Ty transform_function)
+{
+	using _cool_transform_reduce = cool::_parallel_transform_reduce<iterator_Ty, Ty, reduce_function_Ty, transform_function_Ty>;
+
+	cool::_parallel_chunks<iterator_Ty> chunks(threads, first, last);
+
+	if (chunks.count() == 0)
+	{
+		return init;
+	}
+
+	_cool_transform_reduce context{ &chunks, &reduce_function, &transform_function };
+	std::vector<Ty> chunk_results(chunks.count(), init);
+
+	cool::_parallel_base::run(threads, chunks.count(), &_cool_transform_reduce::chunk, &context, chunk_results.data());
+
+	for (Ty& chunk_result : chunk_results)
+	{
+		init = reduce_function(std::move(init), std::move(chunk_result));
+	}
+
+	return init;
+}
+
+template <class threads_Ty, class iterator_Ty, class out_iterator_Ty, class scan_function_Ty>
+inline out_iterator_Ty cool::parallel::inclusive_scan(threads_Ty& threads, iterator_Ty first, iterator_Ty last, out_iterator_Ty out_first, scan_function_Ty scan_function)
+{
+	using _value_type = typename std::iterator_traits<iterator_Ty>::value_type;
+	using _cool_chunk_sum = cool::_parallel_transform_reduce<iterator_Ty, _value_type, scan_function_Ty, cool::_parallel_identity<_value_type>>;
+	using _cool_inclusive_scan = cool::_parallel_inclusive_scan<iterator_Ty, out_iterator_Ty, _value_type, scan_function_Ty>;
+	using _difference_type = typename std::iterator_traits<out_iterator_Ty>::difference_type;
+
+	static_assert(std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<out_iterator_Ty>::iterator_category>::value,
+		"cool::parallel::inclusive_scan : output iterator must be random access");
+
+	cool::_parallel_chunks<iterator_Ty> chunks(threads, first, last);
+
+	if (chunks.count() == 0)
+	{
+		return out_first;
+	}
+
+	// carries[chunk] : combination of all the elements before 'chunk', carries[0] is unused
+
+	std::vector<_value_type> carries(chunks.count(), *first);
+
+	if (chunks.count() > 1)
+	{
+		cool::_parallel_identity<_value_type> identity;
+		_cool_chunk_sum sum_context{ &chunks, &scan_function, &identity };
+
+		cool::_parallel_base::run(threads, chunks.count() - 1, &_cool_chunk_sum::chunk, &sum_context, carries.data() + 1);
+
+		for (std::size_t chunk = 2; chunk < chunks.count(); chunk++)
+		{
+			carries[chunk] = scan_function(carries[chunk - 1], carries[chunk]);
+		}
+	}
+
+	_cool_inclusive_scan scan_context{ &chunks, out_first, &scan_function, carries.data() };
+	std::vector<std::size_t> chunk_results(chunks.count());
+
+	cool::_parallel_base::run(threads, chunks.count(), &_cool_inclusive_scan::chunk, &scan_context, chunk_results.data());
+
+	return out_first + static_cast<_difference_type>(chunks.size());
+}
+
+template <class threads_Ty, class iterator_Ty, class compare_Ty>
+inline void cool::parallel::sort(threads_Ty& threads, iterator_Ty first, iterator_Ty last, compare_Ty compare)
+{
+	using _cool_sort = cool::_parallel_sort<iterator_Ty, compare_Ty>;
+
+	cool::_parallel_chunks<iterator_Ty> chunks(threads, first, last);
+
+	if (chunks.count() == 0)
+	{
+		return;
+	}
+
+	_cool_sort context{ &chunks, &compare, 0 };
+	std::vector<std::size_t> chunk_results(chunks.count());
+
+	cool::_parallel_base::run(threads, chunks.count(), &_cool_sort::chunk, &context, chunk_results.data());
+
+	for (std::size_t width = 1; width < chunks.count(); width *= 2)
+	{
+		context.m_width = width;
+
+		std::size_t merge_count = (chunks.count() - width + 2 * width - 1) / (2 * width);
+
+		cool::_parallel_base::run(threads, merge_count, &_cool_sort::chunk, &context, chunk_results.data());
+	}
+}
+
+#endif // xCOOL_PARALLEL_HPP
+
+
+// cool_parallel.hpp
+//
+// This is free software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software for any purpose and by any means.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY IN CONNECTION WITH THE SOFTWARE.
@@ -13,7 +13,7 @@
 #include <cassert>
 
 
-// to allow the use of atomic to enable cool::queue_spsc/cool::queue_mpmc : #define COOL_QUEUES_ATOMIC
+// to allow the use of atomic to enable cool::queue_spsc/cool::queue_mpmc/cool::queue_spsc_bytes : #define COOL_QUEUES_ATOMIC
 
 #ifdef COOL_QUEUES_ATOMIC
 #endif // COOL_QUEUES_ATOMIC
@@ -25,10 +25,17 @@
 #endif // COOL_QUEUES_THREAD
 
 
+// to allow the use of the Linux futex system call to enable cool::wait_futex : #define COOL_QUEUES_FUTEX
+
+#ifdef COOL_QUEUES_FUTEX
+#endif // COOL_QUEUES_FUTEX
+
+
 #ifdef COOL_QUEUES_ATOMIC
 #include <atomic>
 #include <limits>
 #include <cstring>
+#include <iterator>
 
 #endif // COOL_QUEUES_ATOMIC
 
@@ -45,6 +52,19 @@
 #endif // COOL_QUEUES_THREAD
 
 
+#ifdef COOL_QUEUES_FUTEX
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if !defined(COOL_QUEUES_ATOMIC) && !defined(COOL_QUEUES_THREAD)
+#include <atomic>
+
+#endif // !defined(COOL_QUEUES_ATOMIC) && !defined(COOL_QUEUES_THREAD)
+#endif // COOL_QUEUES_FUTEX
+
+
 // custom wait class prototype
 
 //class custom_wait_example
@@ -54,11 +74,16 @@
 //	void push_wait() noexcept; // required for queue_spsc, queue_mpmc, queue_wlock
 //	void pop_wait() noexcept; // required for queue_spsc, queue_mpmc
 //	bool good() noexcept; // required for queue_spsc, queue_mpmc
+//	static void push_notify(void* shared_data_ptr) noexcept; // optional for queue_spsc, queue_mpmc, along with 'pop_notify'
+//	static void pop_notify(void* shared_data_ptr) noexcept; // optional for queue_spsc, queue_mpmc, along with 'push_notify'
 //};
 
 // 'good()' should return false when the queue and all its items are to be discarded
 // in this case, a member function 'pop()' running will return false
 
+// if present, 'push_notify' / 'pop_notify' are called after every push / pop of a queue_spsc or queue_mpmc
+// so that a wait class can put waiting threads to sleep in 'pop_wait' / 'push_wait' and wake them up
+
 
 namespace cool
 {
@@ -68,13 +93,28 @@ namespace cool
 #ifdef COOL_QUEUES_ATOMIC
 	template <class Ty, std::size_t _cache_line_size, class _wait_Ty = wait_noop, class _uintX_t = std::size_t> class queue_spsc;
 	template <class Ty, std::size_t _cache_line_size, class _wait_Ty = wait_noop, class _uintX_t = std::uint32_t> class queue_mpmc;
+	template <std::size_t _cache_line_size> class queue_spsc_bytes;
+
+#if defined(__cpp_lib_atomic_wait) || defined(COOL_QUEUES_FUTEX)
+	class _park_atomic;
+	class wait_atomic;
+#endif // defined(__cpp_lib_atomic_wait) || defined(COOL_QUEUES_FUTEX)
 #endif // COOL_QUEUES_ATOMIC
 
+#if defined(COOL_QUEUES_FUTEX) || (defined(COOL_QUEUES_ATOMIC) && defined(__cpp_lib_atomic_wait))
+	template <class _park_Ty> class _wait_parking;
+#endif // defined(COOL_QUEUES_FUTEX) || (defined(COOL_QUEUES_ATOMIC) && defined(__cpp_lib_atomic_wait))
+
 #ifdef COOL_QUEUES_THREAD
 	class wait_yield;
 	template <class Ty, std::size_t _cache_line_size, class _wait_Ty = wait_yield> class queue_wlock;
 #endif // COOL_QUEUES_THREAD
 
+#ifdef COOL_QUEUES_FUTEX
+	class _park_futex;
+	class wait_futex;
+#endif // COOL_QUEUES_FUTEX
+
 	class item_buffer_size;
 	class queue_init_result;
 
@@ -123,6 +163,7 @@ namespace cool
 #ifdef COOL_QUEUES_ATOMIC
 		template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX> friend class cool::queue_spsc;
 		template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX> friend class cool::queue_mpmc;
+		template <std::size_t _cache_line_size> friend class cool::queue_spsc_bytes;
 #endif // COOL_QUEUES_ATOMIC
 
 #ifdef COOL_QUEUES_THREAD
@@ -188,6 +229,11 @@ namespace cool
 
 #ifdef COOL_QUEUES_ATOMIC
 
+	// detects the optional 'push_notify' / 'pop_notify' members of a wait class
+
+	template <class wait_Ty, class = void> class _queue_wait_notify : public std::false_type {};
+	template <class wait_Ty> class _queue_wait_notify<wait_Ty, decltype(wait_Ty::push_notify(nullptr), wait_Ty::pop_notify(nullptr), void())> : public std::true_type {};
+
 	// queue_spsc
 
 	template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t> class alignas(_cache_line_size) queue_spsc
@@ -231,17 +277,63 @@ namespace cool
 		inline const void* get_shared_data_ptr() const noexcept;
 		inline void delete_queue_buffer() noexcept;
 
+		// inter-process mode : the queue object is constructed at the start of a region of 'shared_region_size(...)' bytes, for instance
+		// memory mapped with shm_open/mmap, 'init_queue_shared_region' then places 'shared_data_size' bytes of zero filled shared data
+		// (see 'get_shared_data_ptr') and the slots after it, the slots are addressed relative to the queue object so that another process
+		// may use the queue through a pointer to the start of its own mapping of the region, at any address
+		// WARNING : the region must be aligned on max(cache_line_size, alignof(Ty)), Ty must be trivially copyable, std::atomic must be
+		// lock free (which makes it address free) and only the process that called 'init_queue_shared_region' may delete the buffer
+
+		static inline std::size_t shared_region_size(cool::item_buffer_size new_item_buffer_size, std::size_t shared_data_size = 0) noexcept;
+		inline cool::queue_init_result init_queue_shared_region(cool::item_buffer_size new_item_buffer_size, std::size_t region_size, std::size_t shared_data_size = 0);
+
 		template <class ... arg_Ty> inline bool try_push(arg_Ty&& ... args) noexcept(std::is_nothrow_constructible<Ty, arg_Ty ...>::value);
 		inline bool try_pop(Ty& target) noexcept;
 		template <class ... arg_Ty> inline void push(arg_Ty&& ... args) noexcept(std::is_nothrow_constructible<Ty, arg_Ty ...>::value);
 		inline bool pop(Ty& target) noexcept; // returns false when the queue and all its items are to be discarded and item obtained should not be used
 
+		// 'try_push_n' / 'try_pop_n' transfer up to 'count' / 'max_count' items from / to the range at 'first' and return the number of items
+		// transferred, the items are copied with memcpy if Ty is trivially copyable and 'first' is a pointer, and published with a single atomic store
+
+		template <class iterator_Ty> inline std::size_t try_push_n(iterator_Ty first, std::size_t count)
+			noexcept(std::is_nothrow_constructible<Ty, typename std::iterator_traits<iterator_Ty>::reference>::value);
+		template <class iterator_Ty> inline std::size_t try_pop_n(iterator_Ty first, std::size_t max_count) noexcept;
+
+		// in place access to the slots : 'begin_push' returns the next free slot or nullptr if the queue is full, the item it holds (the one
+		// last popped from it, or Ty() if none) is modified in place and published with 'commit_push', 'begin_pop' returns the next item or
+		// nullptr if the queue is empty, the item is read in place and its slot given back with 'release_pop'
+		// WARNING : 'commit_push' / 'release_pop' must only be called once after a non null 'begin_push' / 'begin_pop'
+
+		inline Ty* begin_push() noexcept;
+		inline void commit_push() noexcept;
+		inline const Ty* begin_pop() noexcept;
+		inline void release_pop() noexcept;
+
 	private:
 
-		Ty* m_item_buffer_data_ptr = nullptr;
+		using _wait_notify = cool::_queue_wait_notify<_wait_Ty>;
+
+		static inline std::size_t shared_region_item_buffer_offset(std::size_t shared_data_size) noexcept;
+		inline Ty* item_buffer_data_ptr() noexcept;
+		inline void push_notify(std::true_type) noexcept;
+		inline void push_notify(std::false_type) noexcept;
+		inline void pop_notify(std::true_type) noexcept;
+		inline void pop_notify(std::false_type) noexcept;
+
+		template <class iterator_Ty> using _bulk_copy = std::integral_constant<bool, std::is_trivially_copyable<Ty>::value && std::is_pointer<iterator_Ty>::value
+			&& std::is_same<typename std::remove_cv<typename std::remove_pointer<iterator_Ty>::type>::type, Ty>::value>;
+
+		template <class iterator_Ty> static inline iterator_Ty construct_n(Ty* slot_ptr, std::size_t count, iterator_Ty first, std::false_type)
+			noexcept(std::is_nothrow_constructible<Ty, typename std::iterator_traits<iterator_Ty>::reference>::value);
+		template <class iterator_Ty> static inline iterator_Ty construct_n(Ty* slot_ptr, std::size_t count, iterator_Ty first, std::true_type) noexcept;
+		template <class iterator_Ty> static inline iterator_Ty move_n(Ty* slot_ptr, std::size_t count, iterator_Ty first, std::false_type) noexcept;
+		template <class iterator_Ty> static inline iterator_Ty move_n(Ty* slot_ptr, std::size_t count, iterator_Ty first, std::true_type) noexcept;
+
+		std::uintptr_t m_item_buffer_data_offset = 0; // relative to the queue object
 		_uintX_t m_item_buffer_size = 0;
 		std::atomic<bool> m_good{ false };
 		void* m_shared_data_ptr = nullptr;
+		std::size_t m_shared_data_offset = 0; // relative to the queue object, in inter-process mode
 		char* m_item_buffer_unaligned_data_ptr = nullptr;
 
 		alignas(_cache_line_size) std::atomic<_uintX_t> m_last_item_offset{ 0 };
@@ -258,18 +350,18 @@ namespace cool
 
 	private:
 
-		template <class _uintX_type> class _upcast { public: using uint2X_type = void; };
+		template <class _uintX_type, class _dummy_Ty = void> class _upcast { public: using uint2X_type = void; };
 
 #if defined(UINT8_MAX) && defined(UINT16_MAX)
-		template <> class _upcast<std::uint8_t> { public: using uint2X_type = std::uint16_t; };
+		template <class _dummy_Ty> class _upcast<std::uint8_t, _dummy_Ty> { public: using uint2X_type = std::uint16_t; };
 #endif // defined(UINT8_MAX) && defined(UINT16_MAX)
 
 #if defined(UINT16_MAX) && defined(UINT32_MAX)
-		template <> class _upcast<std::uint16_t> { public: using uint2X_type = std::uint32_t; };
+		template <class _dummy_Ty> class _upcast<std::uint16_t, _dummy_Ty> { public: using uint2X_type = std::uint32_t; };
 #endif // defined(UINT16_MAX) && defined(UINT32_MAX)
 
 #if defined(UINT32_MAX) && defined(UINT64_MAX)
-		template <> class _upcast<std::uint32_t> { public: using uint2X_type = std::uint64_t; };
+		template <class _dummy_Ty> class _upcast<std::uint32_t, _dummy_Ty> { public: using uint2X_type = std::uint64_t; };
 #endif // defined(UINT32_MAX) && defined(UINT64_MAX)
 
 	public:
@@ -316,11 +408,29 @@ namespace cool
 		inline const void* get_shared_data_ptr() const noexcept;
 		inline void delete_queue_buffer() noexcept;
 
+		// inter-process mode : the queue object is constructed at the start of a region of 'shared_region_size(...)' bytes, for instance
+		// memory mapped with shm_open/mmap, 'init_queue_shared_region' then places 'shared_data_size' bytes of zero filled shared data
+		// (see 'get_shared_data_ptr') and the slots after it, the slots are addressed relative to the queue object so that another process
+		// may use the queue through a pointer to the start of its own mapping of the region, at any address
+		// WARNING : the region must be aligned on max(cache_line_size, alignof(item_type)), Ty must be trivially copyable, std::atomic must
+		// be lock free (which makes it address free) and only the process that called 'init_queue_shared_region' may delete the buffer
+
+		static inline std::size_t shared_region_size(cool::item_buffer_size new_item_buffer_size, std::size_t shared_data_size = 0) noexcept;
+		inline cool::queue_init_result init_queue_shared_region(cool::item_buffer_size new_item_buffer_size, std::size_t region_size, std::size_t shared_data_size = 0);
+
 		template <class ... arg_Ty> inline bool try_push(arg_Ty&& ... args) noexcept(std::is_nothrow_constructible<Ty, arg_Ty ...>::value);
 		inline bool try_pop(Ty& target) noexcept;
 		template <class ... arg_Ty> inline void push(arg_Ty&& ... args)  noexcept(std::is_nothrow_constructible<Ty, arg_Ty ...>::value);
 		inline bool pop(Ty& target) noexcept; // returns false when the queue and all its items are to be discarded and item obtained should not be used
 
+		// 'try_push_n' / 'try_pop_n' transfer up to 'count' / 'max_count' items from / to the range at 'first' and return the number of items
+		// transferred, the run of free / filled slots from the current position is claimed with a single compare exchange and the items
+		// are then published slot by slot as with 'try_push' / 'try_pop'
+
+		template <class iterator_Ty> inline std::size_t try_push_n(iterator_Ty first, std::size_t count)
+			noexcept(std::is_nothrow_constructible<Ty, typename std::iterator_traits<iterator_Ty>::reference>::value);
+		template <class iterator_Ty> inline std::size_t try_pop_n(iterator_Ty first, std::size_t max_count) noexcept;
+
 		class item_type {
 		public:
 			Ty value;
@@ -348,20 +458,188 @@ namespace cool
 			inline bool is_equal_to(const item_info_type& rhs) const noexcept;
 		};
 
-		inline item_info_type update_info(const item_info_type& info) const noexcept;
+		using _wait_notify = cool::_queue_wait_notify<_wait_Ty>;
 
-		item_type* m_item_buffer_data_ptr = nullptr;
+		inline item_info_type update_info(const item_info_type& info) const noexcept;
+		static inline std::size_t shared_region_item_buffer_offset(std::size_t shared_data_size) noexcept;
+		inline item_type* item_buffer_data_ptr() noexcept;
+		inline void push_notify(std::true_type) noexcept;
+		inline void push_notify(std::false_type) noexcept;
+		inline void pop_notify(std::true_type) noexcept;
+		inline void pop_notify(std::false_type) noexcept;
+
+		std::uintptr_t m_item_buffer_data_offset = 0; // relative to the queue object
 		std::size_t m_item_buffer_size = 0;
 		std::atomic<bool> m_good{ false };
 		void* m_shared_data_ptr = nullptr;
+		std::size_t m_shared_data_offset = 0; // relative to the queue object, in inter-process mode
 		char* m_item_buffer_unaligned_data_ptr = nullptr;
 
 		alignas(_cache_line_size) std::atomic<item_info_type> m_last_item_info{ item_info_type(0, 0) };
 
 		alignas(_cache_line_size) std::atomic<item_info_type> m_next_item_info{ item_info_type(0, 1) };
 	};
+
+	// queue_spsc_bytes
+
+	// byte oriented single producer single consumer ring, each message is stored as a length prefixed record that
+	// holds 'byte_count' contiguous bytes aligned on 'record_align', a record that does not fit before the end of the
+	// buffer is preceded by a padding record and written at the start of the buffer
+
+	template <std::size_t _cache_line_size> class alignas(_cache_line_size) queue_spsc_bytes
+	{
+
+	public:
+
+		// 64 (bytes) is the most common value for _cache_line_size
+
+		static_assert((_cache_line_size & (_cache_line_size - 1)) == 0,
+			"cool::queue_spsc_bytes<cache_line_size> requirement : cache_line_size must be a power of 2");
+
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		static constexpr std::size_t cache_line_size = alignof(cool::queue_spsc_bytes<_cache_line_size>);
+		static constexpr std::size_t record_align = alignof(std::size_t);
+
+		queue_spsc_bytes() noexcept = default;
+		queue_spsc_bytes(const cool::queue_spsc_bytes<_cache_line_size>&) = delete;
+		cool::queue_spsc_bytes<_cache_line_size>& operator=(const cool::queue_spsc_bytes<_cache_line_size>&) = delete;
+		queue_spsc_bytes(cool::queue_spsc_bytes<_cache_line_size>&&) = delete;
+		cool::queue_spsc_bytes<_cache_line_size>& operator=(cool::queue_spsc_bytes<_cache_line_size>&&) = delete;
+		~queue_spsc_bytes();
+
+		// 'new_byte_buffer_size' is the number of bytes available for records, each record takes 'record_size(byte_count)' bytes
+		// WARNING : in 'init_queue_buffer', array at 'data_ptr' must be aligned on 'record_align' and have space for
+		// new_byte_buffer_size.value() + 'record_align' bytes
+		inline cool::queue_init_result init_queue_buffer(void* data_ptr, cool::item_buffer_size new_byte_buffer_size);
+		inline cool::queue_init_result init_queue_new_buffer(cool::item_buffer_size new_byte_buffer_size);
+		inline bool good() const noexcept;
+		inline std::size_t size() const noexcept;
+		inline std::size_t max_byte_count() const noexcept; // messages up to this size are always accepted once the queue is empty
+		inline bool owns_buffer() const noexcept;
+		inline void delete_queue_buffer() noexcept;
+
+		static inline constexpr std::size_t record_size(std::size_t byte_count) noexcept;
+
+		inline bool try_push(const void* data_ptr, std::size_t byte_count) noexcept;
+
+		// in place access to the records : 'begin_push' reserves space for a message of up to 'max_byte_count' bytes and returns
+		// a pointer to it or nullptr if the queue is full, the message is written in place and published with 'commit_push' with
+		// its actual size, 'begin_pop' returns the next message and sets 'byte_count' to its size or returns nullptr if the queue is
+		// empty, the message is read in place and its space given back with 'release_pop'
+		// WARNING : 'commit_push' / 'release_pop' must only be called once after a non null 'begin_push' / 'begin_pop',
+		// and 'byte_count' in 'commit_push' must not exceed 'max_byte_count' in the 'begin_push' call
+
+		inline void* begin_push(std::size_t max_byte_count) noexcept;
+		inline void commit_push(std::size_t byte_count) noexcept;
+		inline const void* begin_pop(std::size_t& byte_count) noexcept;
+		inline void release_pop() noexcept;
+
+	private:
+
+		static constexpr std::size_t padding_record = static_cast<std::size_t>(-1);
+
+		inline std::size_t free_byte_count(std::size_t last_item_offset, std::size_t next_item_offset) const noexcept;
+
+		char* m_byte_buffer_data_ptr = nullptr;
+		std::size_t m_byte_buffer_size = 0;
+		std::atomic<bool> m_good{ false };
+		char* m_byte_buffer_unaligned_data_ptr = nullptr;
+
+		alignas(_cache_line_size) std::atomic<std::size_t> m_last_item_offset{ 0 };
+		std::size_t m_next_item_cached_offset = 0;
+		std::size_t m_push_record_offset = 0;
+
+		alignas(_cache_line_size) std::atomic<std::size_t> m_next_item_offset{ 0 };
+		std::size_t m_last_item_cached_offset = 0;
+		std::size_t m_pop_record_offset = 0;
+	};
+
 #endif // COOL_QUEUES_ATOMIC
 
+#if defined(COOL_QUEUES_FUTEX) || (defined(COOL_QUEUES_ATOMIC) && defined(__cpp_lib_atomic_wait))
+
+	// _wait_parking
+
+	// common part of wait_atomic and wait_futex, which only differ by the '_park_Ty::park' / '_park_Ty::unpark' primitive :
+	// a waiting thread retries 'spin_count' times and then parks, 'push_notify' / 'pop_notify' only unpark threads when some
+	// thread is parked so that a push or pop that finds none makes no system call, 'shared_data::stop()' makes 'good()'
+	// return false and unparks all the threads, the shared data is ready to use once zero filled
+
+	template <class _park_Ty> class _wait_parking {
+	public:
+
+		class shared_data {
+		public:
+			shared_data() noexcept = default;
+			shared_data(const typename cool::_wait_parking<_park_Ty>::shared_data&) = delete;
+			typename cool::_wait_parking<_park_Ty>::shared_data& operator=(const typename cool::_wait_parking<_park_Ty>::shared_data&) = delete;
+			shared_data(typename cool::_wait_parking<_park_Ty>::shared_data&&) = delete;
+			typename cool::_wait_parking<_park_Ty>::shared_data& operator=(typename cool::_wait_parking<_park_Ty>::shared_data&&) = delete;
+			~shared_data() = default;
+
+			inline void stop() noexcept;
+
+		private:
+			std::atomic<std::uint32_t> m_push_sequence{ 0 };
+			std::atomic<std::uint32_t> m_push_parked_count{ 0 };
+			std::atomic<std::uint32_t> m_pop_sequence{ 0 };
+			std::atomic<std::uint32_t> m_pop_parked_count{ 0 };
+			std::atomic<std::uint32_t> m_stopped{ 0 };
+
+			friend class cool::_wait_parking<_park_Ty>;
+		};
+
+		static constexpr unsigned int spin_count = 64;
+
+		explicit inline _wait_parking(void* shared_data_ptr) noexcept;
+		_wait_parking(const cool::_wait_parking<_park_Ty>&) = delete;
+		cool::_wait_parking<_park_Ty>& operator=(const cool::_wait_parking<_park_Ty>&) = delete;
+		_wait_parking(cool::_wait_parking<_park_Ty>&&) = delete;
+		cool::_wait_parking<_park_Ty>& operator=(cool::_wait_parking<_park_Ty>&&) = delete;
+		inline ~_wait_parking();
+
+		inline void push_wait() noexcept;
+		inline void pop_wait() noexcept;
+		inline bool good() noexcept;
+		static inline void push_notify(void* shared_data_ptr) noexcept;
+		static inline void pop_notify(void* shared_data_ptr) noexcept;
+
+	private:
+
+		static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+			"cool::_wait_parking requirement : std::atomic<std::uint32_t> must have the size of a futex");
+
+		inline void wait(std::atomic<std::uint32_t>& sequence, std::atomic<std::uint32_t>& parked_count) noexcept;
+		static inline void notify(std::atomic<std::uint32_t>& sequence, std::atomic<std::uint32_t>& parked_count) noexcept;
+
+		typename cool::_wait_parking<_park_Ty>::shared_data* m_shared_data_ptr;
+		std::atomic<std::uint32_t>* m_parked_count_ptr = nullptr;
+		std::uint32_t m_sequence_value = 0;
+		unsigned int m_spin_count = 0;
+	};
+#endif // defined(COOL_QUEUES_FUTEX) || (defined(COOL_QUEUES_ATOMIC) && defined(__cpp_lib_atomic_wait))
+
+#if defined(COOL_QUEUES_ATOMIC) && (defined(__cpp_lib_atomic_wait) || defined(COOL_QUEUES_FUTEX))
+
+	// wait_atomic
+
+	// 'shared_data_ptr' must point to a cool::wait_atomic::shared_data, a waiting thread parks with std::atomic::wait (C++20)
+	// or else with a process private futex (COOL_QUEUES_FUTEX), see '_wait_parking'
+
+	class _park_atomic {
+	public:
+		static inline void park(std::atomic<std::uint32_t>& sequence, std::uint32_t sequence_value) noexcept;
+		static inline void unpark(std::atomic<std::uint32_t>& sequence) noexcept;
+	};
+
+	class wait_atomic : public cool::_wait_parking<cool::_park_atomic> {
+	public:
+		explicit inline wait_atomic(void* shared_data_ptr) noexcept;
+	};
+#endif // defined(COOL_QUEUES_ATOMIC) && (defined(__cpp_lib_atomic_wait) || defined(COOL_QUEUES_FUTEX))
+
 #ifdef COOL_QUEUES_THREAD
 
 	// wait_yield
@@ -436,6 +714,26 @@ namespace cool
 		std::mutex m_mutex;
 	};
 #endif // COOL_QUEUES_THREAD
+
+#ifdef COOL_QUEUES_FUTEX
+
+	// wait_futex
+
+	// Linux only : 'shared_data_ptr' must point to a cool::wait_futex::shared_data, a waiting thread sleeps on a futex that is not
+	// process private so that the shared data can be placed in memory shared between processes, for instance as the shared data
+	// of a queue in inter-process mode, see '_wait_parking'
+
+	class _park_futex {
+	public:
+		static inline void park(std::atomic<std::uint32_t>& sequence, std::uint32_t sequence_value) noexcept;
+		static inline void unpark(std::atomic<std::uint32_t>& sequence) noexcept;
+	};
+
+	class wait_futex : public cool::_wait_parking<cool::_park_futex> {
+	public:
+		explicit inline wait_futex(void* shared_data_ptr) noexcept;
+	};
+#endif // COOL_QUEUES_FUTEX
 }
 
 
@@ -650,7 +948,7 @@ inline cool::queue_init_result cool::queue_spsc<Ty, _cache_line_size, _wait_Ty,
 		delete_queue_buffer();
 	}
 
-	if (!(m_last_item_atomic_offset.is_lock_free() && m_next_item_atomic_offset.is_lock_free()))
+	if (!(m_last_item_offset.is_lock_free() && m_next_item_offset.is_lock_free()))
 	{
 		return cool::queue_init_result(cool::queue_init_result::not_lockfree);
 	}
@@ -661,9 +959,10 @@ inline cool::queue_init_result cool::queue_spsc<Ty, _cache_line_size, _wait_Ty,
 		return cool::queue_init_result(cool::queue_init_result::bad_parameters);
 	}
 
-	m_item_buffer_data_ptr = data_ptr;
+	m_item_buffer_data_offset = reinterpret_cast<std::uintptr_t>(data_ptr) - reinterpret_cast<std::uintptr_t>(this);
 	m_item_buffer_size = new_item_buffer_size.value() + 1;
 	m_shared_data_ptr = shared_data_ptr;
+	m_shared_data_offset = 0;
 	m_item_buffer_unaligned_data_ptr = nullptr;
 
 	m_last_item_offset.store(0, std::memory_order_relaxed);
@@ -713,11 +1012,13 @@ inline cool::queue_init_result cool::queue_spsc<Ty, _cache_line_size, _wait_Ty,
 	{
 		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_item_buffer_unaligned_data_ptr) % static_cast<std::uintptr_t>(item_buffer_padding);
 
-		m_item_buffer_data_ptr = reinterpret_cast<Ty*>(m_item_buffer_unaligned_data_ptr
-			+ static_cast<std::size_t>(ptr_remainder != 0) * (item_buffer_padding - static_cast<std::size_t>(ptr_remainder)));
+		m_item_buffer_data_offset = reinterpret_cast<std::uintptr_t>(m_item_buffer_unaligned_data_ptr
+			+ static_cast<std::size_t>(ptr_remainder != 0) * (item_buffer_padding - static_cast<std::size_t>(ptr_remainder)))
+			- reinterpret_cast<std::uintptr_t>(this);
 	}
 
 	m_shared_data_ptr = shared_data_ptr;
+	m_shared_data_offset = 0;
 	m_item_buffer_size = static_cast<_uintX_t>(new_item_buffer_size_p1);
 	m_last_item_offset.store(0, std::memory_order_relaxed);
 	m_last_item_cached_offset = 0;
@@ -726,7 +1027,7 @@ inline cool::queue_init_result cool::queue_spsc<Ty, _cache_line_size, _wait_Ty,
 
 	for (std::size_t k = 0; k < new_item_buffer_size_p1; k++)
 	{
-		new (m_item_buffer_data_ptr + k) Ty();
+		new (item_buffer_data_ptr() + k) Ty();
 	}
 
 	m_good.store(true, std::memory_order_seq_cst);
@@ -742,7 +1043,7 @@ inline bool cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::good() c
 template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
 inline std::size_t cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::size() const noexcept
 {
-	if (m_item_buffer_data_ptr != nullptr)
+	if (m_item_buffer_size != 0)
 	{
 		return static_cast<std::size_t>(m_item_buffer_size) - 1;
 	}
@@ -759,10 +1060,16 @@ inline bool cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::owns_buf
 }
 
 template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline void* cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::get_shared_data_ptr() noexcept { return m_shared_data_ptr; }
+inline void* cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::get_shared_data_ptr() noexcept
+{
+	return (m_shared_data_offset == 0) ? m_shared_data_ptr : static_cast<void*>(reinterpret_cast<char*>(this) + m_shared_data_offset);
+}
 
 template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline const void* cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::get_shared_data_ptr() const noexcept { return m_shared_data_ptr; }
+inline const void* cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::get_shared_data_ptr() const noexcept
+{
+	return (m_shared_data_offset == 0) ? m_shared_data_ptr : static_cast<const void*>(reinterpret_cast<const char*>(this) + m_shared_data_offset);
+}
 
 template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
 inline void cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::delete_queue_buffer() noexcept
@@ -774,15 +1081,16 @@ inline void cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::delete_q
 		std::size_t item_buffer_size_p1 = static_cast<std::size_t>(m_item_buffer_size);
 		for (std::size_t k = 0; k < item_buffer_size_p1; k++)
 		{
-			(m_item_buffer_data_ptr + k)->~Ty();
+			(item_buffer_data_ptr() + k)->~Ty();
 		}
 
 		::operator delete(m_item_buffer_unaligned_data_ptr);
 	}
 
-	m_item_buffer_data_ptr = nullptr;
+	m_item_buffer_data_offset = 0;
 	m_item_buffer_size = 0;
 	m_shared_data_ptr = nullptr;
+	m_shared_data_offset = 0;
 	m_item_buffer_unaligned_data_ptr = nullptr;
 
 	m_last_item_offset.store(0, std::memory_order_relaxed);
@@ -792,6 +1100,69 @@ inline void cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::delete_q
 	m_next_item_cached_offset = 0;
 }
 
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline std::size_t cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::shared_region_size(cool::item_buffer_size new_item_buffer_size, std::size_t shared_data_size) noexcept
+{
+	return shared_region_item_buffer_offset(shared_data_size) + (new_item_buffer_size.value() + 1) * sizeof(Ty);
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline cool::queue_init_result cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::init_queue_shared_region(cool::item_buffer_size new_item_buffer_size, std::size_t region_size, std::size_t shared_data_size)
+{
+	static_assert(std::is_trivially_copyable<Ty>::value,
+		"cool::queue_spsc<value_type, ...> requirement : value_type must be trivially copyable to be used in inter-process mode");
+
+	constexpr std::size_t item_buffer_padding = (cache_line_size > alignof(Ty)) ? cache_line_size : alignof(Ty);
+
+	assert((reinterpret_cast<std::uintptr_t>(this) % item_buffer_padding == 0) && "cool::queue_spsc<...> : object location must be aligned in memory");
+
+	if (reinterpret_cast<std::uintptr_t>(this) % item_buffer_padding != 0)
+	{
+		return cool::queue_init_result(cool::queue_init_result::bad_align);
+	}
+	else
+	{
+		delete_queue_buffer();
+	}
+
+	if (!(m_last_item_offset.is_lock_free() && m_next_item_offset.is_lock_free() && m_good.is_lock_free()))
+	{
+		return cool::queue_init_result(cool::queue_init_result::not_lockfree);
+	}
+
+	if ((new_item_buffer_size.value() == 0)
+		|| (static_cast<std::uintmax_t>(new_item_buffer_size.value()) > static_cast<std::uintmax_t>(std::numeric_limits<_uintX_t>::max() - 1))
+		|| (shared_data_size > region_size) || (new_item_buffer_size.value() > (region_size - shared_data_size) / sizeof(Ty))
+		|| (shared_region_size(new_item_buffer_size, shared_data_size) > region_size))
+	{
+		return cool::queue_init_result(cool::queue_init_result::bad_parameters);
+	}
+
+	std::size_t item_buffer_offset = shared_region_item_buffer_offset(shared_data_size);
+	std::size_t new_item_buffer_size_p1 = new_item_buffer_size.value() + 1;
+	std::memset(reinterpret_cast<char*>(this) + sizeof(cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>), 0,
+		item_buffer_offset - sizeof(cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>));
+
+	m_item_buffer_data_offset = static_cast<std::uintptr_t>(item_buffer_offset);
+	m_item_buffer_size = static_cast<_uintX_t>(new_item_buffer_size_p1);
+	m_shared_data_ptr = nullptr;
+	m_shared_data_offset = (shared_data_size != 0) ? sizeof(cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>) : 0;
+	m_item_buffer_unaligned_data_ptr = nullptr;
+
+	m_last_item_offset.store(0, std::memory_order_relaxed);
+	m_last_item_cached_offset = 0;
+	m_next_item_offset.store(0, std::memory_order_relaxed);
+	m_next_item_cached_offset = 0;
+
+	for (std::size_t k = 0; k < new_item_buffer_size_p1; k++)
+	{
+		new (item_buffer_data_ptr() + k) Ty();
+	}
+
+	m_good.store(true, std::memory_order_seq_cst);
+	return cool::queue_init_result(cool::queue_init_result::success);
+}
+
 template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t> template <class ... arg_Ty>
 inline bool cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::try_push(arg_Ty&& ... args) noexcept(std::is_nothrow_constructible<Ty, arg_Ty ...>::value)
 {
@@ -807,10 +1178,11 @@ inline bool cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::try_push
 		}
 	}
 
-	Ty* last_item_ptr = m_item_buffer_data_ptr + static_cast<std::size_t>(last_item_offset);
+	Ty* last_item_ptr = item_buffer_data_ptr() + static_cast<std::size_t>(last_item_offset);
 	last_item_ptr->~Ty();
 	new (last_item_ptr) Ty(std::forward<arg_Ty>(args)...);
 	m_last_item_offset.store(last_item_offset_p1, std::memory_order_release);
+	push_notify(_wait_notify());
 	return true;
 }
 
@@ -828,9 +1200,10 @@ inline bool cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::try_pop(
 		}
 	}
 
-	target = std::move(*(m_item_buffer_data_ptr + static_cast<std::size_t>(next_item_offset)));
+	target = std::move(*(item_buffer_data_ptr() + static_cast<std::size_t>(next_item_offset)));
 	_uintX_t next_item_offset_p1 = (next_item_offset + 1 != m_item_buffer_size) ? next_item_offset + 1 : 0;
 	m_next_item_offset.store(next_item_offset_p1, std::memory_order_release);
+	pop_notify(_wait_notify());
 	return true;
 }
 
@@ -855,7 +1228,7 @@ inline void cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::push(arg
 
 			if (last_item_offset_p1 == m_next_item_cached_offset)
 			{
-				_wait_Ty wait_obj(m_shared_data_ptr);
+				_wait_Ty wait_obj(get_shared_data_ptr());
 
 				do
 				{
@@ -866,10 +1239,11 @@ inline void cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::push(arg
 		}
 	}
 
-	Ty* last_item_ptr = m_item_buffer_data_ptr + static_cast<std::size_t>(last_item_offset);
+	Ty* last_item_ptr = item_buffer_data_ptr() + static_cast<std::size_t>(last_item_offset);
 	last_item_ptr->~Ty();
 	new (last_item_ptr) Ty(std::forward<arg_Ty>(args)...);
 	m_last_item_offset.store(last_item_offset_p1, std::memory_order_release);
+	push_notify(_wait_notify());
 }
 
 template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
@@ -892,7 +1266,7 @@ inline bool cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::pop(Ty&
 
 			if (next_item_offset == m_last_item_cached_offset)
 			{
-				_wait_Ty wait_obj(m_shared_data_ptr);
+				_wait_Ty wait_obj(get_shared_data_ptr());
 
 				do
 				{
@@ -907,316 +1281,1166 @@ inline bool cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::pop(Ty&
 		}
 	}
 
-	target = std::move(*(m_item_buffer_data_ptr + static_cast<std::size_t>(next_item_offset)));
+	target = std::move(*(item_buffer_data_ptr() + static_cast<std::size_t>(next_item_offset)));
 	_uintX_t next_item_offset_p1 = (next_item_offset + 1 != m_item_buffer_size) ? next_item_offset + 1 : 0;
 	m_next_item_offset.store(next_item_offset_p1, std::memory_order_release);
+	pop_notify(_wait_notify());
 	return true;
 }
 
-template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::queue_mpmc::~queue_mpmc()
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t> template <class iterator_Ty>
+inline std::size_t cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::try_push_n(iterator_Ty first, std::size_t count)
+	noexcept(std::is_nothrow_constructible<Ty, typename std::iterator_traits<iterator_Ty>::reference>::value)
 {
-	delete_queue_buffer();
-}
+	std::size_t item_buffer_size = static_cast<std::size_t>(m_item_buffer_size);
+	std::size_t last_item_offset = static_cast<std::size_t>(m_last_item_offset.load(std::memory_order_relaxed));
+	std::size_t next_item_offset = static_cast<std::size_t>(m_next_item_cached_offset);
 
-template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline cool::queue_init_result cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::init_queue_buffer(item_type* data_ptr, cool::item_buffer_size new_item_buffer_size, void* shared_data_ptr)
-{
-	assert((reinterpret_cast<std::uintptr_t>(this) % cache_line_size == 0) && "cool::queue_mpmc<...> : object location must be aligned in memory");
-	assert(data_ptr != nullptr);
+	// one slot is always left empty so that a full buffer can be told from an empty one
 
-	if (reinterpret_cast<std::uintptr_t>(this) % cache_line_size != 0)
-	{
-		return cool::queue_init_result(cool::queue_init_result::bad_align);
-	}
-	else
-	{
-		delete_queue_buffer();
-	}
+	std::size_t free_count = (next_item_offset > last_item_offset) ?
+		next_item_offset - last_item_offset - 1 : next_item_offset + item_buffer_size - last_item_offset - 1;
 
-	if (!(m_last_item_info.is_lock_free() && m_next_item_info.is_lock_free()))
+	if (free_count < count)
 	{
-		return cool::queue_init_result(cool::queue_init_result::not_lockfree);
-	}
+		m_next_item_cached_offset = m_next_item_offset.load(std::memory_order_acquire);
+		next_item_offset = static_cast<std::size_t>(m_next_item_cached_offset);
 
-	if ((data_ptr == nullptr) || (new_item_buffer_size.value() == 0)
-		|| (static_cast<std::uintmax_t>(new_item_buffer_size.value()) > static_cast<std::uintmax_t>(std::numeric_limits<_uintX_t>::max() - 1)))
-	{
-		return cool::queue_init_result(cool::queue_init_result::bad_parameters);
+		free_count = (next_item_offset > last_item_offset) ?
+			next_item_offset - last_item_offset - 1 : next_item_offset + item_buffer_size - last_item_offset - 1;
 	}
 
-	m_item_buffer_data_ptr = data_ptr;
-	m_item_buffer_size = new_item_buffer_size.value() + 1;
-	m_shared_data_ptr = shared_data_ptr;
-	m_item_buffer_unaligned_data_ptr = nullptr;
-
-	m_last_item_info.store(item_info_type(0, 0), std::memory_order_relaxed);
-	m_next_item_info.store(item_info_type(0, 1), std::memory_order_relaxed);
+	std::size_t push_count = (count < free_count) ? count : free_count;
 
-	for (std::size_t k = 0; k < m_item_buffer_size; k++)
+	if (push_count == 0)
 	{
-		(m_item_buffer_data_ptr + k)->value = Ty();
-		(m_item_buffer_data_ptr + k)->round_number.store(0, std::memory_order_relaxed);
+		return 0;
 	}
 
-	m_good.store(true, std::memory_order_seq_cst);
-	return cool::queue_init_result(cool::queue_init_result::success);
-}
-
-template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline cool::queue_init_result cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::init_queue_new_buffer(cool::item_buffer_size new_item_buffer_size, void* shared_data_ptr)
-{
-	assert((reinterpret_cast<std::uintptr_t>(this) % cache_line_size == 0) && "cool::queue_mpmc<...> : object location must be aligned in memory");
+	std::size_t end_count = item_buffer_size - last_item_offset;
 
-	if (reinterpret_cast<std::uintptr_t>(this) % cache_line_size != 0)
+	if (push_count < end_count)
 	{
-		return cool::queue_init_result(cool::queue_init_result::bad_align);
+		construct_n(item_buffer_data_ptr() + last_item_offset, push_count, first, _bulk_copy<iterator_Ty>());
+		m_last_item_offset.store(static_cast<_uintX_t>(last_item_offset + push_count), std::memory_order_release);
 	}
 	else
 	{
-		delete_queue_buffer();
+		first = construct_n(item_buffer_data_ptr() + last_item_offset, end_count, first, _bulk_copy<iterator_Ty>());
+		construct_n(item_buffer_data_ptr(), push_count - end_count, first, _bulk_copy<iterator_Ty>());
+		m_last_item_offset.store(static_cast<_uintX_t>(push_count - end_count), std::memory_order_release);
 	}
 
-	if (!(m_last_item_info.is_lock_free() && m_next_item_info.is_lock_free()))
+	push_notify(_wait_notify());
+	return push_count;
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t> template <class iterator_Ty>
+inline std::size_t cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::try_pop_n(iterator_Ty first, std::size_t max_count) noexcept
+{
+	std::size_t item_buffer_size = static_cast<std::size_t>(m_item_buffer_size);
+	std::size_t next_item_offset = static_cast<std::size_t>(m_next_item_offset.load(std::memory_order_relaxed));
+	std::size_t last_item_offset = static_cast<std::size_t>(m_last_item_cached_offset);
+
+	std::size_t item_count = (last_item_offset >= next_item_offset) ?
+		last_item_offset - next_item_offset : last_item_offset + item_buffer_size - next_item_offset;
+
+	if (item_count < max_count)
 	{
-		return cool::queue_init_result(cool::queue_init_result::not_lockfree);
+		m_last_item_cached_offset = m_last_item_offset.load(std::memory_order_acquire);
+		last_item_offset = static_cast<std::size_t>(m_last_item_cached_offset);
+
+		item_count = (last_item_offset >= next_item_offset) ?
+			last_item_offset - next_item_offset : last_item_offset + item_buffer_size - next_item_offset;
 	}
 
-	if ((new_item_buffer_size.value() == 0)
-		|| (static_cast<std::uintmax_t>(new_item_buffer_size.value()) > static_cast<std::uintmax_t>(std::numeric_limits<_uintX_t>::max() - 1)))
+	std::size_t pop_count = (max_count < item_count) ? max_count : item_count;
+
+	if (pop_count == 0)
 	{
-		return cool::queue_init_result(cool::queue_init_result::bad_parameters);
+		return 0;
 	}
 
-	constexpr std::size_t item_buffer_padding = (cache_line_size > alignof(item_type)) ? cache_line_size : alignof(item_type);
-	m_item_buffer_unaligned_data_ptr = static_cast<char*>(::operator new((new_item_buffer_size.value() + 1) * sizeof(item_type) + item_buffer_padding + cache_line_size, std::nothrow));
+	std::size_t end_count = item_buffer_size - next_item_offset;
 
-	if (m_item_buffer_unaligned_data_ptr == nullptr)
+	if (pop_count < end_count)
 	{
-		std::atomic_signal_fence(std::memory_order_release);
-		return cool::queue_init_result(cool::queue_init_result::bad_alloc);
+		move_n(item_buffer_data_ptr() + next_item_offset, pop_count, first, _bulk_copy<iterator_Ty>());
+		m_next_item_offset.store(static_cast<_uintX_t>(next_item_offset + pop_count), std::memory_order_release);
 	}
 	else
 	{
-		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_item_buffer_unaligned_data_ptr) % static_cast<std::uintptr_t>(item_buffer_padding);
-
-		m_item_buffer_data_ptr = reinterpret_cast<item_type*>(m_item_buffer_unaligned_data_ptr
-			+ static_cast<std::size_t>(ptr_remainder != 0) * (item_buffer_padding - static_cast<std::size_t>(ptr_remainder)));
+		first = move_n(item_buffer_data_ptr() + next_item_offset, end_count, first, _bulk_copy<iterator_Ty>());
+		move_n(item_buffer_data_ptr(), pop_count - end_count, first, _bulk_copy<iterator_Ty>());
+		m_next_item_offset.store(static_cast<_uintX_t>(pop_count - end_count), std::memory_order_release);
 	}
 
-	m_item_buffer_size = new_item_buffer_size.value() + 1;
-	m_shared_data_ptr = shared_data_ptr;
+	pop_notify(_wait_notify());
+	return pop_count;
+}
 
-	m_last_item_info.store(item_info_type(0, 0), std::memory_order_relaxed);
-	m_next_item_info.store(item_info_type(0, 1), std::memory_order_relaxed);
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline Ty* cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::begin_push() noexcept
+{
+	_uintX_t last_item_offset = m_last_item_offset.load(std::memory_order_relaxed);
+	_uintX_t last_item_offset_p1 = (last_item_offset + 1 != m_item_buffer_size) ? last_item_offset + 1 : 0;
 
-	for (std::size_t k = 0; k < m_item_buffer_size; k++)
+	if (last_item_offset_p1 == m_next_item_cached_offset)
 	{
-		new (m_item_buffer_data_ptr + k) item_type();
+		m_next_item_cached_offset = m_next_item_offset.load(std::memory_order_acquire);
+		if (last_item_offset_p1 == m_next_item_cached_offset)
+		{
+			return nullptr;
+		}
 	}
 
-	m_good.store(true, std::memory_order_seq_cst);
-	return cool::queue_init_result(cool::queue_init_result::success);
+	return item_buffer_data_ptr() + static_cast<std::size_t>(last_item_offset);
 }
 
 template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline bool cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::good() const noexcept { return m_good.load(std::memory_order_seq_cst); }
+inline void cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::commit_push() noexcept
+{
+	_uintX_t last_item_offset = m_last_item_offset.load(std::memory_order_relaxed);
+	_uintX_t last_item_offset_p1 = (last_item_offset + 1 != m_item_buffer_size) ? last_item_offset + 1 : 0;
+	m_last_item_offset.store(last_item_offset_p1, std::memory_order_release);
+	push_notify(_wait_notify());
+}
 
 template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline std::size_t cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::size() const noexcept
+inline const Ty* cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::begin_pop() noexcept
 {
-	if (m_item_buffer_data_ptr != nullptr)
+	_uintX_t next_item_offset = m_next_item_offset.load(std::memory_order_relaxed);
+
+	if (next_item_offset == m_last_item_cached_offset)
 	{
-		return m_item_buffer_size - 1;
-	}
-	else
+		m_last_item_cached_offset = m_last_item_offset.load(std::memory_order_acquire);
+		if (next_item_offset == m_last_item_cached_offset)
+		{
+			return nullptr;
+		}
+	}
+
+	return item_buffer_data_ptr() + static_cast<std::size_t>(next_item_offset);
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline void cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::release_pop() noexcept
+{
+	_uintX_t next_item_offset = m_next_item_offset.load(std::memory_order_relaxed);
+	_uintX_t next_item_offset_p1 = (next_item_offset + 1 != m_item_buffer_size) ? next_item_offset + 1 : 0;
+	m_next_item_offset.store(next_item_offset_p1, std::memory_order_release);
+	pop_notify(_wait_notify());
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline std::size_t cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::shared_region_item_buffer_offset(std::size_t shared_data_size) noexcept
+{
+	constexpr std::size_t item_buffer_padding = (cache_line_size > alignof(Ty)) ? cache_line_size : alignof(Ty);
+	std::size_t item_buffer_offset = sizeof(cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>) + shared_data_size;
+
+	return item_buffer_offset + (item_buffer_padding - item_buffer_offset % item_buffer_padding) % item_buffer_padding;
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline Ty* cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::item_buffer_data_ptr() noexcept
+{
+	return reinterpret_cast<Ty*>(reinterpret_cast<std::uintptr_t>(this) + m_item_buffer_data_offset);
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline void cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::push_notify(std::true_type) noexcept
+{
+	_wait_Ty::push_notify(get_shared_data_ptr());
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline void cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::push_notify(std::false_type) noexcept {}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline void cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::pop_notify(std::true_type) noexcept
+{
+	_wait_Ty::pop_notify(get_shared_data_ptr());
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline void cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::pop_notify(std::false_type) noexcept {}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t> template <class iterator_Ty>
+inline iterator_Ty cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::construct_n(Ty* slot_ptr, std::size_t count, iterator_Ty first, std::false_type)
+	noexcept(std::is_nothrow_constructible<Ty, typename std::iterator_traits<iterator_Ty>::reference>::value)
+{
+	for (std::size_t k = 0; k < count; k++)
+	{
+		(slot_ptr + k)->~Ty();
+		new (slot_ptr + k) Ty(*first);
+		++first;
+	}
+
+	return first;
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t> template <class iterator_Ty>
+inline iterator_Ty cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::construct_n(Ty* slot_ptr, std::size_t count, iterator_Ty first, std::true_type) noexcept
+{
+	std::memcpy(static_cast<void*>(slot_ptr), static_cast<const void*>(first), count * sizeof(Ty));
+	return first + count;
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t> template <class iterator_Ty>
+inline iterator_Ty cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::move_n(Ty* slot_ptr, std::size_t count, iterator_Ty first, std::false_type) noexcept
+{
+	for (std::size_t k = 0; k < count; k++)
+	{
+		*first = std::move(*(slot_ptr + k));
+		++first;
+	}
+
+	return first;
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t> template <class iterator_Ty>
+inline iterator_Ty cool::queue_spsc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::move_n(Ty* slot_ptr, std::size_t count, iterator_Ty first, std::true_type) noexcept
+{
+	std::memcpy(static_cast<void*>(first), static_cast<const void*>(slot_ptr), count * sizeof(Ty));
+	return first + count;
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::queue_mpmc::~queue_mpmc()
+{
+	delete_queue_buffer();
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline cool::queue_init_result cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::init_queue_buffer(item_type* data_ptr, cool::item_buffer_size new_item_buffer_size, void* shared_data_ptr)
+{
+	assert((reinterpret_cast<std::uintptr_t>(this) % cache_line_size == 0) && "cool::queue_mpmc<...> : object location must be aligned in memory");
+	assert(data_ptr != nullptr);
+
+	if (reinterpret_cast<std::uintptr_t>(this) % cache_line_size != 0)
+	{
+		return cool::queue_init_result(cool::queue_init_result::bad_align);
+	}
+	else
+	{
+		delete_queue_buffer();
+	}
+
+	if (!(m_last_item_info.is_lock_free() && m_next_item_info.is_lock_free()))
+	{
+		return cool::queue_init_result(cool::queue_init_result::not_lockfree);
+	}
+
+	if ((data_ptr == nullptr) || (new_item_buffer_size.value() == 0)
+		|| (static_cast<std::uintmax_t>(new_item_buffer_size.value()) > static_cast<std::uintmax_t>(std::numeric_limits<_uintX_t>::max() - 1)))
+	{
+		return cool::queue_init_result(cool::queue_init_result::bad_parameters);
+	}
+
+	m_item_buffer_data_offset = reinterpret_cast<std::uintptr_t>(data_ptr) - reinterpret_cast<std::uintptr_t>(this);
+	m_item_buffer_size = new_item_buffer_size.value() + 1;
+	m_shared_data_ptr = shared_data_ptr;
+	m_shared_data_offset = 0;
+	m_item_buffer_unaligned_data_ptr = nullptr;
+
+	m_last_item_info.store(item_info_type(0, 0), std::memory_order_relaxed);
+	m_next_item_info.store(item_info_type(0, 1), std::memory_order_relaxed);
+
+	for (std::size_t k = 0; k < m_item_buffer_size; k++)
+	{
+		(item_buffer_data_ptr() + k)->value = Ty();
+		(item_buffer_data_ptr() + k)->round_number.store(0, std::memory_order_relaxed);
+	}
+
+	m_good.store(true, std::memory_order_seq_cst);
+	return cool::queue_init_result(cool::queue_init_result::success);
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline cool::queue_init_result cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::init_queue_new_buffer(cool::item_buffer_size new_item_buffer_size, void* shared_data_ptr)
+{
+	assert((reinterpret_cast<std::uintptr_t>(this) % cache_line_size == 0) && "cool::queue_mpmc<...> : object location must be aligned in memory");
+
+	if (reinterpret_cast<std::uintptr_t>(this) % cache_line_size != 0)
+	{
+		return cool::queue_init_result(cool::queue_init_result::bad_align);
+	}
+	else
+	{
+		delete_queue_buffer();
+	}
+
+	if (!(m_last_item_info.is_lock_free() && m_next_item_info.is_lock_free()))
+	{
+		return cool::queue_init_result(cool::queue_init_result::not_lockfree);
+	}
+
+	if ((new_item_buffer_size.value() == 0)
+		|| (static_cast<std::uintmax_t>(new_item_buffer_size.value()) > static_cast<std::uintmax_t>(std::numeric_limits<_uintX_t>::max() - 1)))
+	{
+		return cool::queue_init_result(cool::queue_init_result::bad_parameters);
+	}
+
+	constexpr std::size_t item_buffer_padding = (cache_line_size > alignof(item_type)) ? cache_line_size : alignof(item_type);
+	m_item_buffer_unaligned_data_ptr = static_cast<char*>(::operator new((new_item_buffer_size.value() + 1) * sizeof(item_type) + item_buffer_padding + cache_line_size, std::nothrow));
+
+	if (m_item_buffer_unaligned_data_ptr == nullptr)
+	{
+		std::atomic_signal_fence(std::memory_order_release);
+		return cool::queue_init_result(cool::queue_init_result::bad_alloc);
+	}
+	else
+	{
+		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_item_buffer_unaligned_data_ptr) % static_cast<std::uintptr_t>(item_buffer_padding);
+
+		m_item_buffer_data_offset = reinterpret_cast<std::uintptr_t>(m_item_buffer_unaligned_data_ptr
+			+ static_cast<std::size_t>(ptr_remainder != 0) * (item_buffer_padding - static_cast<std::size_t>(ptr_remainder)))
+			- reinterpret_cast<std::uintptr_t>(this);
+	}
+
+	m_item_buffer_size = new_item_buffer_size.value() + 1;
+	m_shared_data_ptr = shared_data_ptr;
+	m_shared_data_offset = 0;
+
+	m_last_item_info.store(item_info_type(0, 0), std::memory_order_relaxed);
+	m_next_item_info.store(item_info_type(0, 1), std::memory_order_relaxed);
+
+	for (std::size_t k = 0; k < m_item_buffer_size; k++)
+	{
+		new (item_buffer_data_ptr() + k) item_type();
+	}
+
+	m_good.store(true, std::memory_order_seq_cst);
+	return cool::queue_init_result(cool::queue_init_result::success);
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline bool cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::good() const noexcept { return m_good.load(std::memory_order_seq_cst); }
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline std::size_t cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::size() const noexcept
+{
+	if (m_item_buffer_size != 0)
+	{
+		return m_item_buffer_size - 1;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline bool cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::owns_buffer() const noexcept { return m_item_buffer_unaligned_data_ptr != nullptr; }
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline void* cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::get_shared_data_ptr() noexcept
+{
+	return (m_shared_data_offset == 0) ? m_shared_data_ptr : static_cast<void*>(reinterpret_cast<char*>(this) + m_shared_data_offset);
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline const void* cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::get_shared_data_ptr() const noexcept
+{
+	return (m_shared_data_offset == 0) ? m_shared_data_ptr : static_cast<const void*>(reinterpret_cast<const char*>(this) + m_shared_data_offset);
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline void cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::delete_queue_buffer() noexcept
+{
+	m_good.store(false, std::memory_order_seq_cst);
+
+	if (m_item_buffer_unaligned_data_ptr != nullptr)
+	{
+		for (std::size_t k = 0; k < m_item_buffer_size; k++)
+		{
+			(item_buffer_data_ptr() + k)->~item_type();
+		}
+
+		::operator delete(m_item_buffer_unaligned_data_ptr);
+	}
+
+	m_item_buffer_data_offset = 0;
+	m_item_buffer_size = 0;
+	m_shared_data_ptr = nullptr;
+	m_shared_data_offset = 0;
+	m_item_buffer_unaligned_data_ptr = nullptr;
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline std::size_t cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::shared_region_size(cool::item_buffer_size new_item_buffer_size, std::size_t shared_data_size) noexcept
+{
+	return shared_region_item_buffer_offset(shared_data_size) + (new_item_buffer_size.value() + 1) * sizeof(item_type);
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline cool::queue_init_result cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::init_queue_shared_region(cool::item_buffer_size new_item_buffer_size, std::size_t region_size, std::size_t shared_data_size)
+{
+	static_assert(std::is_trivially_copyable<Ty>::value,
+		"cool::queue_mpmc<value_type, ...> requirement : value_type must be trivially copyable to be used in inter-process mode");
+
+	constexpr std::size_t item_buffer_padding = (cache_line_size > alignof(item_type)) ? cache_line_size : alignof(item_type);
+
+	assert((reinterpret_cast<std::uintptr_t>(this) % item_buffer_padding == 0) && "cool::queue_mpmc<...> : object location must be aligned in memory");
+
+	if (reinterpret_cast<std::uintptr_t>(this) % item_buffer_padding != 0)
+	{
+		return cool::queue_init_result(cool::queue_init_result::bad_align);
+	}
+	else
+	{
+		delete_queue_buffer();
+	}
+
+	if (!(m_last_item_info.is_lock_free() && m_next_item_info.is_lock_free() && m_good.is_lock_free()))
+	{
+		return cool::queue_init_result(cool::queue_init_result::not_lockfree);
+	}
+
+	if ((new_item_buffer_size.value() == 0)
+		|| (static_cast<std::uintmax_t>(new_item_buffer_size.value()) > static_cast<std::uintmax_t>(std::numeric_limits<_uintX_t>::max() - 1))
+		|| (shared_data_size > region_size) || (new_item_buffer_size.value() > (region_size - shared_data_size) / sizeof(item_type))
+		|| (shared_region_size(new_item_buffer_size, shared_data_size) > region_size))
+	{
+		return cool::queue_init_result(cool::queue_init_result::bad_parameters);
+	}
+
+	std::size_t item_buffer_offset = shared_region_item_buffer_offset(shared_data_size);
+	std::size_t new_item_buffer_size_p1 = new_item_buffer_size.value() + 1;
+	std::memset(reinterpret_cast<char*>(this) + sizeof(cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>), 0,
+		item_buffer_offset - sizeof(cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>));
+
+	m_item_buffer_data_offset = static_cast<std::uintptr_t>(item_buffer_offset);
+	m_item_buffer_size = new_item_buffer_size_p1;
+	m_shared_data_ptr = nullptr;
+	m_shared_data_offset = (shared_data_size != 0) ? sizeof(cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>) : 0;
+	m_item_buffer_unaligned_data_ptr = nullptr;
+
+	m_last_item_info.store(item_info_type(0, 0), std::memory_order_relaxed);
+	m_next_item_info.store(item_info_type(0, 1), std::memory_order_relaxed);
+
+	for (std::size_t k = 0; k < new_item_buffer_size_p1; k++)
+	{
+		new (item_buffer_data_ptr() + k) item_type();
+	}
+
+	m_good.store(true, std::memory_order_seq_cst);
+	return cool::queue_init_result(cool::queue_init_result::success);
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t> template <class ... arg_Ty>
+inline bool cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::try_push(arg_Ty&& ... args) noexcept(std::is_nothrow_constructible<Ty, arg_Ty ...>::value)
+{
+	item_info_type last_item_info = m_last_item_info.load(std::memory_order_acquire);
+
+	while (true)
+	{
+		item_type& item_ref = *(item_buffer_data_ptr() + static_cast<std::size_t>(last_item_info.item_number));
+
+		if (last_item_info.round_number == item_ref.round_number.load(std::memory_order_acquire))
+		{
+			if (m_last_item_info.compare_exchange_strong(last_item_info, update_info(last_item_info)))
+			{
+				item_ref.value.~Ty();
+				new (&item_ref.value) Ty(std::forward<arg_Ty>(args)...);
+				item_ref.round_number.store(last_item_info.round_number + 1, std::memory_order_release);
+				push_notify(_wait_notify());
+
+				return true;
+			}
+		}
+		else
+		{
+			item_info_type previous_last_item_info = last_item_info;
+			last_item_info = m_last_item_info.load(std::memory_order_acquire);
+
+			if (last_item_info.is_equal_to(previous_last_item_info))
+			{
+				return false;
+			}
+		}
+	}
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline bool cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::try_pop(Ty& target) noexcept
+{
+	item_info_type next_item_info = m_next_item_info.load(std::memory_order_acquire);
+
+	while (true)
+	{
+		item_type& item_ref = *(item_buffer_data_ptr() + static_cast<std::size_t>(next_item_info.item_number));
+
+		if (next_item_info.round_number == item_ref.round_number.load(std::memory_order_acquire))
+		{
+			if (m_next_item_info.compare_exchange_strong(next_item_info, update_info(next_item_info)))
+			{
+				target = std::move(item_ref.value);
+				item_ref.round_number.store(next_item_info.round_number + 1, std::memory_order_release);
+				pop_notify(_wait_notify());
+
+				return true;
+			}
+		}
+		else
+		{
+			item_info_type previous_next_item_info = next_item_info;
+			next_item_info = m_next_item_info.load(std::memory_order_acquire);
+
+			if (next_item_info.is_equal_to(previous_next_item_info))
+			{
+				return false;
+			}
+		}
+	}
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t> template <class ... arg_Ty>
+inline void cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::push(arg_Ty&& ... args) noexcept(std::is_nothrow_constructible<Ty, arg_Ty ...>::value)
+{
+	item_info_type last_item_info = m_last_item_info.load(std::memory_order_acquire);
+	while (!m_last_item_info.compare_exchange_weak(last_item_info, update_info(last_item_info))) {}
+
+	item_type& item_ref = *(item_buffer_data_ptr() + static_cast<std::size_t>(last_item_info.item_number));
+
+	if (std::is_same<_wait_Ty, cool::wait_noop>::value)
+	{
+		while (last_item_info.round_number != item_ref.round_number.load(std::memory_order_acquire)) {}
+	}
+	else
+	{
+		if (last_item_info.round_number != item_ref.round_number.load(std::memory_order_acquire))
+		{
+			_wait_Ty wait_obj(get_shared_data_ptr());
+
+			do
+			{
+				wait_obj.push_wait();
+			} while (last_item_info.round_number != item_ref.round_number.load(std::memory_order_acquire));
+		}
+	}
+
+	item_ref.value.~Ty();
+	new (&item_ref.value) Ty(std::forward<arg_Ty>(args)...);
+	item_ref.round_number.store(last_item_info.round_number + 1, std::memory_order_release);
+	push_notify(_wait_notify());
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline bool cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::pop(Ty& target) noexcept
+{
+	item_info_type next_item_info = m_next_item_info.load(std::memory_order_acquire);
+	while (!m_next_item_info.compare_exchange_weak(next_item_info, update_info(next_item_info))) {}
+
+	item_type& item_ref = *(item_buffer_data_ptr() + static_cast<std::size_t>(next_item_info.item_number));
+
+	if (std::is_same<_wait_Ty, cool::wait_noop>::value)
+	{
+		while (next_item_info.round_number != item_ref.round_number.load(std::memory_order_acquire)) {}
+	}
+	else
+	{
+		if (next_item_info.round_number != item_ref.round_number.load(std::memory_order_acquire))
+		{
+			_wait_Ty wait_obj(get_shared_data_ptr());
+
+			do
+			{
+				if (!wait_obj.good())
+				{
+					return false;
+				}
+				wait_obj.pop_wait();
+			} while (next_item_info.round_number != item_ref.round_number.load(std::memory_order_acquire));
+		}
+	}
+
+	target = std::move(item_ref.value);
+	item_ref.round_number.store(next_item_info.round_number + 1, std::memory_order_release);
+	pop_notify(_wait_notify());
+	return true;
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t> template <class iterator_Ty>
+inline std::size_t cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::try_push_n(iterator_Ty first, std::size_t count)
+	noexcept(std::is_nothrow_constructible<Ty, typename std::iterator_traits<iterator_Ty>::reference>::value)
+{
+	std::size_t max_count = (count < m_item_buffer_size) ? count : m_item_buffer_size;
+	item_info_type last_item_info = m_last_item_info.load(std::memory_order_acquire);
+
+	while (max_count != 0)
+	{
+		// the run of free slots from the current position is claimed at once, a slot seen free stays free until claimed
+
+		item_info_type item_info = last_item_info;
+		std::size_t push_count = 0;
+
+		while ((push_count < max_count)
+			&& (item_info.round_number == (item_buffer_data_ptr() + static_cast<std::size_t>(item_info.item_number))->round_number.load(std::memory_order_acquire)))
+		{
+			item_info = update_info(item_info);
+			push_count++;
+		}
+
+		if (push_count != 0)
+		{
+			if (m_last_item_info.compare_exchange_strong(last_item_info, item_info))
+			{
+				item_info = last_item_info;
+
+				for (std::size_t k = 0; k < push_count; k++)
+				{
+					item_type& item_ref = *(item_buffer_data_ptr() + static_cast<std::size_t>(item_info.item_number));
+
+					item_ref.value.~Ty();
+					new (&item_ref.value) Ty(*first);
+					++first;
+					item_ref.round_number.store(item_info.round_number + 1, std::memory_order_release);
+
+					item_info = update_info(item_info);
+				}
+				push_notify(_wait_notify());
+
+				return push_count;
+			}
+		}
+		else
+		{
+			item_info_type previous_last_item_info = last_item_info;
+			last_item_info = m_last_item_info.load(std::memory_order_acquire);
+
+			if (last_item_info.is_equal_to(previous_last_item_info))
+			{
+				return 0;
+			}
+		}
+	}
+
+	return 0;
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t> template <class iterator_Ty>
+inline std::size_t cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::try_pop_n(iterator_Ty first, std::size_t max_count) noexcept
+{
+	max_count = (max_count < m_item_buffer_size) ? max_count : m_item_buffer_size;
+	item_info_type next_item_info = m_next_item_info.load(std::memory_order_acquire);
+
+	while (max_count != 0)
+	{
+		// the run of filled slots from the current position is claimed at once, a slot seen filled stays filled until claimed
+
+		item_info_type item_info = next_item_info;
+		std::size_t pop_count = 0;
+
+		while ((pop_count < max_count)
+			&& (item_info.round_number == (item_buffer_data_ptr() + static_cast<std::size_t>(item_info.item_number))->round_number.load(std::memory_order_acquire)))
+		{
+			item_info = update_info(item_info);
+			pop_count++;
+		}
+
+		if (pop_count != 0)
+		{
+			if (m_next_item_info.compare_exchange_strong(next_item_info, item_info))
+			{
+				item_info = next_item_info;
+
+				for (std::size_t k = 0; k < pop_count; k++)
+				{
+					item_type& item_ref = *(item_buffer_data_ptr() + static_cast<std::size_t>(item_info.item_number));
+
+					*first = std::move(item_ref.value);
+					++first;
+					item_ref.round_number.store(item_info.round_number + 1, std::memory_order_release);
+
+					item_info = update_info(item_info);
+				}
+				pop_notify(_wait_notify());
+
+				return pop_count;
+			}
+		}
+		else
+		{
+			item_info_type previous_next_item_info = next_item_info;
+			next_item_info = m_next_item_info.load(std::memory_order_acquire);
+
+			if (next_item_info.is_equal_to(previous_next_item_info))
+			{
+				return 0;
+			}
+		}
+	}
+
+	return 0;
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::item_info_type::item_info_type(uintX_type _item_number, uintX_type _round_number) noexcept
+	: item_number(_item_number), round_number(_round_number) {}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline bool cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::item_info_type::is_equal_to(const item_info_type& rhs) const noexcept
+{
+	return std::memcmp(this, &rhs, sizeof(item_info_type)) == 0;
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline typename cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::item_info_type cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::update_info(const item_info_type& info) const noexcept
+{
+	if (info.item_number + 1 != m_item_buffer_size)
+	{
+		return item_info_type(info.item_number + 1, info.round_number);
+	}
+	else
+	{
+		return item_info_type(0, info.round_number + 2);
+	}
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline std::size_t cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::shared_region_item_buffer_offset(std::size_t shared_data_size) noexcept
+{
+	constexpr std::size_t item_buffer_padding = (cache_line_size > alignof(item_type)) ? cache_line_size : alignof(item_type);
+	std::size_t item_buffer_offset = sizeof(cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>) + shared_data_size;
+
+	return item_buffer_offset + (item_buffer_padding - item_buffer_offset % item_buffer_padding) % item_buffer_padding;
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline typename cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::item_type* cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::item_buffer_data_ptr() noexcept
+{
+	return reinterpret_cast<item_type*>(reinterpret_cast<std::uintptr_t>(this) + m_item_buffer_data_offset);
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline void cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::push_notify(std::true_type) noexcept
+{
+	_wait_Ty::push_notify(get_shared_data_ptr());
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline void cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::push_notify(std::false_type) noexcept {}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline void cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::pop_notify(std::true_type) noexcept
+{
+	_wait_Ty::pop_notify(get_shared_data_ptr());
+}
+
+template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
+inline void cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::pop_notify(std::false_type) noexcept {}
+template <std::size_t _cache_line_size>
+cool::queue_spsc_bytes<_cache_line_size>::queue_spsc_bytes::~queue_spsc_bytes()
+{
+	delete_queue_buffer();
+}
+
+template <std::size_t _cache_line_size>
+inline cool::queue_init_result cool::queue_spsc_bytes<_cache_line_size>::init_queue_buffer(void* data_ptr, cool::item_buffer_size new_byte_buffer_size)
+{
+	assert((reinterpret_cast<std::uintptr_t>(this) % cache_line_size == 0) && "cool::queue_spsc_bytes<...> : object location must be aligned in memory");
+	assert(data_ptr != nullptr);
+	assert((reinterpret_cast<std::uintptr_t>(data_ptr) % record_align == 0) && "cool::queue_spsc_bytes<...> : buffer location must be aligned in memory");
+
+	if ((reinterpret_cast<std::uintptr_t>(this) % cache_line_size != 0) || (reinterpret_cast<std::uintptr_t>(data_ptr) % record_align != 0))
+	{
+		return cool::queue_init_result(cool::queue_init_result::bad_align);
+	}
+	else
+	{
+		delete_queue_buffer();
+	}
+
+	if (!(m_last_item_offset.is_lock_free() && m_next_item_offset.is_lock_free()))
+	{
+		return cool::queue_init_result(cool::queue_init_result::not_lockfree);
+	}
+
+	std::size_t new_byte_buffer_size_rounded = new_byte_buffer_size.value() - new_byte_buffer_size.value() % record_align;
+
+	if ((data_ptr == nullptr) || (new_byte_buffer_size_rounded < record_size(0))
+		|| (new_byte_buffer_size_rounded > std::numeric_limits<std::size_t>::max() / 2 - record_align))
+	{
+		return cool::queue_init_result(cool::queue_init_result::bad_parameters);
+	}
+
+	m_byte_buffer_data_ptr = static_cast<char*>(data_ptr);
+	m_byte_buffer_size = new_byte_buffer_size_rounded + record_align;
+	m_byte_buffer_unaligned_data_ptr = nullptr;
+
+	m_last_item_offset.store(0, std::memory_order_relaxed);
+	m_last_item_cached_offset = 0;
+	m_push_record_offset = 0;
+	m_next_item_offset.store(0, std::memory_order_relaxed);
+	m_next_item_cached_offset = 0;
+	m_pop_record_offset = 0;
+
+	m_good.store(true, std::memory_order_seq_cst);
+	return cool::queue_init_result(cool::queue_init_result::success);
+}
+
+template <std::size_t _cache_line_size>
+inline cool::queue_init_result cool::queue_spsc_bytes<_cache_line_size>::init_queue_new_buffer(cool::item_buffer_size new_byte_buffer_size)
+{
+	assert((reinterpret_cast<std::uintptr_t>(this) % cache_line_size == 0) && "cool::queue_spsc_bytes<...> : object location must be aligned in memory");
+
+	if (reinterpret_cast<std::uintptr_t>(this) % cache_line_size != 0)
 	{
-		return 0;
+		return cool::queue_init_result(cool::queue_init_result::bad_align);
+	}
+	else
+	{
+		delete_queue_buffer();
 	}
-}
 
-template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline bool cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::owns_buffer() const noexcept { return m_item_buffer_unaligned_data_ptr != nullptr; }
+	if (!(m_last_item_offset.is_lock_free() && m_next_item_offset.is_lock_free()))
+	{
+		return cool::queue_init_result(cool::queue_init_result::not_lockfree);
+	}
 
-template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline void* cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::get_shared_data_ptr() noexcept { return m_shared_data_ptr; }
+	if ((new_byte_buffer_size.value() == 0)
+		|| (new_byte_buffer_size.value() > std::numeric_limits<std::size_t>::max() / 2 - 2 * record_align))
+	{
+		return cool::queue_init_result(cool::queue_init_result::bad_parameters);
+	}
 
-template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline const void* cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::get_shared_data_ptr() const noexcept { return m_shared_data_ptr; }
+	std::size_t new_byte_buffer_size_rounded = record_size(new_byte_buffer_size.value()) - record_size(0);
+	new_byte_buffer_size_rounded = (new_byte_buffer_size_rounded < record_size(0)) ? record_size(0) : new_byte_buffer_size_rounded;
+	std::size_t new_byte_buffer_size_p1 = new_byte_buffer_size_rounded + record_align;
+	m_byte_buffer_unaligned_data_ptr = static_cast<char*>(::operator new(new_byte_buffer_size_p1 + cache_line_size, std::nothrow));
 
-template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline void cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::delete_queue_buffer() noexcept
+	if (m_byte_buffer_unaligned_data_ptr == nullptr)
+	{
+		std::atomic_signal_fence(std::memory_order_release);
+		return cool::queue_init_result(cool::queue_init_result::bad_alloc);
+	}
+	else
+	{
+		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_byte_buffer_unaligned_data_ptr) % static_cast<std::uintptr_t>(cache_line_size);
+
+		m_byte_buffer_data_ptr = m_byte_buffer_unaligned_data_ptr
+			+ static_cast<std::size_t>(ptr_remainder != 0) * (cache_line_size - static_cast<std::size_t>(ptr_remainder));
+	}
+
+	m_byte_buffer_size = new_byte_buffer_size_p1;
+	m_last_item_offset.store(0, std::memory_order_relaxed);
+	m_last_item_cached_offset = 0;
+	m_push_record_offset = 0;
+	m_next_item_offset.store(0, std::memory_order_relaxed);
+	m_next_item_cached_offset = 0;
+	m_pop_record_offset = 0;
+
+	m_good.store(true, std::memory_order_seq_cst);
+	return cool::queue_init_result(cool::queue_init_result::success);
+}
+
+template <std::size_t _cache_line_size>
+inline bool cool::queue_spsc_bytes<_cache_line_size>::good() const noexcept
 {
-	m_good.store(false, std::memory_order_seq_cst);
+	return m_good.load(std::memory_order_seq_cst);
+}
 
-	if (m_item_buffer_unaligned_data_ptr != nullptr)
+template <std::size_t _cache_line_size>
+inline std::size_t cool::queue_spsc_bytes<_cache_line_size>::size() const noexcept
+{
+	if (m_byte_buffer_data_ptr != nullptr)
 	{
-		for (std::size_t k = 0; k < m_item_buffer_size; k++)
-		{
-			(m_item_buffer_data_ptr + k)->~item_type();
-		}
+		return m_byte_buffer_size - record_align;
+	}
+	else
+	{
+		return 0;
+	}
+}
 
-		::operator delete(m_item_buffer_unaligned_data_ptr);
+template <std::size_t _cache_line_size>
+inline std::size_t cool::queue_spsc_bytes<_cache_line_size>::max_byte_count() const noexcept
+{
+	// with an empty queue, a record of up to half the buffer fits either before the end of the buffer or at its start
+
+	std::size_t half_size = (size() / 2) - (size() / 2) % record_align;
+
+	if (half_size > record_size(0))
+	{
+		return half_size - record_size(0);
+	}
+	else
+	{
+		return 0;
 	}
+}
 
-	m_item_buffer_data_ptr = nullptr;
-	m_item_buffer_size = 0;
-	m_shared_data_ptr = nullptr;
-	m_item_buffer_unaligned_data_ptr = nullptr;
+template <std::size_t _cache_line_size>
+inline bool cool::queue_spsc_bytes<_cache_line_size>::owns_buffer() const noexcept
+{
+	return m_byte_buffer_unaligned_data_ptr != nullptr;
 }
 
-template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t> template <class ... arg_Ty>
-inline bool cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::try_push(arg_Ty&& ... args) noexcept(std::is_nothrow_constructible<Ty, arg_Ty ...>::value)
+template <std::size_t _cache_line_size>
+inline void cool::queue_spsc_bytes<_cache_line_size>::delete_queue_buffer() noexcept
 {
-	item_info_type last_item_info = m_last_item_info.load(std::memory_order_acquire);
+	m_good.store(false, std::memory_order_seq_cst);
 
-	while (true)
+	if (m_byte_buffer_unaligned_data_ptr != nullptr)
 	{
-		item_type& item_ref = *(m_item_buffer_data_ptr + static_cast<std::size_t>(last_item_info.item_number));
+		::operator delete(m_byte_buffer_unaligned_data_ptr);
+	}
 
-		if (last_item_info.round_number == item_ref.round_number.load(std::memory_order_acquire))
-		{
-			if (m_last_item_info.compare_exchange_strong(last_item_info, update_info(last_item_info)))
-			{
-				item_ref.value.~Ty();
-				new (&item_ref.value) Ty(std::forward<arg_Ty>(args)...);
-				item_ref.round_number.store(last_item_info.round_number + 1, std::memory_order_release);
+	m_byte_buffer_data_ptr = nullptr;
+	m_byte_buffer_size = 0;
+	m_byte_buffer_unaligned_data_ptr = nullptr;
 
-				return true;
-			}
-		}
-		else
-		{
-			item_info_type previous_last_item_info = last_item_info;
-			last_item_info = m_last_item_info.load(std::memory_order_acquire);
+	m_last_item_offset.store(0, std::memory_order_relaxed);
+	m_last_item_cached_offset = 0;
+	m_push_record_offset = 0;
 
-			if (last_item_info.is_equal_to(previous_last_item_info))
-			{
-				return false;
-			}
+	m_next_item_offset.store(0, std::memory_order_relaxed);
+	m_next_item_cached_offset = 0;
+	m_pop_record_offset = 0;
+}
+
+template <std::size_t _cache_line_size>
+inline constexpr std::size_t cool::queue_spsc_bytes<_cache_line_size>::record_size(std::size_t byte_count) noexcept
+{
+	return sizeof(std::size_t) + byte_count + (record_align - 1) - (sizeof(std::size_t) + byte_count + (record_align - 1)) % record_align;
+}
+
+template <std::size_t _cache_line_size>
+inline bool cool::queue_spsc_bytes<_cache_line_size>::try_push(const void* data_ptr, std::size_t byte_count) noexcept
+{
+	void* record_data_ptr = begin_push(byte_count);
+
+	if (record_data_ptr != nullptr)
+	{
+		if (byte_count != 0)
+		{
+			std::memcpy(record_data_ptr, data_ptr, byte_count);
 		}
+		commit_push(byte_count);
+		return true;
+	}
+	else
+	{
+		return false;
 	}
 }
 
-template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline bool cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::try_pop(Ty& target) noexcept
+template <std::size_t _cache_line_size>
+inline void* cool::queue_spsc_bytes<_cache_line_size>::begin_push(std::size_t max_byte_count) noexcept
 {
-	item_info_type next_item_info = m_next_item_info.load(std::memory_order_acquire);
-
-	while (true)
+	if (max_byte_count > m_byte_buffer_size)
 	{
-		item_type& item_ref = *(m_item_buffer_data_ptr + static_cast<std::size_t>(next_item_info.item_number));
+		return nullptr;
+	}
 
-		if (next_item_info.round_number == item_ref.round_number.load(std::memory_order_acquire))
-		{
-			if (m_next_item_info.compare_exchange_strong(next_item_info, update_info(next_item_info)))
-			{
-				target = std::move(item_ref.value);
-				item_ref.round_number.store(next_item_info.round_number + 1, std::memory_order_release);
+	std::size_t last_item_offset = m_last_item_offset.load(std::memory_order_relaxed);
+	std::size_t new_record_size = record_size(max_byte_count);
+	std::size_t contiguous_byte_count = m_byte_buffer_size - last_item_offset;
+	std::size_t required_byte_count = (new_record_size <= contiguous_byte_count) ? new_record_size : contiguous_byte_count + new_record_size;
 
-				return true;
-			}
-		}
-		else
+	if (free_byte_count(last_item_offset, m_next_item_cached_offset) < required_byte_count)
+	{
+		m_next_item_cached_offset = m_next_item_offset.load(std::memory_order_acquire);
+		if (free_byte_count(last_item_offset, m_next_item_cached_offset) < required_byte_count)
 		{
-			item_info_type previous_next_item_info = next_item_info;
-			next_item_info = m_next_item_info.load(std::memory_order_acquire);
-
-			if (next_item_info.is_equal_to(previous_next_item_info))
-			{
-				return false;
-			}
+			return nullptr;
 		}
 	}
+
+	m_push_record_offset = (new_record_size <= contiguous_byte_count) ? last_item_offset : 0;
+
+	return m_byte_buffer_data_ptr + m_push_record_offset + sizeof(std::size_t);
 }
 
-template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t> template <class ... arg_Ty>
-inline void cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::push(arg_Ty&& ... args) noexcept(std::is_nothrow_constructible<Ty, arg_Ty ...>::value)
+template <std::size_t _cache_line_size>
+inline void cool::queue_spsc_bytes<_cache_line_size>::commit_push(std::size_t byte_count) noexcept
 {
-	item_info_type last_item_info = m_last_item_info.load(std::memory_order_acquire);
-	while (!m_last_item_info.compare_exchange_weak(last_item_info, update_info(last_item_info))) {}
+	std::size_t last_item_offset = m_last_item_offset.load(std::memory_order_relaxed);
 
-	item_type& item_ref = *(m_item_buffer_data_ptr + static_cast<std::size_t>(last_item_info.item_number));
-
-	if (std::is_same<_wait_Ty, cool::wait_noop>::value)
+	if (m_push_record_offset != last_item_offset)
 	{
-		while (last_item_info.round_number != item_ref.round_number.load(std::memory_order_acquire)) {}
+		*reinterpret_cast<std::size_t*>(m_byte_buffer_data_ptr + last_item_offset) = padding_record;
 	}
-	else
+
+	*reinterpret_cast<std::size_t*>(m_byte_buffer_data_ptr + m_push_record_offset) = byte_count;
+
+	std::size_t new_last_item_offset = m_push_record_offset + record_size(byte_count);
+	m_last_item_offset.store((new_last_item_offset != m_byte_buffer_size) ? new_last_item_offset : 0, std::memory_order_release);
+}
+
+template <std::size_t _cache_line_size>
+inline const void* cool::queue_spsc_bytes<_cache_line_size>::begin_pop(std::size_t& byte_count) noexcept
+{
+	std::size_t next_item_offset = m_next_item_offset.load(std::memory_order_relaxed);
+
+	if (next_item_offset == m_last_item_cached_offset)
 	{
-		if (last_item_info.round_number != item_ref.round_number.load(std::memory_order_acquire))
+		m_last_item_cached_offset = m_last_item_offset.load(std::memory_order_acquire);
+		if (next_item_offset == m_last_item_cached_offset)
 		{
-			_wait_Ty wait_obj(m_shared_data_ptr);
-
-			do
-			{
-				wait_obj.push_wait();
-			} while (last_item_info.round_number != item_ref.round_number.load(std::memory_order_acquire));
+			return nullptr;
 		}
 	}
 
-	item_ref.value.~Ty();
-	new (&item_ref.value) Ty(std::forward<arg_Ty>(args)...);
-	item_ref.round_number.store(last_item_info.round_number + 1, std::memory_order_release);
+	// a padding record is published together with the record that follows it at the start of the buffer
+
+	if (*reinterpret_cast<const std::size_t*>(m_byte_buffer_data_ptr + next_item_offset) == padding_record)
+	{
+		next_item_offset = 0;
+		m_next_item_offset.store(0, std::memory_order_release);
+	}
+
+	m_pop_record_offset = next_item_offset;
+	byte_count = *reinterpret_cast<const std::size_t*>(m_byte_buffer_data_ptr + next_item_offset);
+
+	return m_byte_buffer_data_ptr + next_item_offset + sizeof(std::size_t);
 }
 
-template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline bool cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::pop(Ty& target) noexcept
+template <std::size_t _cache_line_size>
+inline void cool::queue_spsc_bytes<_cache_line_size>::release_pop() noexcept
 {
-	item_info_type next_item_info = m_next_item_info.load(std::memory_order_acquire);
-	while (!m_next_item_info.compare_exchange_weak(next_item_info, update_info(next_item_info))) {}
+	std::size_t new_next_item_offset = m_pop_record_offset
+		+ record_size(*reinterpret_cast<const std::size_t*>(m_byte_buffer_data_ptr + m_pop_record_offset));
+	m_next_item_offset.store((new_next_item_offset != m_byte_buffer_size) ? new_next_item_offset : 0, std::memory_order_release);
+}
 
-	item_type& item_ref = *(m_item_buffer_data_ptr + static_cast<std::size_t>(next_item_info.item_number));
+template <std::size_t _cache_line_size>
+inline std::size_t cool::queue_spsc_bytes<_cache_line_size>::free_byte_count(std::size_t last_item_offset, std::size_t next_item_offset) const noexcept
+{
+	// one 'record_align' gap is kept between the last and the next record so that a full queue differs from an empty one
 
-	if (std::is_same<_wait_Ty, cool::wait_noop>::value)
+	if (next_item_offset > last_item_offset)
 	{
-		while (next_item_info.round_number != item_ref.round_number.load(std::memory_order_acquire)) {}
+		return next_item_offset - last_item_offset - record_align;
 	}
 	else
 	{
-		if (next_item_info.round_number != item_ref.round_number.load(std::memory_order_acquire))
-		{
-			_wait_Ty wait_obj(m_shared_data_ptr);
+		return next_item_offset + m_byte_buffer_size - last_item_offset - record_align;
+	}
+}
 
-			do
-			{
-				if (!wait_obj.good())
-				{
-					return false;
-				}
-				wait_obj.pop_wait();
-			} while (next_item_info.round_number != item_ref.round_number.load(std::memory_order_acquire));
-		}
+#endif // COOL_QUEUES_ATOMIC
+
+#if defined(COOL_QUEUES_FUTEX) || (defined(COOL_QUEUES_ATOMIC) && defined(__cpp_lib_atomic_wait))
+template <class _park_Ty>
+inline void cool::_wait_parking<_park_Ty>::shared_data::stop() noexcept
+{
+	m_stopped.store(1, std::memory_order_seq_cst);
+
+	m_push_sequence.fetch_add(1, std::memory_order_seq_cst);
+	_park_Ty::unpark(m_push_sequence);
+	m_pop_sequence.fetch_add(1, std::memory_order_seq_cst);
+	_park_Ty::unpark(m_pop_sequence);
+}
+
+template <class _park_Ty>
+inline cool::_wait_parking<_park_Ty>::_wait_parking(void* shared_data_ptr) noexcept
+	: m_shared_data_ptr(static_cast<typename cool::_wait_parking<_park_Ty>::shared_data*>(shared_data_ptr))
+{
+	assert((shared_data_ptr != nullptr) && "cool::wait_atomic / cool::wait_futex : shared_data_ptr must point to the shared_data of the wait class");
+}
+
+template <class _park_Ty>
+inline cool::_wait_parking<_park_Ty>::~_wait_parking()
+{
+	if (m_parked_count_ptr != nullptr)
+	{
+		m_parked_count_ptr->fetch_sub(1, std::memory_order_relaxed);
 	}
+}
 
-	target = std::move(item_ref.value);
-	item_ref.round_number.store(next_item_info.round_number + 1, std::memory_order_release);
-	return true;
+template <class _park_Ty>
+inline void cool::_wait_parking<_park_Ty>::push_wait() noexcept
+{
+	wait(m_shared_data_ptr->m_push_sequence, m_shared_data_ptr->m_push_parked_count);
 }
 
-template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::item_info_type::item_info_type(uintX_type _item_number, uintX_type _round_number) noexcept
-	: item_number(_item_number), round_number(_round_number) {}
+template <class _park_Ty>
+inline void cool::_wait_parking<_park_Ty>::pop_wait() noexcept
+{
+	wait(m_shared_data_ptr->m_pop_sequence, m_shared_data_ptr->m_pop_parked_count);
+}
 
-template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline bool cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::item_info_type::is_equal_to(const item_info_type& rhs) const noexcept
+template <class _park_Ty>
+inline bool cool::_wait_parking<_park_Ty>::good() noexcept
 {
-	return std::memcmp(this, &rhs, sizeof(item_info_type)) == 0;
+	return m_shared_data_ptr->m_stopped.load(std::memory_order_acquire) == 0;
 }
 
-template <class Ty, std::size_t _cache_line_size, class _wait_Ty, class _uintX_t>
-inline typename cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::item_info_type cool::queue_mpmc<Ty, _cache_line_size, _wait_Ty, _uintX_t>::update_info(const item_info_type& info) const noexcept
+template <class _park_Ty>
+inline void cool::_wait_parking<_park_Ty>::push_notify(void* shared_data_ptr) noexcept
 {
-	if (info.item_number + 1 != m_item_buffer_size)
+	typename cool::_wait_parking<_park_Ty>::shared_data* ptr = static_cast<typename cool::_wait_parking<_park_Ty>::shared_data*>(shared_data_ptr);
+	notify(ptr->m_pop_sequence, ptr->m_pop_parked_count);
+}
+
+template <class _park_Ty>
+inline void cool::_wait_parking<_park_Ty>::pop_notify(void* shared_data_ptr) noexcept
+{
+	typename cool::_wait_parking<_park_Ty>::shared_data* ptr = static_cast<typename cool::_wait_parking<_park_Ty>::shared_data*>(shared_data_ptr);
+	notify(ptr->m_push_sequence, ptr->m_push_parked_count);
+}
+
+template <class _park_Ty>
+inline void cool::_wait_parking<_park_Ty>::wait(std::atomic<std::uint32_t>& sequence, std::atomic<std::uint32_t>& parked_count) noexcept
+{
+	if (m_spin_count < spin_count)
 	{
-		return item_info_type(info.item_number + 1, info.round_number);
+		m_spin_count++;
 	}
-	else
+	else if (m_parked_count_ptr == nullptr)
 	{
-		return item_info_type(0, info.round_number + 2);
+		// the thread is counted as parked before the caller checks the queue once more, a push or pop that does not see the
+		// count is seen by that check, and one that sees it changes the sequence value read here, so that 'park' returns
+
+		m_parked_count_ptr = &parked_count;
+		parked_count.fetch_add(1, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		m_sequence_value = sequence.load(std::memory_order_acquire);
+	}
+	else if (m_shared_data_ptr->m_stopped.load(std::memory_order_acquire) == 0)
+	{
+		_park_Ty::park(sequence, m_sequence_value);
+		m_sequence_value = sequence.load(std::memory_order_acquire);
 	}
 }
-#endif // COOL_QUEUES_ATOMIC
+
+template <class _park_Ty>
+inline void cool::_wait_parking<_park_Ty>::notify(std::atomic<std::uint32_t>& sequence, std::atomic<std::uint32_t>& parked_count) noexcept
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (parked_count.load(std::memory_order_relaxed) != 0)
+	{
+		sequence.fetch_add(1, std::memory_order_release);
+		_park_Ty::unpark(sequence);
+	}
+}
+#endif // defined(COOL_QUEUES_FUTEX) || (defined(COOL_QUEUES_ATOMIC) && defined(__cpp_lib_atomic_wait))
+
+#if defined(COOL_QUEUES_ATOMIC) && (defined(__cpp_lib_atomic_wait) || defined(COOL_QUEUES_FUTEX))
+inline void cool::_park_atomic::park(std::atomic<std::uint32_t>& sequence, std::uint32_t sequence_value) noexcept
+{
+#ifdef __cpp_lib_atomic_wait
+	sequence.wait(sequence_value, std::memory_order_acquire);
+#else // __cpp_lib_atomic_wait
+	::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&sequence), FUTEX_WAIT_PRIVATE, sequence_value, nullptr, nullptr, 0);
+#endif // __cpp_lib_atomic_wait
+}
+
+inline void cool::_park_atomic::unpark(std::atomic<std::uint32_t>& sequence) noexcept
+{
+#ifdef __cpp_lib_atomic_wait
+	sequence.notify_all();
+#else // __cpp_lib_atomic_wait
+	::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&sequence), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif // __cpp_lib_atomic_wait
+}
+
+inline cool::wait_atomic::wait_atomic(void* shared_data_ptr) noexcept
+	: cool::_wait_parking<cool::_park_atomic>(shared_data_ptr) {}
+#endif // defined(COOL_QUEUES_ATOMIC) && (defined(__cpp_lib_atomic_wait) || defined(COOL_QUEUES_FUTEX))
 
 #ifdef COOL_QUEUES_THREAD
 inline cool::wait_yield::wait_yield(void*) noexcept {}
@@ -1477,6 +2701,21 @@ inline bool cool::queue_wlock<Ty, _cache_line_size, _wait_Ty>::pop(Ty& target)
 }
 #endif // COOL_QUEUES_THREAD
 
+#ifdef COOL_QUEUES_FUTEX
+inline void cool::_park_futex::park(std::atomic<std::uint32_t>& sequence, std::uint32_t sequence_value) noexcept
+{
+	::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&sequence), FUTEX_WAIT, sequence_value, nullptr, nullptr, 0);
+}
+
+inline void cool::_park_futex::unpark(std::atomic<std::uint32_t>& sequence) noexcept
+{
+	::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&sequence), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+inline cool::wait_futex::wait_futex(void* shared_data_ptr) noexcept
+	: cool::_wait_parking<cool::_park_futex>(shared_data_ptr) {}
+#endif // COOL_QUEUES_FUTEX
+
 #endif // xCOOL_QUEUES_HPP
 
 
@@ -15,12 +15,47 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <chrono>
 #include <atomic>
+#include <limits>
 #include <tuple>
 #include <exception>
 #include <system_error>
 #include <cassert>
 
+#include "cool_chrono.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif // defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+
+
+// to disable thread pinning (cool::thread_affinity is then ignored) : #define COOL_THREADS_NO_AFFINITY
+// thread pinning is currently only supported on linux
+
+#ifndef COOL_THREADS_NO_AFFINITY
+#if defined(__linux__)
+#define xCOOL_THREADS_AFFINITY
+#include <cstdio>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif // defined(__linux__)
+#endif // COOL_THREADS_NO_AFFINITY
+
+
+// 'finish' of async_end / async_result sleeps on a futex on linux, with C++20 std::atomic::wait elsewhere if available,
+// and otherwise on a condition variable
+
+#if defined(__linux__)
+#define xCOOL_THREADS_FUTEX
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#elif defined(__cpp_lib_atomic_wait)
+#define xCOOL_THREADS_ATOMIC_WAIT
+#endif // defined(__linux__)
+
 
 // to allow the use of std::thread::native_handle : #define COOL_THREADS_NATIVE_HANDLE
 
@@ -34,6 +69,28 @@
 #endif // COOL_THREADS_NO_EXCEPTIONS
 
 
+// to enable runtime statistics in threads_sq and threads_mq ('stats' / 'reset_stats') : #define COOL_THREADS_STATS
+// to also record a histogram of task execution times : #define COOL_THREADS_STATS_HISTOGRAM
+// to also record the last tasks of every thread for 'write_chrome_trace' : #define COOL_THREADS_TRACE
+// (COOL_THREADS_TRACE_SIZE sets the number of tasks recorded per thread, 1024 by default, must be a power of 2)
+
+#ifndef COOL_THREADS_STATS
+#endif // COOL_THREADS_STATS
+
+
+// C++20 coroutine support ('schedule' / 'resume_after' of threads_sq and threads_mq, co_await on async_end and async_result)
+// is enabled if the compiler provides <coroutine>, to disable it : #define COOL_THREADS_NO_COROUTINES
+
+#ifndef COOL_THREADS_NO_COROUTINES
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define xCOOL_THREADS_COROUTINES
+#include <coroutine>
+#endif // __has_include(<coroutine>)
+#endif // defined(__cpp_impl_coroutine) && defined(__has_include)
+#endif // COOL_THREADS_NO_COROUTINES
+
+
 // to force use of 32 bit counter in threads_mq : #define COOL_THREADS_MQ_32BIT_COUNTER
 
 #ifndef COOL_THREADS_MQ_32BIT_COUNTER
@@ -46,6 +103,14 @@
 #endif // COOL_THREADS_MQ_16BIT_COUNTER
 
 
+// number of slots of the local deque of every thread of threads_mq, which receives the tasks queued with 'async' / 'try_async'
+// by the tasks running on that thread (must be a power of 2, 0 disables the local deques) : #define COOL_THREADS_MQ_LOCAL_QUEUE_SIZE 4
+
+#ifndef COOL_THREADS_MQ_LOCAL_QUEUE_SIZE
+#define COOL_THREADS_MQ_LOCAL_QUEUE_SIZE 4
+#endif // COOL_THREADS_MQ_LOCAL_QUEUE_SIZE
+
+
 #if !defined(xCOOL_THREADS_TRY) && !defined(xCOOL_THREADS_CATCH) && !defined(xCOOL_THREADS_EXCEPTION) && !defined(xCOOL_THREADS_SYSTEM_ERROR)
 #ifndef COOL_THREADS_NO_EXCEPTIONS
 #define xCOOL_THREADS_TRY try
@@ -61,10 +126,30 @@
 #endif // !defined(xCOOL_THREADS_TRY) && !defined(xCOOL_THREADS_CATCH) && !defined(xCOOL_THREADS_EXCEPTION) && !defined(xCOOL_THREADS_SYSTEM_ERROR)
 
 
+#if (defined(COOL_THREADS_STATS_HISTOGRAM) || defined(COOL_THREADS_TRACE)) && !defined(COOL_THREADS_STATS)
+#define COOL_THREADS_STATS
+#endif // (defined(COOL_THREADS_STATS_HISTOGRAM) || defined(COOL_THREADS_TRACE)) && !defined(COOL_THREADS_STATS)
+
+#if defined(COOL_THREADS_TRACE) && !defined(COOL_THREADS_TRACE_SIZE)
+#define COOL_THREADS_TRACE_SIZE 1024
+#endif // defined(COOL_THREADS_TRACE) && !defined(COOL_THREADS_TRACE_SIZE)
+
+#ifndef xCOOL_THREADS_STATS
+#ifdef COOL_THREADS_STATS
+#include <chrono>
+#define xCOOL_THREADS_STATS(...) __VA_ARGS__
+#else // COOL_THREADS_STATS
+#define xCOOL_THREADS_STATS(...)
+#endif // COOL_THREADS_STATS
+#endif // xCOOL_THREADS_STATS
+
+
 namespace cool
 {
 	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> class threads_sq;
 	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> class threads_mq;
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> class threads_ws;
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> class threads_lq;
 	class threads_init_result;
 	class threads_exception_handler;
 
@@ -74,12 +159,25 @@ namespace cool
 #endif // xCOOL_NOT_TARGET_ENUM
 
 	class async_end;
+	class cancel_token;
 	template <class return_Ty> class async_result;
+	template <class threads_Ty, std::size_t _max_predecessor_count> class async_node;
 	class safety_refresh_proxy;
 
 	class _threads_base;
 	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _threads_sq_data;
 	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _threads_mq_data;
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _threads_ws_data;
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _threads_lq_data;
+	class _async_waiter;
+	class _async_completion;
+#ifdef xCOOL_THREADS_COROUTINES
+	template <class threads_Ty> class _schedule_awaiter;
+	template <class target_Ty, class threads_Ty> class _finish_awaiter;
+#endif // xCOOL_THREADS_COROUTINES
+#ifdef COOL_THREADS_STATS
+	class threads_stats;
+#endif // COOL_THREADS_STATS
 	class _async_end_incr_proxy;
 	template <class Ty> class _async_result_to_proxy;
 	template <class Ty> class _async_result_incr_proxy;
@@ -91,6 +189,8 @@ namespace cool
 	class _thread_sq_native_handle;
 	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _thread_mq_id;
 	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _thread_mq_native_handle;
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _thread_ws_id;
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _thread_ws_native_handle;
 
 
 	// init types
@@ -131,6 +231,178 @@ namespace cool
 		std::uint16_t m_value;
 	};
 
+	// 'compact' pins thread i to the i-th cpu available to the process ordered by socket then core, so that consecutive threads share
+	// sockets and cores, 'scatter' pins consecutive threads on different sockets first and on different cores second, 'cpu_list'
+	// pins thread i to 'cpu_list_ptr[i % cpu_list_size]', the list must only remain valid during the call to 'init_new_threads'
+
+	class thread_affinity {
+	public:
+		static constexpr int none = 0;
+		static constexpr int compact = 1;
+		static constexpr int scatter = 2;
+		static constexpr int cpu_list = 3;
+		thread_affinity() = delete;
+		explicit inline constexpr thread_affinity(int new_policy) noexcept;
+		inline constexpr thread_affinity(const unsigned int* new_cpu_list_ptr, std::size_t new_cpu_list_size) noexcept;
+		inline constexpr int policy() const noexcept;
+		inline constexpr const unsigned int* cpu_list_data() const noexcept;
+		inline constexpr std::size_t cpu_list_size() const noexcept;
+	private:
+		int m_policy;
+		const unsigned int* m_cpu_list_ptr;
+		std::size_t m_cpu_list_size;
+	};
+
+	// 'lane_count' priority lanes (at most 'max_lane_count') are added above the regular queue of every thread, threads drain higher
+	// lanes first and, if 'aging_interval' is not 0, a non empty lane that has been passed over 'aging_interval' times is served next
+
+	class priority_lanes {
+	public:
+		static constexpr unsigned int max_lane_count = 8;
+		priority_lanes() = delete;
+		explicit inline constexpr priority_lanes(unsigned int new_lane_count, unsigned int new_aging_interval = 0) noexcept;
+		inline constexpr unsigned int lane_count() const noexcept;
+		inline constexpr unsigned int aging_interval() const noexcept;
+	private:
+		unsigned int m_lane_count;
+		unsigned int m_aging_interval;
+	};
+
+	// with 'min_thread_count' > 0 only 'min_thread_count' threads are started and the thread count given to 'init_new_threads' becomes
+	// the maximum : a thread parked for 'idle_timeout_ms' retires if more than 'min_thread_count' threads remain (0 : never), and a thread
+	// is started when a task is pushed to a queue holding 'grow_queue_depth' tasks or more while no thread is idle (0 : never),
+	// elastic_policy(0) keeps all threads running
+
+	class elastic_policy {
+	public:
+		elastic_policy() = delete;
+		explicit inline constexpr elastic_policy(std::uint16_t new_min_thread_count, unsigned int new_idle_timeout_ms = 0, std::size_t new_grow_queue_depth = 0) noexcept;
+		inline constexpr std::uint16_t min_thread_count() const noexcept;
+		inline constexpr unsigned int idle_timeout_ms() const noexcept;
+		inline constexpr std::size_t grow_queue_depth() const noexcept;
+	private:
+		std::uint16_t m_min_thread_count;
+		unsigned int m_idle_timeout_ms;
+		std::size_t m_grow_queue_depth;
+	};
+
+	// up to 'capacity' tasks given to 'async_at' / 'async_after' can wait for their deadline at once, deadlines are rounded up
+	// to 'resolution_us' microseconds (must be > 0), timer_wheel(0) reserves no timer
+
+	class timer_wheel {
+	public:
+		timer_wheel() = delete;
+		explicit inline constexpr timer_wheel(std::size_t new_capacity, unsigned int new_resolution_us = 1000) noexcept;
+		inline constexpr std::size_t capacity() const noexcept;
+		inline constexpr unsigned int resolution_us() const noexcept;
+	private:
+		std::size_t m_capacity;
+		unsigned int m_resolution_us;
+	};
+
+	// idle threads first check their queue 'spin_count' times with a pause instruction in between, then 'yield_count' times
+	// with a std::this_thread::yield in between, and then park on their condition variable, wait_policy(0, 0) parks right away
+
+	class wait_policy {
+	public:
+		wait_policy() = delete;
+		explicit inline constexpr wait_policy(unsigned int new_spin_count, unsigned int new_yield_count) noexcept;
+		inline constexpr unsigned int spin_count() const noexcept;
+		inline constexpr unsigned int yield_count() const noexcept;
+	private:
+		unsigned int m_spin_count;
+		unsigned int m_yield_count;
+	};
+
+	// number of times idle threads found a task while spinning, found a task while yielding, or had to park
+
+	class wait_stats {
+	public:
+		wait_stats() = delete;
+		explicit inline constexpr wait_stats(std::size_t new_spin_hits, std::size_t new_yield_hits, std::size_t new_parks) noexcept;
+		inline constexpr std::size_t spin_hits() const noexcept;
+		inline constexpr std::size_t yield_hits() const noexcept;
+		inline constexpr std::size_t parks() const noexcept;
+	private:
+		std::size_t m_spin_hits;
+		std::size_t m_yield_hits;
+		std::size_t m_parks;
+	};
+
+	// optional settings of threads_mq 'init_new_threads', every setter returns the object so that calls can be chained
+	// e.g. cool::threads_mq_options().wait_policy(cool::wait_policy(256, 16)).priority_lanes(cool::priority_lanes(2)),
+	// a default constructed object holds the same values as the defaults of the short form of 'init_new_threads'
+
+	class threads_mq_options {
+	public:
+		inline constexpr threads_mq_options() noexcept;
+		inline threads_mq_options& try_pop_count(cool::try_pop_count new_try_pop_count) noexcept;
+		inline threads_mq_options& dispatch_interval(cool::dispatch_interval new_dispatch_interval) noexcept; // 0 : default_dispatch_interval(thread count)
+		inline threads_mq_options& wait_policy(cool::wait_policy new_wait_policy) noexcept;
+		inline threads_mq_options& thread_affinity(cool::thread_affinity new_thread_affinity) noexcept;
+		inline threads_mq_options& priority_lanes(cool::priority_lanes new_priority_lanes) noexcept; // lane count must be <= cool::priority_lanes::max_lane_count
+		inline threads_mq_options& elastic_policy(cool::elastic_policy new_elastic_policy) noexcept; // min thread count must be <= thread count
+		inline threads_mq_options& timer_wheel(cool::timer_wheel new_timer_wheel) noexcept;
+		inline constexpr cool::try_pop_count try_pop_count() const noexcept;
+		inline constexpr cool::dispatch_interval dispatch_interval() const noexcept;
+		inline constexpr cool::wait_policy wait_policy() const noexcept;
+		inline constexpr cool::thread_affinity thread_affinity() const noexcept;
+		inline constexpr cool::priority_lanes priority_lanes() const noexcept;
+		inline constexpr cool::elastic_policy elastic_policy() const noexcept;
+		inline constexpr cool::timer_wheel timer_wheel() const noexcept;
+	private:
+		cool::try_pop_count m_try_pop_count;
+		cool::dispatch_interval m_dispatch_interval;
+		cool::wait_policy m_wait_policy;
+		cool::thread_affinity m_thread_affinity;
+		cool::priority_lanes m_priority_lanes;
+		cool::elastic_policy m_elastic_policy;
+		cool::timer_wheel m_timer_wheel;
+	};
+
+
+#ifdef COOL_THREADS_STATS
+
+	// threads_stats
+
+	// snapshot of the statistics of a threads_sq or threads_mq object, 'probe_hits' / 'probe_misses' are only counted by threads_mq
+	// with 'try_pop_count' > 0, 'task_time_histogram(k)' is the number of tasks that ran for [2^(k-1), 2^k) ns, 0 ns for k = 0 and
+	// more than 2^(histogram_size - 2) ns for k = histogram_size - 1 (only with COOL_THREADS_STATS_HISTOGRAM)
+
+	class threads_stats
+	{
+
+	public:
+
+		static constexpr std::size_t histogram_size = 32;
+
+		threads_stats() = default;
+
+		inline std::size_t tasks_executed() const noexcept;
+		inline std::size_t try_async_failures() const noexcept; // 'try_async' / 'try_priority_async' calls that returned false
+		inline std::size_t full_queue_retries() const noexcept; // attempts to queue a task that found the queue full or locked
+		inline std::size_t probe_hits() const noexcept;
+		inline std::size_t probe_misses() const noexcept;
+		inline std::size_t queue_depth() const noexcept; // number of tasks waiting in queues when 'stats' was called
+		inline std::size_t task_time_histogram(std::size_t bucket) const noexcept;
+
+	private:
+
+		std::size_t m_tasks_executed = 0;
+		std::size_t m_try_async_failures = 0;
+		std::size_t m_full_queue_retries = 0;
+		std::size_t m_probe_hits = 0;
+		std::size_t m_probe_misses = 0;
+		std::size_t m_queue_depth = 0;
+		std::size_t m_task_time_histogram[histogram_size] = {};
+
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_sq;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_mq;
+		friend class cool::_threads_base;
+	};
+
+#endif // COOL_THREADS_STATS
+
 
 	// threads_sq
 
@@ -163,12 +435,23 @@ namespace cool
 			cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&&) = delete;
 		inline ~threads_sq();
 
-		// 'function_Ty task' must be a function pointer
+		// 'function_Ty task' must be a function pointer or a callable object (such as a lambda) movable without throwing exceptions
 		// 'function_Ty task' must pass arguments by copy
 		// 'arg_Ty ... args' must be movable or copyable without throwing exceptions
 
+		// a callable object is moved in the task slot along with the arguments and adds its size to theirs, it is called as an lvalue
+		// and reported with a null function pointer to the exception handler
+
+		// if 'arg_type_static_check' is false, argument packs that do not fit in 'arg_buffer_size' are moved to a slab allocator shared
+		// by the submitting threads (used under the queue lock) and the task slot only holds a pointer, the storage is recycled when the task
+		// completes and freed by 'delete_threads', packs aligned beyond alignof(std::max_align_t) are still rejected, if the storage cannot be
+		// allocated 'try_async' returns false and 'async' retries as it does on a full queue
+
 		// sequentially consistent : task1 being submitted before task2 guarantees that task1 will start executing before task2
 
+		// 'async' / 'priority_async' called from a task running on a thread of the same object runs queued tasks while the queue is full,
+		// so that tasks submitting tasks (with 'finish(threads)' on them) cannot fill the queue and leave every thread waiting for space
+
 		// if 'function_Ty task' throws an std::exception, the thread will call the exception handler and jump to the next task
 		// WARNING : other unrelated types of exceptions will not be caught
 
@@ -234,25 +517,118 @@ namespace cool
 		template <class return_Ty, class function_Ty, class ... arg_Ty>
 		inline bool try_priority_async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
+		// 'async_at' / 'async_after' queue the task once 'deadline' is reached / 'delay' has elapsed, the task waits meanwhile in one
+		// of the timers reserved with 'cool::timer_wheel' in 'init_new_threads' and they return false if none is available
+		// WARNING : the timers are checked by the threads of the object between tasks and while idle, so that a task may be queued late
+		// if all threads are busy with long tasks, the timers still pending when 'delete_threads' is called are queued right away
+
+		template <class clock_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_at(cool::time_point<clock_Ty> deadline, cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept;
+
+		template <class clock_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_at(cool::time_point<clock_Ty> deadline, cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept;
+
+		template <class clock_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_at(cool::time_point<clock_Ty> deadline, cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept;
+
+		template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_at(cool::time_point<clock_Ty> deadline, cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
+
+		template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_at(cool::time_point<clock_Ty> deadline, cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
+
+		template <class clock_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_after(cool::duration<clock_Ty> delay, cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept;
+
+		template <class clock_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_after(cool::duration<clock_Ty> delay, cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept;
+
+		template <class clock_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_after(cool::duration<clock_Ty> delay, cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept;
+
+		template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_after(cool::duration<clock_Ty> delay, cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
+
+		template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_after(cool::duration<clock_Ty> delay, cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
+
+		// 'async_batch' queues the tasks 'task(index, args ...)' for every index in ['first', 'last'), slots are reserved and written
+		// in bulk under as few locks as possible and sleeping threads are woken once per bulk write, 'target' awaits all of them
+		// and should be waited on with 'finish'
+		// 'arg_Ty ... args' are copied in every task, the index type must be integral
+
+		template <class function_Ty, class index_Ty, class ... arg_Ty>
+		inline void async_batch(cool::no_target_t, function_Ty task, index_Ty first, index_Ty last, const arg_Ty& ... args) noexcept;
+
+		template <class function_Ty, class index_Ty, class ... arg_Ty>
+		inline void async_batch(cool::async_end& target, function_Ty task, index_Ty first, index_Ty last, const arg_Ty& ... args) noexcept;
+
+		// 'parallel_for' splits ['first', 'last') in chunks of size 'grain_size' (must be > 0), queues the tasks 'task(chunk_first, chunk_last, args ...)'
+		// for every chunk and returns once they have all been executed, the calling thread runs queued tasks while it waits as with
+		// 'finish(threads)' of async_end, so that 'parallel_for' can be called from a task running on the same threads_sq object
+
+		template <class function_Ty, class index_Ty, class ... arg_Ty>
+		inline void parallel_for(index_Ty first, index_Ty last, index_Ty grain_size, function_Ty task, const arg_Ty& ... args) noexcept;
+
 		// 'arg_type_is_valid<arg_Ty>' returns true if arg_Ty parameter pack type can be called as an argument for 'task' in 'async' / 'priority_async' / 'try_async' / 'try_priority_async'
+		// when 'task' is a function pointer, a callable object 'task' is stored with the arguments and must fit along with them
 
 		template <class ... arg_Ty>
 		static inline constexpr bool arg_type_is_valid() noexcept;
 
+#ifdef xCOOL_THREADS_COROUTINES
+		// 'co_await threads.schedule()' resumes the coroutine on one of the threads, 'co_await threads.resume_after(target)' suspends it
+		// until 'target' has finished and then resumes it on one of the threads, in both cases the coroutine keeps running on the current
+		// thread if all queues are full, 'target' must outlive the suspension
+
+		inline cool::_schedule_awaiter<cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>> schedule() noexcept;
+		inline cool::_finish_awaiter<cool::async_end, cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>> resume_after(cool::async_end& target) noexcept;
+
+		template <class return_Ty>
+		inline cool::_finish_awaiter<cool::async_result<return_Ty>, cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>> resume_after(cool::async_result<return_Ty>& target) noexcept;
+#endif // xCOOL_THREADS_COROUTINES
+
 		// WARNING : 'init_new_threads' and 'delete_threads' must not be called in concurrency with any other method
 		// except 'safety_refresh' or the case of 'init_new_thread' with 'good'
 
-		inline cool::threads_init_result init_new_threads(cool::thread_count new_thread_count, cool::task_buffer_size new_task_buffer_size) noexcept; // arguments must be > 0
+		inline cool::threads_init_result init_new_threads(
+			cool::thread_count new_thread_count, // must be > 0
+			cool::task_buffer_size new_task_buffer_size, // must be > 0
+			cool::thread_affinity new_thread_affinity = cool::thread_affinity(cool::thread_affinity::none),
+			cool::elastic_policy new_elastic_policy = cool::elastic_policy(0), // min thread count must be <= 'new_thread_count'
+			cool::timer_wheel new_timer_wheel = cool::timer_wheel(0)
+		) noexcept;
 		inline bool good() const noexcept; // true if 'init_new_threads' has finished successfully, must not be relied upon if a 'delete_threads' concurrent call is imminent
 		inline std::size_t thread_count() const noexcept;
 		inline std::size_t task_buffer_size() const noexcept;
+		inline std::size_t active_thread_count() const noexcept; // threads running or starting, 'thread_count' unless 'cool::elastic_policy' is used
 		inline void delete_threads() noexcept;
 
+		// elastic pools only (see 'cool::elastic_policy') : 'set_active_thread_count' starts threads right away up to 'new_active_thread_count'
+		// clamped to ['min_thread_count', 'thread_count'], or asks the threads in excess to retire, which they do once the queue is empty
+
+		inline void set_active_thread_count(std::size_t new_active_thread_count) noexcept;
+
 		// 'safety_refresh' produces a spurious wake up of all the potential waits on a condition and should only
 		// be called for safety (possibly cyclically although not in a high frequency loop) if threads_sq could be suspected of deadlocks
 
 		inline void safety_refresh() noexcept;
 
+#ifdef COOL_THREADS_STATS
+		// 'stats' sums the counters of all threads since the last 'init_new_threads' or 'reset_stats' call and measures the current queue depth,
+		// 'stats' / 'reset_stats' must not be called in concurrency with 'init_new_threads' or 'delete_threads'
+
+		inline cool::threads_stats stats() noexcept;
+		inline void reset_stats() noexcept;
+#endif // COOL_THREADS_STATS
+
+#ifdef COOL_THREADS_TRACE
+		// 'write_chrome_trace' writes the last COOL_THREADS_TRACE_SIZE tasks of every thread with operator<< to 'os' as JSON to be opened
+		// with chrome://tracing or ui.perfetto.dev, it must be called while no task is running, for instance after 'finish' on all targets
+
+		template <class ostream_Ty> inline void write_chrome_trace(ostream_Ty& os) const;
+#endif // COOL_THREADS_TRACE
+
 		// WARNING : 'thread_id' / 'thread_native_handle' does not check wether threads have been initialized beforehand
 
 		inline std::thread::id thread_id(std::size_t thread_number) const noexcept;
@@ -270,18 +646,53 @@ namespace cool
 
 		inline thread_native_handle_iterator_proxy thread_native_handles() noexcept; // provides access to 'begin', 'end'
 #endif // COOL_THREADS_NATIVE_HANDLE
+
+	private:
+
+		using _task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+
+		// 'push_task' pushes the task built by 'fill(task_ptr, arg_slab_ptr)' at the back of the queue, or at the front if 'front' is true,
+		// returns false if the queue is full and 'wait_for_space' is false
+
+		template <class fill_Ty> inline bool push_task(fill_Ty& fill, bool front, bool wait_for_space) noexcept;
+
+		// 'push_batch' runs queued tasks on the calling thread while the queues are full if 'run_pending' is true, so that a thread of
+		// the object does not wait on queues that only it could drain
+
+		template <class fill_Ty> inline void push_batch(fill_Ty& fill, std::size_t task_count, bool run_pending) noexcept;
+
+		inline void run_thread(std::size_t thread_num);
+
+		// 'run_pending_task' runs the next queued task on the calling thread, returns false if there was none or the queue was busy
+
+		inline bool run_pending_task() noexcept;
+
+		// 'start_stopped_thread' must be called under 'm_elastic.m_mutex', 'grow_if_saturated' starts a thread if the pool is elastic,
+		// below its thread count, has no idle thread and 'm_grow_queue_depth' tasks or more queued
+
+		inline bool start_stopped_thread() noexcept;
+		inline void grow_if_saturated() noexcept;
+
+		// 'fire_timers' queues the due timers, or all of them with 'flush' set, 'wake_timer_keeper' wakes up the idle threads
+		// so that the keeper of the timers, or a new one, takes an earlier deadline into account
+
+		template <class fill_Ty> inline bool push_timer(fill_Ty& fill, std::int64_t deadline_ns) noexcept;
+		inline void fire_timers(bool flush) noexcept;
+		inline void wake_timer_keeper() noexcept;
+
+		friend class cool::_async_completion;
 	};
 
 
-	// threads_mq
+	// threads_lq
 
 	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align = alignof(std::max_align_t), bool _arg_type_static_check = true>
-	class threads_mq : private cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>
+	class threads_lq : private cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>
 	{
 
 	public:
 
-		static constexpr std::size_t cache_line_size = alignof(cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>);
+		static constexpr std::size_t cache_line_size = alignof(cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>);
 		static constexpr std::size_t arg_buffer_size = _arg_buffer_size;
 		static constexpr std::size_t arg_buffer_align = _arg_buffer_align;
 		static constexpr bool arg_type_static_check = _arg_type_static_check;
@@ -289,26 +700,36 @@ namespace cool
 		// 64 (bytes) is the most common value for _cache_line_size
 
 		static_assert((_cache_line_size & (_cache_line_size - 1)) == 0,
-			"cool::threads_mq<cache_line_size, arg_buffer_size, arg_buffer_align> requirement : cache_line_size must be a power of 2");
+			"cool::threads_lq<cache_line_size, arg_buffer_size, arg_buffer_align> requirement : cache_line_size must be a power of 2");
 		static_assert((_arg_buffer_align & (_arg_buffer_align - 1)) == 0,
-			"cool::threads_mq<cache_line_size, arg_buffer_size, arg_buffer_align> requirement : arg_buffer_align must be a power of 2");
+			"cool::threads_lq<cache_line_size, arg_buffer_size, arg_buffer_align> requirement : arg_buffer_align must be a power of 2");
 		static_assert(_arg_buffer_align >= alignof(std::max_align_t),
-			"cool::threads_mq<cache_line_size, arg_buffer_size, arg_buffer_align> requirement : arg_buffer_align must be greater or equal to alignof(std::max_align_t)");
-
-		threads_mq() = default;
-		threads_mq(const cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&) = delete;
-		cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& operator=(
-			const cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&) = delete;
-		threads_mq(cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&&) = delete;
-		cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& operator=(
-			cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&&) = delete;
-		inline ~threads_mq();
-
-		// 'function_Ty task' must be a function pointer
+			"cool::threads_lq<cache_line_size, arg_buffer_size, arg_buffer_align> requirement : arg_buffer_align must be greater or equal to alignof(std::max_align_t)");
+
+		threads_lq() = default;
+		threads_lq(const cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&) = delete;
+		cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& operator=(
+			const cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&) = delete;
+		threads_lq(cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&&) = delete;
+		cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& operator=(
+			cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&&) = delete;
+		inline ~threads_lq();
+
+		// 'function_Ty task' must be a function pointer or a callable object (such as a lambda) movable without throwing exceptions
 		// 'function_Ty task' must pass arguments by copy
 		// 'arg_Ty ... args' must be movable or copyable without throwing exceptions
 
-		// not sequentially consistent : task1 being submitted before task2 does not guarantee that task1 will start executing before task2
+		// a callable object is moved in the task slot along with the arguments and adds its size to theirs, it is called as an lvalue
+		// and reported with a null function pointer to the exception handler
+
+		// sequentially consistent : task1 being submitted before task2 guarantees that task1 will start executing before task2
+
+		// lock-free variant of threads_sq : tasks are pushed to and popped from a single bounded MPMC ring with atomic operations only,
+		// threads only sleep when the ring is empty and submitting only wakes one if some thread is sleeping
+
+		// 'async' called from a task running on a thread of the same object runs queued tasks while the ring is full, so that tasks
+		// submitting tasks (with 'finish(threads)' on them) cannot fill the ring and leave every thread waiting for space, other
+		// threads calling 'async' on a full ring yield for a while and then sleep until a slot is freed
 
 		// if 'function_Ty task' throws an std::exception, the thread will call the exception handler and jump to the next task
 		// WARNING : other unrelated types of exceptions will not be caught
@@ -345,29 +766,25 @@ namespace cool
 		template <class return_Ty, class function_Ty, class ... arg_Ty>
 		inline bool try_async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		// 'arg_type_is_valid<arg_Ty>' returns true if arg_Ty parameter pack type can be called as an argument for 'task' in 'async' / 'priority_async'
+		// 'arg_type_is_valid<arg_Ty>' returns true if arg_Ty parameter pack type can be called as an argument for 'task' in 'async' / 'try_async'
+		// when 'task' is a function pointer, a callable object 'task' is stored with the arguments and must fit along with them
 
 		template <class ... arg_Ty>
 		static inline constexpr bool arg_type_is_valid() noexcept;
 
 		// WARNING : 'init_new_threads' and 'delete_threads' must not be called in concurrency with any other method
 		// except 'safety_refresh' or the case of 'init_new_thread' with 'good'
-		
-		inline cool::threads_init_result init_new_threads(
-			cool::thread_count new_thread_count, // must be > 0
-			cool::task_buffer_size new_task_buffer_size, // must be > 0
-			cool::try_pop_count new_try_pop_count = cool::try_pop_count(1),
-			cool::dispatch_interval = cool::dispatch_interval(0) // 0 sets value for 'new_dispatch_interval' to default_dispatch_interval('new_thread_count')
-		) noexcept;
+
+		// the task buffer size is rounded up to the next power of 2
+
+		inline cool::threads_init_result init_new_threads(cool::thread_count new_thread_count, cool::task_buffer_size new_task_buffer_size) noexcept; // arguments must be > 0
 		inline bool good() const noexcept; // true if 'init_new_threads' has finished successfully, must not be relied upon if a 'delete_threads' concurrent call is imminent
 		inline std::size_t thread_count() const noexcept;
 		inline std::size_t task_buffer_size() const noexcept;
-		inline unsigned int try_pop_count() const noexcept;
-		inline std::uint16_t dispatch_interval() const noexcept;
 		inline void delete_threads() noexcept;
 
 		// 'safety_refresh' produces a spurious wake up of all the potential waits on a condition and should only
-		// be called for safety (possibly cyclically although not in a high frequency loop) if threads_mq could be suspected of deadlocks
+		// be called for safety (possibly cyclically although not in a high frequency loop) if threads_lq could be suspected of deadlocks
 
 		inline void safety_refresh() noexcept;
 
@@ -375,7 +792,7 @@ namespace cool
 
 		inline std::thread::id thread_id(std::size_t thread_number) const noexcept;
 
-		using thread_id_iterator = cool::_thread_iterator<cool::_thread_mq_id<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>;
+		using thread_id_iterator = cool::_thread_iterator<cool::_thread_sq_id>;
 		using thread_id_iterator_proxy = cool::_thread_const_iterator_proxy<thread_id_iterator>;
 
 		inline thread_id_iterator_proxy thread_ids() const noexcept; // provides access to 'begin', 'end', 'cbegin', 'cend'
@@ -383,2303 +800,7354 @@ namespace cool
 #ifdef COOL_THREADS_NATIVE_HANDLE
 		inline std::thread::native_handle_type thread_native_handle(std::size_t thread_number);
 
-		using thread_native_handle_iterator = cool::_thread_iterator<cool::_thread_mq_native_handle<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>;
+		using thread_native_handle_iterator = cool::_thread_iterator<cool::_thread_sq_native_handle>;
 		using thread_native_handle_iterator_proxy = cool::_thread_iterator_proxy<thread_native_handle_iterator>;
 
 		inline thread_native_handle_iterator_proxy thread_native_handles() noexcept; // provides access to 'begin', 'end'
 #endif // COOL_THREADS_NATIVE_HANDLE
 
-		// 'default_dispatch_interval' returns a value 'new_dispatch_interval' close to sqrt('new_thread_count')
-		// such that gcd('new_thread_count', 'new_dispatch_interval') is 1
+	private:
 
-		static inline std::uint16_t default_dispatch_interval(std::uint16_t new_thread_count) noexcept;
+		using _task = typename cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+
+		template <class fill_Ty> inline bool push_task(fill_Ty& fill, bool wait_for_space) noexcept;
+
+		// 'run_pending_task' runs the next queued task on the calling thread, returns false if there was none
+
+		inline bool run_pending_task() noexcept;
+
+		friend class cool::_async_completion;
 	};
 
 
-	// threads_init_result
+	// threads_mq
 
-	class threads_init_result
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align = alignof(std::max_align_t), bool _arg_type_static_check = true>
+	class threads_mq : private cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>
 	{
 
 	public:
 
-		static constexpr int success = 0;
-		static constexpr int bad_align = 1;
-		static constexpr int bad_parameters = 2;
-		static constexpr int bad_alloc = 3;
-		static constexpr int bad_thread_creation = 4;
+		static constexpr std::size_t cache_line_size = alignof(cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>);
+		static constexpr std::size_t arg_buffer_size = _arg_buffer_size;
+		static constexpr std::size_t arg_buffer_align = _arg_buffer_align;
+		static constexpr bool arg_type_static_check = _arg_type_static_check;
 
-		static constexpr int undefined = -1;
+		// 64 (bytes) is the most common value for _cache_line_size
 
-		threads_init_result() = default;
+		static_assert((_cache_line_size & (_cache_line_size - 1)) == 0,
+			"cool::threads_mq<cache_line_size, arg_buffer_size, arg_buffer_align> requirement : cache_line_size must be a power of 2");
+		static_assert((_arg_buffer_align & (_arg_buffer_align - 1)) == 0,
+			"cool::threads_mq<cache_line_size, arg_buffer_size, arg_buffer_align> requirement : arg_buffer_align must be a power of 2");
+		static_assert(_arg_buffer_align >= alignof(std::max_align_t),
+			"cool::threads_mq<cache_line_size, arg_buffer_size, arg_buffer_align> requirement : arg_buffer_align must be greater or equal to alignof(std::max_align_t)");
 
-		inline operator bool() const noexcept; // returns true if threads init is successful
-		inline bool good() const noexcept; // returns true if threads init is successful
-		inline int value() const noexcept;
-		inline const char* message() const noexcept;
+		threads_mq() = default;
+		threads_mq(const cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&) = delete;
+		cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& operator=(
+			const cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&) = delete;
+		threads_mq(cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&&) = delete;
+		cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& operator=(
+			cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&&) = delete;
+		inline ~threads_mq();
 
-	private:
+		// 'function_Ty task' must be a function pointer or a callable object (such as a lambda) movable without throwing exceptions
+		// 'function_Ty task' must pass arguments by copy
+		// 'arg_Ty ... args' must be movable or copyable without throwing exceptions
 
-		inline threads_init_result(int result) noexcept;
+		// a callable object is moved in the task slot along with the arguments and adds its size to theirs, it is called as an lvalue
+		// and reported with a null function pointer to the exception handler
 
-		int m_result = cool::threads_init_result::undefined;
+		// if 'arg_type_static_check' is false, argument packs that do not fit in 'arg_buffer_size' are moved to the slab allocator of
+		// the thread whose queue receives the task and the task slot only holds a pointer, the storage is recycled when the task completes
+		// and freed by 'delete_threads', packs aligned beyond alignof(std::max_align_t) are still rejected, if the storage cannot be
+		// allocated 'try_async' returns false and 'async' retries as it does on a full queue
 
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_sq;
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_mq;
-	};
+		// not sequentially consistent : task1 being submitted before task2 does not guarantee that task1 will start executing before task2
 
+		// tasks queued with 'async' / 'try_async' from a task running on a thread of the same threads_mq object are pushed on the local
+		// lock-free deque of that thread (COOL_THREADS_MQ_LOCAL_QUEUE_SIZE slots) instead of being dispatched : the thread runs them
+		// newest first before going back to its queue, the threads probing the other queues ('try_pop_count' > 0) steal them oldest
+		// first and an idle thread is woken up to steal them before it parks again, when the deque is full its oldest task is handed
+		// over to the queue of another thread or run in place if none has space
+		// submissions from other threads, 'priority_async', 'async_on_node', 'async_batch', 'parallel_for' and the timers are always dispatched
 
-	// threads_exception_handler
+		// a task waiting with 'finish()' for tasks it has queued itself blocks its thread while the other threads steal them from its
+		// local deque, 'finish(threads)' of async_end / async_result runs them on the waiting thread instead
 
-	// handles all exceptions from all instances of threads_sq and threads_mq
+		// if 'function_Ty task' throws an std::exception, the thread will call the exception handler and jump to the next task
+		// WARNING : other unrelated types of exceptions will not be caught
 
-	class threads_exception_handler
-	{
+		// WARNING : queuing tasks with 'async' / 'priority_async' / 'try_async' / 'try_priority_async' does not check wether threads have been initialized beforehand
 
-	public:
+		template <class function_Ty, class ... arg_Ty>
+		inline void async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		// 'on_exception' arguments are :
-		// > const std::exception& : exception thrown
-		// > void(*)(void) : task function pointer that produced the exception
-		// > std::thread::id : id of the thread that produced the exception
-		// > void* : optional pointer to buffer 'exception_arg_ptr'
+		template <class function_Ty, class ... arg_Ty>
+		inline void async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		// if 'on_exception' is a nullptr, then the exception handling will be the logical equivalent to a no-op
+		template <class function_Ty, class ... arg_Ty>
+		inline void async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		// WARNING : 'on_exception' must not throw any exception or the program will terminate
-		// WARNING : potential reads and writes to 'exception_arg_ptr' by 'on_exception' must be synchronized properly
+		template <class return_Ty, class function_Ty, class ... arg_Ty>
+		inline void async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
+		template <class return_Ty, class function_Ty, class ... arg_Ty>
+		inline void async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		// 'on_delete_thread_exception' arguments are :
-		// > const std::system_error& : exception thrown
-		// > std::thread::id : id of the thread that produced the exception
-		// > void* : optional pointer to buffer 'delete_thread_exception_arg_ptr'
+		// 'async_on_node' queues the task on a thread pinned on NUMA node 'numa_node', or on any thread if there is none
 
-		// if 'on_delete_thread_exception' is a nullptr, then the exception handling will be the logical equivalent to a no-op
+		template <class function_Ty, class ... arg_Ty>
+		inline void async_on_node(int numa_node, cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		// WARNING : 'on_delete_thread_exception' must not throw any exception or the program will terminate
-		// WARNING : potential reads and writes to 'delete_thread_exception_arg_ptr' by 'on_delete_thread_exception' must be synchronized properly
-		// WARNING : 'on_delete_thread_exception' is called if a thread failed to join and the program should be considered to be unlikely to be left in a good state afterwards
+		template <class function_Ty, class ... arg_Ty>
+		inline void async_on_node(int numa_node, cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		static inline void set_on_exception(void(*on_exception)(const std::exception&, void(*)(void), std::thread::id, void*), void* exception_arg_ptr = nullptr) noexcept;
-		static inline void set_on_delete_thread_exception(void(*on_delete_thread_exception)(const std::system_error&, std::thread::id, void*), void* delete_thread_exception_arg_ptr = nullptr) noexcept;
-		static inline void clear() noexcept;
-	};
+		// 'priority_async' / 'try_priority_async' queue the task in the priority lane 'priority' (see 'cool::priority_lanes' in 'init_new_threads'),
+		// 0 is the regular queue, 1 the lowest priority lane and values above the lane count select the highest lane
 
+		template <class function_Ty, class ... arg_Ty>
+		inline void priority_async(unsigned int priority, cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept;
 
-	// async_end
+		template <class function_Ty, class ... arg_Ty>
+		inline void priority_async(unsigned int priority, cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-	// WARNNING : async_end object must outlive the completion of all function calls and notifications from
-	// try_async or try_priority_async with it as a target argument
+		template <class function_Ty, class ... arg_Ty>
+		inline void priority_async(unsigned int priority, cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-	class async_end
-	{
+		template <class return_Ty, class function_Ty, class ... arg_Ty>
+		inline void priority_async(unsigned int priority, cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-	public:
+		template <class return_Ty, class function_Ty, class ... arg_Ty>
+		inline void priority_async(unsigned int priority, cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		async_end() = default;
-		async_end(const cool::async_end& rhs) = delete;
-		cool::async_end& operator=(const cool::async_end& rhs) = delete;
-		async_end(cool::async_end&& rhs) = delete;
-		cool::async_end& operator=(cool::async_end&& rhs) = delete;
-		~async_end() = default;
+		template <class function_Ty, class ... arg_Ty>
+		inline bool try_priority_async(unsigned int priority, cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		inline void add_awaited(std::size_t number_of_tasks) noexcept;
-		inline bool sub_awaited(std::size_t number_of_tasks) noexcept; // returns true iff notified
-		inline bool set_awaited(std::ptrdiff_t number_of_tasks) noexcept; // returns true iff notified
-		inline std::ptrdiff_t get_awaited() const noexcept;
-		inline bool decr_awaited() noexcept; // returns true iff notified
-		inline void notify() noexcept;
-		inline void finish() noexcept;
-		inline bool finished() const noexcept;
+		template <class function_Ty, class ... arg_Ty>
+		inline bool try_priority_async(unsigned int priority, cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		inline cool::_async_end_incr_proxy try_incr_awaited() noexcept;
+		template <class function_Ty, class ... arg_Ty>
+		inline bool try_priority_async(unsigned int priority, cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		// 'safety_refresh' produces a spurious wake up of all the potential waits on a condition and should only
-		// be called for safety (possibly cyclically although not in a high frequency loop) if async_end could be suspected of deadlocks
+		template <class return_Ty, class function_Ty, class ... arg_Ty>
+		inline bool try_priority_async(unsigned int priority, cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		inline void safety_refresh() noexcept;
+		template <class return_Ty, class function_Ty, class ... arg_Ty>
+		inline bool try_priority_async(unsigned int priority, cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-	private:
+		template <class function_Ty, class ... arg_Ty>
+		inline bool try_async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		std::condition_variable m_finish_condition_var;
-		std::mutex m_finish_mutex;
-		std::atomic<std::ptrdiff_t> m_tasks_awaited{ 0 };
+		template <class function_Ty, class ... arg_Ty>
+		inline bool try_async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_sq;
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_mq;
-	};
+		template <class function_Ty, class ... arg_Ty>
+		inline bool try_async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept;
 
+		template <class return_Ty, class function_Ty, class ... arg_Ty>
+		inline bool try_async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-	// async_result
+		template <class return_Ty, class function_Ty, class ... arg_Ty>
+		inline bool try_async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-	// WARNNING : async_result object must outlive the completion of all function calls and notifications from
-	// try_async or try_priority_async with it as a target argument
+		// 'async_at' / 'async_after' queue the task once 'deadline' is reached / 'delay' has elapsed, the task waits meanwhile in one
+		// of the timers reserved with 'cool::timer_wheel' in 'init_new_threads' and they return false if none is available
+		// WARNING : the timers are checked by the threads of the object between tasks and while idle, so that a task may be queued late
+		// if all threads are busy with long tasks, the timers still pending when 'delete_threads' is called are queued right away
 
-	template <class return_Ty> class async_result
-	{
+		template <class clock_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_at(cool::time_point<clock_Ty> deadline, cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept;
 
-	public:
+		template <class clock_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_at(cool::time_point<clock_Ty> deadline, cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		using value_type = return_Ty;
-		using pointer = return_Ty*;
-		using const_pointer = const return_Ty*;
-		using reference = return_Ty&;
-		using const_reference = const return_Ty&;
-		using size_type = std::size_t;
-		using difference_type = std::ptrdiff_t;
+		template <class clock_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_at(cool::time_point<clock_Ty> deadline, cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		async_result() = default;
-		async_result(const cool::async_result<return_Ty>& rhs) = delete;
-		cool::async_result<return_Ty>& operator=(const cool::async_result<return_Ty>& rhs) = delete;
-		async_result(cool::async_result<return_Ty>&& rhs) = delete;
-		cool::async_result<return_Ty>& operator=(cool::async_result<return_Ty>&& rhs) = delete;
-		~async_result() = default;
+		template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_at(cool::time_point<clock_Ty> deadline, cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		explicit inline async_result(return_Ty* storage_ptr) noexcept;
+		template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_at(cool::time_point<clock_Ty> deadline, cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		inline void add_awaited(std::size_t number_of_tasks) noexcept;
-		inline bool sub_awaited(std::size_t number_of_tasks) noexcept; // returns true iff notified
-		inline bool set_awaited(std::ptrdiff_t number_of_tasks) noexcept; // returns true iff notified
-		inline std::ptrdiff_t get_awaited() const noexcept;
-		inline cool::_async_result_to_proxy<return_Ty> to(std::size_t offset) noexcept;
-		inline bool decr_awaited() noexcept; // returns true iff notified
-		inline void notify() noexcept;
-		inline void finish() noexcept;
-		inline bool finished() const noexcept;
+		template <class clock_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_after(cool::duration<clock_Ty> delay, cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		inline return_Ty& get(std::size_t offset) noexcept;
-		inline return_Ty& get_unchecked(std::size_t offset) noexcept;
-		inline const return_Ty& get_unchecked(std::size_t offset) const noexcept;
-		inline void reset(std::size_t count);
-		inline void reset(std::size_t count, const return_Ty& rhs);
-		inline void reset_unchecked(std::size_t count);
-		inline void reset_unchecked(std::size_t count, const return_Ty& rhs);
+		template <class clock_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_after(cool::duration<clock_Ty> delay, cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		inline return_Ty* data() noexcept;
-		inline const return_Ty* data() const noexcept;
+		template <class clock_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_after(cool::duration<clock_Ty> delay, cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		inline void set_data(return_Ty* storage_ptr) noexcept;
-		inline void set_data_unchecked(return_Ty* storage_ptr) noexcept;
-		inline void clear() noexcept;
-		inline void clear_unchecked() noexcept;
+		template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_after(cool::duration<clock_Ty> delay, cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		// 'safety_refresh' produces a spurious wake up of all the potential waits on a condition and should only
-		// be called for safety (possibly cyclically although not in a high frequency loop) if async_result could be suspected of deadlocks
+		template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+		inline bool async_after(cool::duration<clock_Ty> delay, cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		inline void safety_refresh() noexcept;
+		// 'async_batch' queues the tasks 'task(index, args ...)' for every index in ['first', 'last'), slots are reserved and written
+		// in bulk under as few locks as possible and sleeping threads are woken once per bulk write, 'target' awaits all of them
+		// and should be waited on with 'finish'
+		// 'arg_Ty ... args' are copied in every task, the index type must be integral
 
-	private:
+		template <class function_Ty, class index_Ty, class ... arg_Ty>
+		inline void async_batch(cool::no_target_t, function_Ty task, index_Ty first, index_Ty last, const arg_Ty& ... args) noexcept;
 
-		return_Ty* m_stored_values_ptr = nullptr;
-		std::condition_variable m_finish_condition_var;
-		std::mutex m_finish_mutex;
-		std::atomic<std::ptrdiff_t> m_tasks_awaited{ 0 };
+		template <class function_Ty, class index_Ty, class ... arg_Ty>
+		inline void async_batch(cool::async_end& target, function_Ty task, index_Ty first, index_Ty last, const arg_Ty& ... args) noexcept;
 
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_sq;
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_mq;
-		template <class return_Ty2> friend class cool::_async_result_to_proxy;
-	};
+		// 'parallel_for' splits ['first', 'last') in chunks of size 'grain_size' (must be > 0), queues the tasks 'task(chunk_first, chunk_last, args ...)'
+		// for every chunk and returns once they have all been executed, the calling thread runs queued tasks while it waits as with
+		// 'finish(threads)' of async_end, so that 'parallel_for' can be called from a task running on the same threads_mq object
 
-	template <class return_Ty> class _async_result_to_proxy
-	{
+		template <class function_Ty, class index_Ty, class ... arg_Ty>
+		inline void parallel_for(index_Ty first, index_Ty last, index_Ty grain_size, function_Ty task, const arg_Ty& ... args) noexcept;
 
-	public:
+		// 'arg_type_is_valid<arg_Ty>' returns true if arg_Ty parameter pack type can be called as an argument for 'task' in 'async' / 'priority_async'
+		// when 'task' is a function pointer, a callable object 'task' is stored with the arguments and must fit along with them
 
-		_async_result_to_proxy() = delete;
-		_async_result_to_proxy(const cool::_async_result_to_proxy<return_Ty>&) = delete;
-		cool::_async_result_to_proxy<return_Ty>& operator=(const cool::_async_result_to_proxy<return_Ty>&) = delete;
-		_async_result_to_proxy(cool::_async_result_to_proxy<return_Ty>&&) noexcept = default;
-		cool::_async_result_to_proxy<return_Ty>& operator=(cool::_async_result_to_proxy<return_Ty>&&) noexcept = default;
-		~_async_result_to_proxy() = default;
+		template <class ... arg_Ty>
+		static inline constexpr bool arg_type_is_valid() noexcept;
 
-		inline cool::_async_result_incr_proxy<return_Ty> try_incr_awaited() noexcept;
+#ifdef xCOOL_THREADS_COROUTINES
+		// 'co_await threads.schedule()' resumes the coroutine on one of the threads, 'co_await threads.resume_after(target)' suspends it
+		// until 'target' has finished and then resumes it on one of the threads, in both cases the coroutine keeps running on the current
+		// thread if all queues are full, 'target' must outlive the suspension
 
-	private:
+		// WARNING : a resumed coroutine runs as a task of the object, 'async' called from it could wait forever if all queues are full
 
-		inline _async_result_to_proxy(cool::async_result<return_Ty>* target_ptr, std::size_t offset) noexcept : m_parent_ptr(target_ptr), m_offset(offset) {}
+		inline cool::_schedule_awaiter<cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>> schedule() noexcept;
+		inline cool::_finish_awaiter<cool::async_end, cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>> resume_after(cool::async_end& target) noexcept;
 
-		cool::async_result<return_Ty>* m_parent_ptr;
-		std::size_t m_offset;
+		template <class return_Ty>
+		inline cool::_finish_awaiter<cool::async_result<return_Ty>, cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>> resume_after(cool::async_result<return_Ty>& target) noexcept;
+#endif // xCOOL_THREADS_COROUTINES
 
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_sq;
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_mq;
-		template <class return_Ty2> friend class cool::async_result;
-	};
+		// WARNING : 'init_new_threads' and 'delete_threads' must not be called in concurrency with any other method
+		// except 'safety_refresh' or the case of 'init_new_thread' with 'good'
+		
+		inline cool::threads_init_result init_new_threads(
+			cool::thread_count new_thread_count, // must be > 0
+			cool::task_buffer_size new_task_buffer_size, // must be > 0
+			cool::try_pop_count new_try_pop_count = cool::try_pop_count(1),
+			cool::dispatch_interval = cool::dispatch_interval(0) // 0 sets value for 'new_dispatch_interval' to default_dispatch_interval('new_thread_count')
+		) noexcept;
+		inline cool::threads_init_result init_new_threads(
+			cool::thread_count new_thread_count, // must be > 0
+			cool::task_buffer_size new_task_buffer_size, // must be > 0
+			const cool::threads_mq_options& new_options // wait policy, affinity, priority lanes, elastic policy and timers, see cool::threads_mq_options
+		) noexcept;
+		inline bool good() const noexcept; // true if 'init_new_threads' has finished successfully, must not be relied upon if a 'delete_threads' concurrent call is imminent
+		inline std::size_t thread_count() const noexcept;
+		inline std::size_t task_buffer_size() const noexcept;
+		inline unsigned int try_pop_count() const noexcept;
+		inline std::uint16_t dispatch_interval() const noexcept;
+		inline cool::wait_policy wait_policy() const noexcept;
+		inline cool::priority_lanes priority_lanes() const noexcept;
+		inline cool::elastic_policy elastic_policy() const noexcept;
+		inline cool::timer_wheel timer_wheel() const noexcept;
+		inline std::size_t active_thread_count() const noexcept; // threads running or starting, 'thread_count' unless 'cool::elastic_policy' is used
+		inline void delete_threads() noexcept;
 
+		// elastic pools only (see 'cool::elastic_policy') : 'set_active_thread_count' starts threads right away up to 'new_active_thread_count'
+		// clamped to ['min_thread_count', 'thread_count'], or asks the threads in excess to retire : the queues of the highest numbered threads
+		// stop accepting tasks and their thread leaves once they are empty
 
-	// safety_refresh_proxy
+		inline void set_active_thread_count(std::size_t new_active_thread_count) noexcept;
 
-	class safety_refresh_proxy
-	{
+		// 'wait_stats' sums the counters of all threads since the last 'init_new_threads' or 'reset_wait_stats' call,
+		// it must not be called in concurrency with 'init_new_threads' or 'delete_threads'
 
-	public:
+		inline cool::wait_stats wait_stats() const noexcept;
+		inline void reset_wait_stats() noexcept;
 
-		safety_refresh_proxy() = delete;
-		safety_refresh_proxy(const cool::safety_refresh_proxy&) noexcept = default;
-		cool::safety_refresh_proxy& operator=(const cool::safety_refresh_proxy&) noexcept = default;
-		safety_refresh_proxy(cool::safety_refresh_proxy&&) noexcept = default;
-		cool::safety_refresh_proxy& operator=(cool::safety_refresh_proxy&&) noexcept = default;
-		~safety_refresh_proxy() = default;
+		// 'safety_refresh' produces a spurious wake up of all the potential waits on a condition and should only
+		// be called for safety (possibly cyclically although not in a high frequency loop) if threads_mq could be suspected of deadlocks
 
-		inline void safety_refresh() const noexcept;
+		inline void safety_refresh() noexcept;
 
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-		explicit inline safety_refresh_proxy(cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& rhs) noexcept;
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-		explicit inline safety_refresh_proxy(cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& rhs) noexcept;
-		explicit inline safety_refresh_proxy(cool::async_end& rhs) noexcept;
-		template <class return_Ty> explicit inline safety_refresh_proxy(cool::async_result<return_Ty>& rhs) noexcept;
+#ifdef COOL_THREADS_STATS
+		// 'stats' sums the counters of all threads since the last 'init_new_threads' or 'reset_stats' call and measures the current queue depth,
+		// 'stats' / 'reset_stats' must not be called in concurrency with 'init_new_threads' or 'delete_threads'
 
-		inline bool operator==(const cool::safety_refresh_proxy& rhs) const noexcept;
-		inline bool operator!=(const cool::safety_refresh_proxy& rhs) const noexcept;
-		inline bool operator<=(const cool::safety_refresh_proxy& rhs) const noexcept;
-		inline bool operator>=(const cool::safety_refresh_proxy& rhs) const noexcept;
-		inline bool operator<(const cool::safety_refresh_proxy & rhs) const noexcept;
-		inline bool operator>(const cool::safety_refresh_proxy& rhs) const noexcept;
+		inline cool::threads_stats stats() noexcept;
+		inline void reset_stats() noexcept;
+#endif // COOL_THREADS_STATS
 
-		inline bool operator==(const void* rhs_ptr) const noexcept;
-		inline bool operator!=(const void* rhs_ptr) const noexcept;
-		inline bool operator<=(const void* rhs_ptr) const noexcept;
-		inline bool operator>=(const void* rhs_ptr) const noexcept;
-		inline bool operator<(const void* rhs_ptr) const noexcept;
-		inline bool operator>(const void* rhs_ptr) const noexcept;
+#ifdef COOL_THREADS_TRACE
+		// 'write_chrome_trace' writes the last COOL_THREADS_TRACE_SIZE tasks of every thread with operator<< to 'os' as JSON to be opened
+		// with chrome://tracing or ui.perfetto.dev, it must be called while no task is running, for instance after 'finish' on all targets
 
-	private:
+		template <class ostream_Ty> inline void write_chrome_trace(ostream_Ty& os) const;
+#endif // COOL_THREADS_TRACE
 
-		void(*m_callable)(void*);
-		void* m_object_ptr;
-	};
+		// WARNING : 'thread_id' / 'thread_native_handle' does not check wether threads have been initialized beforehand
 
-	inline bool operator==(const void* lhs_ptr, const cool::safety_refresh_proxy& rhs) noexcept;
-	inline bool operator!=(const void* lhs_ptr, const cool::safety_refresh_proxy& rhs) noexcept;
-	inline bool operator<=(const void* lhs_ptr, const cool::safety_refresh_proxy& rhs) noexcept;
-	inline bool operator>=(const void* lhs_ptr, const cool::safety_refresh_proxy& rhs) noexcept;
-	inline bool operator<(const void* lhs_ptr, const cool::safety_refresh_proxy& rhs) noexcept;
-	inline bool operator>(const void* lhs_ptr, const cool::safety_refresh_proxy& rhs) noexcept;
-}
+		inline std::thread::id thread_id(std::size_t thread_number) const noexcept;
 
+		using thread_id_iterator = cool::_thread_iterator<cool::_thread_mq_id<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>;
+		using thread_id_iterator_proxy = cool::_thread_const_iterator_proxy<thread_id_iterator>;
 
-namespace cool
-{
-	// _threads_base
+		inline thread_id_iterator_proxy thread_ids() const noexcept; // provides access to 'begin', 'end', 'cbegin', 'cend'
 
-	class _threads_base
-	{
+		// 'thread_cpu' / 'thread_numa_node' return -1 if the thread has not been pinned with 'cool::thread_affinity'
+
+		inline int thread_cpu(std::size_t thread_number) const noexcept;
+		inline int thread_numa_node(std::size_t thread_number) const noexcept;
+
+#ifdef COOL_THREADS_NATIVE_HANDLE
+		inline std::thread::native_handle_type thread_native_handle(std::size_t thread_number);
+
+		using thread_native_handle_iterator = cool::_thread_iterator<cool::_thread_mq_native_handle<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>;
+		using thread_native_handle_iterator_proxy = cool::_thread_iterator_proxy<thread_native_handle_iterator>;
+
+		inline thread_native_handle_iterator_proxy thread_native_handles() noexcept; // provides access to 'begin', 'end'
+#endif // COOL_THREADS_NATIVE_HANDLE
+
+		// 'default_dispatch_interval' returns a value 'new_dispatch_interval' close to sqrt('new_thread_count')
+		// such that gcd('new_thread_count', 'new_dispatch_interval') is 1
+
+		static inline std::uint16_t default_dispatch_interval(std::uint16_t new_thread_count) noexcept;
 
 	private:
 
-		friend class cool::threads_exception_handler;
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> friend class cool::_threads_sq_data;
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_sq;
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> friend class cool::_threads_mq_data;
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_mq;
+		using _task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
 
-		template <std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _base_task {
-		private:
-			static constexpr std::size_t _arg_buffer_size_padded = (_arg_buffer_size != 0) ? _arg_buffer_size : 1;
-		public:
-			class _address {
-			public:
-				void(*m_callable)(_base_task<_arg_buffer_size, _arg_buffer_align>*, _base_task<_arg_buffer_size, _arg_buffer_align>*);
-				void(*m_function_ptr)(void);
-			};
-			class _address_with_target : public _address {
-			public:
-				void* m_target_ptr;
-			};
-			class _address_with_target_and_offset : public _address_with_target {
-			public:
-				std::size_t m_offset;
-			};
-			
-			static constexpr std::size_t address_size = sizeof(_address);
-			static constexpr std::size_t address_with_target_size = sizeof(_address_with_target);
-			static constexpr std::size_t address_with_target_and_offset_size = sizeof(_address_with_target_and_offset);
+		// 'push_batch' runs queued tasks on the calling thread while the queues are full if 'run_pending' is true, so that a thread of
+		// the object does not wait on queues that only it could drain
 
-			alignas(_arg_buffer_align) unsigned char m_arg_buffer[_arg_buffer_size_padded];
-			_address_with_target_and_offset m_address_data;
-		};
+		template <class fill_Ty> inline void push_batch(fill_Ty& fill, std::size_t task_count, bool run_pending) noexcept;
+		template <class fill_Ty> inline void push_on_node(fill_Ty& fill, int numa_node) noexcept;
 
-		template <std::size_t ... _indices> class indices {};
-		template <std::size_t n, std::size_t ... _indices> class build_indices : public build_indices<n - 1, n - 1, _indices...> {};
-		template <std::size_t ... _indices> class build_indices<0, _indices...> : public indices<_indices...> {};
+		// 'push_local' pushes the task built by 'fill(task_ptr, arg_slab_ptr)' on the local deque of the calling thread if it is a thread
+		// of the object, with 'evict' set a full deque gives its oldest task to the queue of another thread without waiting for space or
+		// for a lock, or runs it in place on the calling thread if no other queue takes it, returns false if not pushed
 
-		template <class function_Ty, class tuple_Ty, std::size_t ... _indices>
-		static inline auto call(function_Ty task, tuple_Ty&& args, indices<_indices...>) -> decltype(task(std::get<_indices>(std::forward<tuple_Ty>(args))...)) {
-			return std::move(task(std::get<_indices>(std::forward<tuple_Ty>(args))...));
-		}
-		template <class function_Ty, class tuple_Ty>
-		static inline auto call(function_Ty task, tuple_Ty&& args) -> decltype(call(task, args, build_indices<std::tuple_size<tuple_Ty>::value>())) {
-			return std::move(call(task, std::move(args), build_indices<std::tuple_size<tuple_Ty>::value>()));
-		}
-		template <class function_Ty, class tuple_Ty, std::size_t ... _indices>
-		static inline void call_no_return(function_Ty task, tuple_Ty&& args, indices<_indices...>) {
-			task(std::get<_indices>(std::forward<tuple_Ty>(args))...);
-		}
-		template <class function_Ty, class tuple_Ty>
-		static inline void call_no_return(function_Ty task, tuple_Ty&& args) {
-			call_no_return(task, std::move(args), build_indices<std::tuple_size<tuple_Ty>::value>());
-		}
+		template <class fill_Ty> inline bool push_local(fill_Ty& fill, bool evict) noexcept;
+		template <class fill_Ty> inline bool push_priority(fill_Ty& fill, unsigned int priority, bool wait_for_space) noexcept;
 
-		class exception_handler {
-		public:
-			inline exception_handler(void(*_function)(const std::exception&, void(*)(void), std::thread::id, void*), void* _arg_ptr) noexcept
-				: m_function(_function), m_arg_ptr(_arg_ptr) {};
-			void(*m_function)(const std::exception&, void(*)(void), std::thread::id, void*) = nullptr;
-			void* m_arg_ptr = nullptr;
-		};
+		// 'run_pending_task' runs a queued task on the calling thread, with the tasks of the local deque of the calling thread first
+		// if it is a thread of the object, returns false if none was found
 
-		static inline std::atomic<exception_handler>& get_exception_handler() noexcept {
-			static std::atomic<exception_handler> handler{ exception_handler{ nullptr, nullptr } };
-			return handler;
-		}
-		static inline void catch_exception(const std::exception& excep, void(*task_function_ptr)(void)) noexcept {
-			exception_handler handler = get_exception_handler().load(std::memory_order_seq_cst);
-			if (handler.m_function != nullptr) {
-				handler.m_function(excep, task_function_ptr, std::this_thread::get_id(), handler.m_arg_ptr);
-			}
-		}
+		inline bool run_pending_task() noexcept;
 
-		class delete_thread_exception_handler {
-		public:
-			inline delete_thread_exception_handler(void(*_function)(const std::system_error&, std::thread::id, void*), void* _arg_ptr) noexcept
-				: m_function(_function), m_arg_ptr(_arg_ptr) {};
-			void(*m_function)(const std::system_error&, std::thread::id, void*) = nullptr;
-			void* m_arg_ptr = nullptr;
-		};
+		// 'launch_thread' throws if the thread cannot be created, 'start_stopped_thread' must be called under 'm_elastic.m_mutex',
+		// 'grow_threads' starts a thread unless another thread is already being started
 
-		static inline std::atomic<delete_thread_exception_handler>& get_delete_thread_exception_handler() noexcept {
-			static std::atomic<delete_thread_exception_handler> handler{ delete_thread_exception_handler{ nullptr, nullptr } };
-			return handler;
-		}
-		static inline void catch_delete_thread_exception(const std::system_error& error, std::thread::id thread_id) noexcept {
-			delete_thread_exception_handler handler = get_delete_thread_exception_handler().load(std::memory_order_seq_cst);
-			if (handler.m_function != nullptr) {
-				handler.m_function(error, thread_id, handler.m_arg_ptr);
-			}
-		}
-	};
+		inline void launch_thread(std::size_t thread_num);
+		inline bool start_stopped_thread() noexcept;
+		inline void grow_threads() noexcept;
 
-	// _threads_sq_data
+		// 'fire_timers' queues the due timers, or all of them with 'flush' set, 'wake_timer_keeper' wakes up the idle threads so that
+		// the keeper of the timers, or a new one, takes an earlier deadline into account, 'hand_over_timers' is called by a keeper
+		// that leaves with a task
 
-	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
-	class alignas(_cache_line_size) _threads_sq_data : public cool::_threads_base
-	{
+		template <class fill_Ty> inline bool push_timer(fill_Ty& fill, std::int64_t deadline_ns) noexcept;
+		inline void fire_timers(bool flush) noexcept;
+		inline void wake_timer_keeper() noexcept;
+		inline void hand_over_timers() noexcept;
 
-	private:
+		friend class cool::_async_completion;
+	};
 
-		friend class cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, true>;
-		friend class cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, false>;
 
-		using _task = typename cool::_threads_base::_base_task<_arg_buffer_size, _arg_buffer_align>;
+	// threads_ws
 
-		_threads_sq_data() = default;
-		_threads_sq_data(const cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&) = delete;
-		cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>& operator=(
-			const cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&) = delete;
-		_threads_sq_data(cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&&) = delete;
-		cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>& operator=(
-			cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&&) = delete;
-		~_threads_sq_data() = default;
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align = alignof(std::max_align_t), bool _arg_type_static_check = true>
+	class threads_ws : private cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>
+	{
 
-		inline void delete_threads_detail(std::size_t threads_constructed) noexcept;
+	public:
 
-		_task* m_task_buffer_data_ptr = nullptr;
-		_task* m_task_buffer_end_ptr = nullptr;
+		static constexpr std::size_t cache_line_size = alignof(cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>);
+		static constexpr std::size_t arg_buffer_size = _arg_buffer_size;
+		static constexpr std::size_t arg_buffer_align = _arg_buffer_align;
+		static constexpr bool arg_type_static_check = _arg_type_static_check;
 
-		_task* m_last_task_ptr = nullptr;
-		_task* m_next_task_ptr = nullptr;
+		// 64 (bytes) is the most common value for _cache_line_size
 
-		bool m_stop_threads = true;
-		char* m_task_buffer_unaligned_data_ptr = nullptr;
+		static_assert((_cache_line_size & (_cache_line_size - 1)) == 0,
+			"cool::threads_ws<cache_line_size, arg_buffer_size, arg_buffer_align> requirement : cache_line_size must be a power of 2");
+		static_assert((_arg_buffer_align & (_arg_buffer_align - 1)) == 0,
+			"cool::threads_ws<cache_line_size, arg_buffer_size, arg_buffer_align> requirement : arg_buffer_align must be a power of 2");
+		static_assert(_arg_buffer_align >= alignof(std::max_align_t),
+			"cool::threads_ws<cache_line_size, arg_buffer_size, arg_buffer_align> requirement : arg_buffer_align must be greater or equal to alignof(std::max_align_t)");
+
+		threads_ws() = default;
+		threads_ws(const cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&) = delete;
+		cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& operator=(
+			const cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&) = delete;
+		threads_ws(cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&&) = delete;
+		cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& operator=(
+			cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>&&) = delete;
+		inline ~threads_ws();
+
+		// 'function_Ty task' must be a function pointer or a callable object (such as a lambda) movable without throwing exceptions
+		// 'function_Ty task' must pass arguments by copy
+		// 'arg_Ty ... args' must be movable or copyable without throwing exceptions
 
-		std::thread* m_threads_data_ptr = nullptr;
-		std::size_t m_thread_count = 0;
+		// a callable object is moved in the task slot along with the arguments and adds its size to theirs, it is called as an lvalue
+		// and reported with a null function pointer to the exception handler
 
-		alignas(_cache_line_size) std::condition_variable m_condition_var;
-		std::mutex m_mutex;
+		// not sequentially consistent : task1 being submitted before task2 does not guarantee that task1 will start executing before task2
 
-		std::atomic<bool> m_good{ false };
-	};
+		// each thread owns a lock-free work-stealing deque (Chase-Lev) fed from its task buffer, threads running out of tasks steal
+		// from the deques of randomly picked threads before waiting, tasks submitted from a thread of the same threads_ws object
+		// are pushed on the deque of the submitting thread
 
-	// _threads_mq_data
+		// if 'function_Ty task' throws an std::exception, the thread will call the exception handler and jump to the next task
+		// WARNING : other unrelated types of exceptions will not be caught
 
-	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
-	class alignas(_cache_line_size) _threads_mq_data : public cool::_threads_base
-	{
+		// WARNING : queuing tasks with 'async' / 'try_async' does not check wether threads have been initialized beforehand
 
-	private:
+		template <class function_Ty, class ... arg_Ty>
+		inline void async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		friend class cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, true>;
-		friend class cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, false>;
-		friend class cool::_thread_mq_id<_cache_line_size, _arg_buffer_size, _arg_buffer_align>;
-		friend class cool::_thread_mq_native_handle<_cache_line_size, _arg_buffer_size, _arg_buffer_align>;
+		template <class function_Ty, class ... arg_Ty>
+		inline void async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		using _task = typename cool::_threads_base::_base_task<_arg_buffer_size, _arg_buffer_align>;
+		template <class function_Ty, class ... arg_Ty>
+		inline void async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-#if !defined(COOL_THREADS_MQ_32BIT_COUNTER) && !defined(COOL_THREADS_MQ_16BIT_COUNTER)
-#ifdef UINT64_MAX
-		using _uintX = std::uint32_t;
-		using _uint2X = std::uint64_t;
-#else // UINT64_MAX
-		using _uintX = std::uint16_t;
-		using _uint2X = std::uint32_t;
-#endif // UINT64_MAX
-#elif defined(COOL_THREADS_MQ_32BIT_COUNTER)
-		using _uintX = std::uint32_t;
-		using _uint2X = std::uint64_t;
-#else // defined(COOL_THREADS_MQ_16BIT_COUNTER)
-		using _uintX = std::uint16_t;
-		using _uint2X = std::uint32_t;
-#endif // COOL_THREADS_MQ_XBIT_COUNTER
+		template <class return_Ty, class function_Ty, class ... arg_Ty>
+		inline void async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		_threads_mq_data() = default;
-		_threads_mq_data(const cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&) = delete;
-		cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>& operator=(
-			const cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&) = delete;
-		_threads_mq_data(cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&&) = delete;
-		cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>& operator=(
-			cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&&) = delete;
-		~_threads_mq_data() = default;
+		template <class return_Ty, class function_Ty, class ... arg_Ty>
+		inline void async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		inline void delete_threads_detail(std::size_t threads_constructed, std::size_t threads_launched) noexcept;
+		template <class function_Ty, class ... arg_Ty>
+		inline bool try_async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		class _thread_block;
+		template <class function_Ty, class ... arg_Ty>
+		inline bool try_async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		_uintX m_dispatch_interval = 1;
-		_uintX m_mod_k = 0;
-		_uint2X m_mod_a = static_cast<_uint2X>(1) << (sizeof(_uintX) * CHAR_BIT);
-		_uint2X m_mod_D = 1;
-		std::size_t m_thread_count = 0;
-		_thread_block* m_thread_blocks_data_ptr = nullptr;
+		template <class function_Ty, class ... arg_Ty>
+		inline bool try_async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		std::atomic<bool> m_good{ false };
-		unsigned int m_pop_rounds = 0;
+		template <class return_Ty, class function_Ty, class ... arg_Ty>
+		inline bool try_async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		char* m_thread_blocks_unaligned_data_ptr = nullptr;
+		template <class return_Ty, class function_Ty, class ... arg_Ty>
+		inline bool try_async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept;
 
-		alignas(_cache_line_size) std::atomic<_uintX> m_thread_dispatch{ 0 };
+		// 'arg_type_is_valid<arg_Ty>' returns true if arg_Ty parameter pack type can be called as an argument for 'task' in 'async' / 'try_async'
+		// when 'task' is a function pointer, a callable object 'task' is stored with the arguments and must fit along with them
 
-		alignas(_cache_line_size) std::atomic<bool> m_can_refresh{ false };
+		template <class ... arg_Ty>
+		static inline constexpr bool arg_type_is_valid() noexcept;
 
-		class alignas(_cache_line_size) _thread_block
-		{
+		// WARNING : 'init_new_threads' and 'delete_threads' must not be called in concurrency with any other method
+		// except 'safety_refresh' or the case of 'init_new_thread' with 'good'
 
-		public:
+		// each thread gets a task buffer of size 'new_task_buffer_size' / 'new_thread_count' (rounded up) and a deque
+		// of the next power of 2 above that size, 'new_try_pop_count' is the number of steal attempts on random threads before waiting
 
-			inline bool new_task_buffer(std::size_t new_task_buffer_size) noexcept;
-			inline void delete_task_buffer() noexcept;
+		inline cool::threads_init_result init_new_threads(
+			cool::thread_count new_thread_count, // must be > 0
+			cool::task_buffer_size new_task_buffer_size, // must be > 0
+			cool::try_pop_count new_try_pop_count = cool::try_pop_count(0) // 0 sets value for 'new_try_pop_count' to 2 * 'new_thread_count'
+		) noexcept;
+		inline bool good() const noexcept; // true if 'init_new_threads' has finished successfully, must not be relied upon if a 'delete_threads' concurrent call is imminent
+		inline std::size_t thread_count() const noexcept;
+		inline std::size_t task_buffer_size() const noexcept;
+		inline unsigned int try_pop_count() const noexcept;
+		inline void delete_threads() noexcept;
 
-			_task* m_task_buffer_data_ptr = nullptr;
-			_task* m_task_buffer_end_ptr = nullptr;
+		// 'safety_refresh' produces a spurious wake up of all the potential waits on a condition and should only
+		// be called for safety (possibly cyclically although not in a high frequency loop) if threads_ws could be suspected of deadlocks
 
-			_task* m_last_task_ptr = nullptr;
-			_task* m_next_task_ptr = nullptr;
+		inline void safety_refresh() noexcept;
 
-			bool m_stop_threads = true;
+		// WARNING : 'thread_id' / 'thread_native_handle' does not check wether threads have been initialized beforehand
 
-			std::thread m_thread;
-			char* m_task_buffer_unaligned_data_ptr = nullptr;
+		inline std::thread::id thread_id(std::size_t thread_number) const noexcept;
 
-			alignas(_cache_line_size) std::condition_variable m_condition_var;
-			std::mutex m_mutex;
-		};
-	};
+		using thread_id_iterator = cool::_thread_iterator<cool::_thread_ws_id<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>;
+		using thread_id_iterator_proxy = cool::_thread_const_iterator_proxy<thread_id_iterator>;
 
-	// target incr proxy
+		inline thread_id_iterator_proxy thread_ids() const noexcept; // provides access to 'begin', 'end', 'cbegin', 'cend'
 
-	class _async_end_incr_proxy
-	{
+#ifdef COOL_THREADS_NATIVE_HANDLE
+		inline std::thread::native_handle_type thread_native_handle(std::size_t thread_number);
 
-	public:
+		using thread_native_handle_iterator = cool::_thread_iterator<cool::_thread_ws_native_handle<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>;
+		using thread_native_handle_iterator_proxy = cool::_thread_iterator_proxy<thread_native_handle_iterator>;
 
-		_async_end_incr_proxy() = delete;
-		_async_end_incr_proxy(const cool::_async_end_incr_proxy&) = delete;
-		cool::_async_end_incr_proxy& operator=(const cool::_async_end_incr_proxy&) = delete;
-		_async_end_incr_proxy(cool::_async_end_incr_proxy&&) noexcept = default;
-		cool::_async_end_incr_proxy& operator=(cool::_async_end_incr_proxy&&) noexcept = default;
-		~_async_end_incr_proxy() = default;
+		inline thread_native_handle_iterator_proxy thread_native_handles() noexcept; // provides access to 'begin', 'end'
+#endif // COOL_THREADS_NATIVE_HANDLE
 
 	private:
 
-		_async_end_incr_proxy(cool::async_end* target_ptr) noexcept : m_parent_ptr(target_ptr) {}
+		using _task = typename cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
 
-		cool::async_end* m_parent_ptr;
+		template <class fill_Ty> inline bool push_task(fill_Ty& fill, bool wait_for_space) noexcept;
 
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_sq;
-		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_mq;
-		friend class cool::async_end;
+		// 'run_pending_task' runs a queued task on the calling thread, with the tasks of the local deque of the calling thread first
+		// if it is a thread of the object, returns false if none was found
+
+		inline bool run_pending_task() noexcept;
+
+		friend class cool::_async_completion;
 	};
 
-	template <class return_Ty> class _async_result_incr_proxy
+
+	// threads_init_result
+
+	class threads_init_result
 	{
 
 	public:
 
-		_async_result_incr_proxy() = delete;
-		_async_result_incr_proxy(const cool::_async_result_incr_proxy<return_Ty>&) = delete;
-		cool::_async_result_incr_proxy<return_Ty>& operator=(const cool::_async_result_incr_proxy<return_Ty>&) = delete;
-		_async_result_incr_proxy(cool::_async_result_incr_proxy<return_Ty>&&) noexcept = default;
-		cool::_async_result_incr_proxy<return_Ty>& operator=(cool::_async_result_incr_proxy<return_Ty>&&) noexcept = default;
-		~_async_result_incr_proxy() = default;
+		static constexpr int success = 0;
+		static constexpr int bad_align = 1;
+		static constexpr int bad_parameters = 2;
+		static constexpr int bad_alloc = 3;
+		static constexpr int bad_thread_creation = 4;
+
+		static constexpr int undefined = -1;
+
+		threads_init_result() = default;
+
+		inline operator bool() const noexcept; // returns true if threads init is successful
+		inline bool good() const noexcept; // returns true if threads init is successful
+		inline int value() const noexcept;
+		inline const char* message() const noexcept;
 
 	private:
 
-		inline _async_result_incr_proxy(cool::async_result<return_Ty>* target_ptr, std::size_t offset) noexcept : m_parent_ptr(target_ptr), m_offset(offset) {}
+		inline threads_init_result(int result) noexcept;
 
-		cool::async_result<return_Ty>* m_parent_ptr;
-		std::size_t m_offset;
+		int m_result = cool::threads_init_result::undefined;
 
 		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_sq;
 		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_mq;
-		template <class return_Ty2> friend class cool::_async_result_to_proxy;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_ws;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_lq;
 	};
 
-	// iterators
 
-	template <class data_Ty> class _thread_iterator : private data_Ty
+	// threads_exception_handler
+
+	// handles all exceptions from all instances of threads_sq, threads_lq, threads_mq and threads_ws
+
+	class threads_exception_handler
 	{
 
 	public:
 
-		using data_Ty::data_Ty;
-		using value_type = typename data_Ty::value_type;
-		using pointer_type = typename data_Ty::pointer_type;
+		// 'on_exception' arguments are :
+		// > const std::exception& : exception thrown
+		// > void(*)(void) : task function pointer that produced the exception, nullptr if the task is a callable object
+		// > std::thread::id : id of the thread that produced the exception
+		// > void* : optional pointer to buffer 'exception_arg_ptr'
 
-		inline cool::_thread_iterator<data_Ty>& operator--() noexcept { this->m_ptr--; return *this; }
-		inline cool::_thread_iterator<data_Ty>& operator++() noexcept { this->m_ptr++; return *this; }
-		inline cool::_thread_iterator<data_Ty> operator--(int) noexcept { cool::_thread_iterator<data_Ty> ret = *this; this->m_ptr--; return ret; }
-		inline cool::_thread_iterator<data_Ty> operator++(int) noexcept { cool::_thread_iterator<data_Ty> ret = *this; this->m_ptr++; return ret; }
-		inline cool::_thread_iterator<data_Ty>& operator-=(std::ptrdiff_t offset) noexcept { this->m_ptr -= offset; return *this; }
-		inline cool::_thread_iterator<data_Ty>& operator+=(std::ptrdiff_t offset) noexcept { this->m_ptr += offset; return *this; }
-		inline cool::_thread_iterator<data_Ty> operator-(std::ptrdiff_t offset) const noexcept { return cool::_thread_iterator<data_Ty>(this->m_ptr - offset); }
-		inline cool::_thread_iterator<data_Ty> operator+(std::ptrdiff_t offset) const noexcept { return cool::_thread_iterator<data_Ty>(this->m_ptr + offset); }
-		inline std::ptrdiff_t operator-(const cool::_thread_iterator<data_Ty>& rhs) const noexcept { return this->m_ptr - rhs.m_ptr; }
+		// if 'on_exception' is a nullptr, then the exception handling will be the logical equivalent to a no-op
 
-		inline bool operator==(const cool::_thread_iterator<data_Ty>& rhs) const noexcept { return this->m_ptr == rhs.m_ptr; }
-		inline bool operator!=(const cool::_thread_iterator<data_Ty>& rhs) const noexcept { return this->m_ptr != rhs.m_ptr; }
-		inline bool operator<=(const cool::_thread_iterator<data_Ty>& rhs) const noexcept { return this->m_ptr <= rhs.m_ptr; }
-		inline bool operator>=(const cool::_thread_iterator<data_Ty>& rhs) const noexcept { return this->m_ptr >= rhs.m_ptr; }
-		inline bool operator<(const cool::_thread_iterator<data_Ty>& rhs) const noexcept { return this->m_ptr < rhs.m_ptr; }
-		inline bool operator>(const cool::_thread_iterator<data_Ty>& rhs) const noexcept { return this->m_ptr > rhs.m_ptr; }
+		// WARNING : 'on_exception' must not throw any exception or the program will terminate
+		// WARNING : potential reads and writes to 'exception_arg_ptr' by 'on_exception' must be synchronized properly
 
-		value_type operator*() const noexcept(data_Ty::indirection_is_noexcept) { return this->indirection_impl(); }
-		value_type operator[](std::ptrdiff_t offset) const noexcept(data_Ty::indirection_is_noexcept) { return this->indirection_impl(offset); }
+
+		// 'on_delete_thread_exception' arguments are :
+		// > const std::system_error& : exception thrown
+		// > std::thread::id : id of the thread that produced the exception
+		// > void* : optional pointer to buffer 'delete_thread_exception_arg_ptr'
+
+		// if 'on_delete_thread_exception' is a nullptr, then the exception handling will be the logical equivalent to a no-op
+
+		// WARNING : 'on_delete_thread_exception' must not throw any exception or the program will terminate
+		// WARNING : potential reads and writes to 'delete_thread_exception_arg_ptr' by 'on_delete_thread_exception' must be synchronized properly
+		// WARNING : 'on_delete_thread_exception' is called if a thread failed to join and the program should be considered to be unlikely to be left in a good state afterwards
+
+		static inline void set_on_exception(void(*on_exception)(const std::exception&, void(*)(void), std::thread::id, void*), void* exception_arg_ptr = nullptr) noexcept;
+		static inline void set_on_delete_thread_exception(void(*on_delete_thread_exception)(const std::system_error&, std::thread::id, void*), void* delete_thread_exception_arg_ptr = nullptr) noexcept;
+		static inline void clear() noexcept;
 	};
 
-	template <class _thread_iterator_Ty> class _thread_iterator_proxy
+
+	// _async_waiter
+
+	class _async_waiter
 	{
 
 	public:
 
-		using pointer_type = typename _thread_iterator_Ty::pointer_type;
+		void(*m_callback)(void*) = nullptr;
+		void* m_object_ptr = nullptr;
+		cool::_async_waiter* m_next_ptr = nullptr;
+	};
 
-		inline _thread_iterator_proxy(pointer_type begin_ptr, pointer_type end_ptr) noexcept : m_begin(begin_ptr), m_end(end_ptr) {}
-		inline _thread_iterator_Ty begin() const noexcept { return m_begin; }
-		inline _thread_iterator_Ty end() const noexcept { return m_end; }
+
+	// _async_completion
+
+	// completion counter of async_end and async_result : the number of tasks awaited and the state flags share a single atomic word
+	// so that a task decrementing the counter does nothing else unless it is the last one, which then only touches the word again
+	// if waiters have to be collected, 'wait' only returns once that last access is done so that the object may be destroyed right away,
+	// the thread that completes the counter wakes the sleeping threads by address only (futex, or a static park slot picked from the address)
+
+	class _async_completion
+	{
+
+	public:
+
+		static constexpr std::ptrdiff_t waiting_flag = 1; // threads sleep or are about to sleep in 'wait'
+		static constexpr std::ptrdiff_t lock_flag = 2; // the list of waiters is being accessed
+		static constexpr std::ptrdiff_t list_flag = 4; // the list of waiters is not empty
+		static constexpr std::ptrdiff_t flag_mask = 7;
+		static constexpr std::ptrdiff_t unit = 8;
+		static constexpr unsigned int help_poll_count = 256; // consecutive empty polls of 'wait_helping' before it sleeps
+
+		inline void add(std::size_t number_of_tasks) noexcept;
+		inline void incr() noexcept;
+		inline bool sub(std::size_t number_of_tasks) noexcept; // returns true iff notified
+		inline bool set(std::ptrdiff_t number_of_tasks) noexcept; // returns true iff notified
+		inline std::ptrdiff_t get() const noexcept;
+		inline bool decr() noexcept; // returns true iff notified
+		inline void wake() noexcept;
+		inline void wait(std::size_t spin_count) noexcept;
+		template <class threads_Ty> inline void wait_helping(threads_Ty& threads) noexcept; // runs the tasks queued in 'threads' until finished
+		inline bool finished() const noexcept;
+		inline bool add_waiter(cool::_async_waiter* waiter_ptr) noexcept; // returns false if already finished
+
+#if defined(xCOOL_THREADS_FUTEX)
+		// 'futex_wait' sleeps while the 32-bit word at 'word_ptr' holds 'value' (or spuriously), 'futex_wake' wakes up to 'count'
+		// threads sleeping on it and only uses its address
+
+		static inline void futex_wait(void* word_ptr, std::uint32_t value) noexcept;
+		static inline void futex_wake(void* word_ptr, int count) noexcept;
+#endif // defined(xCOOL_THREADS_FUTEX)
 
 	private:
 
-		_thread_iterator_Ty m_begin;
-		_thread_iterator_Ty m_end;
+		static inline std::ptrdiff_t count(std::ptrdiff_t state) noexcept;
+		static inline bool done(std::ptrdiff_t state) noexcept;
+		inline void on_finished(std::ptrdiff_t state) noexcept;
+		inline void wait_on(std::ptrdiff_t state) noexcept;
+		inline void wake_all() noexcept;
+
+#if !defined(xCOOL_THREADS_FUTEX)
+		// slot of a static table where the threads waiting on a counter sleep, the slot outlives the counter so that waking
+		// them up never touches an object that its waiter may have destroyed already, counters sharing a slot wake up spuriously
+
+		class alignas(64) _park_slot
+		{
+
+		public:
+
+			std::atomic<std::uint32_t> m_epoch{ 0 };
+#if !defined(xCOOL_THREADS_ATOMIC_WAIT)
+			std::mutex m_mutex;
+			std::condition_variable m_condition_var;
+#endif // !defined(xCOOL_THREADS_ATOMIC_WAIT)
+		};
+
+		static constexpr std::size_t park_slot_count = 64;
+
+		static inline _park_slot& park_slot(const void* address) noexcept;
+#endif // !defined(xCOOL_THREADS_FUTEX)
+
+		std::atomic<std::ptrdiff_t> m_state{ 0 };
+		cool::_async_waiter* m_waiter_ptr = nullptr;
 	};
 
-	template <class _thread_iterator_Ty> class _thread_const_iterator_proxy
+
+#ifdef xCOOL_THREADS_COROUTINES
+	// _schedule_awaiter
+
+	// resumes the awaiting coroutine on a thread of 'threads', or right away on the current thread if all queues are full
+
+	template <class threads_Ty> class _schedule_awaiter
 	{
 
 	public:
 
-		using pointer_type = typename _thread_iterator_Ty::pointer_type;
+		_schedule_awaiter() = delete;
+		explicit _schedule_awaiter(threads_Ty* threads_ptr) noexcept : m_threads_ptr(threads_ptr) {}
 
-		inline _thread_const_iterator_proxy(pointer_type begin_ptr, pointer_type end_ptr) noexcept : m_begin(begin_ptr), m_end(end_ptr) {}
-		inline _thread_iterator_Ty begin() const noexcept { return m_begin; }
-		inline _thread_iterator_Ty end() const noexcept { return m_end; }
-		inline _thread_iterator_Ty cbegin() const noexcept { return m_begin; }
-		inline _thread_iterator_Ty cend() const noexcept { return m_end; }
+		inline bool await_ready() const noexcept;
+		inline bool await_suspend(std::coroutine_handle<> handle) noexcept;
+		inline void await_resume() const noexcept;
+
+		static inline void resume(void* handle_address);
 
 	private:
 
-		_thread_iterator_Ty m_begin;
-		_thread_iterator_Ty m_end;
+		threads_Ty* m_threads_ptr;
 	};
 
-	class _thread_sq_id {
+	// _finish_awaiter
+
+	// resumes the awaiting coroutine once 'target' has finished, on a thread of 'threads' (or on the thread that completed
+	// 'target' if all queues are full), or on the thread that completed 'target' if 'threads_Ty' is void
+
+	template <class target_Ty, class threads_Ty> class _finish_awaiter
+	{
+
 	public:
-		using value_type = std::thread::id;
-		using pointer_type = const std::thread*;
-		static constexpr bool indirection_is_noexcept = true;
-		inline _thread_sq_id(pointer_type ptr) noexcept : m_ptr(ptr) {}
-	protected:
-		inline value_type indirection_impl() const noexcept { return m_ptr->get_id(); }
-		inline value_type indirection_impl(std::ptrdiff_t offset) const noexcept { return (m_ptr + offset)->get_id(); }
-		pointer_type m_ptr;
+
+		_finish_awaiter() = delete;
+		_finish_awaiter(target_Ty* target_ptr, threads_Ty* threads_ptr) noexcept : m_target_ptr(target_ptr), m_threads_ptr(threads_ptr) {}
+
+		inline bool await_ready() const noexcept;
+		inline bool await_suspend(std::coroutine_handle<> handle) noexcept;
+		inline void await_resume() const noexcept;
+
+	private:
+
+		static inline void on_finished(void* awaiter_ptr) noexcept;
+
+		target_Ty* m_target_ptr;
+		threads_Ty* m_threads_ptr;
+		std::coroutine_handle<> m_handle;
+		cool::_async_waiter m_waiter;
 	};
-	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _thread_mq_id {
+#endif // xCOOL_THREADS_COROUTINES
+
+
+	// async_end
+
+	// WARNNING : async_end object must outlive the completion of all function calls and notifications from
+	// try_async or try_priority_async with it as a target argument
+
+	class async_end
+	{
+
 	public:
-		using value_type = std::thread::id;
-		using pointer_type = const typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block*;
-		static constexpr bool indirection_is_noexcept = true;
-		inline _thread_mq_id(pointer_type ptr) noexcept : m_ptr(ptr) {}
-	protected:
-		inline value_type indirection_impl() const noexcept { return m_ptr->m_thread.get_id(); }
-		inline value_type indirection_impl(std::ptrdiff_t offset) const noexcept { return (m_ptr + offset)->m_thread.get_id(); }
-		pointer_type m_ptr;
+
+		async_end() = default;
+		async_end(const cool::async_end& rhs) = delete;
+		cool::async_end& operator=(const cool::async_end& rhs) = delete;
+		async_end(cool::async_end&& rhs) = delete;
+		cool::async_end& operator=(cool::async_end&& rhs) = delete;
+		~async_end() = default;
+
+		inline void add_awaited(std::size_t number_of_tasks) noexcept;
+		inline bool sub_awaited(std::size_t number_of_tasks) noexcept; // returns true iff notified
+		inline bool set_awaited(std::ptrdiff_t number_of_tasks) noexcept; // returns true iff notified
+		inline std::ptrdiff_t get_awaited() const noexcept;
+		inline bool decr_awaited() noexcept; // returns true iff notified
+		inline void notify() noexcept;
+		inline void finish(std::size_t spin_count = 0) noexcept; // 'spin_count' : number of checks before sleeping
+		inline bool finished() const noexcept;
+
+		inline cool::_async_end_incr_proxy try_incr_awaited() noexcept;
+
+		// 'finish(threads)' waits by running the tasks queued in 'threads' on the calling thread instead of sleeping, so that a task
+		// running on 'threads' can wait for the tasks it has queued itself without blocking its thread, which could otherwise leave
+		// the pool idle or deadlock it once enough threads wait, the calling thread sleeps as with 'finish()' once it has found no
+		// task in a while
+
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+		inline void finish(cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+		inline void finish(cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+		inline void finish(cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+		inline void finish(cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept;
+
+#ifdef xCOOL_THREADS_COROUTINES
+		// 'co_await' on an async_end suspends the coroutine until it has finished and resumes it on the thread that completed it,
+		// use 'resume_after' of threads_sq / threads_mq to resume on a thread of the pool instead
+
+		inline cool::_finish_awaiter<cool::async_end, void> operator co_await() noexcept;
+#endif // xCOOL_THREADS_COROUTINES
+
+		// 'safety_refresh' produces a spurious wake up of all the potential waits on a condition and should only
+		// be called for safety (possibly cyclically although not in a high frequency loop) if async_end could be suspected of deadlocks
+
+		inline void safety_refresh() noexcept;
+
+	private:
+
+		inline bool add_waiter(cool::_async_waiter* waiter_ptr) noexcept; // returns false if already finished
+
+		cool::_async_completion m_completion;
+		std::atomic<bool> m_cancelled{ false };
+
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_sq;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_mq;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_ws;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_lq;
+		friend class cool::_threads_base;
+		template <class threads_Ty, std::size_t _max_predecessor_count> friend class cool::async_node;
+#ifdef xCOOL_THREADS_COROUTINES
+		template <class target_Ty, class threads_Ty> friend class cool::_finish_awaiter;
+#endif // xCOOL_THREADS_COROUTINES
+		friend class cool::cancel_token;
 	};
-#ifdef COOL_THREADS_NATIVE_HANDLE
-	class _thread_sq_native_handle {
+
+
+	// cancel_token
+
+	// a cancel_token is an async_end that can be passed as a target wherever an async_end can (including 'try_incr_awaited',
+	// 'async_batch' and 'async_at' / 'async_after'), once 'cancel' has been called the tasks queued with it as a target that
+	// have not started yet are dropped when dequeued : their function is not called but their arguments are still destroyed
+	// and the awaited counter is still decremented, so that 'finish' returns as soon as the queues have been drained of them
+
+	// 'cancel' does not interrupt tasks already running, which may poll 'cancelled' to return early, 'reset' allows the object
+	// to be reused for new tasks and must not be called while tasks queued before the cancellation are still pending
+
+	// WARNNING : cancel_token object must outlive the completion of all function calls and notifications from
+	// try_async or try_priority_async with it as a target argument
+
+	class cancel_token : public cool::async_end
+	{
+
 	public:
-		using value_type = std::thread::native_handle_type;
-		using pointer_type = std::thread*;
-		static constexpr bool indirection_is_noexcept = false;
-		inline _thread_sq_native_handle(pointer_type ptr) noexcept : m_ptr(ptr) {}
-	protected:
-		inline value_type indirection_impl() const { return m_ptr->native_handle(); }
-		inline value_type indirection_impl(std::ptrdiff_t offset) const { return (m_ptr + offset)->native_handle(); }
-		pointer_type m_ptr;
+
+		cancel_token() = default;
+		cancel_token(const cool::cancel_token& rhs) = delete;
+		cool::cancel_token& operator=(const cool::cancel_token& rhs) = delete;
+		cancel_token(cool::cancel_token&& rhs) = delete;
+		cool::cancel_token& operator=(cool::cancel_token&& rhs) = delete;
+		~cancel_token() = default;
+
+		inline void cancel() noexcept;
+		inline bool cancelled() const noexcept;
+		inline void reset() noexcept;
 	};
-	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _thread_mq_native_handle {
+
+
+	// async_result
+
+	// WARNNING : async_result object must outlive the completion of all function calls and notifications from
+	// try_async or try_priority_async with it as a target argument
+
+	template <class return_Ty> class async_result
+	{
+
 	public:
-		using value_type = std::thread::native_handle_type;
-		using pointer_type = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block*;
-		static constexpr bool indirection_is_noexcept = false;
-		inline _thread_mq_native_handle(pointer_type ptr) noexcept : m_ptr(ptr) {}
-	protected:
-		inline value_type indirection_impl() const { return m_ptr->m_thread.native_handle(); }
-		inline value_type indirection_impl(std::ptrdiff_t offset) const { return (m_ptr + offset)->m_thread.native_handle(); }
-		pointer_type m_ptr;
-	};
-#endif // COOL_THREADS_NATIVE_HANDLE
-}
 
+		using value_type = return_Ty;
+		using pointer = return_Ty*;
+		using const_pointer = const return_Ty*;
+		using reference = return_Ty&;
+		using const_reference = const return_Ty&;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
 
-// init types detail
+		async_result() = default;
+		async_result(const cool::async_result<return_Ty>& rhs) = delete;
+		cool::async_result<return_Ty>& operator=(const cool::async_result<return_Ty>& rhs) = delete;
+		async_result(cool::async_result<return_Ty>&& rhs) = delete;
+		cool::async_result<return_Ty>& operator=(cool::async_result<return_Ty>&& rhs) = delete;
+		~async_result() = default;
 
-inline constexpr cool::thread_count::thread_count(std::uint16_t new_thread_count) noexcept : m_value(new_thread_count) {}
-inline constexpr std::uint16_t cool::thread_count::value() const noexcept { return m_value; }
+		explicit inline async_result(return_Ty* storage_ptr) noexcept;
 
-inline constexpr cool::task_buffer_size::task_buffer_size(std::size_t new_task_buffer_size) noexcept : m_value(new_task_buffer_size) {}
-inline constexpr std::size_t cool::task_buffer_size::value() const noexcept { return m_value; }
+		inline void add_awaited(std::size_t number_of_tasks) noexcept;
+		inline bool sub_awaited(std::size_t number_of_tasks) noexcept; // returns true iff notified
+		inline bool set_awaited(std::ptrdiff_t number_of_tasks) noexcept; // returns true iff notified
+		inline std::ptrdiff_t get_awaited() const noexcept;
+		inline cool::_async_result_to_proxy<return_Ty> to(std::size_t offset) noexcept;
+		inline bool decr_awaited() noexcept; // returns true iff notified
+		inline void notify() noexcept;
+		inline void finish(std::size_t spin_count = 0) noexcept; // 'spin_count' : number of checks before sleeping
+		inline bool finished() const noexcept;
 
-inline constexpr cool::try_pop_count::try_pop_count(unsigned int new_try_pop_count) noexcept : m_value(new_try_pop_count) {}
-inline constexpr unsigned int cool::try_pop_count::value() const noexcept { return m_value; }
+		// 'finish(threads)' waits by running the tasks queued in 'threads' on the calling thread instead of sleeping, so that a task
+		// running on 'threads' can wait for the tasks it has queued itself without blocking its thread, which could otherwise leave
+		// the pool idle or deadlock it once enough threads wait, the calling thread sleeps as with 'finish()' once it has found no
+		// task in a while
 
-inline constexpr cool::dispatch_interval::dispatch_interval(std::uint16_t new_dispatch_interval) noexcept : m_value(new_dispatch_interval) {}
-inline constexpr std::uint16_t cool::dispatch_interval::value() const noexcept { return m_value; }
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+		inline void finish(cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+		inline void finish(cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+		inline void finish(cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+		inline void finish(cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept;
 
+#ifdef xCOOL_THREADS_COROUTINES
+		// 'co_await' on an async_result suspends the coroutine until it has finished and resumes it on the thread that completed it,
+		// use 'resume_after' of threads_sq / threads_mq to resume on a thread of the pool instead
 
-// threads_sq detail
+		inline cool::_finish_awaiter<cool::async_result<return_Ty>, void> operator co_await() noexcept;
+#endif // xCOOL_THREADS_COROUTINES
+
+#ifndef COOL_THREADS_NO_EXCEPTIONS
+		// 'capture_exceptions(true)' makes the tasks that target the async_result keep the std::exception they throw instead of reporting
+		// it to threads_exception_handler, the value at the offset of a task that threw is left untouched, 'has_exception' / 'get_exception'
+		// / 'rethrow_exception' give access to the first exception captured since the last 'clear_exceptions' and should only be called
+		// once 'finish' has returned, if 'exception_storage_ptr' is not null every exception is also stored at the offset of its task in
+		// the array pointed to, which must be as large as the value storage
+		// capturing costs nothing to the tasks that do not throw
+
+		inline void capture_exceptions(bool enable, std::exception_ptr* exception_storage_ptr = nullptr) noexcept;
+		inline bool has_exception() const noexcept;
+		inline std::exception_ptr get_exception() const noexcept;
+		inline void rethrow_exception() const; // rethrows the first exception captured if any
+		inline void clear_exceptions() noexcept;
+#endif // COOL_THREADS_NO_EXCEPTIONS
+
+		inline return_Ty& get(std::size_t offset) noexcept;
+		inline return_Ty& get_unchecked(std::size_t offset) noexcept;
+		inline const return_Ty& get_unchecked(std::size_t offset) const noexcept;
+		inline void reset(std::size_t count);
+		inline void reset(std::size_t count, const return_Ty& rhs);
+		inline void reset_unchecked(std::size_t count);
+		inline void reset_unchecked(std::size_t count, const return_Ty& rhs);
+
+		inline return_Ty* data() noexcept;
+		inline const return_Ty* data() const noexcept;
+
+		inline void set_data(return_Ty* storage_ptr) noexcept;
+		inline void set_data_unchecked(return_Ty* storage_ptr) noexcept;
+		inline void clear() noexcept;
+		inline void clear_unchecked() noexcept;
+
+		// 'safety_refresh' produces a spurious wake up of all the potential waits on a condition and should only
+		// be called for safety (possibly cyclically although not in a high frequency loop) if async_result could be suspected of deadlocks
+
+		inline void safety_refresh() noexcept;
+
+	private:
+
+		inline bool add_waiter(cool::_async_waiter* waiter_ptr) noexcept; // returns false if already finished
+		inline bool capture_exception(std::size_t offset) noexcept; // must be called from a catch block, returns false if not capturing
+
+		return_Ty* m_stored_values_ptr = nullptr;
+		cool::_async_completion m_completion;
+#ifndef COOL_THREADS_NO_EXCEPTIONS
+		std::exception_ptr* m_exceptions_ptr = nullptr;
+		std::exception_ptr m_first_exception;
+		std::atomic<bool> m_exception_captured{ false };
+		bool m_capture_exceptions = false;
+#endif // COOL_THREADS_NO_EXCEPTIONS
+
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_sq;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_mq;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_ws;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_lq;
+		friend class cool::_threads_base;
+		template <class return_Ty2> friend class cool::_async_result_to_proxy;
+		template <class threads_Ty, std::size_t _max_predecessor_count> friend class cool::async_node;
+#ifdef xCOOL_THREADS_COROUTINES
+		template <class target_Ty, class threads_Ty> friend class cool::_finish_awaiter;
+#endif // xCOOL_THREADS_COROUTINES
+	};
+
+	template <class return_Ty> class _async_result_to_proxy
+	{
+
+	public:
+
+		_async_result_to_proxy() = delete;
+		_async_result_to_proxy(const cool::_async_result_to_proxy<return_Ty>&) = delete;
+		cool::_async_result_to_proxy<return_Ty>& operator=(const cool::_async_result_to_proxy<return_Ty>&) = delete;
+		_async_result_to_proxy(cool::_async_result_to_proxy<return_Ty>&&) noexcept = default;
+		cool::_async_result_to_proxy<return_Ty>& operator=(cool::_async_result_to_proxy<return_Ty>&&) noexcept = default;
+		~_async_result_to_proxy() = default;
+
+		inline cool::_async_result_incr_proxy<return_Ty> try_incr_awaited() noexcept;
+
+	private:
+
+		inline _async_result_to_proxy(cool::async_result<return_Ty>* target_ptr, std::size_t offset) noexcept : m_parent_ptr(target_ptr), m_offset(offset) {}
+
+		cool::async_result<return_Ty>* m_parent_ptr;
+		std::size_t m_offset;
+
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_sq;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_mq;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_ws;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_lq;
+		friend class cool::_threads_base;
+		template <class return_Ty2> friend class cool::async_result;
+	};
+
+
+	// safety_refresh_proxy
+
+	class safety_refresh_proxy
+	{
+
+	public:
+
+		safety_refresh_proxy() = delete;
+		safety_refresh_proxy(const cool::safety_refresh_proxy&) noexcept = default;
+		cool::safety_refresh_proxy& operator=(const cool::safety_refresh_proxy&) noexcept = default;
+		safety_refresh_proxy(cool::safety_refresh_proxy&&) noexcept = default;
+		cool::safety_refresh_proxy& operator=(cool::safety_refresh_proxy&&) noexcept = default;
+		~safety_refresh_proxy() = default;
+
+		inline void safety_refresh() const noexcept;
+
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+		explicit inline safety_refresh_proxy(cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& rhs) noexcept;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+		explicit inline safety_refresh_proxy(cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& rhs) noexcept;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+		explicit inline safety_refresh_proxy(cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& rhs) noexcept;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+		explicit inline safety_refresh_proxy(cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& rhs) noexcept;
+		explicit inline safety_refresh_proxy(cool::async_end& rhs) noexcept;
+		template <class return_Ty> explicit inline safety_refresh_proxy(cool::async_result<return_Ty>& rhs) noexcept;
+
+		inline bool operator==(const cool::safety_refresh_proxy& rhs) const noexcept;
+		inline bool operator!=(const cool::safety_refresh_proxy& rhs) const noexcept;
+		inline bool operator<=(const cool::safety_refresh_proxy& rhs) const noexcept;
+		inline bool operator>=(const cool::safety_refresh_proxy& rhs) const noexcept;
+		inline bool operator<(const cool::safety_refresh_proxy & rhs) const noexcept;
+		inline bool operator>(const cool::safety_refresh_proxy& rhs) const noexcept;
+
+		inline bool operator==(const void* rhs_ptr) const noexcept;
+		inline bool operator!=(const void* rhs_ptr) const noexcept;
+		inline bool operator<=(const void* rhs_ptr) const noexcept;
+		inline bool operator>=(const void* rhs_ptr) const noexcept;
+		inline bool operator<(const void* rhs_ptr) const noexcept;
+		inline bool operator>(const void* rhs_ptr) const noexcept;
+
+	private:
+
+		void(*m_callable)(void*);
+		void* m_object_ptr;
+	};
+
+	inline bool operator==(const void* lhs_ptr, const cool::safety_refresh_proxy& rhs) noexcept;
+	inline bool operator!=(const void* lhs_ptr, const cool::safety_refresh_proxy& rhs) noexcept;
+	inline bool operator<=(const void* lhs_ptr, const cool::safety_refresh_proxy& rhs) noexcept;
+	inline bool operator>=(const void* lhs_ptr, const cool::safety_refresh_proxy& rhs) noexcept;
+	inline bool operator<(const void* lhs_ptr, const cool::safety_refresh_proxy& rhs) noexcept;
+	inline bool operator>(const void* lhs_ptr, const cool::safety_refresh_proxy& rhs) noexcept;
+}
+
+
+namespace cool
+{
+	// _threads_base
+
+	class _threads_base
+	{
+
+	private:
+
+		friend class cool::threads_exception_handler;
+		friend class cool::_async_completion;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> friend class cool::_threads_sq_data;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_sq;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> friend class cool::_threads_mq_data;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_mq;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> friend class cool::_threads_ws_data;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> friend class cool::_threads_lq_data;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_ws;
+		template <class threads_Ty, std::size_t _max_predecessor_count> friend class cool::async_node;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_lq;
+
+		template <std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _base_task {
+		private:
+			static constexpr std::size_t _arg_buffer_size_padded = (_arg_buffer_size != 0) ? _arg_buffer_size : 1;
+		public:
+			class _address {
+			public:
+				void(*m_callable)(_base_task<_arg_buffer_size, _arg_buffer_align>*, _base_task<_arg_buffer_size, _arg_buffer_align>*);
+				void(*m_function_ptr)(void);
+			};
+			class _address_with_target : public _address {
+			public:
+				void* m_target_ptr;
+			};
+			class _address_with_target_and_offset : public _address_with_target {
+			public:
+				std::size_t m_offset;
+			};
+			
+			static constexpr std::size_t arg_buffer_size = _arg_buffer_size;
+			static constexpr std::size_t arg_buffer_align = _arg_buffer_align;
+			static constexpr std::size_t address_size = sizeof(_address);
+			static constexpr std::size_t address_with_target_size = sizeof(_address_with_target);
+			static constexpr std::size_t address_with_target_and_offset_size = sizeof(_address_with_target_and_offset);
+
+			alignas(_arg_buffer_align) unsigned char m_arg_buffer[_arg_buffer_size_padded];
+			_address_with_target_and_offset m_address_data;
+		};
+
+		template <std::size_t ... _indices> class indices {};
+		template <std::size_t n, std::size_t ... _indices> class build_indices : public build_indices<n - 1, n - 1, _indices...> {};
+		template <std::size_t ... _indices> class build_indices<0, _indices...> : public indices<_indices...> {};
+
+		template <class function_Ty, class tuple_Ty, std::size_t ... _indices>
+		static inline auto call(function_Ty task, tuple_Ty&& args, indices<_indices...>) -> decltype(task(std::get<_indices>(std::forward<tuple_Ty>(args))...)) {
+			return std::move(task(std::get<_indices>(std::forward<tuple_Ty>(args))...));
+		}
+		template <class function_Ty, class tuple_Ty>
+		static inline auto call(function_Ty task, tuple_Ty&& args) -> decltype(call(task, args, build_indices<std::tuple_size<tuple_Ty>::value>())) {
+			return std::move(call(task, std::move(args), build_indices<std::tuple_size<tuple_Ty>::value>()));
+		}
+		template <class function_Ty, class tuple_Ty, std::size_t ... _indices>
+		static inline void call_no_return(function_Ty task, tuple_Ty&& args, indices<_indices...>) {
+			task(std::get<_indices>(std::forward<tuple_Ty>(args))...);
+		}
+		template <class function_Ty, class tuple_Ty>
+		static inline void call_no_return(function_Ty task, tuple_Ty&& args) {
+			call_no_return(task, std::move(args), build_indices<std::tuple_size<tuple_Ty>::value>());
+		}
+
+		// '_parking_word' parks threads until 'wake' moves its epoch past the value they read beforehand : on a futex on linux,
+		// with C++20 std::atomic::wait elsewhere if available, and otherwise on a condition variable, as async_end / async_result
+
+		class _parking_word {
+		public:
+			_parking_word() = default;
+			_parking_word(const _parking_word&) = delete;
+			_parking_word& operator=(const _parking_word&) = delete;
+			_parking_word(_parking_word&&) = delete;
+			_parking_word& operator=(_parking_word&&) = delete;
+
+			inline std::uint32_t epoch() const noexcept { return m_epoch.load(std::memory_order_acquire); }
+			inline void wait(std::uint32_t epoch) noexcept; // returns once the epoch differs from 'epoch', or spuriously
+			inline void wake(bool all) noexcept;
+
+		private:
+			std::atomic<std::uint32_t> m_epoch{ 0 };
+#if !defined(xCOOL_THREADS_FUTEX) && !defined(xCOOL_THREADS_ATOMIC_WAIT)
+			std::mutex m_mutex;
+			std::condition_variable m_condition_var;
+#endif // !defined(xCOOL_THREADS_FUTEX) && !defined(xCOOL_THREADS_ATOMIC_WAIT)
+		};
+
+		// '_arg_slab' recycles the storage of the argument packs that do not fit in a task slot, 'allocate' must only be called
+		// by the owner of the slab (under the lock of its queue) whereas 'deallocate' can be called from any thread
+
+		class _arg_slab {
+		public:
+			static constexpr std::size_t class_count = 8;
+			static constexpr std::size_t min_class_size = 64;
+
+			_arg_slab() = default;
+			_arg_slab(const _arg_slab&) = delete;
+			_arg_slab& operator=(const _arg_slab&) = delete;
+			_arg_slab(_arg_slab&&) = delete;
+			_arg_slab& operator=(_arg_slab&&) = delete;
+			inline ~_arg_slab() { release(); }
+
+			inline void* allocate(std::size_t size) noexcept; // returns nullptr on failure
+			static inline void deallocate(void* ptr) noexcept;
+			inline void release() noexcept; // must not be called while packs allocated by the slab are alive
+
+		private:
+			class alignas(alignof(std::max_align_t)) _chunk_header {
+			public:
+				_arg_slab* m_slab_ptr; // nullptr if the chunk is too large for any size class
+				_chunk_header* m_next_ptr;
+				std::size_t m_class;
+			};
+
+			_chunk_header* m_free[class_count] = {};
+			std::atomic<_chunk_header*> m_returned[class_count] = {};
+		};
+
+		// '_spilled_pack' takes the place of an argument pack in a task slot and owns the pack built in 'storage_ptr', which is
+		// allocated in a '_arg_slab'
+
+		template <class tuple_Ty> class _spilled_pack {
+		public:
+			template <class ... arg_Ty> inline _spilled_pack(void* storage_ptr, arg_Ty&& ... args);
+			inline _spilled_pack(_spilled_pack<tuple_Ty>&& rhs) noexcept : m_ptr(rhs.m_ptr) { rhs.m_ptr = nullptr; }
+			_spilled_pack(const _spilled_pack<tuple_Ty>&) = delete;
+			_spilled_pack<tuple_Ty>& operator=(const _spilled_pack<tuple_Ty>&) = delete;
+			_spilled_pack<tuple_Ty>& operator=(_spilled_pack<tuple_Ty>&&) = delete;
+			inline ~_spilled_pack();
+
+			tuple_Ty* m_ptr;
+		};
+
+		// '_arg_pack<...>::type' is the type stored in a task slot : the argument pack itself if it fits or if the static check is enabled,
+		// a '_spilled_pack' otherwise (over-aligned packs and slots too small for a pointer are not spilled)
+
+		template <class tuple_Ty, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> class _arg_pack {
+		private:
+			static constexpr bool fits = (sizeof(tuple_Ty) <= _arg_buffer_size) && (alignof(tuple_Ty) <= _arg_buffer_align);
+			static constexpr bool can_spill = (sizeof(_spilled_pack<tuple_Ty>) <= _arg_buffer_size) && (alignof(tuple_Ty) <= alignof(std::max_align_t));
+		public:
+			using type = typename std::conditional<fits || _arg_type_static_check || !can_spill, tuple_Ty, _spilled_pack<tuple_Ty>>::type;
+		};
+
+		// 'construct_pack' returns false if the storage of a spilled pack cannot be allocated, the arguments are then left untouched
+		// and the slot empty so that the caller can give up on the slot as if the queue was full
+
+		template <class pack_Ty> class _pack_builder {
+		public:
+			template <class ... arg_Ty> static inline bool construct(void* buffer_ptr, _arg_slab*, arg_Ty&& ... args) {
+				new (buffer_ptr) pack_Ty(std::forward<arg_Ty>(args)...);
+				return true;
+			}
+		};
+		template <class tuple_Ty> class _pack_builder<_spilled_pack<tuple_Ty>> {
+		public:
+			template <class ... arg_Ty> static inline bool construct(void* buffer_ptr, _arg_slab* slab_ptr, arg_Ty&& ... args) {
+				void* storage_ptr = slab_ptr->allocate(sizeof(tuple_Ty));
+				if (storage_ptr == nullptr) {
+					return false;
+				}
+				new (buffer_ptr) _spilled_pack<tuple_Ty>(storage_ptr, std::forward<arg_Ty>(args)...);
+				return true;
+			}
+		};
+
+		template <class pack_Ty, class ... arg_Ty>
+		static inline bool construct_pack(unsigned char* buffer_ptr, _arg_slab* slab_ptr, arg_Ty&& ... args) {
+			return _pack_builder<pack_Ty>::construct(static_cast<void*>(buffer_ptr), slab_ptr, std::forward<arg_Ty>(args)...);
+		}
+
+		template <class function_Ty, class tuple_Ty>
+		static inline auto call(function_Ty task, _spilled_pack<tuple_Ty>&& args) -> decltype(call(task, std::move(*args.m_ptr))) {
+			return std::move(call(task, std::move(*args.m_ptr)));
+		}
+		template <class function_Ty, class tuple_Ty>
+		static inline void call_no_return(function_Ty task, _spilled_pack<tuple_Ty>&& args) {
+			call_no_return(task, std::move(*args.m_ptr));
+		}
+
+		template <class pack_Ty> static inline pack_Ty& stored_pack(pack_Ty& pack) noexcept { return pack; }
+		template <class tuple_Ty> static inline tuple_Ty& stored_pack(_spilled_pack<tuple_Ty>& pack) noexcept { return *pack.m_ptr; }
+
+		// '_functor_pack' stores a callable object in a task slot along with its arguments
+
+		template <class function_Ty, class tuple_Ty> class _functor_pack {
+		public:
+			template <class ... arg_Ty> inline _functor_pack(function_Ty task, arg_Ty&& ... args)
+				: m_task(std::move(task)), m_args(std::forward<arg_Ty>(args)...) {}
+
+			function_Ty m_task;
+			tuple_Ty m_args;
+		};
+
+		// '_task_traits<function_Ty>' abstracts how a task is stored and called : a function pointer is stored in 'm_function_ptr'
+		// whereas a callable object is moved in the task slot with '_functor_pack' and leaves 'm_function_ptr' null
+
+		template <class function_Ty, bool _is_function_ptr = std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value>
+		class _task_traits {
+		public:
+			static constexpr bool valid = true;
+
+			template <class tuple_Ty> using pack = tuple_Ty;
+
+			static inline void(*address(const function_Ty& task) noexcept)(void) {
+				void(*ret)(void);
+				std::memcpy(&ret, &task, sizeof(void(*)(void)));
+				return ret;
+			}
+			template <class pack_Ty, class ... arg_Ty>
+			static inline bool construct(unsigned char* buffer_ptr, cool::_threads_base::_arg_slab* slab_ptr, function_Ty, arg_Ty&& ... args) {
+				return cool::_threads_base::construct_pack<pack_Ty>(buffer_ptr, slab_ptr, std::forward<arg_Ty>(args)...);
+			}
+			template <class pack_Ty>
+			static inline auto call(void(*function_address)(void), pack_Ty&& pack) -> decltype(cool::_threads_base::call(std::declval<function_Ty>(), std::forward<pack_Ty>(pack))) {
+				function_Ty function_ptr;
+				std::memcpy(&function_ptr, &function_address, sizeof(void(*)(void)));
+				return std::move(cool::_threads_base::call(function_ptr, std::forward<pack_Ty>(pack)));
+			}
+			template <class pack_Ty>
+			static inline void call_no_return(void(*function_address)(void), pack_Ty&& pack) {
+				function_Ty function_ptr;
+				std::memcpy(&function_ptr, &function_address, sizeof(void(*)(void)));
+				cool::_threads_base::call_no_return(function_ptr, std::forward<pack_Ty>(pack));
+			}
+		};
+		template <class function_Ty> class _task_traits<function_Ty, false> {
+		public:
+			static constexpr bool valid = std::is_class<function_Ty>::value && std::is_nothrow_move_constructible<function_Ty>::value;
+
+			template <class tuple_Ty> using pack = cool::_threads_base::_functor_pack<function_Ty, tuple_Ty>;
+
+			static inline void(*address(const function_Ty&) noexcept)(void) {
+				return nullptr;
+			}
+			template <class pack_Ty, class ... arg_Ty>
+			static inline bool construct(unsigned char* buffer_ptr, cool::_threads_base::_arg_slab* slab_ptr, function_Ty task, arg_Ty&& ... args) {
+				return cool::_threads_base::construct_pack<pack_Ty>(buffer_ptr, slab_ptr, std::move(task), std::forward<arg_Ty>(args)...);
+			}
+			template <class pack_Ty>
+			static inline auto call(void(*)(void), pack_Ty&& pack)
+				-> decltype(cool::_threads_base::call(std::ref(cool::_threads_base::stored_pack(pack).m_task), std::move(cool::_threads_base::stored_pack(pack).m_args))) {
+				auto& functor_pack = cool::_threads_base::stored_pack(pack);
+				return std::move(cool::_threads_base::call(std::ref(functor_pack.m_task), std::move(functor_pack.m_args)));
+			}
+			template <class pack_Ty>
+			static inline void call_no_return(void(*)(void), pack_Ty&& pack) {
+				auto& functor_pack = cool::_threads_base::stored_pack(pack);
+				cool::_threads_base::call_no_return(std::ref(functor_pack.m_task), std::move(functor_pack.m_args));
+			}
+		};
+
+		// '_task_callable<task_Ty, function_Ty, pack_Ty>' provides the 'm_callable' of the tasks of all pools for each kind of target :
+		// a null 'fetch_task_ptr' runs the task in 'task_ptr', otherwise the task is moved from 'fetch_task_ptr' to 'task_ptr'
+
+		template <class task_Ty, class function_Ty, class pack_Ty> class _task_callable {
+		public:
+			static inline void no_target(task_Ty* task_ptr, task_Ty* fetch_task_ptr);
+			static inline void async_end(task_Ty* task_ptr, task_Ty* fetch_task_ptr);
+			template <class return_Ty> static inline void async_result(task_Ty* task_ptr, task_Ty* fetch_task_ptr);
+		private:
+			static inline void move(task_Ty* task_ptr, task_Ty* fetch_task_ptr, std::size_t address_size) noexcept;
+		};
+
+		// '_task_fill<...>' is the 'fill' built by the 'async' / 'try_async' functions of all pools and given to their push functions,
+		// 'fill(task_ptr, arg_slab_ptr)' builds the task in the slot 'task_ptr' and registers it on its target, the argument pack is
+		// spilled in 'arg_slab_ptr' if it does not fit and '_spill' is true (threads_lq and threads_ws have no slab), 'fill' returns
+		// false and leaves the slot and the target untouched if the spilled pack cannot be allocated, which never happens without '_spill'
+
+		template <class task_Ty, bool _arg_type_static_check, bool _spill, class target_Ty, class function_Ty, class ... arg_Ty> class _task_fill {
+		public:
+			using tuple_type = typename _task_traits<function_Ty>::template pack<std::tuple<typename std::decay<arg_Ty>::type ...>>;
+			using pack_type = typename std::conditional<_spill,
+				typename _arg_pack<tuple_type, task_Ty::arg_buffer_size, task_Ty::arg_buffer_align, _arg_type_static_check>::type, tuple_type>::type;
+
+			static_assert(_task_traits<function_Ty>::valid, "cool::threads<...>::async : task must be a function pointer or a nothrow move constructible callable");
+			static_assert((sizeof(pack_type) <= task_Ty::arg_buffer_size) || !_arg_type_static_check, "cool::threads<...>::async : task arguments size too large");
+			static_assert((alignof(pack_type) <= alignof(task_Ty)) || !_arg_type_static_check, "cool::threads<...>::async : task arguments alignment too large");
+
+			inline _task_fill(target_Ty target, function_Ty& task, arg_Ty&& ... args) noexcept;
+			inline bool operator()(task_Ty* task_ptr, _arg_slab* arg_slab_ptr);
+		private:
+			template <std::size_t ... _indices> inline bool construct(task_Ty* task_ptr, _arg_slab* arg_slab_ptr, indices<_indices...>);
+			static inline void set_target(task_Ty* task_ptr, cool::no_target_t) noexcept;
+			static inline void set_target(task_Ty* task_ptr, cool::async_end& target) noexcept;
+			static inline void set_target(task_Ty* task_ptr, cool::_async_end_incr_proxy& target) noexcept;
+			template <class return_Ty> static inline void set_target(task_Ty* task_ptr, cool::_async_result_to_proxy<return_Ty>& target) noexcept;
+			template <class return_Ty> static inline void set_target(task_Ty* task_ptr, cool::_async_result_incr_proxy<return_Ty>& target) noexcept;
+
+			target_Ty m_target;
+			function_Ty& m_task;
+			std::tuple<arg_Ty&& ...> m_args;
+		};
+
+		class exception_handler {
+		public:
+			inline exception_handler(void(*_function)(const std::exception&, void(*)(void), std::thread::id, void*), void* _arg_ptr) noexcept
+				: m_function(_function), m_arg_ptr(_arg_ptr) {};
+			void(*m_function)(const std::exception&, void(*)(void), std::thread::id, void*) = nullptr;
+			void* m_arg_ptr = nullptr;
+		};
+
+		static inline std::atomic<exception_handler>& get_exception_handler() noexcept {
+			static std::atomic<exception_handler> handler{ exception_handler{ nullptr, nullptr } };
+			return handler;
+		}
+		static inline void catch_exception(const std::exception& excep, void(*task_function_ptr)(void)) noexcept {
+			exception_handler handler = get_exception_handler().load(std::memory_order_seq_cst);
+			if (handler.m_function != nullptr) {
+				handler.m_function(excep, task_function_ptr, std::this_thread::get_id(), handler.m_arg_ptr);
+			}
+		}
+
+		// 'affinity_plan' writes the cpu of each thread in 'cpus', or -1 if the thread must not be pinned
+
+		static inline void affinity_plan(const cool::thread_affinity& affinity, int* cpus, std::size_t thread_count) noexcept;
+		static inline void pin_this_thread(int cpu) noexcept;
+		static inline int this_thread_numa_node() noexcept;
+
+		// state of an elastic pool (see 'cool::elastic_policy'), 'm_mutex' serializes thread starts and 'set_active_thread_count'
+
+		class _elastic_control {
+		public:
+			inline bool enabled() const noexcept { return m_min_thread_count != 0; }
+			inline bool try_retire(std::size_t floor) noexcept { // lowers 'm_active_thread_count' by one if it is above 'floor'
+				std::size_t active_thread_count = m_active_thread_count.load(std::memory_order_relaxed);
+				while (active_thread_count > floor) {
+					if (m_active_thread_count.compare_exchange_weak(active_thread_count, active_thread_count - 1, std::memory_order_relaxed, std::memory_order_relaxed)) {
+						return true;
+					}
+				}
+				return false;
+			}
+			std::size_t m_min_thread_count = 0; // 0 : not elastic
+			std::size_t m_grow_queue_depth = 0;
+			unsigned int m_idle_timeout_ms = 0;
+			bool m_closed = false; // under 'm_mutex', set by 'delete_threads' so that no thread is started past that point
+			std::atomic<std::size_t> m_active_thread_count{ 0 };
+			std::mutex m_mutex;
+		};
+
+		// '_timer_wheel' keeps the tasks of 'async_at' / 'async_after' in preallocated timers until their deadline, a timer is filed
+		// in one of the 64 slots of the level of the highest group of 6 bits where its deadline tick differs from the current tick,
+		// so that scheduling is O(1) and a timer is moved down at most 'level_count' times before it is due, everything but
+		// the atomics is used under 'm_mutex', threads check 'm_next_deadline_ns' without locking and one idle thread at a time
+		// (the keeper) parks until it instead of parking for good
+
+		template <class task_Ty> class _timer_wheel {
+		public:
+			static constexpr unsigned int level_count = 10;
+			static constexpr unsigned int slot_bit_count = 6;
+			static constexpr std::size_t slot_count = static_cast<std::size_t>(1) << slot_bit_count;
+			static constexpr std::int64_t no_deadline = (std::numeric_limits<std::int64_t>::max)();
+
+			class _timer {
+			public:
+				task_Ty m_task;
+				std::uint64_t m_deadline_tick;
+				_timer* m_next_ptr;
+			};
+
+			_timer_wheel() = default;
+			_timer_wheel(const _timer_wheel&) = delete;
+			_timer_wheel& operator=(const _timer_wheel&) = delete;
+			_timer_wheel(_timer_wheel&&) = delete;
+			_timer_wheel& operator=(_timer_wheel&&) = delete;
+			inline ~_timer_wheel() { delete_timers(); }
+
+			inline bool new_timers(std::size_t new_capacity, std::int64_t new_resolution_ns) noexcept; // returns false on failure
+			inline void delete_timers() noexcept; // all timers must have been expired and released beforehand
+			inline bool enabled() const noexcept { return m_capacity != 0; }
+			inline std::size_t capacity() const noexcept { return m_capacity; }
+			inline unsigned int resolution_us() const noexcept { return static_cast<unsigned int>(m_resolution_ns / 1000); }
+
+			static inline std::int64_t now_ns() noexcept { // time base of the deadlines
+				return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+			}
+			static inline std::chrono::steady_clock::time_point wake_time(std::int64_t deadline_ns) noexcept {
+				return std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(deadline_ns)));
+			}
+			template <class clock_Ty> static inline std::int64_t deadline_ns(cool::time_point<clock_Ty> deadline) noexcept {
+				std::int64_t current_ns = now_ns();
+				std::int64_t remaining_ns = (deadline - cool::time_point<clock_Ty>(cool::now)).template get<std::int64_t>(cool::duration_unit::ns);
+				return (remaining_ns < no_deadline - current_ns) ? current_ns + remaining_ns : no_deadline;
+			}
+
+			// 'acquire' returns nullptr if all timers are pending, 'schedule' files an acquired timer once its task is filled,
+			// 'expire' returns the list of the timers due at 'current_ns' which must each be given back with 'release' after
+			// their task has been moved out, or with 'postpone' to be returned again by the next 'expire'
+
+			inline _timer* acquire() noexcept;
+			inline bool schedule(_timer* timer_ptr, std::int64_t deadline_ns) noexcept; // true if 'm_next_deadline_ns' has moved earlier
+			inline _timer* expire(std::int64_t current_ns) noexcept;
+			inline void release(_timer* timer_ptr) noexcept;
+			inline void postpone(_timer* timer_ptr) noexcept;
+
+			std::atomic<std::int64_t> m_next_deadline_ns{ no_deadline }; // 'expire' returns nothing before, may be early for a timer to be moved down
+			std::atomic<std::size_t> m_timer_count{ 0 }; // timers acquired
+			std::atomic<bool> m_keeper{ false }; // true while an idle thread parks until 'm_next_deadline_ns'
+			cool::_threads_base::_arg_slab m_arg_slab;
+			std::mutex m_mutex;
+
+		private:
+			inline void file(_timer* timer_ptr) noexcept;
+			inline bool next_event(unsigned int& level, std::size_t& slot, std::uint64_t& event_tick) const noexcept;
+			inline void update_next_deadline() noexcept;
+
+			_timer* m_slots[level_count][slot_count] = {};
+			std::uint64_t m_occupied[level_count] = {}; // bit k set if slot k of the level is not empty
+			std::uint64_t m_current_tick = 0;
+			_timer* m_due_ptr = nullptr;
+			_timer* m_free_ptr = nullptr;
+			_timer* m_timers_ptr = nullptr;
+			char* m_timers_unaligned_ptr = nullptr;
+			std::size_t m_capacity = 0;
+			std::int64_t m_epoch_ns = 0;
+			std::int64_t m_resolution_ns = 1;
+		};
+
+#ifdef COOL_THREADS_STATS
+		class _trace_event {
+		public:
+			std::int64_t m_start;
+			std::int64_t m_duration;
+			void(*m_function_ptr)(void);
+		};
+
+		// written by the thread owning the block only, except for 'reset'
+
+		template <std::size_t _cache_line_size> class alignas(_cache_line_size) _stats_block {
+		public:
+			inline void record_task(std::int64_t start, void(*function_ptr)(void)) noexcept;
+			inline void add_to(cool::threads_stats& stats) const noexcept;
+			inline void reset() noexcept;
+#ifdef COOL_THREADS_TRACE
+			template <class ostream_Ty> inline void write_chrome_trace(ostream_Ty& os, std::size_t thread_number, bool& first) const;
+#endif // COOL_THREADS_TRACE
+			std::atomic<std::size_t> m_tasks_executed{ 0 };
+			std::atomic<std::size_t> m_probe_hits{ 0 };
+			std::atomic<std::size_t> m_probe_misses{ 0 };
+#ifdef COOL_THREADS_STATS_HISTOGRAM
+			std::atomic<std::size_t> m_task_time_histogram[cool::threads_stats::histogram_size] = {};
+#endif // COOL_THREADS_STATS_HISTOGRAM
+#ifdef COOL_THREADS_TRACE
+			static_assert((COOL_THREADS_TRACE_SIZE != 0) && ((COOL_THREADS_TRACE_SIZE & (COOL_THREADS_TRACE_SIZE - 1)) == 0),
+				"COOL_THREADS_TRACE_SIZE requirement : must be a power of 2");
+			std::atomic<std::size_t> m_trace_count{ 0 };
+			_trace_event m_trace[COOL_THREADS_TRACE_SIZE];
+#endif // COOL_THREADS_TRACE
+		};
+
+		template <std::size_t _cache_line_size> class alignas(_cache_line_size) _submit_stats_block {
+		public:
+			std::atomic<std::size_t> m_try_async_failures{ 0 };
+			std::atomic<std::size_t> m_full_queue_retries{ 0 };
+		};
+
+		static inline std::int64_t stats_now() noexcept {
+#if defined(COOL_THREADS_STATS_HISTOGRAM) || defined(COOL_THREADS_TRACE)
+			return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#else // defined(COOL_THREADS_STATS_HISTOGRAM) || defined(COOL_THREADS_TRACE)
+			return 0;
+#endif // defined(COOL_THREADS_STATS_HISTOGRAM) || defined(COOL_THREADS_TRACE)
+		}
+#endif // COOL_THREADS_STATS
+
+		static inline void cpu_pause() noexcept {
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+			_mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+			__builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+			__asm__ __volatile__("yield");
+#else
+			std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+		}
+
+		class delete_thread_exception_handler {
+		public:
+			inline delete_thread_exception_handler(void(*_function)(const std::system_error&, std::thread::id, void*), void* _arg_ptr) noexcept
+				: m_function(_function), m_arg_ptr(_arg_ptr) {};
+			void(*m_function)(const std::system_error&, std::thread::id, void*) = nullptr;
+			void* m_arg_ptr = nullptr;
+		};
+
+		static inline std::atomic<delete_thread_exception_handler>& get_delete_thread_exception_handler() noexcept {
+			static std::atomic<delete_thread_exception_handler> handler{ delete_thread_exception_handler{ nullptr, nullptr } };
+			return handler;
+		}
+		static inline void catch_delete_thread_exception(const std::system_error& error, std::thread::id thread_id) noexcept {
+			delete_thread_exception_handler handler = get_delete_thread_exception_handler().load(std::memory_order_seq_cst);
+			if (handler.m_function != nullptr) {
+				handler.m_function(error, thread_id, handler.m_arg_ptr);
+			}
+		}
+	};
+
+	// _threads_sq_data
+
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+	class alignas(_cache_line_size) _threads_sq_data : public cool::_threads_base
+	{
+
+	private:
+
+		friend class cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, true>;
+		friend class cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, false>;
+
+		using _task = typename cool::_threads_base::_base_task<_arg_buffer_size, _arg_buffer_align>;
+
+		_threads_sq_data() = default;
+		_threads_sq_data(const cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&) = delete;
+		cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>& operator=(
+			const cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&) = delete;
+		_threads_sq_data(cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&&) = delete;
+		cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>& operator=(
+			cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&&) = delete;
+		~_threads_sq_data() = default;
+
+		inline void delete_threads_detail(std::size_t threads_constructed) noexcept;
+
+		// object running the calling thread, nullptr on other threads
+
+		static inline const void*& this_thread_owner() noexcept
+		{
+			static thread_local const void* owner_ptr = nullptr;
+			return owner_ptr;
+		}
+
+		_task* m_task_buffer_data_ptr = nullptr;
+		_task* m_task_buffer_end_ptr = nullptr;
+
+		_task* m_last_task_ptr = nullptr;
+		_task* m_next_task_ptr = nullptr;
+
+		bool m_stop_threads = true;
+		char* m_task_buffer_unaligned_data_ptr = nullptr;
+
+		std::thread* m_threads_data_ptr = nullptr;
+		std::size_t m_thread_count = 0;
+
+		cool::_threads_base::_arg_slab m_arg_slab; // used under 'm_mutex'
+
+		// 'lock' must own 'm_mutex', returns true if the thread retires, false with a task available, 'm_stop_threads' set,
+		// or with 'timer_due' set if the thread has kept the timers until a deadline
+
+		inline bool wait_for_task_timed(std::unique_lock<std::mutex>& lock, std::size_t thread_num, bool& timer_due);
+
+		int* m_thread_cpus_ptr = nullptr; // kept for the threads started later by an elastic pool
+		bool* m_thread_stopped_ptr = nullptr; // under 'm_mutex', true if the thread of the slot has retired or has not been started
+		std::size_t m_retire_count = 0; // under 'm_mutex', threads still to retire after 'set_active_thread_count'
+		std::atomic<std::size_t> m_idle_thread_count{ 0 };
+		cool::_threads_base::_elastic_control m_elastic;
+		cool::_threads_base::_timer_wheel<_task> m_timer_wheel;
+
+#ifdef COOL_THREADS_STATS
+		cool::_threads_base::_stats_block<_cache_line_size>* m_stats_data_ptr = nullptr;
+		char* m_stats_unaligned_data_ptr = nullptr;
+#endif // COOL_THREADS_STATS
+
+		alignas(_cache_line_size) std::condition_variable m_condition_var;
+		std::mutex m_mutex;
+
+		std::atomic<bool> m_good{ false };
+
+#ifdef COOL_THREADS_STATS
+		cool::_threads_base::_submit_stats_block<_cache_line_size> m_submit_stats;
+#endif // COOL_THREADS_STATS
+	};
+
+	// _threads_lq_data
+
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+	class alignas(_cache_line_size) _threads_lq_data : public cool::_threads_base
+	{
+
+	private:
+
+		friend class cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, true>;
+		friend class cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, false>;
+
+		using _task = typename cool::_threads_base::_base_task<_arg_buffer_size, _arg_buffer_align>;
+
+		_threads_lq_data() = default;
+		_threads_lq_data(const cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&) = delete;
+		cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>& operator=(
+			const cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&) = delete;
+		_threads_lq_data(cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&&) = delete;
+		cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>& operator=(
+			cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&&) = delete;
+		~_threads_lq_data() = default;
+
+		inline void delete_threads_detail(std::size_t threads_constructed) noexcept;
+		inline bool pop_task(_task* target_ptr) noexcept;
+		inline void wake_threads(bool all) noexcept;
+
+		static constexpr unsigned int full_poll_count = 256; // consecutive yields of a submitter on a full ring before it sleeps
+
+		// object running the calling thread, nullptr on other threads
+
+		static inline const void*& this_thread_owner() noexcept
+		{
+			static thread_local const void* owner_ptr = nullptr;
+			return owner_ptr;
+		}
+
+		// slots of the ring, 'm_sequence' tells whether the slot is ready for a push or a pop at a given position
+
+		class _ring_slot
+		{
+
+		public:
+
+			_task m_task;
+			std::atomic<std::size_t> m_sequence{ 0 };
+		};
+
+		_ring_slot* m_task_buffer_data_ptr = nullptr;
+		std::size_t m_task_buffer_mask = 0;
+		char* m_task_buffer_unaligned_data_ptr = nullptr;
+
+		std::thread* m_threads_data_ptr = nullptr;
+		std::size_t m_thread_count = 0;
+
+		std::atomic<bool> m_good{ false };
+		std::atomic<bool> m_stop_threads{ true };
+
+		alignas(_cache_line_size) std::atomic<std::size_t> m_push_pos{ 0 };
+
+		alignas(_cache_line_size) std::atomic<std::size_t> m_pop_pos{ 0 };
+
+		alignas(_cache_line_size) cool::_threads_base::_parking_word m_task_parking; // threads waiting for a task
+		std::atomic<std::size_t> m_sleeping_count{ 0 };
+
+		alignas(_cache_line_size) cool::_threads_base::_parking_word m_space_parking; // submitters waiting for a free slot
+		std::atomic<std::size_t> m_space_waiting_count{ 0 };
+	};
+
+	// _threads_mq_data
+
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+	class alignas(_cache_line_size) _threads_mq_data : public cool::_threads_base
+	{
+
+	private:
+
+		friend class cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, true>;
+		friend class cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, false>;
+		friend class cool::_thread_mq_id<_cache_line_size, _arg_buffer_size, _arg_buffer_align>;
+		friend class cool::_thread_mq_native_handle<_cache_line_size, _arg_buffer_size, _arg_buffer_align>;
+
+		using _task = typename cool::_threads_base::_base_task<_arg_buffer_size, _arg_buffer_align>;
+
+#if !defined(COOL_THREADS_MQ_32BIT_COUNTER) && !defined(COOL_THREADS_MQ_16BIT_COUNTER)
+#ifdef UINT64_MAX
+		using _uintX = std::uint32_t;
+		using _uint2X = std::uint64_t;
+#else // UINT64_MAX
+		using _uintX = std::uint16_t;
+		using _uint2X = std::uint32_t;
+#endif // UINT64_MAX
+#elif defined(COOL_THREADS_MQ_32BIT_COUNTER)
+		using _uintX = std::uint32_t;
+		using _uint2X = std::uint64_t;
+#else // defined(COOL_THREADS_MQ_16BIT_COUNTER)
+		using _uintX = std::uint16_t;
+		using _uint2X = std::uint32_t;
+#endif // COOL_THREADS_MQ_XBIT_COUNTER
+
+		_threads_mq_data() = default;
+		_threads_mq_data(const cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&) = delete;
+		cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>& operator=(
+			const cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&) = delete;
+		_threads_mq_data(cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&&) = delete;
+		cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>& operator=(
+			cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&&) = delete;
+		~_threads_mq_data() = default;
+
+		inline void delete_threads_detail(std::size_t threads_constructed, std::size_t threads_launched) noexcept;
+
+		class _thread_block;
+
+		static constexpr std::size_t local_queue_size = COOL_THREADS_MQ_LOCAL_QUEUE_SIZE;
+
+		static_assert((local_queue_size & (local_queue_size - 1)) == 0, "cool::threads_mq<...> requirement : COOL_THREADS_MQ_LOCAL_QUEUE_SIZE must be a power of 2 or 0");
+
+		// block of the thread of a threads_mq object that is running the calling thread, nullptr on other threads
+
+		static inline _thread_block*& this_thread_block() noexcept
+		{
+			static thread_local _thread_block* thread_block_ptr = nullptr;
+			return thread_block_ptr;
+		}
+
+		// true if the pool is elastic, can still grow and the queue of 'block_ptr' holds 'm_grow_queue_depth' tasks or more,
+		// must be called under the mutex of the block
+
+		inline bool saturated(const _thread_block* block_ptr) const noexcept;
+
+		// wakes up a thread parked with empty queues after a task has been pushed on a local deque, so that it steals it
+
+		inline void wake_idle_thread();
+
+		_uintX m_dispatch_interval = 1;
+		_uintX m_mod_k = 0;
+		_uint2X m_mod_a = static_cast<_uint2X>(1) << (sizeof(_uintX) * CHAR_BIT);
+		_uint2X m_mod_D = 1;
+		std::size_t m_thread_count = 0;
+		_thread_block* m_thread_blocks_data_ptr = nullptr;
+
+		std::atomic<bool> m_good{ false };
+		unsigned int m_pop_rounds = 0;
+		unsigned int m_spin_count = 0;
+		unsigned int m_yield_count = 0;
+		unsigned int m_lane_count = 0;
+		unsigned int m_aging_interval = 0;
+		std::size_t m_task_buffer_size_per_thread = 0;
+
+		cool::_threads_base::_elastic_control m_elastic;
+		cool::_threads_base::_timer_wheel<_task> m_timer_wheel;
+
+		char* m_thread_blocks_unaligned_data_ptr = nullptr;
+
+		alignas(_cache_line_size) std::atomic<_uintX> m_thread_dispatch{ 0 };
+
+		alignas(_cache_line_size) std::atomic<std::size_t> m_idle_count{ 0 };
+
+		alignas(_cache_line_size) std::atomic<bool> m_can_refresh{ false };
+
+#ifdef COOL_THREADS_STATS
+		cool::_threads_base::_submit_stats_block<_cache_line_size> m_submit_stats;
+#endif // COOL_THREADS_STATS
+
+		// ring of tasks of a priority lane
+
+		class _lane
+		{
+
+		public:
+
+			inline bool new_task_buffer(std::size_t new_task_buffer_size) noexcept;
+			inline void delete_task_buffer() noexcept;
+
+			_task* m_task_buffer_data_ptr = nullptr;
+			_task* m_task_buffer_end_ptr = nullptr;
+
+			_task* m_last_task_ptr = nullptr;
+			_task* m_next_task_ptr = nullptr;
+
+			char* m_task_buffer_unaligned_data_ptr = nullptr;
+			unsigned int m_skip_count = 0; // times the lane has been passed over while not empty since it was last served
+		};
+
+		class _deque_slot
+		{
+
+		public:
+
+			_task m_task;
+			std::atomic<bool> m_full{ false };
+		};
+
+		class alignas(_cache_line_size) _thread_block
+		{
+
+		public:
+
+			inline bool new_task_buffer(std::size_t new_task_buffer_size) noexcept;
+			inline void delete_task_buffer() noexcept;
+
+			// 'has_task' / 'pop_task' must be called under 'm_mutex', 'pop_task' moves the next task to 'target_ptr' and requires 'has_task'
+
+			inline bool has_task() const noexcept;
+			inline void pop_task(_task* target_ptr);
+			inline std::size_t task_count() const noexcept;
+
+			// 'lock' must refer to 'm_mutex' without owning it, it owns it on return with a task available or 'm_stop_threads' set,
+			// or with no task if the thread retires from an elastic pool, returns true if the thread has kept the timers (see '_timer_wheel')
+			// and returns with no task because one is due, or with a task so that the caller must call 'hand_over_timers' once unlocked
+
+			inline bool wait_for_task(std::unique_lock<std::mutex>& lock, unsigned int spin_count, unsigned int yield_count,
+				cool::_threads_base::_elastic_control* elastic_ptr, cool::_threads_base::_timer_wheel<_task>* timers_ptr);
+
+			// called first by the thread of the block : pins it to 'm_cpu' and allocates the task buffer if it has not been done yet,
+			// so that the task buffer is first touched by the pinned thread and lands on its NUMA node, returns false if that failed
+
+			inline bool start_thread(std::size_t new_task_buffer_size, cool::_threads_base::_elastic_control* elastic_ptr) noexcept;
+
+			// local deque (Chase-Lev, 'local_queue_size' slots), thread of the block only : 'deque_push' / 'deque_pop' (LIFO),
+			// any thread : 'deque_steal' (FIFO), 'fill(task_ptr, arg_slab_ptr)' builds the task in the slot, 'deque_push' also
+			// returns false if 'fill' fails
+
+			template <class fill_Ty> inline bool deque_push(fill_Ty& fill) noexcept;
+			inline bool deque_pop(_task* target_ptr) noexcept;
+			inline bool deque_steal(_task* target_ptr) noexcept;
+
+			// must be called under 'm_mutex' with an empty queue : declares the thread idle then checks every local deque, so that
+			// no task pushed by 'push_local' is missed, returns true with the task moved to the queue and the thread no longer idle
+
+			inline bool idle_steal() noexcept;
+
+			_task* m_task_buffer_data_ptr = nullptr;
+			_task* m_task_buffer_end_ptr = nullptr;
+
+			_task* m_last_task_ptr = nullptr;
+			_task* m_next_task_ptr = nullptr;
+
+			bool m_stop_threads = true;
+			bool m_wake = false; // under 'm_mutex', set by 'wake_idle_thread'
+			std::atomic<bool> m_has_task{ false }; // 'has_task() || m_stop_threads' stored under 'm_mutex' by every push, pop and stop, polled without it by 'wait_for_task'
+
+			std::thread m_thread;
+			char* m_task_buffer_unaligned_data_ptr = nullptr;
+
+			std::atomic<std::size_t> m_spin_hits{ 0 };
+			std::atomic<std::size_t> m_yield_hits{ 0 };
+			std::atomic<std::size_t> m_parks{ 0 };
+
+			int m_cpu = -1;
+			int m_numa_node = -1;
+			std::atomic<int> m_start_state{ 0 }; // 0 : starting, 1 : started, 2 : task buffer allocation failed
+			int m_elastic_state = 0; // under 'm_mutex', 0 : running, 1 : retiring, 2 : stopped, 3 : starting, tasks are only pushed when running
+
+			cool::_threads_base::_arg_slab m_arg_slab; // used under 'm_mutex', released with the block
+			cool::_threads_base::_arg_slab m_local_arg_slab; // used by the thread of the block for its local deque, released with the block
+
+			cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>* m_parent_ptr = nullptr;
+
+			_lane* m_lanes_ptr = nullptr; // lane k has priority k + 1
+			std::size_t m_priority_task_count = 0;
+			unsigned int m_lane_count = 0;
+			unsigned int m_aging_interval = 0;
+			unsigned int m_skip_count = 0; // same as '_lane::m_skip_count' for the regular queue
+
+#ifdef COOL_THREADS_STATS
+			cool::_threads_base::_stats_block<_cache_line_size> m_stats;
+#endif // COOL_THREADS_STATS
+
+			alignas(_cache_line_size) std::atomic<std::ptrdiff_t> m_deque_top{ 0 };
+			std::atomic<bool> m_idle{ false };
+
+			alignas(_cache_line_size) std::atomic<std::ptrdiff_t> m_deque_bottom{ 0 };
+			_deque_slot m_deque_data[(local_queue_size != 0) ? local_queue_size : 1];
+
+			alignas(_cache_line_size) std::condition_variable m_condition_var;
+			std::mutex m_mutex;
+		};
+	};
+
+	// _threads_ws_data
+
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+	class alignas(_cache_line_size) _threads_ws_data : public cool::_threads_base
+	{
+
+	private:
+
+		friend class cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, true>;
+		friend class cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, false>;
+		friend class cool::_thread_ws_id<_cache_line_size, _arg_buffer_size, _arg_buffer_align>;
+		friend class cool::_thread_ws_native_handle<_cache_line_size, _arg_buffer_size, _arg_buffer_align>;
+
+		using _task = typename cool::_threads_base::_base_task<_arg_buffer_size, _arg_buffer_align>;
+
+		_threads_ws_data() = default;
+		_threads_ws_data(const cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&) = delete;
+		cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>& operator=(
+			const cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&) = delete;
+		_threads_ws_data(cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&&) = delete;
+		cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>& operator=(
+			cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>&&) = delete;
+		~_threads_ws_data() = default;
+
+		class _thread_block;
+
+		inline void delete_threads_detail(std::size_t threads_constructed, std::size_t threads_launched) noexcept;
+		inline bool pop_task(_thread_block* thread_block_ptr, _task* target_ptr);
+		inline void wake_idle_thread();
+
+		static inline _thread_block*& this_thread_block() noexcept
+		{
+			static thread_local _thread_block* thread_block_ptr = nullptr;
+			return thread_block_ptr;
+		}
+
+		std::size_t m_thread_count = 0;
+		_thread_block* m_thread_blocks_data_ptr = nullptr;
+
+		std::atomic<bool> m_good{ false };
+		unsigned int m_steal_count = 0;
+
+		char* m_thread_blocks_unaligned_data_ptr = nullptr;
+
+		alignas(_cache_line_size) std::atomic<std::size_t> m_thread_dispatch{ 0 };
+
+		alignas(_cache_line_size) std::atomic<std::size_t> m_idle_count{ 0 };
+
+		alignas(_cache_line_size) std::atomic<bool> m_can_refresh{ false };
+
+		class _deque_slot
+		{
+
+		public:
+
+			_task m_task;
+			std::atomic<bool> m_full{ false };
+		};
+
+		class alignas(_cache_line_size) _thread_block
+		{
+
+		public:
+
+			inline bool new_task_buffer(std::size_t new_task_buffer_size) noexcept;
+			inline void delete_task_buffer() noexcept;
+
+			// owner thread only : 'deque_push' / 'deque_pop', any thread : 'deque_steal' / 'deque_empty'
+
+			template <class fill_Ty> inline bool deque_push(fill_Ty& fill) noexcept;
+			inline bool deque_pop(_task* target_ptr) noexcept;
+			inline bool deque_steal(_task* target_ptr) noexcept;
+			inline bool deque_empty() const noexcept;
+			inline std::size_t victim(std::size_t thread_count) noexcept;
+
+			_task* m_task_buffer_data_ptr = nullptr;
+			_task* m_task_buffer_end_ptr = nullptr;
+
+			_task* m_last_task_ptr = nullptr;
+			_task* m_next_task_ptr = nullptr;
+
+			bool m_stop_threads = true;
+			bool m_wake = false;
+
+			std::thread m_thread;
+			char* m_task_buffer_unaligned_data_ptr = nullptr;
+
+			_deque_slot* m_deque_data_ptr = nullptr;
+			std::ptrdiff_t m_deque_mask = 0;
+			char* m_deque_unaligned_data_ptr = nullptr;
+
+			cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>* m_parent_ptr = nullptr;
+			std::size_t m_thread_num = 0;
+			std::uint32_t m_random_state = 1;
+
+			alignas(_cache_line_size) std::atomic<std::ptrdiff_t> m_deque_top{ 0 };
+			std::atomic<bool> m_idle{ false };
+
+			alignas(_cache_line_size) std::atomic<std::ptrdiff_t> m_deque_bottom{ 0 };
+
+			alignas(_cache_line_size) std::condition_variable m_condition_var;
+			std::mutex m_mutex;
+		};
+	};
+
+	// target incr proxy
+
+	class _async_end_incr_proxy
+	{
+
+	public:
+
+		_async_end_incr_proxy() = delete;
+		_async_end_incr_proxy(const cool::_async_end_incr_proxy&) = delete;
+		cool::_async_end_incr_proxy& operator=(const cool::_async_end_incr_proxy&) = delete;
+		_async_end_incr_proxy(cool::_async_end_incr_proxy&&) noexcept = default;
+		cool::_async_end_incr_proxy& operator=(cool::_async_end_incr_proxy&&) noexcept = default;
+		~_async_end_incr_proxy() = default;
+
+	private:
+
+		_async_end_incr_proxy(cool::async_end* target_ptr) noexcept : m_parent_ptr(target_ptr) {}
+
+		cool::async_end* m_parent_ptr;
+
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_sq;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_mq;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_ws;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_lq;
+		friend class cool::_threads_base;
+		friend class cool::async_end;
+	};
+
+	template <class return_Ty> class _async_result_incr_proxy
+	{
+
+	public:
+
+		_async_result_incr_proxy() = delete;
+		_async_result_incr_proxy(const cool::_async_result_incr_proxy<return_Ty>&) = delete;
+		cool::_async_result_incr_proxy<return_Ty>& operator=(const cool::_async_result_incr_proxy<return_Ty>&) = delete;
+		_async_result_incr_proxy(cool::_async_result_incr_proxy<return_Ty>&&) noexcept = default;
+		cool::_async_result_incr_proxy<return_Ty>& operator=(cool::_async_result_incr_proxy<return_Ty>&&) noexcept = default;
+		~_async_result_incr_proxy() = default;
+
+	private:
+
+		inline _async_result_incr_proxy(cool::async_result<return_Ty>* target_ptr, std::size_t offset) noexcept : m_parent_ptr(target_ptr), m_offset(offset) {}
+
+		cool::async_result<return_Ty>* m_parent_ptr;
+		std::size_t m_offset;
+
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_sq;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_mq;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_ws;
+		template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> friend class cool::threads_lq;
+		friend class cool::_threads_base;
+		template <class return_Ty2> friend class cool::_async_result_to_proxy;
+	};
+
+	// async_node
+
+	// task graph node : the task of an async_node is queued on 'threads' once all its predecessors (async_end, async_result
+	// or async_node objects) have finished, without any thread waiting in between, an async_node without task only acts as a join point
+
+	// usage : set the task with 'set_task', declare up to 'max_predecessor_count' predecessors with 'depends_on', then call 'submit'
+	// the predecessors must already await their tasks (with 'add_awaited' or 'try_incr_awaited' targets) when 'depends_on' is called,
+	// async_node predecessors await their own task from construction
+
+	// 'threads_Ty' can be any of threads_sq, threads_lq, threads_mq or threads_ws
+	// the task is queued with 'async' by the thread calling 'submit', or with 'try_async' by the thread that completes the last predecessor,
+	// which runs the task itself if the queues are full so that a thread of 'threads' never waits on its own queues
+
+	// WARNNING : async_node object must outlive the completion of its task and must not be submitted more than once
+
+	template <class threads_Ty, std::size_t _max_predecessor_count = 4> class async_node
+	{
+
+	public:
+
+		static constexpr std::size_t max_predecessor_count = _max_predecessor_count;
+
+		async_node() = delete;
+		async_node(const cool::async_node<threads_Ty, _max_predecessor_count>& rhs) = delete;
+		cool::async_node<threads_Ty, _max_predecessor_count>& operator=(const cool::async_node<threads_Ty, _max_predecessor_count>& rhs) = delete;
+		async_node(cool::async_node<threads_Ty, _max_predecessor_count>&& rhs) = delete;
+		cool::async_node<threads_Ty, _max_predecessor_count>& operator=(cool::async_node<threads_Ty, _max_predecessor_count>&& rhs) = delete;
+		inline ~async_node();
+
+		explicit inline async_node(threads_Ty& threads) noexcept;
+
+		// 'function_Ty task' must be a function pointer or a callable object (such as a lambda) movable without throwing exceptions
+		// 'function_Ty task' must pass arguments by copy
+		// 'arg_Ty ... args' must be movable or copyable without throwing exceptions
+		// a callable object 'task' is stored in the node with the arguments and must fit along with them, exceptions thrown by it
+		// are reported with a null function pointer to the exception handler
+
+		template <class function_Ty, class ... arg_Ty>
+		inline void set_task(function_Ty task, arg_Ty&& ... args) noexcept;
+
+		// 'depends_on' returns false if 'max_predecessor_count' is exceeded
+
+		inline bool depends_on(cool::async_end& predecessor) noexcept;
+		template <class return_Ty> inline bool depends_on(cool::async_result<return_Ty>& predecessor) noexcept;
+		template <class threads_Ty2, std::size_t _max_predecessor_count2> inline bool depends_on(cool::async_node<threads_Ty2, _max_predecessor_count2>& predecessor) noexcept;
+
+		inline void submit() noexcept;
+		inline void finish() noexcept; // waits for the completion of the task of the node
+		inline bool finished() const noexcept;
+
+	private:
+
+		inline void release(bool wait_for_space) noexcept;
+
+		// '_functor_call' is queued with the pack of a callable object task as its only argument, so that a failed 'try_async'
+		// leaves the callable object in the pack and that exceptions are reported with a null function pointer
+
+		template <class pack_Ty> class _functor_call {
+		public:
+			inline void operator()(pack_Ty pack) const {
+				cool::_threads_base::_task_traits<decltype(pack.m_task)>::call_no_return(nullptr, pack);
+			}
+		};
+
+		// 'queue' gives the task to 'async' if 'wait_for_space' is true and to 'try_async' otherwise, 'pack' is left untouched if
+		// 'try_async' returns false
+
+		template <class function_Ty, class tuple_Ty>
+		static inline bool queue(threads_Ty* threads_ptr, cool::async_end& target, void(*function_address)(void), tuple_Ty& pack, bool wait_for_space) noexcept {
+			function_Ty function_ptr;
+			std::memcpy(&function_ptr, &function_address, sizeof(void(*)(void)));
+			return queue_call(threads_ptr, target, function_ptr, pack, wait_for_space, cool::_threads_base::build_indices<std::tuple_size<tuple_Ty>::value>());
+		}
+		template <class function_Ty, class tuple_Ty>
+		static inline bool queue(threads_Ty* threads_ptr, cool::async_end& target, void(*)(void), cool::_threads_base::_functor_pack<function_Ty, tuple_Ty>& pack, bool wait_for_space) noexcept {
+			return queue_call(threads_ptr, target, _functor_call<cool::_threads_base::_functor_pack<function_Ty, tuple_Ty>>(), std::forward_as_tuple(std::move(pack)),
+				wait_for_space, cool::_threads_base::build_indices<1>());
+		}
+		template <class function_Ty, class tuple_Ty, std::size_t ... _indices>
+		static inline bool queue_call(threads_Ty* threads_ptr, cool::async_end& target, function_Ty task, tuple_Ty&& args, bool wait_for_space, cool::_threads_base::indices<_indices...>) noexcept {
+			if (wait_for_space) {
+				threads_ptr->async(target, task, std::get<_indices>(std::move(args))...);
+				return true;
+			}
+			else {
+				return threads_ptr->try_async(target, task, std::get<_indices>(std::move(args))...);
+			}
+		}
+
+		threads_Ty* m_threads_ptr;
+		cool::async_end m_end;
+		std::atomic<std::ptrdiff_t> m_predecessors_awaited{ 1 };
+
+		void(*m_callable)(cool::async_node<threads_Ty, _max_predecessor_count>*, bool, bool) = nullptr;
+		void(*m_function_ptr)(void) = nullptr;
+		alignas(threads_Ty::arg_buffer_align) unsigned char m_arg_buffer[threads_Ty::arg_buffer_size];
+
+		cool::_async_waiter m_waiters[(_max_predecessor_count != 0) ? _max_predecessor_count : 1];
+		std::size_t m_waiter_count = 0;
+
+		template <class threads_Ty2, std::size_t _max_predecessor_count2> friend class cool::async_node;
+	};
+
+
+	// iterators
+
+	template <class data_Ty> class _thread_iterator : private data_Ty
+	{
+
+	public:
+
+		using data_Ty::data_Ty;
+		using value_type = typename data_Ty::value_type;
+		using pointer_type = typename data_Ty::pointer_type;
+
+		inline cool::_thread_iterator<data_Ty>& operator--() noexcept { this->m_ptr--; return *this; }
+		inline cool::_thread_iterator<data_Ty>& operator++() noexcept { this->m_ptr++; return *this; }
+		inline cool::_thread_iterator<data_Ty> operator--(int) noexcept { cool::_thread_iterator<data_Ty> ret = *this; this->m_ptr--; return ret; }
+		inline cool::_thread_iterator<data_Ty> operator++(int) noexcept { cool::_thread_iterator<data_Ty> ret = *this; this->m_ptr++; return ret; }
+		inline cool::_thread_iterator<data_Ty>& operator-=(std::ptrdiff_t offset) noexcept { this->m_ptr -= offset; return *this; }
+		inline cool::_thread_iterator<data_Ty>& operator+=(std::ptrdiff_t offset) noexcept { this->m_ptr += offset; return *this; }
+		inline cool::_thread_iterator<data_Ty> operator-(std::ptrdiff_t offset) const noexcept { return cool::_thread_iterator<data_Ty>(this->m_ptr - offset); }
+		inline cool::_thread_iterator<data_Ty> operator+(std::ptrdiff_t offset) const noexcept { return cool::_thread_iterator<data_Ty>(this->m_ptr + offset); }
+		inline std::ptrdiff_t operator-(const cool::_thread_iterator<data_Ty>& rhs) const noexcept { return this->m_ptr - rhs.m_ptr; }
+
+		inline bool operator==(const cool::_thread_iterator<data_Ty>& rhs) const noexcept { return this->m_ptr == rhs.m_ptr; }
+		inline bool operator!=(const cool::_thread_iterator<data_Ty>& rhs) const noexcept { return this->m_ptr != rhs.m_ptr; }
+		inline bool operator<=(const cool::_thread_iterator<data_Ty>& rhs) const noexcept { return this->m_ptr <= rhs.m_ptr; }
+		inline bool operator>=(const cool::_thread_iterator<data_Ty>& rhs) const noexcept { return this->m_ptr >= rhs.m_ptr; }
+		inline bool operator<(const cool::_thread_iterator<data_Ty>& rhs) const noexcept { return this->m_ptr < rhs.m_ptr; }
+		inline bool operator>(const cool::_thread_iterator<data_Ty>& rhs) const noexcept { return this->m_ptr > rhs.m_ptr; }
+
+		value_type operator*() const noexcept(data_Ty::indirection_is_noexcept) { return this->indirection_impl(); }
+		value_type operator[](std::ptrdiff_t offset) const noexcept(data_Ty::indirection_is_noexcept) { return this->indirection_impl(offset); }
+	};
+
+	template <class _thread_iterator_Ty> class _thread_iterator_proxy
+	{
+
+	public:
+
+		using pointer_type = typename _thread_iterator_Ty::pointer_type;
+
+		inline _thread_iterator_proxy(pointer_type begin_ptr, pointer_type end_ptr) noexcept : m_begin(begin_ptr), m_end(end_ptr) {}
+		inline _thread_iterator_Ty begin() const noexcept { return m_begin; }
+		inline _thread_iterator_Ty end() const noexcept { return m_end; }
+
+	private:
+
+		_thread_iterator_Ty m_begin;
+		_thread_iterator_Ty m_end;
+	};
+
+	template <class _thread_iterator_Ty> class _thread_const_iterator_proxy
+	{
+
+	public:
+
+		using pointer_type = typename _thread_iterator_Ty::pointer_type;
+
+		inline _thread_const_iterator_proxy(pointer_type begin_ptr, pointer_type end_ptr) noexcept : m_begin(begin_ptr), m_end(end_ptr) {}
+		inline _thread_iterator_Ty begin() const noexcept { return m_begin; }
+		inline _thread_iterator_Ty end() const noexcept { return m_end; }
+		inline _thread_iterator_Ty cbegin() const noexcept { return m_begin; }
+		inline _thread_iterator_Ty cend() const noexcept { return m_end; }
+
+	private:
+
+		_thread_iterator_Ty m_begin;
+		_thread_iterator_Ty m_end;
+	};
+
+	class _thread_sq_id {
+	public:
+		using value_type = std::thread::id;
+		using pointer_type = const std::thread*;
+		static constexpr bool indirection_is_noexcept = true;
+		inline _thread_sq_id(pointer_type ptr) noexcept : m_ptr(ptr) {}
+	protected:
+		inline value_type indirection_impl() const noexcept { return m_ptr->get_id(); }
+		inline value_type indirection_impl(std::ptrdiff_t offset) const noexcept { return (m_ptr + offset)->get_id(); }
+		pointer_type m_ptr;
+	};
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _thread_mq_id {
+	public:
+		using value_type = std::thread::id;
+		using pointer_type = const typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block*;
+		static constexpr bool indirection_is_noexcept = true;
+		inline _thread_mq_id(pointer_type ptr) noexcept : m_ptr(ptr) {}
+	protected:
+		inline value_type indirection_impl() const noexcept { return m_ptr->m_thread.get_id(); }
+		inline value_type indirection_impl(std::ptrdiff_t offset) const noexcept { return (m_ptr + offset)->m_thread.get_id(); }
+		pointer_type m_ptr;
+	};
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _thread_ws_id {
+	public:
+		using value_type = std::thread::id;
+		using pointer_type = const typename cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block*;
+		static constexpr bool indirection_is_noexcept = true;
+		inline _thread_ws_id(pointer_type ptr) noexcept : m_ptr(ptr) {}
+	protected:
+		inline value_type indirection_impl() const noexcept { return m_ptr->m_thread.get_id(); }
+		inline value_type indirection_impl(std::ptrdiff_t offset) const noexcept { return (m_ptr + offset)->m_thread.get_id(); }
+		pointer_type m_ptr;
+	};
+#ifdef COOL_THREADS_NATIVE_HANDLE
+	class _thread_sq_native_handle {
+	public:
+		using value_type = std::thread::native_handle_type;
+		using pointer_type = std::thread*;
+		static constexpr bool indirection_is_noexcept = false;
+		inline _thread_sq_native_handle(pointer_type ptr) noexcept : m_ptr(ptr) {}
+	protected:
+		inline value_type indirection_impl() const { return m_ptr->native_handle(); }
+		inline value_type indirection_impl(std::ptrdiff_t offset) const { return (m_ptr + offset)->native_handle(); }
+		pointer_type m_ptr;
+	};
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _thread_mq_native_handle {
+	public:
+		using value_type = std::thread::native_handle_type;
+		using pointer_type = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block*;
+		static constexpr bool indirection_is_noexcept = false;
+		inline _thread_mq_native_handle(pointer_type ptr) noexcept : m_ptr(ptr) {}
+	protected:
+		inline value_type indirection_impl() const { return m_ptr->m_thread.native_handle(); }
+		inline value_type indirection_impl(std::ptrdiff_t offset) const { return (m_ptr + offset)->m_thread.native_handle(); }
+		pointer_type m_ptr;
+	};
+	template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> class _thread_ws_native_handle {
+	public:
+		using value_type = std::thread::native_handle_type;
+		using pointer_type = typename cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block*;
+		static constexpr bool indirection_is_noexcept = false;
+		inline _thread_ws_native_handle(pointer_type ptr) noexcept : m_ptr(ptr) {}
+	protected:
+		inline value_type indirection_impl() const { return m_ptr->m_thread.native_handle(); }
+		inline value_type indirection_impl(std::ptrdiff_t offset) const { return (m_ptr + offset)->m_thread.native_handle(); }
+		pointer_type m_ptr;
+	};
+#endif // COOL_THREADS_NATIVE_HANDLE
+}
+
+
+// init types detail
+
+inline constexpr cool::thread_count::thread_count(std::uint16_t new_thread_count) noexcept : m_value(new_thread_count) {}
+inline constexpr std::uint16_t cool::thread_count::value() const noexcept { return m_value; }
+
+inline constexpr cool::task_buffer_size::task_buffer_size(std::size_t new_task_buffer_size) noexcept : m_value(new_task_buffer_size) {}
+inline constexpr std::size_t cool::task_buffer_size::value() const noexcept { return m_value; }
+
+inline constexpr cool::try_pop_count::try_pop_count(unsigned int new_try_pop_count) noexcept : m_value(new_try_pop_count) {}
+inline constexpr unsigned int cool::try_pop_count::value() const noexcept { return m_value; }
+
+inline constexpr cool::dispatch_interval::dispatch_interval(std::uint16_t new_dispatch_interval) noexcept : m_value(new_dispatch_interval) {}
+inline constexpr std::uint16_t cool::dispatch_interval::value() const noexcept { return m_value; }
+
+inline constexpr cool::thread_affinity::thread_affinity(int new_policy) noexcept
+	: m_policy(((new_policy == compact) || (new_policy == scatter)) ? new_policy : none), m_cpu_list_ptr(nullptr), m_cpu_list_size(0) {}
+inline constexpr cool::thread_affinity::thread_affinity(const unsigned int* new_cpu_list_ptr, std::size_t new_cpu_list_size) noexcept
+	: m_policy(((new_cpu_list_ptr != nullptr) && (new_cpu_list_size != 0)) ? cpu_list : none), m_cpu_list_ptr(new_cpu_list_ptr), m_cpu_list_size(new_cpu_list_size) {}
+inline constexpr int cool::thread_affinity::policy() const noexcept { return m_policy; }
+inline constexpr const unsigned int* cool::thread_affinity::cpu_list_data() const noexcept { return m_cpu_list_ptr; }
+inline constexpr std::size_t cool::thread_affinity::cpu_list_size() const noexcept { return m_cpu_list_size; }
+
+inline constexpr cool::priority_lanes::priority_lanes(unsigned int new_lane_count, unsigned int new_aging_interval) noexcept
+	: m_lane_count(new_lane_count), m_aging_interval(new_aging_interval) {}
+inline constexpr unsigned int cool::priority_lanes::lane_count() const noexcept { return m_lane_count; }
+inline constexpr unsigned int cool::priority_lanes::aging_interval() const noexcept { return m_aging_interval; }
+
+inline constexpr cool::elastic_policy::elastic_policy(std::uint16_t new_min_thread_count, unsigned int new_idle_timeout_ms, std::size_t new_grow_queue_depth) noexcept
+	: m_min_thread_count(new_min_thread_count), m_idle_timeout_ms(new_idle_timeout_ms), m_grow_queue_depth(new_grow_queue_depth) {}
+inline constexpr std::uint16_t cool::elastic_policy::min_thread_count() const noexcept { return m_min_thread_count; }
+inline constexpr unsigned int cool::elastic_policy::idle_timeout_ms() const noexcept { return m_idle_timeout_ms; }
+inline constexpr std::size_t cool::elastic_policy::grow_queue_depth() const noexcept { return m_grow_queue_depth; }
+
+inline constexpr cool::timer_wheel::timer_wheel(std::size_t new_capacity, unsigned int new_resolution_us) noexcept
+	: m_capacity(new_capacity), m_resolution_us(new_resolution_us) {}
+inline constexpr std::size_t cool::timer_wheel::capacity() const noexcept { return m_capacity; }
+inline constexpr unsigned int cool::timer_wheel::resolution_us() const noexcept { return m_resolution_us; }
+
+inline constexpr cool::wait_policy::wait_policy(unsigned int new_spin_count, unsigned int new_yield_count) noexcept : m_spin_count(new_spin_count), m_yield_count(new_yield_count) {}
+inline constexpr unsigned int cool::wait_policy::spin_count() const noexcept { return m_spin_count; }
+inline constexpr unsigned int cool::wait_policy::yield_count() const noexcept { return m_yield_count; }
+
+inline constexpr cool::wait_stats::wait_stats(std::size_t new_spin_hits, std::size_t new_yield_hits, std::size_t new_parks) noexcept
+	: m_spin_hits(new_spin_hits), m_yield_hits(new_yield_hits), m_parks(new_parks) {}
+inline constexpr std::size_t cool::wait_stats::spin_hits() const noexcept { return m_spin_hits; }
+inline constexpr std::size_t cool::wait_stats::yield_hits() const noexcept { return m_yield_hits; }
+inline constexpr std::size_t cool::wait_stats::parks() const noexcept { return m_parks; }
+
+inline constexpr cool::threads_mq_options::threads_mq_options() noexcept
+	: m_try_pop_count(1), m_dispatch_interval(0), m_wait_policy(0, 0), m_thread_affinity(cool::thread_affinity::none),
+	m_priority_lanes(0), m_elastic_policy(0), m_timer_wheel(0) {}
+inline cool::threads_mq_options& cool::threads_mq_options::try_pop_count(cool::try_pop_count new_try_pop_count) noexcept { m_try_pop_count = new_try_pop_count; return *this; }
+inline cool::threads_mq_options& cool::threads_mq_options::dispatch_interval(cool::dispatch_interval new_dispatch_interval) noexcept { m_dispatch_interval = new_dispatch_interval; return *this; }
+inline cool::threads_mq_options& cool::threads_mq_options::wait_policy(cool::wait_policy new_wait_policy) noexcept { m_wait_policy = new_wait_policy; return *this; }
+inline cool::threads_mq_options& cool::threads_mq_options::thread_affinity(cool::thread_affinity new_thread_affinity) noexcept { m_thread_affinity = new_thread_affinity; return *this; }
+inline cool::threads_mq_options& cool::threads_mq_options::priority_lanes(cool::priority_lanes new_priority_lanes) noexcept { m_priority_lanes = new_priority_lanes; return *this; }
+inline cool::threads_mq_options& cool::threads_mq_options::elastic_policy(cool::elastic_policy new_elastic_policy) noexcept { m_elastic_policy = new_elastic_policy; return *this; }
+inline cool::threads_mq_options& cool::threads_mq_options::timer_wheel(cool::timer_wheel new_timer_wheel) noexcept { m_timer_wheel = new_timer_wheel; return *this; }
+inline constexpr cool::try_pop_count cool::threads_mq_options::try_pop_count() const noexcept { return m_try_pop_count; }
+inline constexpr cool::dispatch_interval cool::threads_mq_options::dispatch_interval() const noexcept { return m_dispatch_interval; }
+inline constexpr cool::wait_policy cool::threads_mq_options::wait_policy() const noexcept { return m_wait_policy; }
+inline constexpr cool::thread_affinity cool::threads_mq_options::thread_affinity() const noexcept { return m_thread_affinity; }
+inline constexpr cool::priority_lanes cool::threads_mq_options::priority_lanes() const noexcept { return m_priority_lanes; }
+inline constexpr cool::elastic_policy cool::threads_mq_options::elastic_policy() const noexcept { return m_elastic_policy; }
+inline constexpr cool::timer_wheel cool::threads_mq_options::timer_wheel() const noexcept { return m_timer_wheel; }
+
+#ifdef COOL_THREADS_STATS
+inline std::size_t cool::threads_stats::tasks_executed() const noexcept { return m_tasks_executed; }
+inline std::size_t cool::threads_stats::try_async_failures() const noexcept { return m_try_async_failures; }
+inline std::size_t cool::threads_stats::full_queue_retries() const noexcept { return m_full_queue_retries; }
+inline std::size_t cool::threads_stats::probe_hits() const noexcept { return m_probe_hits; }
+inline std::size_t cool::threads_stats::probe_misses() const noexcept { return m_probe_misses; }
+inline std::size_t cool::threads_stats::queue_depth() const noexcept { return m_queue_depth; }
+inline std::size_t cool::threads_stats::task_time_histogram(std::size_t bucket) const noexcept { return (bucket < histogram_size) ? m_task_time_histogram[bucket] : 0; }
+#endif // COOL_THREADS_STATS
+
+
+// thread affinity detail
+
+inline void cool::_threads_base::affinity_plan(const cool::thread_affinity& affinity, int* cpus, std::size_t thread_count) noexcept
+{
+	for (std::size_t k = 0; k < thread_count; k++)
+	{
+		cpus[k] = -1;
+	}
+
+#ifdef xCOOL_THREADS_AFFINITY
+	if (affinity.policy() == cool::thread_affinity::cpu_list)
+	{
+		for (std::size_t k = 0; k < thread_count; k++)
+		{
+			unsigned int cpu = affinity.cpu_list_data()[k % affinity.cpu_list_size()];
+			cpus[k] = (cpu < static_cast<unsigned int>(CPU_SETSIZE)) ? static_cast<int>(cpu) : -1;
+		}
+	}
+	else if (affinity.policy() != cool::thread_affinity::none)
+	{
+		class _cpu_info {
+		public:
+			int m_cpu;
+			int m_package;
+			int m_core;
+			int m_rank;
+		};
+
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+
+		if (sched_getaffinity(0, sizeof(cpu_set_t), &cpu_set) != 0)
+		{
+			return;
+		}
+
+		_cpu_info* info = new (std::nothrow) _cpu_info[CPU_SETSIZE];
+
+		if (info == nullptr)
+		{
+			return;
+		}
+
+		auto read_topology = [](int cpu, const char* name) -> int
+		{
+			char path[96];
+			int value = -1;
+			std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, name);
+			std::FILE* file = std::fopen(path, "r");
+			if (file != nullptr)
+			{
+				if (std::fscanf(file, "%d", &value) != 1) { value = -1; }
+				std::fclose(file);
+			}
+			return value;
+		};
+
+		std::size_t cpu_count = 0;
+
+		for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+		{
+			if (CPU_ISSET(cpu, &cpu_set))
+			{
+				info[cpu_count] = _cpu_info{ cpu, read_topology(cpu, "physical_package_id"), read_topology(cpu, "core_id"), 0 };
+				cpu_count++;
+			}
+		}
+
+		// compact order : by socket, then core, then cpu number
+
+		auto compact_less = [](const _cpu_info& lhs, const _cpu_info& rhs) -> bool
+		{
+			return (lhs.m_package != rhs.m_package) ? (lhs.m_package < rhs.m_package)
+				: ((lhs.m_core != rhs.m_core) ? (lhs.m_core < rhs.m_core) : (lhs.m_cpu < rhs.m_cpu));
+		};
+
+		for (std::size_t k = 1; k < cpu_count; k++)
+		{
+			_cpu_info temp = info[k];
+			std::size_t n = k;
+			for (; (n > 0) && compact_less(temp, info[n - 1]); n--) { info[n] = info[n - 1]; }
+			info[n] = temp;
+		}
+
+		if (affinity.policy() == cool::thread_affinity::scatter)
+		{
+			// rank : hyperthread sibling number * socket core count + core number in socket, then scatter order by rank, then socket
+
+			std::size_t package_first = 0;
+
+			while (package_first < cpu_count)
+			{
+				std::size_t package_last = package_first;
+				std::size_t core_count = 0;
+
+				while ((package_last < cpu_count) && (info[package_last].m_package == info[package_first].m_package))
+				{
+					core_count += static_cast<std::size_t>((package_last == package_first) || (info[package_last].m_core != info[package_last - 1].m_core));
+					package_last++;
+				}
+
+				int core_number = -1;
+				int sibling_number = 0;
+
+				for (std::size_t k = package_first; k < package_last; k++)
+				{
+					if ((k == package_first) || (info[k].m_core != info[k - 1].m_core))
+					{
+						core_number++;
+						sibling_number = 0;
+					}
+					else
+					{
+						sibling_number++;
+					}
+					info[k].m_rank = sibling_number * static_cast<int>(core_count) + core_number;
+				}
+
+				package_first = package_last;
+			}
+
+			auto scatter_less = [](const _cpu_info& lhs, const _cpu_info& rhs) -> bool
+			{
+				return (lhs.m_rank != rhs.m_rank) ? (lhs.m_rank < rhs.m_rank)
+					: ((lhs.m_package != rhs.m_package) ? (lhs.m_package < rhs.m_package) : (lhs.m_cpu < rhs.m_cpu));
+			};
+
+			for (std::size_t k = 1; k < cpu_count; k++)
+			{
+				_cpu_info temp = info[k];
+				std::size_t n = k;
+				for (; (n > 0) && scatter_less(temp, info[n - 1]); n--) { info[n] = info[n - 1]; }
+				info[n] = temp;
+			}
+		}
+
+		if (cpu_count != 0)
+		{
+			for (std::size_t k = 0; k < thread_count; k++)
+			{
+				cpus[k] = info[k % cpu_count].m_cpu;
+			}
+		}
+
+		delete[] info;
+	}
+#else // xCOOL_THREADS_AFFINITY
+	static_cast<void>(affinity);
+#endif // xCOOL_THREADS_AFFINITY
+}
+
+inline void cool::_threads_base::pin_this_thread(int cpu) noexcept
+{
+#ifdef xCOOL_THREADS_AFFINITY
+	if ((cpu >= 0) && (cpu < CPU_SETSIZE))
+	{
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		CPU_SET(cpu, &cpu_set);
+		sched_setaffinity(0, sizeof(cpu_set_t), &cpu_set);
+	}
+#else // xCOOL_THREADS_AFFINITY
+	static_cast<void>(cpu);
+#endif // xCOOL_THREADS_AFFINITY
+}
+
+inline int cool::_threads_base::this_thread_numa_node() noexcept
+{
+#if defined(xCOOL_THREADS_AFFINITY) && defined(SYS_getcpu)
+	unsigned int cpu = 0;
+	unsigned int node = 0;
+	if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+	{
+		return static_cast<int>(node);
+	}
+	else
+	{
+		return -1;
+	}
+#else // defined(xCOOL_THREADS_AFFINITY) && defined(SYS_getcpu)
+	return -1;
+#endif // defined(xCOOL_THREADS_AFFINITY) && defined(SYS_getcpu)
+}
+
+
+// parking word detail
+
+inline void cool::_threads_base::_parking_word::wait(std::uint32_t epoch) noexcept
+{
+#if defined(xCOOL_THREADS_FUTEX)
+	static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "cool::_threads_base::_parking_word : unexpected atomic layout");
+
+	cool::_async_completion::futex_wait(static_cast<void*>(&m_epoch), epoch);
+#elif defined(xCOOL_THREADS_ATOMIC_WAIT)
+	m_epoch.wait(epoch, std::memory_order_acquire);
+#else
+	while (true)
+	{
+		xCOOL_THREADS_TRY
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			if (m_epoch.load(std::memory_order_acquire) == epoch)
+			{
+				m_condition_var.wait(lock);
+			}
+			break;
+		}
+		xCOOL_THREADS_CATCH(...) {}
+	}
+#endif
+}
+
+inline void cool::_threads_base::_parking_word::wake(bool all) noexcept
+{
+	m_epoch.fetch_add(1, std::memory_order_seq_cst);
+
+#if defined(xCOOL_THREADS_FUTEX)
+	cool::_async_completion::futex_wake(static_cast<void*>(&m_epoch), all ? INT_MAX : 1);
+#elif defined(xCOOL_THREADS_ATOMIC_WAIT)
+	if (all)
+	{
+		m_epoch.notify_all();
+	}
+	else
+	{
+		m_epoch.notify_one();
+	}
+#else
+	// taking the mutex once orders the wake up after the check of a waiter that is about to sleep
+
+	while (true)
+	{
+		xCOOL_THREADS_TRY
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			break;
+		}
+		xCOOL_THREADS_CATCH(...) {}
+	}
+
+	if (all)
+	{
+		m_condition_var.notify_all();
+	}
+	else
+	{
+		m_condition_var.notify_one();
+	}
+#endif
+}
+
+
+// arg slab detail
+
+inline void* cool::_threads_base::_arg_slab::allocate(std::size_t size) noexcept
+{
+	std::size_t size_class = 0;
+	while ((size_class < class_count) && ((min_class_size << size_class) < size))
+	{
+		size_class++;
+	}
+
+	_chunk_header* chunk_ptr = nullptr;
+
+	if (size_class < class_count)
+	{
+		chunk_ptr = m_free[size_class];
+
+		if (chunk_ptr == nullptr)
+		{
+			chunk_ptr = m_returned[size_class].exchange(nullptr, std::memory_order_acquire);
+		}
+
+		if (chunk_ptr != nullptr)
+		{
+			m_free[size_class] = chunk_ptr->m_next_ptr;
+			return static_cast<void*>(chunk_ptr + 1);
+		}
+	}
+
+	std::size_t chunk_size = sizeof(_chunk_header) + ((size_class < class_count) ? (min_class_size << size_class) : size);
+	void* new_chunk_ptr = ::operator new(chunk_size, std::nothrow);
+
+	if (new_chunk_ptr == nullptr)
+	{
+		return nullptr;
+	}
+
+	chunk_ptr = new (new_chunk_ptr) _chunk_header{ (size_class < class_count) ? this : nullptr, nullptr, size_class };
+
+	return static_cast<void*>(chunk_ptr + 1);
+}
+
+inline void cool::_threads_base::_arg_slab::deallocate(void* ptr) noexcept
+{
+	_chunk_header* chunk_ptr = static_cast<_chunk_header*>(ptr) - 1;
+	_arg_slab* slab_ptr = chunk_ptr->m_slab_ptr;
+
+	if (slab_ptr != nullptr)
+	{
+		// the owner only ever takes the whole list with 'exchange' so that this push is free of ABA
+
+		std::atomic<_chunk_header*>& returned = slab_ptr->m_returned[chunk_ptr->m_class];
+		_chunk_header* head_ptr = returned.load(std::memory_order_relaxed);
+
+		do
+		{
+			chunk_ptr->m_next_ptr = head_ptr;
+		} while (!returned.compare_exchange_weak(head_ptr, chunk_ptr, std::memory_order_release, std::memory_order_relaxed));
+	}
+	else
+	{
+		::operator delete(static_cast<void*>(chunk_ptr));
+	}
+}
+
+inline void cool::_threads_base::_arg_slab::release() noexcept
+{
+	for (std::size_t size_class = 0; size_class < class_count; size_class++)
+	{
+		_chunk_header* lists[2] = { m_free[size_class], m_returned[size_class].exchange(nullptr, std::memory_order_acquire) };
+		m_free[size_class] = nullptr;
+
+		for (_chunk_header* chunk_ptr : lists)
+		{
+			while (chunk_ptr != nullptr)
+			{
+				_chunk_header* next_ptr = chunk_ptr->m_next_ptr;
+				::operator delete(static_cast<void*>(chunk_ptr));
+				chunk_ptr = next_ptr;
+			}
+		}
+	}
+}
+
+template <class tuple_Ty> template <class ... arg_Ty>
+inline cool::_threads_base::_spilled_pack<tuple_Ty>::_spilled_pack(void* storage_ptr, arg_Ty&& ... args)
+	: m_ptr(new (storage_ptr) tuple_Ty(std::forward<arg_Ty>(args)...)) {}
+
+template <class tuple_Ty>
+inline cool::_threads_base::_spilled_pack<tuple_Ty>::~_spilled_pack()
+{
+	if (m_ptr != nullptr)
+	{
+		m_ptr->~tuple_Ty();
+		cool::_threads_base::_arg_slab::deallocate(static_cast<void*>(m_ptr));
+	}
+}
+
+
+// task fill detail
+
+template <class task_Ty, class function_Ty, class pack_Ty>
+inline void cool::_threads_base::_task_callable<task_Ty, function_Ty, pack_Ty>::no_target(task_Ty* task_ptr, task_Ty* fetch_task_ptr)
+{
+	if (fetch_task_ptr == nullptr)
+	{
+		xCOOL_THREADS_TRY
+		{
+			cool::_threads_base::_task_traits<function_Ty>::call_no_return(
+				task_ptr->m_address_data.m_function_ptr, std::move(*reinterpret_cast<pack_Ty*>(task_ptr->m_arg_buffer))
+			);
+		}
+		xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
+		{
+			cool::_threads_base::catch_exception(xCOOL_THREADS_EXCEPTION, task_ptr->m_address_data.m_function_ptr);
+		}
+
+		reinterpret_cast<pack_Ty*>(task_ptr->m_arg_buffer)->~pack_Ty();
+	}
+	else
+	{
+		move(task_ptr, fetch_task_ptr, task_Ty::address_size);
+	}
+}
+
+template <class task_Ty, class function_Ty, class pack_Ty>
+inline void cool::_threads_base::_task_callable<task_Ty, function_Ty, pack_Ty>::async_end(task_Ty* task_ptr, task_Ty* fetch_task_ptr)
+{
+	if (fetch_task_ptr == nullptr)
+	{
+		cool::async_end& target_ref = *static_cast<cool::async_end*>(task_ptr->m_address_data.m_target_ptr);
+
+		if (!target_ref.m_cancelled.load(std::memory_order_relaxed))
+		{
+			xCOOL_THREADS_TRY
+			{
+				cool::_threads_base::_task_traits<function_Ty>::call_no_return(
+					task_ptr->m_address_data.m_function_ptr, std::move(*reinterpret_cast<pack_Ty*>(task_ptr->m_arg_buffer))
+				);
+			}
+			xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
+			{
+				cool::_threads_base::catch_exception(xCOOL_THREADS_EXCEPTION, task_ptr->m_address_data.m_function_ptr);
+			}
+		}
+
+		target_ref.decr_awaited();
+
+		reinterpret_cast<pack_Ty*>(task_ptr->m_arg_buffer)->~pack_Ty();
+	}
+	else
+	{
+		move(task_ptr, fetch_task_ptr, task_Ty::address_with_target_size);
+	}
+}
+
+template <class task_Ty, class function_Ty, class pack_Ty> template <class return_Ty>
+inline void cool::_threads_base::_task_callable<task_Ty, function_Ty, pack_Ty>::async_result(task_Ty* task_ptr, task_Ty* fetch_task_ptr)
+{
+	if (fetch_task_ptr == nullptr)
+	{
+		cool::async_result<return_Ty>& target_ref = *static_cast<cool::async_result<return_Ty>*>(task_ptr->m_address_data.m_target_ptr);
+
+		xCOOL_THREADS_TRY
+		{
+			*(target_ref.m_stored_values_ptr + task_ptr->m_address_data.m_offset) = cool::_threads_base::_task_traits<function_Ty>::call(
+				task_ptr->m_address_data.m_function_ptr, std::move(*reinterpret_cast<pack_Ty*>(task_ptr->m_arg_buffer))
+			);
+		}
+		xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
+		{
+			if (!target_ref.capture_exception(task_ptr->m_address_data.m_offset))
+			{
+				cool::_threads_base::catch_exception(xCOOL_THREADS_EXCEPTION, task_ptr->m_address_data.m_function_ptr);
+			}
+		}
+
+		target_ref.decr_awaited();
+
+		reinterpret_cast<pack_Ty*>(task_ptr->m_arg_buffer)->~pack_Ty();
+	}
+	else
+	{
+		move(task_ptr, fetch_task_ptr, task_Ty::address_with_target_and_offset_size);
+	}
+}
+
+template <class task_Ty, class function_Ty, class pack_Ty>
+inline void cool::_threads_base::_task_callable<task_Ty, function_Ty, pack_Ty>::move(task_Ty* task_ptr, task_Ty* fetch_task_ptr, std::size_t address_size) noexcept
+{
+	new (static_cast<void*>(task_ptr->m_arg_buffer)) pack_Ty(std::move(*reinterpret_cast<pack_Ty*>(fetch_task_ptr->m_arg_buffer)));
+	reinterpret_cast<pack_Ty*>(fetch_task_ptr->m_arg_buffer)->~pack_Ty();
+
+	std::memcpy(&task_ptr->m_address_data, &fetch_task_ptr->m_address_data, address_size);
+}
+
+template <class task_Ty, bool _arg_type_static_check, bool _spill, class target_Ty, class function_Ty, class ... arg_Ty>
+inline cool::_threads_base::_task_fill<task_Ty, _arg_type_static_check, _spill, target_Ty, function_Ty, arg_Ty ...>::_task_fill(target_Ty target, function_Ty& task, arg_Ty&& ... args) noexcept
+	: m_target(std::forward<target_Ty>(target)), m_task(task), m_args(std::forward<arg_Ty>(args)...)
+{
+	constexpr bool doom = !(sizeof(pack_type) <= task_Ty::arg_buffer_size) || !(alignof(pack_type) <= alignof(task_Ty));
+	if (doom)
+	{
+		assert(false && "cool::threads<...>::async : task arguments size or alignment too large");
+		std::terminate();
+	}
+}
+
+template <class task_Ty, bool _arg_type_static_check, bool _spill, class target_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::_threads_base::_task_fill<task_Ty, _arg_type_static_check, _spill, target_Ty, function_Ty, arg_Ty ...>::operator()(task_Ty* task_ptr, cool::_threads_base::_arg_slab* arg_slab_ptr)
+{
+	if (!construct(task_ptr, arg_slab_ptr, cool::_threads_base::build_indices<sizeof...(arg_Ty)>()))
+	{
+		return false;
+	}
+
+	task_ptr->m_address_data.m_function_ptr = cool::_threads_base::_task_traits<function_Ty>::address(m_task);
+	set_target(task_ptr, m_target);
+
+	return true;
+}
+
+template <class task_Ty, bool _arg_type_static_check, bool _spill, class target_Ty, class function_Ty, class ... arg_Ty> template <std::size_t ... _indices>
+inline bool cool::_threads_base::_task_fill<task_Ty, _arg_type_static_check, _spill, target_Ty, function_Ty, arg_Ty ...>::construct(task_Ty* task_ptr, cool::_threads_base::_arg_slab* arg_slab_ptr, cool::_threads_base::indices<_indices...>)
+{
+	return cool::_threads_base::_task_traits<function_Ty>::template construct<pack_type>(task_ptr->m_arg_buffer, arg_slab_ptr, std::move(m_task), std::forward<arg_Ty>(std::get<_indices>(m_args))...);
+}
+
+template <class task_Ty, bool _arg_type_static_check, bool _spill, class target_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::_threads_base::_task_fill<task_Ty, _arg_type_static_check, _spill, target_Ty, function_Ty, arg_Ty ...>::set_target(task_Ty* task_ptr, cool::no_target_t) noexcept
+{
+	task_ptr->m_address_data.m_callable = &cool::_threads_base::_task_callable<task_Ty, function_Ty, pack_type>::no_target;
+}
+
+template <class task_Ty, bool _arg_type_static_check, bool _spill, class target_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::_threads_base::_task_fill<task_Ty, _arg_type_static_check, _spill, target_Ty, function_Ty, arg_Ty ...>::set_target(task_Ty* task_ptr, cool::async_end& target) noexcept
+{
+	task_ptr->m_address_data.m_target_ptr = static_cast<void*>(&target);
+	task_ptr->m_address_data.m_callable = &cool::_threads_base::_task_callable<task_Ty, function_Ty, pack_type>::async_end;
+}
+
+template <class task_Ty, bool _arg_type_static_check, bool _spill, class target_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::_threads_base::_task_fill<task_Ty, _arg_type_static_check, _spill, target_Ty, function_Ty, arg_Ty ...>::set_target(task_Ty* task_ptr, cool::_async_end_incr_proxy& target) noexcept
+{
+	target.m_parent_ptr->m_completion.incr();
+
+	set_target(task_ptr, *target.m_parent_ptr);
+}
+
+template <class task_Ty, bool _arg_type_static_check, bool _spill, class target_Ty, class function_Ty, class ... arg_Ty> template <class return_Ty>
+inline void cool::_threads_base::_task_fill<task_Ty, _arg_type_static_check, _spill, target_Ty, function_Ty, arg_Ty ...>::set_target(task_Ty* task_ptr, cool::_async_result_to_proxy<return_Ty>& target) noexcept
+{
+	task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
+	task_ptr->m_address_data.m_offset = target.m_offset;
+	task_ptr->m_address_data.m_callable = &cool::_threads_base::_task_callable<task_Ty, function_Ty, pack_type>::template async_result<return_Ty>;
+}
+
+template <class task_Ty, bool _arg_type_static_check, bool _spill, class target_Ty, class function_Ty, class ... arg_Ty> template <class return_Ty>
+inline void cool::_threads_base::_task_fill<task_Ty, _arg_type_static_check, _spill, target_Ty, function_Ty, arg_Ty ...>::set_target(task_Ty* task_ptr, cool::_async_result_incr_proxy<return_Ty>& target) noexcept
+{
+	target.m_parent_ptr->m_completion.incr();
+
+	task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
+	task_ptr->m_address_data.m_offset = target.m_offset;
+	task_ptr->m_address_data.m_callable = &cool::_threads_base::_task_callable<task_Ty, function_Ty, pack_type>::template async_result<return_Ty>;
+}
+
+
+// timer wheel detail
+
+template <class task_Ty>
+inline bool cool::_threads_base::_timer_wheel<task_Ty>::new_timers(std::size_t new_capacity, std::int64_t new_resolution_ns) noexcept
+{
+	delete_timers();
+
+	if (new_capacity == 0)
+	{
+		return true;
+	}
+
+	m_timers_unaligned_ptr = static_cast<char*>(::operator new(new_capacity * sizeof(_timer) + alignof(_timer), std::nothrow));
+
+	if (m_timers_unaligned_ptr == nullptr)
+	{
+		return false;
+	}
+
+	std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(m_timers_unaligned_ptr) % static_cast<std::uintptr_t>(alignof(_timer));
+
+	m_timers_ptr = reinterpret_cast<_timer*>(m_timers_unaligned_ptr
+		+ static_cast<std::size_t>(ptr_remainder != 0) * (alignof(_timer) - static_cast<std::size_t>(ptr_remainder)));
+
+	for (std::size_t k = 0; k < new_capacity; k++)
+	{
+		new (m_timers_ptr + k) _timer();
+		(m_timers_ptr + k)->m_next_ptr = (k + 1 < new_capacity) ? m_timers_ptr + k + 1 : nullptr;
+	}
+
+	m_free_ptr = m_timers_ptr;
+	m_capacity = new_capacity;
+	m_epoch_ns = now_ns();
+	m_resolution_ns = (new_resolution_ns > 0) ? new_resolution_ns : 1;
+
+	return true;
+}
+
+template <class task_Ty>
+inline void cool::_threads_base::_timer_wheel<task_Ty>::delete_timers() noexcept
+{
+	if (m_timers_ptr != nullptr)
+	{
+		for (std::size_t k = 0; k < m_capacity; k++)
+		{
+			(m_timers_ptr + k)->~_timer();
+		}
+	}
+
+	::operator delete(m_timers_unaligned_ptr);
+
+	m_arg_slab.release();
+
+	for (unsigned int level = 0; level < level_count; level++)
+	{
+		for (std::size_t slot = 0; slot < slot_count; slot++)
+		{
+			m_slots[level][slot] = nullptr;
+		}
+
+		m_occupied[level] = 0;
+	}
+
+	m_current_tick = 0;
+	m_due_ptr = nullptr;
+	m_free_ptr = nullptr;
+	m_timers_ptr = nullptr;
+	m_timers_unaligned_ptr = nullptr;
+	m_capacity = 0;
+	m_epoch_ns = 0;
+	m_resolution_ns = 1;
+
+	m_next_deadline_ns.store(no_deadline, std::memory_order_relaxed);
+	m_timer_count.store(0, std::memory_order_relaxed);
+	m_keeper.store(false, std::memory_order_relaxed);
+}
+
+template <class task_Ty>
+inline typename cool::_threads_base::_timer_wheel<task_Ty>::_timer* cool::_threads_base::_timer_wheel<task_Ty>::acquire() noexcept
+{
+	_timer* timer_ptr = m_free_ptr;
+
+	if (timer_ptr != nullptr)
+	{
+		m_free_ptr = timer_ptr->m_next_ptr;
+		m_timer_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	return timer_ptr;
+}
+
+template <class task_Ty>
+inline bool cool::_threads_base::_timer_wheel<task_Ty>::schedule(_timer* timer_ptr, std::int64_t deadline_ns) noexcept
+{
+	constexpr std::uint64_t max_tick = (static_cast<std::uint64_t>(1) << (level_count * slot_bit_count)) - 1;
+
+	std::int64_t previous_deadline_ns = m_next_deadline_ns.load(std::memory_order_relaxed);
+	std::uint64_t deadline_tick = 0;
+
+	if (deadline_ns > m_epoch_ns)
+	{
+		std::uint64_t resolution_ns = static_cast<std::uint64_t>(m_resolution_ns);
+		deadline_tick = (static_cast<std::uint64_t>(deadline_ns - m_epoch_ns) + resolution_ns - 1) / resolution_ns;
+		deadline_tick = (deadline_tick < max_tick) ? deadline_tick : max_tick;
+	}
+
+	timer_ptr->m_deadline_tick = deadline_tick;
+
+	if (deadline_tick <= m_current_tick)
+	{
+		timer_ptr->m_next_ptr = m_due_ptr;
+		m_due_ptr = timer_ptr;
+	}
+	else
+	{
+		file(timer_ptr);
+	}
+
+	update_next_deadline();
+
+	return m_next_deadline_ns.load(std::memory_order_relaxed) < previous_deadline_ns;
+}
+
+template <class task_Ty>
+inline typename cool::_threads_base::_timer_wheel<task_Ty>::_timer* cool::_threads_base::_timer_wheel<task_Ty>::expire(std::int64_t current_ns) noexcept
+{
+	_timer* due_ptr = m_due_ptr;
+	m_due_ptr = nullptr;
+
+	std::uint64_t current_tick = (current_ns > m_epoch_ns) ?
+		static_cast<std::uint64_t>(current_ns - m_epoch_ns) / static_cast<std::uint64_t>(m_resolution_ns) : 0;
+
+	unsigned int level = 0;
+	std::size_t slot = 0;
+	std::uint64_t event_tick = 0;
+
+	// the timers of a slot of level 0 are due, those of a higher level are filed again one level down at least
+
+	while (next_event(level, slot, event_tick) && (event_tick <= current_tick))
+	{
+		m_current_tick = event_tick;
+
+		_timer* timer_ptr = m_slots[level][slot];
+		m_slots[level][slot] = nullptr;
+		m_occupied[level] &= ~(static_cast<std::uint64_t>(1) << slot);
+
+		while (timer_ptr != nullptr)
+		{
+			_timer* next_ptr = timer_ptr->m_next_ptr;
+
+			if (timer_ptr->m_deadline_tick <= m_current_tick)
+			{
+				timer_ptr->m_next_ptr = due_ptr;
+				due_ptr = timer_ptr;
+			}
+			else
+			{
+				file(timer_ptr);
+			}
+
+			timer_ptr = next_ptr;
+		}
+	}
+
+	m_current_tick = (current_tick > m_current_tick) ? current_tick : m_current_tick;
+	update_next_deadline();
+
+	return due_ptr;
+}
+
+template <class task_Ty>
+inline void cool::_threads_base::_timer_wheel<task_Ty>::release(_timer* timer_ptr) noexcept
+{
+	timer_ptr->m_next_ptr = m_free_ptr;
+	m_free_ptr = timer_ptr;
+	m_timer_count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+template <class task_Ty>
+inline void cool::_threads_base::_timer_wheel<task_Ty>::postpone(_timer* timer_ptr) noexcept
+{
+	// 'timer_ptr' heads a list of due timers
+
+	_timer* last_ptr = timer_ptr;
+
+	while (last_ptr->m_next_ptr != nullptr)
+	{
+		last_ptr = last_ptr->m_next_ptr;
+	}
+
+	last_ptr->m_next_ptr = m_due_ptr;
+	m_due_ptr = timer_ptr;
+
+	update_next_deadline();
+}
+
+template <class task_Ty>
+inline void cool::_threads_base::_timer_wheel<task_Ty>::file(_timer* timer_ptr) noexcept
+{
+	// requires 'm_deadline_tick' > 'm_current_tick' so that the slot is ahead of the current position on its level
+
+	std::uint64_t diff = timer_ptr->m_deadline_tick ^ m_current_tick;
+	unsigned int level = 0;
+
+	while ((level + 1 < level_count) && ((diff >> ((level + 1) * slot_bit_count)) != 0))
+	{
+		level++;
+	}
+
+	std::size_t slot = static_cast<std::size_t>((timer_ptr->m_deadline_tick >> (level * slot_bit_count)) & (slot_count - 1));
+
+	timer_ptr->m_next_ptr = m_slots[level][slot];
+	m_slots[level][slot] = timer_ptr;
+	m_occupied[level] |= static_cast<std::uint64_t>(1) << slot;
+}
+
+template <class task_Ty>
+inline bool cool::_threads_base::_timer_wheel<task_Ty>::next_event(unsigned int& level, std::size_t& slot, std::uint64_t& event_tick) const noexcept
+{
+	bool found = false;
+
+	for (unsigned int k = 0; k < level_count; k++)
+	{
+		unsigned int shift = k * slot_bit_count;
+		std::size_t position = static_cast<std::size_t>((m_current_tick >> shift) & (slot_count - 1));
+		std::uint64_t ahead = (position + 1 < slot_count) ? m_occupied[k] & ~((static_cast<std::uint64_t>(2) << position) - 1) : 0;
+
+		if (ahead != 0)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			std::size_t first_slot = static_cast<std::size_t>(__builtin_ctzll(static_cast<unsigned long long>(ahead)));
+#elif defined(_MSC_VER) && defined(_M_X64)
+			unsigned long index = 0;
+			_BitScanForward64(&index, ahead);
+			std::size_t first_slot = static_cast<std::size_t>(index);
+#else
+			std::size_t first_slot = 0;
+			while (((ahead >> first_slot) & 1) == 0)
+			{
+				first_slot++;
+			}
+#endif
+			std::uint64_t tick = (((m_current_tick >> shift) & ~static_cast<std::uint64_t>(slot_count - 1)) | static_cast<std::uint64_t>(first_slot)) << shift;
+
+			if (!found || (tick < event_tick))
+			{
+				found = true;
+				level = k;
+				slot = first_slot;
+				event_tick = tick;
+			}
+		}
+	}
+
+	return found;
+}
+
+template <class task_Ty>
+inline void cool::_threads_base::_timer_wheel<task_Ty>::update_next_deadline() noexcept
+{
+	std::int64_t next_deadline_ns = no_deadline;
+
+	unsigned int level = 0;
+	std::size_t slot = 0;
+	std::uint64_t event_tick = 0;
+
+	if (m_due_ptr != nullptr)
+	{
+		next_deadline_ns = (std::numeric_limits<std::int64_t>::min)();
+	}
+	else if (next_event(level, slot, event_tick)
+		&& (event_tick <= static_cast<std::uint64_t>((no_deadline - ((m_epoch_ns > 0) ? m_epoch_ns : 0)) / m_resolution_ns)))
+	{
+		next_deadline_ns = m_epoch_ns + static_cast<std::int64_t>(event_tick) * m_resolution_ns;
+	}
+
+	m_next_deadline_ns.store(next_deadline_ns, std::memory_order_relaxed);
+}
+
+
+#ifdef COOL_THREADS_STATS
+
+// threads stats detail
+
+template <std::size_t _cache_line_size>
+inline void cool::_threads_base::_stats_block<_cache_line_size>::record_task(std::int64_t start, void(*function_ptr)(void)) noexcept
+{
+	m_tasks_executed.fetch_add(1, std::memory_order_relaxed);
+
+#if defined(COOL_THREADS_STATS_HISTOGRAM) || defined(COOL_THREADS_TRACE)
+	std::int64_t duration = cool::_threads_base::stats_now() - start;
+#endif // defined(COOL_THREADS_STATS_HISTOGRAM) || defined(COOL_THREADS_TRACE)
+
+#ifdef COOL_THREADS_STATS_HISTOGRAM
+	std::size_t bucket = 0;
+	for (std::uint64_t remainder = (duration > 0) ? static_cast<std::uint64_t>(duration) : 0;
+		(remainder != 0) && (bucket < cool::threads_stats::histogram_size - 1); remainder >>= 1)
+	{
+		bucket++;
+	}
+	m_task_time_histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+#endif // COOL_THREADS_STATS_HISTOGRAM
+
+#ifdef COOL_THREADS_TRACE
+	std::size_t trace_count = m_trace_count.load(std::memory_order_relaxed);
+	_trace_event& event = m_trace[trace_count & (static_cast<std::size_t>(COOL_THREADS_TRACE_SIZE) - 1)];
+	event.m_start = start;
+	event.m_duration = duration;
+	event.m_function_ptr = function_ptr;
+	m_trace_count.store(trace_count + 1, std::memory_order_release);
+#else // COOL_THREADS_TRACE
+	static_cast<void>(start);
+	static_cast<void>(function_ptr);
+#endif // COOL_THREADS_TRACE
+}
+
+template <std::size_t _cache_line_size>
+inline void cool::_threads_base::_stats_block<_cache_line_size>::add_to(cool::threads_stats& stats) const noexcept
+{
+	stats.m_tasks_executed += m_tasks_executed.load(std::memory_order_relaxed);
+	stats.m_probe_hits += m_probe_hits.load(std::memory_order_relaxed);
+	stats.m_probe_misses += m_probe_misses.load(std::memory_order_relaxed);
+
+#ifdef COOL_THREADS_STATS_HISTOGRAM
+	for (std::size_t k = 0; k < cool::threads_stats::histogram_size; k++)
+	{
+		stats.m_task_time_histogram[k] += m_task_time_histogram[k].load(std::memory_order_relaxed);
+	}
+#endif // COOL_THREADS_STATS_HISTOGRAM
+}
+
+template <std::size_t _cache_line_size>
+inline void cool::_threads_base::_stats_block<_cache_line_size>::reset() noexcept
+{
+	m_tasks_executed.store(0, std::memory_order_relaxed);
+	m_probe_hits.store(0, std::memory_order_relaxed);
+	m_probe_misses.store(0, std::memory_order_relaxed);
+
+#ifdef COOL_THREADS_STATS_HISTOGRAM
+	for (std::size_t k = 0; k < cool::threads_stats::histogram_size; k++)
+	{
+		m_task_time_histogram[k].store(0, std::memory_order_relaxed);
+	}
+#endif // COOL_THREADS_STATS_HISTOGRAM
+}
+
+#ifdef COOL_THREADS_TRACE
+template <std::size_t _cache_line_size> template <class ostream_Ty>
+inline void cool::_threads_base::_stats_block<_cache_line_size>::write_chrome_trace(ostream_Ty& os, std::size_t thread_number, bool& first) const
+{
+	// timestamps are written in microseconds with 3 decimals
+
+	auto write_us = [&os](std::int64_t ns)
+	{
+		if (ns < 0) { ns = 0; }
+		os << (ns / 1000) << '.' << static_cast<char>('0' + (ns / 100) % 10) << static_cast<char>('0' + (ns / 10) % 10) << static_cast<char>('0' + ns % 10);
+	};
+
+	std::size_t trace_count = m_trace_count.load(std::memory_order_acquire);
+	std::size_t trace_first = (trace_count > static_cast<std::size_t>(COOL_THREADS_TRACE_SIZE)) ? trace_count - static_cast<std::size_t>(COOL_THREADS_TRACE_SIZE) : 0;
+
+	for (std::size_t n = trace_first; n < trace_count; n++)
+	{
+		const _trace_event& event = m_trace[n & (static_cast<std::size_t>(COOL_THREADS_TRACE_SIZE) - 1)];
+
+		os << (first ? "\n" : ",\n") << "{\"name\":\"task\",\"cat\":\"cool_threads\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread_number << ",\"ts\":";
+		write_us(event.m_start);
+		os << ",\"dur\":";
+		write_us(event.m_duration);
+		os << ",\"args\":{\"function\":" << reinterpret_cast<std::uintptr_t>(event.m_function_ptr) << "}}";
+		first = false;
+	}
+}
+#endif // COOL_THREADS_TRACE
+
+#endif // COOL_THREADS_STATS
+
+
+// threads_sq detail
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::threads_sq::~threads_sq()
+{
+	delete_threads();
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, false, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, false, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_end_incr_proxy, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, false, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_end_incr_proxy, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_to_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, false, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_to_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_incr_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, false, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_incr_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, true, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, true, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_end_incr_proxy, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_end_incr_proxy, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, true, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_to_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_to_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, true, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_incr_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_incr_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, true, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_at(cool::time_point<clock_Ty> deadline, cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	return this->push_timer(fill, cool::_threads_base::_timer_wheel<_task>::deadline_ns(deadline));
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_at(cool::time_point<clock_Ty> deadline, cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	return this->push_timer(fill, cool::_threads_base::_timer_wheel<_task>::deadline_ns(deadline));
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_at(cool::time_point<clock_Ty> deadline, cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_end_incr_proxy, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return this->push_timer(fill, cool::_threads_base::_timer_wheel<_task>::deadline_ns(deadline));
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_at(cool::time_point<clock_Ty> deadline, cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_to_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return this->push_timer(fill, cool::_threads_base::_timer_wheel<_task>::deadline_ns(deadline));
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_at(cool::time_point<clock_Ty> deadline, cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_incr_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return this->push_timer(fill, cool::_threads_base::_timer_wheel<_task>::deadline_ns(deadline));
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_after(cool::duration<clock_Ty> delay, cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	return async_at(cool::time_point<clock_Ty>(cool::now) + delay, cool::no_target, std::move(task), std::forward<arg_Ty>(args)...);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_after(cool::duration<clock_Ty> delay, cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	return async_at(cool::time_point<clock_Ty>(cool::now) + delay, target, std::move(task), std::forward<arg_Ty>(args)...);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_after(cool::duration<clock_Ty> delay, cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	return async_at(cool::time_point<clock_Ty>(cool::now) + delay, std::move(target), std::move(task), std::forward<arg_Ty>(args)...);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_after(cool::duration<clock_Ty> delay, cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	return async_at(cool::time_point<clock_Ty>(cool::now) + delay, std::move(target), std::move(task), std::forward<arg_Ty>(args)...);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_after(cool::duration<clock_Ty> delay, cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	return async_at(cool::time_point<clock_Ty>(cool::now) + delay, std::move(target), std::move(task), std::forward<arg_Ty>(args)...);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class index_Ty, class ... arg_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_batch(cool::no_target_t, function_Ty task, index_Ty first, index_Ty last, const arg_Ty& ... args) noexcept
+{
+	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thsq_pack = typename cool::_threads_base::_arg_pack<typename cool::_threads_base::_task_traits<function_Ty>::template pack<std::tuple<index_Ty, typename std::decay<arg_Ty>::type ...>>, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::type;
+
+	static_assert(cool::_threads_base::_task_traits<function_Ty>::valid,
+		"cool::threads_sq<...>::async_batch : task must be a function pointer or a nothrow move constructible callable");
+	static_assert(std::is_integral<index_Ty>::value, "cool::threads_sq<...>::async_batch : index type must be integral");
+	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::async_batch : task arguments size too large");
+	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::async_batch : task arguments alignment too large");
+
+	constexpr bool doom = !(sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !(alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task));
+	if (doom)
+	{
+		assert(false && "cool::threads_sq<...>::async_batch : task arguments size or alignment too large");
+		std::terminate();
+	}
+
+	if (!(first < last))
+	{
+		return;
+	}
+
+	auto fill = [&](_cool_thsq_task* task_ptr, std::size_t offset, cool::_threads_base::_arg_slab* arg_slab_ptr)
+	{
+		if (!(cool::_threads_base::_task_traits<function_Ty>::template construct<_cool_thsq_pack>(task_ptr->m_arg_buffer, arg_slab_ptr, task, static_cast<index_Ty>(first + static_cast<index_Ty>(offset)), args...)))
+		{
+			return false;
+		}
+
+		task_ptr->m_address_data.m_function_ptr = cool::_threads_base::_task_traits<function_Ty>::address(task);
+		task_ptr->m_address_data.m_callable = &cool::_threads_base::_task_callable<_cool_thsq_task, function_Ty, _cool_thsq_pack>::no_target;
+
+		return true;
+	};
+
+	push_batch(fill, static_cast<std::size_t>(last - first), false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class index_Ty, class ... arg_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_batch(cool::async_end& target, function_Ty task, index_Ty first, index_Ty last, const arg_Ty& ... args) noexcept
+{
+	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thsq_pack = typename cool::_threads_base::_arg_pack<typename cool::_threads_base::_task_traits<function_Ty>::template pack<std::tuple<index_Ty, typename std::decay<arg_Ty>::type ...>>, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::type;
+
+	static_assert(cool::_threads_base::_task_traits<function_Ty>::valid,
+		"cool::threads_sq<...>::async_batch : task must be a function pointer or a nothrow move constructible callable");
+	static_assert(std::is_integral<index_Ty>::value, "cool::threads_sq<...>::async_batch : index type must be integral");
+	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::async_batch : task arguments size too large");
+	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::async_batch : task arguments alignment too large");
+
+	constexpr bool doom = !(sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !(alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task));
+	if (doom)
+	{
+		assert(false && "cool::threads_sq<...>::async_batch : task arguments size or alignment too large");
+		std::terminate();
+	}
+
+	if (!(first < last))
+	{
+		return;
+	}
+
+	target.add_awaited(static_cast<std::size_t>(last - first));
+
+	auto fill = [&](_cool_thsq_task* task_ptr, std::size_t offset, cool::_threads_base::_arg_slab* arg_slab_ptr)
+	{
+		if (!(cool::_threads_base::_task_traits<function_Ty>::template construct<_cool_thsq_pack>(task_ptr->m_arg_buffer, arg_slab_ptr, task, static_cast<index_Ty>(first + static_cast<index_Ty>(offset)), args...)))
+		{
+			return false;
+		}
+
+		task_ptr->m_address_data.m_function_ptr = cool::_threads_base::_task_traits<function_Ty>::address(task);
+		task_ptr->m_address_data.m_target_ptr = static_cast<void*>(&target);
+		task_ptr->m_address_data.m_callable = &cool::_threads_base::_task_callable<_cool_thsq_task, function_Ty, _cool_thsq_pack>::async_end;
+
+		return true;
+	};
+
+	push_batch(fill, static_cast<std::size_t>(last - first), false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class index_Ty, class ... arg_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::parallel_for(index_Ty first, index_Ty last, index_Ty grain_size, function_Ty task, const arg_Ty& ... args) noexcept
+{
+	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thsq_pack = typename cool::_threads_base::_arg_pack<typename cool::_threads_base::_task_traits<function_Ty>::template pack<std::tuple<index_Ty, index_Ty, typename std::decay<arg_Ty>::type ...>>, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::type;
+
+	static_assert(cool::_threads_base::_task_traits<function_Ty>::valid,
+		"cool::threads_sq<...>::parallel_for : task must be a function pointer or a nothrow move constructible callable");
+	static_assert(std::is_integral<index_Ty>::value, "cool::threads_sq<...>::parallel_for : index type must be integral");
+	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::parallel_for : task arguments size too large");
+	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::parallel_for : task arguments alignment too large");
+
+	constexpr bool doom = !(sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !(alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task));
+	if (doom)
+	{
+		assert(false && "cool::threads_sq<...>::parallel_for : task arguments size or alignment too large");
+		std::terminate();
+	}
+
+	assert((grain_size > 0) && "cool::threads_sq<...>::parallel_for : grain size must be > 0");
+
+	if (!(first < last))
+	{
+		return;
+	}
+
+	index_Ty _grain_size = (grain_size > 0) ? grain_size : static_cast<index_Ty>(1);
+	std::size_t range_size = static_cast<std::size_t>(last - first);
+	std::size_t chunk_size = static_cast<std::size_t>(_grain_size);
+	std::size_t chunk_count = range_size / chunk_size + static_cast<std::size_t>(range_size % chunk_size != 0);
+
+	cool::async_end target;
+	target.add_awaited(chunk_count);
+
+	auto fill = [&](_cool_thsq_task* task_ptr, std::size_t offset, cool::_threads_base::_arg_slab* arg_slab_ptr)
+	{
+		index_Ty chunk_first = static_cast<index_Ty>(first + static_cast<index_Ty>(offset * chunk_size));
+		index_Ty chunk_last = (offset + 1 != chunk_count) ? static_cast<index_Ty>(chunk_first + _grain_size) : last;
+
+		if (!(cool::_threads_base::_task_traits<function_Ty>::template construct<_cool_thsq_pack>(task_ptr->m_arg_buffer, arg_slab_ptr, task, chunk_first, chunk_last, args...)))
+		{
+			return false;
+		}
+
+		task_ptr->m_address_data.m_function_ptr = cool::_threads_base::_task_traits<function_Ty>::address(task);
+		task_ptr->m_address_data.m_target_ptr = static_cast<void*>(&target);
+		task_ptr->m_address_data.m_callable = &cool::_threads_base::_task_callable<_cool_thsq_task, function_Ty, _cool_thsq_pack>::async_end;
+
+		return true;
+	};
+
+	push_batch(fill, chunk_count, true);
+
+	target.finish(*this);
+}
+
+#ifdef xCOOL_THREADS_COROUTINES
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::_schedule_awaiter<cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>> cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::schedule() noexcept
+{
+	return cool::_schedule_awaiter<cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>>(this);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::_finish_awaiter<cool::async_end, cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>> cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::resume_after(cool::async_end& target) noexcept
+{
+	return cool::_finish_awaiter<cool::async_end, cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>>(&target, this);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty>
+inline cool::_finish_awaiter<cool::async_result<return_Ty>, cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>> cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::resume_after(cool::async_result<return_Ty>& target) noexcept
+{
+	return cool::_finish_awaiter<cool::async_result<return_Ty>, cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>>(&target, this);
+}
+#endif // xCOOL_THREADS_COROUTINES
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class ... arg_Ty>
+inline constexpr bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::arg_type_is_valid() noexcept
+{
+	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thsq_pack = typename cool::_threads_base::_arg_pack<std::tuple<typename std::decay<arg_Ty>::type ...>, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::type;
+
+	constexpr bool ret = (sizeof(_cool_thsq_pack) <= _arg_buffer_size) && (alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task));
+	return ret;
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::threads_init_result cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::init_new_threads(
+	cool::thread_count new_thread_count,
+	cool::task_buffer_size new_task_buffer_size,
+	cool::thread_affinity new_thread_affinity,
+	cool::elastic_policy new_elastic_policy,
+	cool::timer_wheel new_timer_wheel) noexcept
+{
+	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+
+	assert((reinterpret_cast<std::uintptr_t>(this) % cache_line_size == 0) && "cool::threads_sq<...> : object location must be aligned in memory");
+
+	if (reinterpret_cast<std::uintptr_t>(this) % cache_line_size != 0)
+	{
+		return cool::threads_init_result(cool::threads_init_result::bad_align);
+	}
+	else
+	{
+		delete_threads();
+		this->m_stop_threads = false;
+	}
+
+	if ((new_thread_count.value() == 0) || (new_task_buffer_size.value() == 0) || (new_elastic_policy.min_thread_count() > new_thread_count.value())
+		|| ((new_timer_wheel.capacity() != 0) && (new_timer_wheel.resolution_us() == 0)))
+	{
+		return cool::threads_init_result(cool::threads_init_result::bad_parameters);
+	}
+
+	std::size_t _new_thread_count = static_cast<std::size_t>(new_thread_count.value());
+	this->m_thread_count = _new_thread_count;
+
+	bool elastic = (new_elastic_policy.min_thread_count() != 0);
+	std::size_t active_thread_count = elastic ? static_cast<std::size_t>(new_elastic_policy.min_thread_count()) : _new_thread_count;
+
+	this->m_elastic.m_min_thread_count = static_cast<std::size_t>(new_elastic_policy.min_thread_count());
+	this->m_elastic.m_grow_queue_depth = elastic ? new_elastic_policy.grow_queue_depth() : 0;
+	this->m_elastic.m_idle_timeout_ms = elastic ? new_elastic_policy.idle_timeout_ms() : 0;
+	this->m_elastic.m_closed = false;
+	this->m_elastic.m_active_thread_count.store(active_thread_count, std::memory_order_relaxed);
+	this->m_retire_count = 0;
+	this->m_idle_thread_count.store(0, std::memory_order_relaxed);
+
+	std::size_t threads_constructed = 0;
+
+	this->m_threads_data_ptr = static_cast<std::thread*>(::operator new(
+		_new_thread_count * sizeof(std::thread) + 2 * cache_line_size, std::nothrow));
+
+	if (this->m_threads_data_ptr == nullptr)
+	{
+		this->delete_threads_detail(threads_constructed);
+		std::atomic_signal_fence(std::memory_order_release);
+		return cool::threads_init_result(cool::threads_init_result::bad_alloc);
+	}
+	else
+	{
+		this->m_threads_data_ptr = reinterpret_cast<std::thread*>(
+			reinterpret_cast<char*>(this->m_threads_data_ptr) + cache_line_size);
+	}
+
+	constexpr std::size_t task_buffer_padding = (cache_line_size > arg_buffer_align) ? cache_line_size : arg_buffer_align;
+	std::size_t new_task_buffer_size_p1 = new_task_buffer_size.value() + 1;
+
+	this->m_task_buffer_unaligned_data_ptr = static_cast<char*>(::operator new(new_task_buffer_size_p1 * sizeof(_cool_thsq_task) + task_buffer_padding + cache_line_size, std::nothrow));
+
+	if (this->m_task_buffer_unaligned_data_ptr == nullptr)
+	{
+		this->delete_threads_detail(threads_constructed);
+		std::atomic_signal_fence(std::memory_order_release);
+		return cool::threads_init_result(cool::threads_init_result::bad_alloc);
+	}
+	else
+	{
+		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_task_buffer_unaligned_data_ptr) % static_cast<std::uintptr_t>(task_buffer_padding);
+
+		this->m_task_buffer_data_ptr = reinterpret_cast<_cool_thsq_task*>(this->m_task_buffer_unaligned_data_ptr
+			+ static_cast<std::size_t>(ptr_remainder != 0) * (task_buffer_padding - static_cast<std::size_t>(ptr_remainder)));
+	}
+
+	this->m_task_buffer_end_ptr = this->m_task_buffer_data_ptr + new_task_buffer_size_p1;
+	this->m_last_task_ptr = this->m_task_buffer_data_ptr;
+	this->m_next_task_ptr = this->m_task_buffer_data_ptr;
+
+	for (std::size_t k = 0; k < new_task_buffer_size_p1; k++)
+	{
+		new (this->m_task_buffer_data_ptr + k) _cool_thsq_task();
+	}
+
+	this->m_thread_cpus_ptr = new (std::nothrow) int[_new_thread_count];
+	this->m_thread_stopped_ptr = new (std::nothrow) bool[_new_thread_count];
+
+	if ((this->m_thread_cpus_ptr == nullptr) || (this->m_thread_stopped_ptr == nullptr))
+	{
+		this->delete_threads_detail(threads_constructed);
+		std::atomic_signal_fence(std::memory_order_release);
+		return cool::threads_init_result(cool::threads_init_result::bad_alloc);
+	}
+
+	cool::_threads_base::affinity_plan(new_thread_affinity, this->m_thread_cpus_ptr, _new_thread_count);
+
+	if (!(this->m_timer_wheel.new_timers(new_timer_wheel.capacity(), static_cast<std::int64_t>(new_timer_wheel.resolution_us()) * 1000)))
+	{
+		this->delete_threads_detail(threads_constructed);
+		std::atomic_signal_fence(std::memory_order_release);
+		return cool::threads_init_result(cool::threads_init_result::bad_alloc);
+	}
+
+#ifdef COOL_THREADS_STATS
+	{
+		using _cool_thsq_stats = cool::_threads_base::_stats_block<_cache_line_size>;
+
+		this->m_stats_unaligned_data_ptr = static_cast<char*>(::operator new(_new_thread_count * sizeof(_cool_thsq_stats) + cache_line_size, std::nothrow));
+
+		if (this->m_stats_unaligned_data_ptr == nullptr)
+		{
+			this->delete_threads_detail(threads_constructed);
+			std::atomic_signal_fence(std::memory_order_release);
+			return cool::threads_init_result(cool::threads_init_result::bad_alloc);
+		}
+
+		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_stats_unaligned_data_ptr) % static_cast<std::uintptr_t>(cache_line_size);
+
+		this->m_stats_data_ptr = reinterpret_cast<_cool_thsq_stats*>(this->m_stats_unaligned_data_ptr
+			+ static_cast<std::size_t>(ptr_remainder != 0) * (cache_line_size - static_cast<std::size_t>(ptr_remainder)));
+
+		for (std::size_t k = 0; k < _new_thread_count; k++)
+		{
+			new (this->m_stats_data_ptr + k) _cool_thsq_stats();
+		}
+
+		this->m_submit_stats.m_try_async_failures.store(0, std::memory_order_relaxed);
+		this->m_submit_stats.m_full_queue_retries.store(0, std::memory_order_relaxed);
+	}
+#endif // COOL_THREADS_STATS
+
+	// slots past the active thread count of an elastic pool hold a thread object that is not running
+
+	for (std::size_t k = 0; k < _new_thread_count; k++)
+	{
+		*(this->m_thread_stopped_ptr + k) = (k >= active_thread_count);
+
+		xCOOL_THREADS_TRY
+		{
+			if (k < active_thread_count)
+			{
+				new (this->m_threads_data_ptr + k) std::thread([this, k]() { this->run_thread(k); });
+			}
+			else
+			{
+				new (this->m_threads_data_ptr + k) std::thread();
+			}
+		}
+		xCOOL_THREADS_CATCH(...)
+		{
+			this->delete_threads_detail(threads_constructed);
+			std::atomic_signal_fence(std::memory_order_release);
+			return cool::threads_init_result(cool::threads_init_result::bad_thread_creation);
+		}
+
+		threads_constructed++;
+	}
+
+	std::atomic_signal_fence(std::memory_order_release);
+	this->m_good.store(true, std::memory_order_seq_cst);
+	return cool::threads_init_result(cool::threads_init_result::success);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::good() const noexcept
+{
+	return this->m_good.load(std::memory_order_seq_cst);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::size_t cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_count() const noexcept
+{
+	std::atomic_signal_fence(std::memory_order_acquire);
+	return this->m_thread_count;
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::size_t cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::task_buffer_size() const noexcept
+{
+	std::atomic_signal_fence(std::memory_order_acquire);
+
+	if (this->m_task_buffer_data_ptr != nullptr)
+	{
+		return static_cast<std::size_t>(this->m_task_buffer_end_ptr - this->m_task_buffer_data_ptr) - 1;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::size_t cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::active_thread_count() const noexcept
+{
+	return this->m_elastic.m_active_thread_count.load(std::memory_order_relaxed);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::set_active_thread_count(std::size_t new_active_thread_count) noexcept
+{
+	if (!this->m_elastic.enabled())
+	{
+		return;
+	}
+
+	std::size_t target_thread_count = (new_active_thread_count > this->m_elastic.m_min_thread_count) ? new_active_thread_count : this->m_elastic.m_min_thread_count;
+	target_thread_count = (target_thread_count < this->m_thread_count) ? target_thread_count : this->m_thread_count;
+
+	xCOOL_THREADS_TRY
+	{
+		std::lock_guard<std::mutex> control_lock(this->m_elastic.m_mutex);
+
+		if (this->m_elastic.m_closed)
+		{
+			return;
+		}
+
+		std::size_t start_count = 0;
+
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+
+			std::size_t active_thread_count = this->m_elastic.m_active_thread_count.load(std::memory_order_relaxed);
+
+			if (target_thread_count < active_thread_count)
+			{
+				this->m_retire_count += active_thread_count - target_thread_count;
+			}
+			else
+			{
+				// pending retirements are cancelled first
+
+				std::size_t cancel_count = (this->m_retire_count < target_thread_count - active_thread_count) ? this->m_retire_count : target_thread_count - active_thread_count;
+				this->m_retire_count -= cancel_count;
+				start_count = target_thread_count - active_thread_count - cancel_count;
+			}
+
+			this->m_elastic.m_active_thread_count.store(target_thread_count - start_count, std::memory_order_relaxed);
+		}
+
+		this->m_condition_var.notify_all();
+
+		while ((start_count != 0) && this->start_stopped_thread())
+		{
+			start_count--;
+		}
+	}
+	xCOOL_THREADS_CATCH(...) {}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::delete_threads() noexcept
+{
+	this->m_good.store(false, std::memory_order_seq_cst);
+	this->fire_timers(true);
+	this->delete_threads_detail(this->m_thread_count);
+	std::atomic_signal_fence(std::memory_order_release);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::safety_refresh() noexcept
+{
+	this->m_condition_var.notify_all();
+}
+
+#ifdef COOL_THREADS_STATS
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::threads_stats cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::stats() noexcept
+{
+	cool::threads_stats stats;
+
+	if (this->m_stats_data_ptr != nullptr)
+	{
+		for (std::size_t k = 0; k < this->m_thread_count; k++)
+		{
+			(this->m_stats_data_ptr + k)->add_to(stats);
+		}
+	}
+
+	stats.m_try_async_failures = this->m_submit_stats.m_try_async_failures.load(std::memory_order_relaxed);
+	stats.m_full_queue_retries = this->m_submit_stats.m_full_queue_retries.load(std::memory_order_relaxed);
+
+	while (true)
+	{
+		xCOOL_THREADS_TRY
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+
+			if (this->m_task_buffer_data_ptr != nullptr)
+			{
+				std::ptrdiff_t depth = this->m_last_task_ptr - this->m_next_task_ptr;
+				stats.m_queue_depth = static_cast<std::size_t>((depth >= 0) ? depth : depth + (this->m_task_buffer_end_ptr - this->m_task_buffer_data_ptr));
+			}
+			break;
+		}
+		xCOOL_THREADS_CATCH(...) {}
+	}
+
+	return stats;
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::reset_stats() noexcept
+{
+	if (this->m_stats_data_ptr != nullptr)
+	{
+		for (std::size_t k = 0; k < this->m_thread_count; k++)
+		{
+			(this->m_stats_data_ptr + k)->reset();
+		}
+	}
+
+	this->m_submit_stats.m_try_async_failures.store(0, std::memory_order_relaxed);
+	this->m_submit_stats.m_full_queue_retries.store(0, std::memory_order_relaxed);
+}
+#endif // COOL_THREADS_STATS
+
+#ifdef COOL_THREADS_TRACE
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class ostream_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::write_chrome_trace(ostream_Ty& os) const
+{
+	bool first = true;
+
+	os << "{\"traceEvents\":[";
+
+	if (this->m_stats_data_ptr != nullptr)
+	{
+		for (std::size_t k = 0; k < this->m_thread_count; k++)
+		{
+			(this->m_stats_data_ptr + k)->write_chrome_trace(os, k, first);
+		}
+	}
+
+	os << "\n]}\n";
+}
+#endif // COOL_THREADS_TRACE
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::thread::id cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_id(std::size_t thread_number) const noexcept
+{
+	return (this->m_threads_data_ptr + thread_number)->get_id();
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::_thread_const_iterator_proxy<cool::_thread_iterator<cool::_thread_sq_id>> cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_ids() const noexcept
+{
+	return cool::_thread_const_iterator_proxy<cool::_thread_iterator<cool::_thread_sq_id>>(this->m_threads_data_ptr, this->m_threads_data_ptr + this->m_thread_count);
+}
+
+#ifdef COOL_THREADS_NATIVE_HANDLE
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::thread::native_handle_type cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_native_handle(std::size_t thread_number)
+{
+	return (this->m_threads_data_ptr + thread_number)->native_handle();
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::_thread_iterator_proxy<cool::_thread_iterator<cool::_thread_sq_native_handle>> cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_native_handles() noexcept
+{
+	return cool::_thread_iterator_proxy<cool::_thread_iterator<cool::_thread_sq_native_handle>>(this->m_threads_data_ptr, this->m_threads_data_ptr + this->m_thread_count);
+}
+#endif // COOL_THREADS_NATIVE_HANDLE
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class fill_Ty>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::push_batch(fill_Ty& fill, std::size_t task_count, bool run_pending) noexcept
+{
+	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+
+	std::size_t tasks_pushed = 0;
+
+	while (tasks_pushed < task_count)
+	{
+		std::size_t tasks_pushed_now = 0;
+
+		xCOOL_THREADS_TRY
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+
+			while (tasks_pushed + tasks_pushed_now < task_count)
+			{
+				_cool_thsq_task* last_task_ptr_p1 = (this->m_last_task_ptr + 1 != this->m_task_buffer_end_ptr) ? this->m_last_task_ptr + 1 : this->m_task_buffer_data_ptr;
+
+				if ((last_task_ptr_p1 == this->m_next_task_ptr) || !fill(this->m_last_task_ptr, tasks_pushed + tasks_pushed_now, &this->m_arg_slab))
+				{
+					break;
+				}
+
+				this->m_last_task_ptr = last_task_ptr_p1;
+				tasks_pushed_now++;
+			}
+		}
+		xCOOL_THREADS_CATCH(...) {}
+
+		if (tasks_pushed_now != 0)
+		{
+			tasks_pushed += tasks_pushed_now;
+
+			if (tasks_pushed_now < this->m_thread_count)
+			{
+				for (std::size_t k = 0; k < tasks_pushed_now; k++)
+				{
+					this->m_condition_var.notify_one();
+				}
+			}
+			else
+			{
+				this->m_condition_var.notify_all();
+			}
+
+			this->grow_if_saturated();
+		}
+		else
+		{
+			xCOOL_THREADS_STATS(this->m_submit_stats.m_full_queue_retries.fetch_add(1, std::memory_order_relaxed);)
+
+			if (!run_pending || !this->run_pending_task())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::run_thread(std::size_t thread_num)
+{
+	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+
+	cool::_threads_base::pin_this_thread(*(this->m_thread_cpus_ptr + thread_num));
+	this->this_thread_owner() = this;
+	xCOOL_THREADS_STATS(cool::_threads_base::_stats_block<_cache_line_size>* stats_ptr = this->m_stats_data_ptr + thread_num;)
+
+	while (true)
+	{
+		xCOOL_THREADS_TRY
+		{
+			_cool_thsq_task current_task;
+
+			this->fire_timers(false);
+
+			{
+				std::unique_lock<std::mutex> lock(this->m_mutex);
+				bool timer_due = false;
+
+				if (!this->m_elastic.enabled() && !this->m_timer_wheel.enabled())
+				{
+					this->m_condition_var.wait(lock, [this]() -> bool { return (this->m_next_task_ptr != this->m_last_task_ptr) || this->m_stop_threads; });
+				}
+				else if (this->wait_for_task_timed(lock, thread_num, timer_due))
+				{
+					return;
+				}
+
+				if (this->m_next_task_ptr != this->m_last_task_ptr)
+				{
+					this->m_next_task_ptr->m_address_data.m_callable(&current_task, this->m_next_task_ptr);
+
+					this->m_next_task_ptr = (this->m_next_task_ptr + 1 != this->m_task_buffer_end_ptr) ?
+						this->m_next_task_ptr + 1 : this->m_task_buffer_data_ptr;
+				}
+				else if (timer_due)
+				{
+					continue; // the due timers are queued at the top of the loop
+				}
+				else
+				{
+					return;
+				}
+			}
+
+			xCOOL_THREADS_STATS(std::int64_t task_start = cool::_threads_base::stats_now();)
+			current_task.m_address_data.m_callable(&current_task, nullptr);
+			xCOOL_THREADS_STATS(stats_ptr->record_task(task_start, current_task.m_address_data.m_function_ptr);)
+		}
+		xCOOL_THREADS_CATCH(...) {}
+	}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::run_pending_task() noexcept
+{
+	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+
+	_cool_thsq_task current_task;
+
+	{
+		std::unique_lock<std::mutex> lock(this->m_mutex, std::try_to_lock);
+
+		if (!lock.owns_lock() || (this->m_next_task_ptr == this->m_last_task_ptr))
+		{
+			return false;
+		}
+
+		this->m_next_task_ptr->m_address_data.m_callable(&current_task, this->m_next_task_ptr);
+
+		this->m_next_task_ptr = (this->m_next_task_ptr + 1 != this->m_task_buffer_end_ptr) ?
+			this->m_next_task_ptr + 1 : this->m_task_buffer_data_ptr;
+	}
+
+	xCOOL_THREADS_TRY
+	{
+		current_task.m_address_data.m_callable(&current_task, nullptr);
+	}
+	xCOOL_THREADS_CATCH(...) {}
+
+	return true;
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::start_stopped_thread() noexcept
+{
+	std::size_t thread_num = this->m_thread_count;
+
+	while (true)
+	{
+		xCOOL_THREADS_TRY
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+
+			for (std::size_t k = 0; (k < this->m_thread_count) && !this->m_stop_threads; k++)
+			{
+				if (*(this->m_thread_stopped_ptr + k))
+				{
+					*(this->m_thread_stopped_ptr + k) = false;
+					this->m_elastic.m_active_thread_count.fetch_add(1, std::memory_order_relaxed);
+					thread_num = k;
+					break;
+				}
+			}
+			break;
+		}
+		xCOOL_THREADS_CATCH(...) {}
+	}
+
+	if (thread_num == this->m_thread_count)
+	{
+		return false;
+	}
+
+	// the previous thread of the slot, if any, has returned or is about to
+
+	std::thread* thread_ptr = this->m_threads_data_ptr + thread_num;
+	bool thread_started = false;
+
+	xCOOL_THREADS_TRY
+	{
+		if (thread_ptr->joinable())
+		{
+			thread_ptr->join();
+		}
+
+		*thread_ptr = std::thread([this, thread_num]() { this->run_thread(thread_num); });
+		thread_started = true;
+	}
+	xCOOL_THREADS_CATCH(...) {}
+
+	if (!thread_started)
+	{
+		while (true)
+		{
+			xCOOL_THREADS_TRY
+			{
+				std::lock_guard<std::mutex> lock(this->m_mutex);
+				*(this->m_thread_stopped_ptr + thread_num) = true;
+				this->m_elastic.m_active_thread_count.fetch_sub(1, std::memory_order_relaxed);
+				break;
+			}
+			xCOOL_THREADS_CATCH(...) {}
+		}
+	}
+
+	return thread_started;
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::grow_if_saturated() noexcept
+{
+	if ((this->m_elastic.m_grow_queue_depth != 0)
+		&& (this->m_idle_thread_count.load(std::memory_order_relaxed) == 0)
+		&& (this->m_elastic.m_active_thread_count.load(std::memory_order_relaxed) < this->m_thread_count))
+	{
+		xCOOL_THREADS_TRY
+		{
+			std::unique_lock<std::mutex> control_lock(this->m_elastic.m_mutex, std::try_to_lock);
+
+			if (control_lock.owns_lock() && !this->m_elastic.m_closed)
+			{
+				std::size_t queue_depth;
+
+				{
+					std::lock_guard<std::mutex> lock(this->m_mutex);
+
+					queue_depth = (this->m_last_task_ptr >= this->m_next_task_ptr) ? static_cast<std::size_t>(this->m_last_task_ptr - this->m_next_task_ptr)
+						: static_cast<std::size_t>((this->m_task_buffer_end_ptr - this->m_task_buffer_data_ptr) - (this->m_next_task_ptr - this->m_last_task_ptr));
+				}
+
+				if (queue_depth >= this->m_elastic.m_grow_queue_depth)
+				{
+					this->start_stopped_thread();
+				}
+			}
+		}
+		xCOOL_THREADS_CATCH(...) {}
+	}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class fill_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::push_timer(fill_Ty& fill, std::int64_t deadline_ns) noexcept
+{
+	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thsq_timer = typename cool::_threads_base::_timer_wheel<_cool_thsq_task>::_timer;
+
+	bool wake_up_required = false;
+
+	while (true)
+	{
+		xCOOL_THREADS_TRY
+		{
+			std::lock_guard<std::mutex> timer_lock(this->m_timer_wheel.m_mutex);
+
+			_cool_thsq_timer* timer_ptr = this->m_timer_wheel.acquire();
+
+			if (timer_ptr == nullptr)
+			{
+				return false;
+			}
+
+			if (!fill(&timer_ptr->m_task, &this->m_timer_wheel.m_arg_slab))
+			{
+				this->m_timer_wheel.release(timer_ptr);
+				return false;
+			}
+
+			wake_up_required = this->m_timer_wheel.schedule(timer_ptr, deadline_ns);
+			break;
+		}
+		xCOOL_THREADS_CATCH(...) {}
+	}
+
+	if (wake_up_required)
+	{
+		this->wake_timer_keeper();
+	}
+
+	return true;
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class fill_Ty>
+inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::push_task(fill_Ty& fill, bool front, bool wait_for_space) noexcept
+{
+	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+
+	while (true)
+	{
+		xCOOL_THREADS_TRY
+		{
+			std::unique_lock<std::mutex> lock(this->m_mutex);
+
+			_cool_thsq_task* last_task_ptr_p1 = (this->m_last_task_ptr + 1 != this->m_task_buffer_end_ptr) ? this->m_last_task_ptr + 1 : this->m_task_buffer_data_ptr;
+
+			_cool_thsq_task* next_task_ptr_m1 = (this->m_next_task_ptr != this->m_task_buffer_data_ptr) ? this->m_next_task_ptr - 1 : this->m_task_buffer_end_ptr - 1;
+
+			// a failed allocation of the task arguments is handled as a full queue
+
+			if ((last_task_ptr_p1 != this->m_next_task_ptr) && fill(front ? next_task_ptr_m1 : this->m_last_task_ptr, &this->m_arg_slab))
+			{
+				if (front)
+				{
+					this->m_next_task_ptr = next_task_ptr_m1;
+				}
+				else
+				{
+					this->m_last_task_ptr = last_task_ptr_p1;
+				}
+
+				lock.unlock();
+
+				this->m_condition_var.notify_one();
+				this->grow_if_saturated();
+				return true;
+			}
+			else if (!wait_for_space)
+			{
+				xCOOL_THREADS_STATS(this->m_submit_stats.m_try_async_failures.fetch_add(1, std::memory_order_relaxed);)
+				return false;
+			}
+		}
+		xCOOL_THREADS_CATCH(...) {}
+
+		xCOOL_THREADS_STATS(this->m_submit_stats.m_full_queue_retries.fetch_add(1, std::memory_order_relaxed);)
+
+		// a thread of the object must not only wait for space as all threads could do so, it runs a queued task meanwhile
+
+		if ((this->this_thread_owner() != this) || !this->run_pending_task())
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::fire_timers(bool flush) noexcept
+{
+	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thsq_timers = cool::_threads_base::_timer_wheel<_cool_thsq_task>;
+	using _cool_thsq_timer = typename _cool_thsq_timers::_timer;
+
+	if ((this->m_timer_wheel.m_timer_count.load(std::memory_order_relaxed) == 0)
+		|| (!flush && (_cool_thsq_timers::now_ns() < this->m_timer_wheel.m_next_deadline_ns.load(std::memory_order_relaxed))))
+	{
+		return;
+	}
+
+	while (true)
+	{
+		xCOOL_THREADS_TRY
+		{
+			// a thread that finds the timers locked leaves them to the thread holding the lock
+
+			std::unique_lock<std::mutex> timer_lock(this->m_timer_wheel.m_mutex, std::defer_lock);
+
+			if (flush)
+			{
+				timer_lock.lock();
+			}
+			else if (!timer_lock.try_lock())
+			{
+				return;
+			}
+
+			_cool_thsq_timer* timer_ptr = this->m_timer_wheel.expire(flush ? _cool_thsq_timers::no_deadline : _cool_thsq_timers::now_ns());
+
+			while (timer_ptr != nullptr)
+			{
+				_cool_thsq_timer* next_ptr = timer_ptr->m_next_ptr;
+
+				auto fill = [timer_ptr](_cool_thsq_task* task_ptr, cool::_threads_base::_arg_slab*) -> bool
+				{
+					timer_ptr->m_task.m_address_data.m_callable(task_ptr, &timer_ptr->m_task);
+					return true;
+				};
+
+				if (!(this->push_task(fill, false, flush)))
+				{
+					this->m_timer_wheel.postpone(timer_ptr); // the queue is full, the rest is queued on a later call
+					return;
+				}
+
+				this->m_timer_wheel.release(timer_ptr);
+				timer_ptr = next_ptr;
+			}
+
+			return;
+		}
+		xCOOL_THREADS_CATCH(...) {}
+	}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::wake_timer_keeper() noexcept
+{
+	// locking orders the new deadline before the predicate checks of the parked threads
+
+	while (true)
+	{
+		xCOOL_THREADS_TRY
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+			break;
+		}
+		xCOOL_THREADS_CATCH(...) {}
+	}
+
+	this->m_condition_var.notify_all();
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline void cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::delete_threads_detail(std::size_t threads_constructed) noexcept
+{
+	constexpr std::size_t cache_line_size = alignof(cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>);
+
+	while (true)
+	{
+		xCOOL_THREADS_TRY
+		{
+			std::lock_guard<std::mutex> control_lock(this->m_elastic.m_mutex);
+			std::unique_lock<std::mutex> lock(this->m_mutex);
+			this->m_elastic.m_closed = true;
+			this->m_stop_threads = true;
+			break;
+		}
+		xCOOL_THREADS_CATCH(...) {}
+	}
+
+	this->m_condition_var.notify_all();
+
+	if (this->m_threads_data_ptr != nullptr)
+	{
+		for (std::size_t k = 0; k < threads_constructed; k++)
+		{
+			if ((this->m_threads_data_ptr + k)->joinable())
+			{
+				std::thread::id thread_id = (this->m_threads_data_ptr + k)->get_id();
+
+				xCOOL_THREADS_TRY
+				{
+					(this->m_threads_data_ptr + k)->join();
+				}
+				xCOOL_THREADS_CATCH(const std::system_error& xCOOL_THREADS_SYSTEM_ERROR)
+				{
+					cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::catch_delete_thread_exception(xCOOL_THREADS_SYSTEM_ERROR, thread_id);
+				}
+			}
+			(this->m_threads_data_ptr + k)->~thread();
+		}
+
+		::operator delete(reinterpret_cast<char*>(this->m_threads_data_ptr) - cache_line_size);
+	}
+
+	if (this->m_task_buffer_data_ptr != nullptr)
+	{
+		std::size_t task_buffer_size = static_cast<std::size_t>(this->m_task_buffer_end_ptr - this->m_task_buffer_data_ptr);
+		for (std::size_t k = 0; k < task_buffer_size; k++)
+		{
+			(this->m_task_buffer_data_ptr + k)->~_task();
+		}
+
+		::operator delete(this->m_task_buffer_unaligned_data_ptr);
+	}
+
+	this->m_arg_slab.release();
+	this->m_timer_wheel.delete_timers();
+
+#ifdef COOL_THREADS_STATS
+	if (this->m_stats_data_ptr != nullptr)
+	{
+		for (std::size_t k = 0; k < this->m_thread_count; k++)
+		{
+			(this->m_stats_data_ptr + k)->~_stats_block();
+		}
+	}
+
+	::operator delete(this->m_stats_unaligned_data_ptr);
+
+	this->m_stats_data_ptr = nullptr;
+	this->m_stats_unaligned_data_ptr = nullptr;
+#endif // COOL_THREADS_STATS
+
+	delete[] this->m_thread_cpus_ptr;
+	delete[] this->m_thread_stopped_ptr;
+
+	this->m_threads_data_ptr = nullptr;
+	this->m_thread_count = 0;
+
+	this->m_task_buffer_data_ptr = nullptr;
+	this->m_task_buffer_end_ptr = nullptr;
+	this->m_last_task_ptr = nullptr;
+	this->m_next_task_ptr = nullptr;
+
+	this->m_task_buffer_unaligned_data_ptr = nullptr;
+	this->m_thread_cpus_ptr = nullptr;
+	this->m_thread_stopped_ptr = nullptr;
+	this->m_elastic.m_active_thread_count.store(0, std::memory_order_relaxed);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::wait_for_task_timed(std::unique_lock<std::mutex>& lock, std::size_t thread_num, bool& timer_due)
+{
+	using _cool_thsq_timers = cool::_threads_base::_timer_wheel<_task>;
+
+	bool keeper = false;
+	std::int64_t keeper_deadline_ns = _cool_thsq_timers::no_deadline;
+
+	// the keeper of the timers also wakes up if the next deadline moves earlier, the other threads if there is no keeper
+
+	auto wake_up = [this, &keeper, &keeper_deadline_ns]() -> bool {
+		return (this->m_next_task_ptr != this->m_last_task_ptr) || this->m_stop_threads || (this->m_retire_count != 0)
+			|| (keeper ? (this->m_timer_wheel.m_next_deadline_ns.load(std::memory_order_relaxed) < keeper_deadline_ns)
+				: ((this->m_timer_wheel.m_timer_count.load(std::memory_order_relaxed) != 0) && !(this->m_timer_wheel.m_keeper.load(std::memory_order_relaxed))));
+	};
+
+	std::chrono::steady_clock::time_point idle_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(this->m_elastic.m_idle_timeout_ms);
+
+	while ((this->m_next_task_ptr == this->m_last_task_ptr) && !this->m_stop_threads)
+	{
+		if (this->m_retire_count != 0)
+		{
+			this->m_retire_count--;
+			*(this->m_thread_stopped_ptr + thread_num) = true;
+			return true;
+		}
+
+		keeper = (this->m_timer_wheel.m_timer_count.load(std::memory_order_relaxed) != 0)
+			&& !(this->m_timer_wheel.m_keeper.exchange(true, std::memory_order_relaxed));
+		keeper_deadline_ns = keeper ? this->m_timer_wheel.m_next_deadline_ns.load(std::memory_order_relaxed) : _cool_thsq_timers::no_deadline;
+
+		bool timed_out = false;
+		this->m_idle_thread_count.fetch_add(1, std::memory_order_relaxed);
+
+		if ((this->m_elastic.m_idle_timeout_ms == 0) && (keeper_deadline_ns == _cool_thsq_timers::no_deadline))
+		{
+			this->m_condition_var.wait(lock, wake_up);
+		}
+		else
+		{
+			std::chrono::steady_clock::time_point wake_time = _cool_thsq_timers::wake_time(keeper_deadline_ns);
+
+			if ((this->m_elastic.m_idle_timeout_ms != 0) && ((keeper_deadline_ns == _cool_thsq_timers::no_deadline) || (idle_deadline < wake_time)))
+			{
+				wake_time = idle_deadline;
+			}
+
+			timed_out = !(this->m_condition_var.wait_until(lock, wake_time, wake_up));
+		}
+
+		this->m_idle_thread_count.fetch_sub(1, std::memory_order_relaxed);
+
+		if (keeper)
+		{
+			keeper = false;
+			this->m_timer_wheel.m_keeper.store(false, std::memory_order_relaxed);
+
+			if (_cool_thsq_timers::now_ns() >= this->m_timer_wheel.m_next_deadline_ns.load(std::memory_order_relaxed))
+			{
+				timer_due = true;
+				return false;
+			}
+			else if ((this->m_next_task_ptr != this->m_last_task_ptr) && (this->m_timer_wheel.m_timer_count.load(std::memory_order_relaxed) != 0))
+			{
+				this->m_condition_var.notify_one(); // another idle thread becomes the keeper
+			}
+		}
+
+		if (timed_out && (this->m_elastic.m_idle_timeout_ms != 0) && (std::chrono::steady_clock::now() >= idle_deadline)
+			&& this->m_elastic.try_retire(this->m_elastic.m_min_thread_count))
+		{
+			*(this->m_thread_stopped_ptr + thread_num) = true;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+// threads_lq detail
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::threads_lq::~threads_lq()
+{
+	delete_threads();
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::_async_end_incr_proxy, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::_async_result_to_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::_async_result_incr_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::_async_end_incr_proxy, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::_async_result_to_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::_async_result_incr_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class ... arg_Ty>
+inline constexpr bool cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::arg_type_is_valid() noexcept
+{
+	using _cool_thlq_task = typename cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thlq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+
+	constexpr bool ret = (sizeof(_cool_thlq_pack) <= _arg_buffer_size) && (alignof(_cool_thlq_pack) <= alignof(_cool_thlq_task));
+	return ret;
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::threads_init_result cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::init_new_threads(cool::thread_count new_thread_count, cool::task_buffer_size new_task_buffer_size) noexcept
+{
+	using _cool_thlq_task = typename cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thlq_slot = typename cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_ring_slot;
+
+	assert((reinterpret_cast<std::uintptr_t>(this) % cache_line_size == 0) && "cool::threads_lq<...> : object location must be aligned in memory");
+
+	if (reinterpret_cast<std::uintptr_t>(this) % cache_line_size != 0)
+	{
+		return cool::threads_init_result(cool::threads_init_result::bad_align);
+	}
+	else
+	{
+		delete_threads();
+		this->m_stop_threads.store(false, std::memory_order_relaxed);
+	}
+
+	if ((new_thread_count.value() == 0) || (new_task_buffer_size.value() == 0))
+	{
+		return cool::threads_init_result(cool::threads_init_result::bad_parameters);
+	}
+
+	std::size_t _new_thread_count = static_cast<std::size_t>(new_thread_count.value());
+	this->m_thread_count = _new_thread_count;
+
+	std::size_t threads_constructed = 0;
+
+	this->m_threads_data_ptr = static_cast<std::thread*>(::operator new(
+		_new_thread_count * sizeof(std::thread) + 2 * cache_line_size, std::nothrow));
+
+	if (this->m_threads_data_ptr == nullptr)
+	{
+		this->delete_threads_detail(threads_constructed);
+		std::atomic_signal_fence(std::memory_order_release);
+		return cool::threads_init_result(cool::threads_init_result::bad_alloc);
+	}
+	else
+	{
+		this->m_threads_data_ptr = reinterpret_cast<std::thread*>(
+			reinterpret_cast<char*>(this->m_threads_data_ptr) + cache_line_size);
+	}
+
+	constexpr std::size_t task_buffer_padding = (cache_line_size > arg_buffer_align) ? cache_line_size : arg_buffer_align;
+
+	std::size_t new_task_buffer_size_pow2 = 2;
+	while (new_task_buffer_size_pow2 < new_task_buffer_size.value())
+	{
+		new_task_buffer_size_pow2 *= 2;
+	}
+
+	this->m_task_buffer_unaligned_data_ptr = static_cast<char*>(::operator new(new_task_buffer_size_pow2 * sizeof(_cool_thlq_slot) + task_buffer_padding + cache_line_size, std::nothrow));
+
+	if (this->m_task_buffer_unaligned_data_ptr == nullptr)
+	{
+		this->delete_threads_detail(threads_constructed);
+		std::atomic_signal_fence(std::memory_order_release);
+		return cool::threads_init_result(cool::threads_init_result::bad_alloc);
+	}
+	else
+	{
+		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_task_buffer_unaligned_data_ptr) % static_cast<std::uintptr_t>(task_buffer_padding);
+
+		this->m_task_buffer_data_ptr = reinterpret_cast<_cool_thlq_slot*>(this->m_task_buffer_unaligned_data_ptr
+			+ static_cast<std::size_t>(ptr_remainder != 0) * (task_buffer_padding - static_cast<std::size_t>(ptr_remainder)));
+	}
+
+	this->m_task_buffer_mask = new_task_buffer_size_pow2 - 1;
+
+	for (std::size_t k = 0; k < new_task_buffer_size_pow2; k++)
+	{
+		new (this->m_task_buffer_data_ptr + k) _cool_thlq_slot();
+		(this->m_task_buffer_data_ptr + k)->m_sequence.store(k, std::memory_order_relaxed);
+	}
+
+	this->m_push_pos.store(0, std::memory_order_relaxed);
+	this->m_pop_pos.store(0, std::memory_order_relaxed);
+	this->m_sleeping_count.store(0, std::memory_order_relaxed);
+	this->m_space_waiting_count.store(0, std::memory_order_relaxed);
+
+	std::atomic_thread_fence(std::memory_order_release);
+
+	for (std::size_t k = 0; k < _new_thread_count; k++)
+	{
+		xCOOL_THREADS_TRY
+		{
+			new (this->m_threads_data_ptr + k) std::thread([this]()
+			{
+				this->this_thread_owner() = this;
+
+				while (true)
+				{
+					xCOOL_THREADS_TRY
+					{
+						_cool_thlq_task current_task;
+
+						if (this->pop_task(&current_task))
+						{
+							current_task.m_address_data.m_callable(&current_task, nullptr);
+						}
+						else
+						{
+							// declared as sleeping before checking again so that a concurrent push either is seen or wakes the thread
+
+							std::uint32_t epoch = this->m_task_parking.epoch();
+							this->m_sleeping_count.fetch_add(1, std::memory_order_seq_cst);
+
+							if (this->pop_task(&current_task))
+							{
+								this->m_sleeping_count.fetch_sub(1, std::memory_order_relaxed);
+								current_task.m_address_data.m_callable(&current_task, nullptr);
+							}
+							else if (this->m_stop_threads.load(std::memory_order_seq_cst))
+							{
+								this->m_sleeping_count.fetch_sub(1, std::memory_order_relaxed);
+								return;
+							}
+							else
+							{
+								this->m_task_parking.wait(epoch);
+
+								this->m_sleeping_count.fetch_sub(1, std::memory_order_relaxed);
+							}
+						}
+					}
+					xCOOL_THREADS_CATCH(...) {}
+				}
+			});
+		}
+		xCOOL_THREADS_CATCH(...)
+		{
+			this->delete_threads_detail(threads_constructed);
+			std::atomic_signal_fence(std::memory_order_release);
+			return cool::threads_init_result(cool::threads_init_result::bad_thread_creation);
+		}
+
+		threads_constructed++;
+	}
+
+	std::atomic_signal_fence(std::memory_order_release);
+	this->m_good.store(true, std::memory_order_seq_cst);
+	return cool::threads_init_result(cool::threads_init_result::success);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline bool cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::good() const noexcept
+{
+	return this->m_good.load(std::memory_order_seq_cst);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::size_t cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_count() const noexcept
+{
+	std::atomic_signal_fence(std::memory_order_acquire);
+	return this->m_thread_count;
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::size_t cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::task_buffer_size() const noexcept
+{
+	std::atomic_signal_fence(std::memory_order_acquire);
+
+	if (this->m_task_buffer_data_ptr != nullptr)
+	{
+		return this->m_task_buffer_mask + 1;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::delete_threads() noexcept
+{
+	this->m_good.store(false, std::memory_order_seq_cst);
+	this->delete_threads_detail(this->m_thread_count);
+	std::atomic_signal_fence(std::memory_order_release);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::safety_refresh() noexcept
+{
+	this->wake_threads(true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::thread::id cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_id(std::size_t thread_number) const noexcept
+{
+	return (this->m_threads_data_ptr + thread_number)->get_id();
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::_thread_const_iterator_proxy<cool::_thread_iterator<cool::_thread_sq_id>> cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_ids() const noexcept
+{
+	return cool::_thread_const_iterator_proxy<cool::_thread_iterator<cool::_thread_sq_id>>(this->m_threads_data_ptr, this->m_threads_data_ptr + this->m_thread_count);
+}
+
+#ifdef COOL_THREADS_NATIVE_HANDLE
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::thread::native_handle_type cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_native_handle(std::size_t thread_number)
+{
+	return (this->m_threads_data_ptr + thread_number)->native_handle();
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::_thread_iterator_proxy<cool::_thread_iterator<cool::_thread_sq_native_handle>> cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_native_handles() noexcept
+{
+	return cool::_thread_iterator_proxy<cool::_thread_iterator<cool::_thread_sq_native_handle>>(this->m_threads_data_ptr, this->m_threads_data_ptr + this->m_thread_count);
+}
+#endif // COOL_THREADS_NATIVE_HANDLE
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class fill_Ty>
+inline bool cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::push_task(fill_Ty& fill, bool wait_for_space) noexcept
+{
+	using _cool_thlq_slot = typename cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_ring_slot;
+
+	std::size_t pos = this->m_push_pos.load(std::memory_order_relaxed);
+	_cool_thlq_slot* slot_ptr;
+	unsigned int full_poll_counter = this->full_poll_count;
+
+	while (true)
+	{
+		slot_ptr = this->m_task_buffer_data_ptr + (pos & this->m_task_buffer_mask);
+
+		std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(slot_ptr->m_sequence.load(std::memory_order_acquire) - pos);
+
+		if (diff == 0)
+		{
+			if (this->m_push_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			if (!wait_for_space)
+			{
+				return false;
+			}
+
+			// a thread of the object must not only wait for space as all threads could do so, it runs a queued task meanwhile,
+			// other threads sleep until a pop frees a slot once they have yielded 'full_poll_count' times in a row
+
+			if (this->this_thread_owner() == this)
+			{
+				if (!this->run_pending_task())
+				{
+					std::this_thread::yield();
+				}
+			}
+			else if (full_poll_counter != 0)
+			{
+				full_poll_counter--;
+				std::this_thread::yield();
+			}
+			else
+			{
+				// declared as waiting before checking again so that a concurrent pop either is seen or wakes the thread
+
+				std::uint32_t epoch = this->m_space_parking.epoch();
+				this->m_space_waiting_count.fetch_add(1, std::memory_order_seq_cst);
+
+				if (static_cast<std::ptrdiff_t>(slot_ptr->m_sequence.load(std::memory_order_acquire) - pos) < 0)
+				{
+					this->m_space_parking.wait(epoch);
+				}
+
+				this->m_space_waiting_count.fetch_sub(1, std::memory_order_relaxed);
+				full_poll_counter = this->full_poll_count;
+			}
+
+			pos = this->m_push_pos.load(std::memory_order_relaxed);
+		}
+		else
+		{
+			pos = this->m_push_pos.load(std::memory_order_relaxed);
+		}
+	}
+
+	fill(&(slot_ptr->m_task), nullptr);
+	slot_ptr->m_sequence.store(pos + 1, std::memory_order_release);
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (this->m_sleeping_count.load(std::memory_order_relaxed) != 0)
+	{
+		this->wake_threads(false);
+	}
+
+	return true;
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline bool cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::run_pending_task() noexcept
+{
+	_task current_task;
+
+	if (!this->pop_task(&current_task))
+	{
+		return false;
+	}
+
+	xCOOL_THREADS_TRY
+	{
+		current_task.m_address_data.m_callable(&current_task, nullptr);
+	}
+	xCOOL_THREADS_CATCH(...) {}
+
+	return true;
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline void cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::delete_threads_detail(std::size_t threads_constructed) noexcept
+{
+	constexpr std::size_t cache_line_size = alignof(cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>);
+
+	this->m_stop_threads.store(true, std::memory_order_seq_cst);
+	this->wake_threads(true);
+
+	if (this->m_threads_data_ptr != nullptr)
+	{
+		for (std::size_t k = 0; k < threads_constructed; k++)
+		{
+			if ((this->m_threads_data_ptr + k)->joinable())
+			{
+				std::thread::id thread_id = (this->m_threads_data_ptr + k)->get_id();
+
+				xCOOL_THREADS_TRY
+				{
+					(this->m_threads_data_ptr + k)->join();
+				}
+				xCOOL_THREADS_CATCH(const std::system_error& xCOOL_THREADS_SYSTEM_ERROR)
+				{
+					cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::catch_delete_thread_exception(xCOOL_THREADS_SYSTEM_ERROR, thread_id);
+				}
+			}
+			(this->m_threads_data_ptr + k)->~thread();
+		}
+
+		::operator delete(reinterpret_cast<char*>(this->m_threads_data_ptr) - cache_line_size);
+	}
+
+	if (this->m_task_buffer_data_ptr != nullptr)
+	{
+		std::size_t task_buffer_size = this->m_task_buffer_mask + 1;
+
+		for (std::size_t k = 0; k < task_buffer_size; k++)
+		{
+			(this->m_task_buffer_data_ptr + k)->~_ring_slot();
+		}
+
+		::operator delete(this->m_task_buffer_unaligned_data_ptr);
+	}
+
+	this->m_threads_data_ptr = nullptr;
+	this->m_thread_count = 0;
+
+	this->m_task_buffer_data_ptr = nullptr;
+	this->m_task_buffer_mask = 0;
+
+	this->m_task_buffer_unaligned_data_ptr = nullptr;
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::pop_task(_task* target_ptr) noexcept
+{
+	std::size_t pos = this->m_pop_pos.load(std::memory_order_relaxed);
+	_ring_slot* slot_ptr;
+
+	while (true)
+	{
+		slot_ptr = this->m_task_buffer_data_ptr + (pos & this->m_task_buffer_mask);
+
+		std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(slot_ptr->m_sequence.load(std::memory_order_acquire) - (pos + 1));
+
+		if (diff == 0)
+		{
+			if (this->m_pop_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			return false;
+		}
+		else
+		{
+			pos = this->m_pop_pos.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot_ptr->m_task.m_address_data.m_callable(target_ptr, &(slot_ptr->m_task));
+	slot_ptr->m_sequence.store(pos + this->m_task_buffer_mask + 1, std::memory_order_release);
+
+	// pairs with the check of a submitter about to sleep on a full ring : either it sees the free slot or it is woken up
+
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if (this->m_space_waiting_count.load(std::memory_order_relaxed) != 0)
+	{
+		this->m_space_parking.wake(false);
+	}
+
+	return true;
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline void cool::_threads_lq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::wake_threads(bool all) noexcept
+{
+	this->m_task_parking.wake(all);
+}
+
+
+// threads_mq detail
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::threads_mq::~threads_mq()
+{
+	delete_threads();
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	if (!(this->push_local(fill, true)))
+	{
+		this->push_priority(fill, 0, true);
+	}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	if (!(this->push_local(fill, true)))
+	{
+		this->push_priority(fill, 0, true);
+	}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_end_incr_proxy, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	if (!(this->push_local(fill, true)))
+	{
+		this->push_priority(fill, 0, true);
+	}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_to_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	if (!(this->push_local(fill, true)))
+	{
+		this->push_priority(fill, 0, true);
+	}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_incr_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	if (!(this->push_local(fill, true)))
+	{
+		this->push_priority(fill, 0, true);
+	}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_on_node(int numa_node, cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	push_on_node(fill, numa_node);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_on_node(int numa_node, cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	push_on_node(fill, numa_node);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(unsigned int priority, cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	push_priority(fill, priority, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(unsigned int priority, cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	push_priority(fill, priority, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(unsigned int priority, cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_end_incr_proxy, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_priority(fill, priority, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(unsigned int priority, cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_to_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_priority(fill, priority, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(unsigned int priority, cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_incr_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_priority(fill, priority, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(unsigned int priority, cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	return push_priority(fill, priority, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(unsigned int priority, cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	return push_priority(fill, priority, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(unsigned int priority, cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_end_incr_proxy, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_priority(fill, priority, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(unsigned int priority, cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_to_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_priority(fill, priority, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(unsigned int priority, cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_incr_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_priority(fill, priority, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_at(cool::time_point<clock_Ty> deadline, cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	return this->push_timer(fill, cool::_threads_base::_timer_wheel<_task>::deadline_ns(deadline));
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_at(cool::time_point<clock_Ty> deadline, cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	return this->push_timer(fill, cool::_threads_base::_timer_wheel<_task>::deadline_ns(deadline));
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_at(cool::time_point<clock_Ty> deadline, cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_end_incr_proxy, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return this->push_timer(fill, cool::_threads_base::_timer_wheel<_task>::deadline_ns(deadline));
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_at(cool::time_point<clock_Ty> deadline, cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_to_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return this->push_timer(fill, cool::_threads_base::_timer_wheel<_task>::deadline_ns(deadline));
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_at(cool::time_point<clock_Ty> deadline, cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_incr_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return this->push_timer(fill, cool::_threads_base::_timer_wheel<_task>::deadline_ns(deadline));
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_after(cool::duration<clock_Ty> delay, cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	return async_at(cool::time_point<clock_Ty>(cool::now) + delay, cool::no_target, std::move(task), std::forward<arg_Ty>(args)...);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_after(cool::duration<clock_Ty> delay, cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	return async_at(cool::time_point<clock_Ty>(cool::now) + delay, target, std::move(task), std::forward<arg_Ty>(args)...);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_after(cool::duration<clock_Ty> delay, cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	return async_at(cool::time_point<clock_Ty>(cool::now) + delay, std::move(target), std::move(task), std::forward<arg_Ty>(args)...);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_after(cool::duration<clock_Ty> delay, cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	return async_at(cool::time_point<clock_Ty>(cool::now) + delay, std::move(target), std::move(task), std::forward<arg_Ty>(args)...);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class clock_Ty, class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_after(cool::duration<clock_Ty> delay, cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	return async_at(cool::time_point<clock_Ty>(cool::now) + delay, std::move(target), std::move(task), std::forward<arg_Ty>(args)...);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	return this->push_local(fill, false) || this->push_priority(fill, 0, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	return this->push_local(fill, false) || this->push_priority(fill, 0, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_end_incr_proxy, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return this->push_local(fill, false) || this->push_priority(fill, 0, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_to_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return this->push_local(fill, false) || this->push_priority(fill, 0, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, true, cool::_async_result_incr_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return this->push_local(fill, false) || this->push_priority(fill, 0, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class index_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_batch(cool::no_target_t, function_Ty task, index_Ty first, index_Ty last, const arg_Ty& ... args) noexcept
+{
+	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thmq_pack = typename cool::_threads_base::_arg_pack<typename cool::_threads_base::_task_traits<function_Ty>::template pack<std::tuple<index_Ty, typename std::decay<arg_Ty>::type ...>>, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::type;
+
+	static_assert(cool::_threads_base::_task_traits<function_Ty>::valid,
+		"cool::threads_mq<...>::async_batch : task must be a function pointer or a nothrow move constructible callable");
+	static_assert(std::is_integral<index_Ty>::value, "cool::threads_mq<...>::async_batch : index type must be integral");
+	static_assert((sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_mq<...>::async_batch : task arguments size too large");
+	static_assert((alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task)) || !_arg_type_static_check, "cool::threads_mq<...>::async_batch : task arguments alignment too large");
+
+	constexpr bool doom = !(sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !(alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task));
+	if (doom)
+	{
+		assert(false && "cool::threads_mq<...>::async_batch : task arguments size or alignment too large");
+		std::terminate();
+	}
+
+	if (!(first < last))
+	{
+		return;
+	}
+
+	auto fill = [&](_cool_thmq_task* task_ptr, std::size_t offset, cool::_threads_base::_arg_slab* arg_slab_ptr)
+	{
+		if (!(cool::_threads_base::_task_traits<function_Ty>::template construct<_cool_thmq_pack>(task_ptr->m_arg_buffer, arg_slab_ptr, task, static_cast<index_Ty>(first + static_cast<index_Ty>(offset)), args...)))
+		{
+			return false;
+		}
+
+		task_ptr->m_address_data.m_function_ptr = cool::_threads_base::_task_traits<function_Ty>::address(task);
+		task_ptr->m_address_data.m_callable = &cool::_threads_base::_task_callable<_cool_thmq_task, function_Ty, _cool_thmq_pack>::no_target;
+
+		return true;
+	};
+
+	push_batch(fill, static_cast<std::size_t>(last - first), false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class index_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async_batch(cool::async_end& target, function_Ty task, index_Ty first, index_Ty last, const arg_Ty& ... args) noexcept
+{
+	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thmq_pack = typename cool::_threads_base::_arg_pack<typename cool::_threads_base::_task_traits<function_Ty>::template pack<std::tuple<index_Ty, typename std::decay<arg_Ty>::type ...>>, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::type;
+
+	static_assert(cool::_threads_base::_task_traits<function_Ty>::valid,
+		"cool::threads_mq<...>::async_batch : task must be a function pointer or a nothrow move constructible callable");
+	static_assert(std::is_integral<index_Ty>::value, "cool::threads_mq<...>::async_batch : index type must be integral");
+	static_assert((sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_mq<...>::async_batch : task arguments size too large");
+	static_assert((alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task)) || !_arg_type_static_check, "cool::threads_mq<...>::async_batch : task arguments alignment too large");
+
+	constexpr bool doom = !(sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !(alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task));
+	if (doom)
+	{
+		assert(false && "cool::threads_mq<...>::async_batch : task arguments size or alignment too large");
+		std::terminate();
+	}
+
+	if (!(first < last))
+	{
+		return;
+	}
+
+	target.add_awaited(static_cast<std::size_t>(last - first));
+
+	auto fill = [&](_cool_thmq_task* task_ptr, std::size_t offset, cool::_threads_base::_arg_slab* arg_slab_ptr)
+	{
+		if (!(cool::_threads_base::_task_traits<function_Ty>::template construct<_cool_thmq_pack>(task_ptr->m_arg_buffer, arg_slab_ptr, task, static_cast<index_Ty>(first + static_cast<index_Ty>(offset)), args...)))
+		{
+			return false;
+		}
+
+		task_ptr->m_address_data.m_function_ptr = cool::_threads_base::_task_traits<function_Ty>::address(task);
+		task_ptr->m_address_data.m_target_ptr = static_cast<void*>(&target);
+		task_ptr->m_address_data.m_callable = &cool::_threads_base::_task_callable<_cool_thmq_task, function_Ty, _cool_thmq_pack>::async_end;
+
+		return true;
+	};
+
+	push_batch(fill, static_cast<std::size_t>(last - first), false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class index_Ty, class ... arg_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::parallel_for(index_Ty first, index_Ty last, index_Ty grain_size, function_Ty task, const arg_Ty& ... args) noexcept
+{
+	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thmq_pack = typename cool::_threads_base::_arg_pack<typename cool::_threads_base::_task_traits<function_Ty>::template pack<std::tuple<index_Ty, index_Ty, typename std::decay<arg_Ty>::type ...>>, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::type;
+
+	static_assert(cool::_threads_base::_task_traits<function_Ty>::valid,
+		"cool::threads_mq<...>::parallel_for : task must be a function pointer or a nothrow move constructible callable");
+	static_assert(std::is_integral<index_Ty>::value, "cool::threads_mq<...>::parallel_for : index type must be integral");
+	static_assert((sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_mq<...>::parallel_for : task arguments size too large");
+	static_assert((alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task)) || !_arg_type_static_check, "cool::threads_mq<...>::parallel_for : task arguments alignment too large");
+
+	constexpr bool doom = !(sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !(alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task));
+	if (doom)
+	{
+		assert(false && "cool::threads_mq<...>::parallel_for : task arguments size or alignment too large");
+		std::terminate();
+	}
+
+	assert((grain_size > 0) && "cool::threads_mq<...>::parallel_for : grain size must be > 0");
+
+	if (!(first < last))
+	{
+		return;
+	}
+
+	index_Ty _grain_size = (grain_size > 0) ? grain_size : static_cast<index_Ty>(1);
+	std::size_t range_size = static_cast<std::size_t>(last - first);
+	std::size_t chunk_size = static_cast<std::size_t>(_grain_size);
+	std::size_t chunk_count = range_size / chunk_size + static_cast<std::size_t>(range_size % chunk_size != 0);
+
+	cool::async_end target;
+	target.add_awaited(chunk_count);
+
+	auto fill = [&](_cool_thmq_task* task_ptr, std::size_t offset, cool::_threads_base::_arg_slab* arg_slab_ptr)
+	{
+		index_Ty chunk_first = static_cast<index_Ty>(first + static_cast<index_Ty>(offset * chunk_size));
+		index_Ty chunk_last = (offset + 1 != chunk_count) ? static_cast<index_Ty>(chunk_first + _grain_size) : last;
+
+		if (!(cool::_threads_base::_task_traits<function_Ty>::template construct<_cool_thmq_pack>(task_ptr->m_arg_buffer, arg_slab_ptr, task, chunk_first, chunk_last, args...)))
+		{
+			return false;
+		}
+
+		task_ptr->m_address_data.m_function_ptr = cool::_threads_base::_task_traits<function_Ty>::address(task);
+		task_ptr->m_address_data.m_target_ptr = static_cast<void*>(&target);
+		task_ptr->m_address_data.m_callable = &cool::_threads_base::_task_callable<_cool_thmq_task, function_Ty, _cool_thmq_pack>::async_end;
+
+		return true;
+	};
+
+	push_batch(fill, chunk_count, true);
+
+	target.finish(*this);
+}
+
+#ifdef xCOOL_THREADS_COROUTINES
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::_schedule_awaiter<cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>> cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::schedule() noexcept
+{
+	return cool::_schedule_awaiter<cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>>(this);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::_finish_awaiter<cool::async_end, cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>> cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::resume_after(cool::async_end& target) noexcept
+{
+	return cool::_finish_awaiter<cool::async_end, cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>>(&target, this);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty>
+inline cool::_finish_awaiter<cool::async_result<return_Ty>, cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>> cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::resume_after(cool::async_result<return_Ty>& target) noexcept
+{
+	return cool::_finish_awaiter<cool::async_result<return_Ty>, cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>>(&target, this);
+}
+#endif // xCOOL_THREADS_COROUTINES
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class ... arg_Ty>
+inline constexpr bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::arg_type_is_valid() noexcept
+{
+	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thmq_pack = typename cool::_threads_base::_arg_pack<std::tuple<typename std::decay<arg_Ty>::type ...>, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::type;
+
+	constexpr bool ret = (sizeof(_cool_thmq_pack) <= _arg_buffer_size) && (alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task));
+	return ret;
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::threads_init_result cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::init_new_threads(
+	cool::thread_count new_thread_count,
+	cool::task_buffer_size new_task_buffer_size,
+	cool::try_pop_count new_try_pop_count,
+	cool::dispatch_interval new_dispatch_interval) noexcept
+{
+	return init_new_threads(new_thread_count, new_task_buffer_size, cool::threads_mq_options().try_pop_count(new_try_pop_count).dispatch_interval(new_dispatch_interval));
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::threads_init_result cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::init_new_threads(
+	cool::thread_count new_thread_count,
+	cool::task_buffer_size new_task_buffer_size,
+	const cool::threads_mq_options& new_options) noexcept
+{
+	cool::try_pop_count new_try_pop_count = new_options.try_pop_count();
+	cool::dispatch_interval new_dispatch_interval = new_options.dispatch_interval();
+	cool::wait_policy new_wait_policy = new_options.wait_policy();
+	cool::thread_affinity new_thread_affinity = new_options.thread_affinity();
+	cool::priority_lanes new_priority_lanes = new_options.priority_lanes();
+	cool::elastic_policy new_elastic_policy = new_options.elastic_policy();
+	cool::timer_wheel new_timer_wheel = new_options.timer_wheel();
+
+	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
+
+	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
+	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
+
+	assert((reinterpret_cast<std::uintptr_t>(this) % cache_line_size == 0) && "cool::threads_mq<...> : object location must be aligned in memory");
+
+	if (reinterpret_cast<std::uintptr_t>(this) % cache_line_size != 0)
+	{
+		return cool::threads_init_result(cool::threads_init_result::bad_align);
+	}
+	else
+	{
+		delete_threads();
+	}
+
+	if ((new_thread_count.value() == 0) || (new_task_buffer_size.value() == 0) || (new_priority_lanes.lane_count() > cool::priority_lanes::max_lane_count)
+		|| (new_elastic_policy.min_thread_count() > new_thread_count.value()) || ((new_timer_wheel.capacity() != 0) && (new_timer_wheel.resolution_us() == 0)))
+	{
+		return cool::threads_init_result(cool::threads_init_result::bad_parameters);
+	}
+
+	if (new_dispatch_interval.value() != 0)
+	{
+		this->m_dispatch_interval = static_cast<_cool_thmq_uintX>(new_dispatch_interval.value());
+	}
+	else
+	{
+		this->m_dispatch_interval = static_cast<_cool_thmq_uintX>(default_dispatch_interval(new_thread_count.value()));
+	}
+
+	if (new_thread_count.value() != 1)
+	{
+		constexpr _cool_thmq_uintX uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
+
+		_cool_thmq_uint2X mod_D = static_cast<_cool_thmq_uint2X>(new_thread_count.value());
+
+		_cool_thmq_uintX i = 0;
+		while ((static_cast<_cool_thmq_uint2X>(1) << i) < static_cast<_cool_thmq_uint2X>(new_thread_count.value()))
+		{
+			i++;
+		}
+
+		_cool_thmq_uintX temp = uintX_bitcount + i;
+		_cool_thmq_uint2X mod_a = (static_cast<_cool_thmq_uint2X>(1) << temp) / mod_D;
+		if ((mod_a * mod_D) != (static_cast<_cool_thmq_uint2X>(1) << temp))
+		{
+			mod_a++;
+		}
+
+		this->m_mod_k = i - 1;
+		this->m_mod_a = mod_a - (static_cast<_cool_thmq_uint2X>(1) << uintX_bitcount);
+		this->m_mod_D = mod_D;
+	}
+	else
+	{
+		constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
+
+		this->m_mod_k = 0;
+		this->m_mod_a = static_cast<_cool_thmq_uint2X>(1) << uintX_bitcount;
+		this->m_mod_D = 1;
+	}
+
+	std::size_t _new_thread_count = static_cast<std::size_t>(new_thread_count.value());
+	std::size_t task_buffer_size_per_thread = new_task_buffer_size.value() / _new_thread_count;
+	if (_new_thread_count * task_buffer_size_per_thread != new_task_buffer_size.value())
+	{
+		task_buffer_size_per_thread++;
+	}
+
+	this->m_thread_count = _new_thread_count;
+
+	unsigned int _new_pop_rounds = new_try_pop_count.value() / static_cast<unsigned int>(new_thread_count.value());
+	if ((static_cast<unsigned int>(new_thread_count.value()) * _new_pop_rounds != new_try_pop_count.value())
+		&& (static_cast<unsigned int>(new_thread_count.value()) * (_new_pop_rounds + 1) >= new_try_pop_count.value()))
+	{
+		_new_pop_rounds++;
+	}
+
+	this->m_pop_rounds = _new_pop_rounds;
+
+	unsigned int _new_spin_count = new_wait_policy.spin_count();
+	unsigned int _new_yield_count = new_wait_policy.yield_count();
+
+	this->m_spin_count = _new_spin_count;
+	this->m_yield_count = _new_yield_count;
+
+	this->m_lane_count = new_priority_lanes.lane_count();
+	this->m_aging_interval = new_priority_lanes.aging_interval();
+	this->m_task_buffer_size_per_thread = task_buffer_size_per_thread;
+
+	bool elastic = (new_elastic_policy.min_thread_count() != 0);
+	std::size_t active_thread_count = elastic ? static_cast<std::size_t>(new_elastic_policy.min_thread_count()) : _new_thread_count;
+
+	this->m_elastic.m_min_thread_count = static_cast<std::size_t>(new_elastic_policy.min_thread_count());
+	this->m_elastic.m_grow_queue_depth = elastic ? new_elastic_policy.grow_queue_depth() : 0;
+	this->m_elastic.m_idle_timeout_ms = elastic ? new_elastic_policy.idle_timeout_ms() : 0;
+	this->m_elastic.m_closed = false;
+	this->m_elastic.m_active_thread_count.store(active_thread_count, std::memory_order_relaxed);
+
+#ifdef COOL_THREADS_STATS
+	this->m_submit_stats.m_try_async_failures.store(0, std::memory_order_relaxed);
+	this->m_submit_stats.m_full_queue_retries.store(0, std::memory_order_relaxed);
+#endif // COOL_THREADS_STATS
+
+	std::size_t threads_constructed = 0;
+	std::size_t threads_launched = 0;
+
+	this->m_thread_blocks_unaligned_data_ptr = static_cast<char*>(::operator new(
+		_new_thread_count * sizeof(_cool_thmq_tblk) + 2 * cache_line_size, std::nothrow));
+
+	if (this->m_thread_blocks_unaligned_data_ptr == nullptr)
+	{
+		this->delete_threads_detail(threads_constructed, threads_launched);
+		return cool::threads_init_result(cool::threads_init_result::bad_alloc);
+	}
+	else
+	{
+		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_thread_blocks_unaligned_data_ptr) % static_cast<std::uintptr_t>(cache_line_size);
+
+		this->m_thread_blocks_data_ptr = reinterpret_cast<_cool_thmq_tblk*>(this->m_thread_blocks_unaligned_data_ptr
+			+ static_cast<std::size_t>(ptr_remainder != 0) * (cache_line_size - static_cast<std::size_t>(ptr_remainder)));
+	}
+
+	if (!(this->m_timer_wheel.new_timers(new_timer_wheel.capacity(), static_cast<std::int64_t>(new_timer_wheel.resolution_us()) * 1000)))
+	{
+		this->delete_threads_detail(threads_constructed, threads_launched);
+		return cool::threads_init_result(cool::threads_init_result::bad_alloc);
+	}
+
+	int* thread_cpus = new (std::nothrow) int[_new_thread_count];
+
+	if (thread_cpus == nullptr)
+	{
+		this->delete_threads_detail(threads_constructed, threads_launched);
+		return cool::threads_init_result(cool::threads_init_result::bad_alloc);
+	}
+
+	cool::_threads_base::affinity_plan(new_thread_affinity, thread_cpus, _new_thread_count);
+
+	for (std::size_t thread_num = 0; thread_num < _new_thread_count; thread_num++)
+	{
+		new (this->m_thread_blocks_data_ptr + thread_num) _cool_thmq_tblk();
+		(this->m_thread_blocks_data_ptr + thread_num)->m_parent_ptr = this;
+		(this->m_thread_blocks_data_ptr + thread_num)->m_cpu = thread_cpus[thread_num];
+		(this->m_thread_blocks_data_ptr + thread_num)->m_lane_count = this->m_lane_count;
+		(this->m_thread_blocks_data_ptr + thread_num)->m_aging_interval = this->m_aging_interval;
+		(this->m_thread_blocks_data_ptr + thread_num)->m_elastic_state = (thread_num < active_thread_count) ? 0 : 2;
+
+		// pinned threads allocate their own task buffer in 'start_thread'
+
+		if ((thread_cpus[thread_num] < 0) && !((this->m_thread_blocks_data_ptr + thread_num)->new_task_buffer(task_buffer_size_per_thread)))
+		{
+			delete[] thread_cpus;
+			this->delete_threads_detail(threads_constructed, threads_launched);
+			return cool::threads_init_result(cool::threads_init_result::bad_alloc);
+		}
+		threads_constructed++;
+	}
+
+	delete[] thread_cpus;
+
+	// blocks past the active thread count of an elastic pool are stopped and get their thread later
+
+	for (std::size_t thread_num = 0; thread_num < _new_thread_count; thread_num++)
+	{
+		(this->m_thread_blocks_data_ptr + thread_num)->m_stop_threads = false;
+
+		if (thread_num < active_thread_count)
+		{
+			xCOOL_THREADS_TRY
+			{
+				this->launch_thread(thread_num);
+			}
+			xCOOL_THREADS_CATCH(...)
+			{
+				this->delete_threads_detail(threads_constructed, threads_launched);
+				return cool::threads_init_result(cool::threads_init_result::bad_thread_creation);
+			}
+		}
+
+		threads_launched++;
+	}
+
+	bool task_buffers_allocated = true;
+
+	for (std::size_t thread_num = 0; thread_num < active_thread_count; thread_num++)
+	{
+		int start_state;
+
+		while ((start_state = (this->m_thread_blocks_data_ptr + thread_num)->m_start_state.load(std::memory_order_acquire)) == 0)
+		{
+			std::this_thread::yield();
+		}
+
+		task_buffers_allocated = task_buffers_allocated && (start_state == 1);
+	}
+
+	if (!task_buffers_allocated)
+	{
+		this->delete_threads_detail(threads_constructed, threads_launched);
+		return cool::threads_init_result(cool::threads_init_result::bad_alloc);
+	}
+
+	std::atomic_signal_fence(std::memory_order_release);
+	this->m_can_refresh.store(true, std::memory_order_release);
+	this->m_good.store(true, std::memory_order_seq_cst);
+	return cool::threads_init_result(cool::threads_init_result::success);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::good() const noexcept
+{
+	return this->m_good.load(std::memory_order_seq_cst);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::size_t cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_count() const noexcept
+{
+	std::atomic_signal_fence(std::memory_order_acquire);
+	return this->m_thread_count;
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::size_t cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::task_buffer_size() const noexcept
+{
+	std::atomic_signal_fence(std::memory_order_acquire);
+
+	if (this->m_thread_blocks_data_ptr != nullptr)
+	{
+		if (this->m_thread_blocks_data_ptr->m_task_buffer_data_ptr != nullptr)
+		{
+			return static_cast<std::size_t>((this->m_thread_blocks_data_ptr->m_task_buffer_end_ptr
+				- this->m_thread_blocks_data_ptr->m_task_buffer_data_ptr) - 1) * this->m_thread_count;
+		}
+		else
+		{
+			return 0;
+		}
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline unsigned int cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_pop_count() const noexcept
+{
+	std::atomic_signal_fence(std::memory_order_acquire);
+	return this->m_pop_rounds * static_cast<unsigned int>(this->m_thread_count);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::uint16_t cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::dispatch_interval() const noexcept
+{
+	std::atomic_signal_fence(std::memory_order_acquire);
+	return static_cast<std::uint16_t>(this->m_dispatch_interval);
+}
 
 template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::threads_sq::~threads_sq()
+inline cool::wait_policy cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::wait_policy() const noexcept
 {
-	delete_threads();
+	std::atomic_signal_fence(std::memory_order_acquire);
+	return cool::wait_policy(this->m_spin_count, this->m_yield_count);
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::priority_lanes cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_lanes() const noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+	std::atomic_signal_fence(std::memory_order_acquire);
+	return cool::priority_lanes(this->m_lane_count, this->m_aging_interval);
+}
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::async : task arguments alignment too large");
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::wait_stats cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::wait_stats() const noexcept
+{
+	std::size_t spin_hits = 0;
+	std::size_t yield_hits = 0;
+	std::size_t parks = 0;
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
+	if (this->m_thread_blocks_data_ptr != nullptr)
 	{
-		assert(false && "cool::threads_sq<...>::async : task arguments size or alignment too large");
-		std::terminate();
+		for (std::size_t k = 0; k < this->m_thread_count; k++)
+		{
+			spin_hits += (this->m_thread_blocks_data_ptr + k)->m_spin_hits.load(std::memory_order_relaxed);
+			yield_hits += (this->m_thread_blocks_data_ptr + k)->m_yield_hits.load(std::memory_order_relaxed);
+			parks += (this->m_thread_blocks_data_ptr + k)->m_parks.load(std::memory_order_relaxed);
+		}
 	}
 
-	while (true)
+	return cool::wait_stats(spin_hits, yield_hits, parks);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::reset_wait_stats() noexcept
+{
+	if (this->m_thread_blocks_data_ptr != nullptr)
 	{
-		xCOOL_THREADS_TRY
+		for (std::size_t k = 0; k < this->m_thread_count; k++)
 		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
-
-			_cool_thsq_task* last_task_ptr_p1 = (this->m_last_task_ptr + 1 != this->m_task_buffer_end_ptr) ? this->m_last_task_ptr + 1 : this->m_task_buffer_data_ptr;
-
-			if (last_task_ptr_p1 != this->m_next_task_ptr)
-			{
-				new (static_cast<void*>(this->m_last_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-
-				this->m_last_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
-				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
-
-						xCOOL_THREADS_TRY
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
-
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_size);
-					}
-				};
-
-				this->m_last_task_ptr = last_task_ptr_p1;
-
-				break;
-			}
+			(this->m_thread_blocks_data_ptr + k)->m_spin_hits.store(0, std::memory_order_relaxed);
+			(this->m_thread_blocks_data_ptr + k)->m_yield_hits.store(0, std::memory_order_relaxed);
+			(this->m_thread_blocks_data_ptr + k)->m_parks.store(0, std::memory_order_relaxed);
 		}
-		xCOOL_THREADS_CATCH(...) {}
-
-		std::this_thread::yield();
 	}
+}
 
-	this->m_condition_var.notify_one();
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::elastic_policy cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::elastic_policy() const noexcept
+{
+	std::atomic_signal_fence(std::memory_order_acquire);
+	return cool::elastic_policy(static_cast<std::uint16_t>(this->m_elastic.m_min_thread_count), this->m_elastic.m_idle_timeout_ms, this->m_elastic.m_grow_queue_depth);
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::timer_wheel cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::timer_wheel() const noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+	std::atomic_signal_fence(std::memory_order_acquire);
+	return this->m_timer_wheel.enabled() ? cool::timer_wheel(this->m_timer_wheel.capacity(), this->m_timer_wheel.resolution_us()) : cool::timer_wheel(0);
+}
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::priority_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::priority_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::priority_async : task arguments alignment too large");
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::size_t cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::active_thread_count() const noexcept
+{
+	return this->m_elastic.m_active_thread_count.load(std::memory_order_relaxed);
+}
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::set_active_thread_count(std::size_t new_active_thread_count) noexcept
+{
+	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
+
+	if (!this->m_elastic.enabled())
 	{
-		assert(false && "cool::threads_sq<...>::priority_async : task arguments size or alignment too large");
-		std::terminate();
+		return;
 	}
 
-	while (true)
+	std::size_t target_thread_count = (new_active_thread_count > this->m_elastic.m_min_thread_count) ? new_active_thread_count : this->m_elastic.m_min_thread_count;
+	target_thread_count = (target_thread_count < this->m_thread_count) ? target_thread_count : this->m_thread_count;
+
+	xCOOL_THREADS_TRY
 	{
-		xCOOL_THREADS_TRY
+		std::lock_guard<std::mutex> control_lock(this->m_elastic.m_mutex);
+
+		if (this->m_elastic.m_closed)
 		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
+			return;
+		}
 
-			_cool_thsq_task* next_task_ptr_m1 = (this->m_next_task_ptr != this->m_task_buffer_data_ptr) ? this->m_next_task_ptr - 1 : this->m_task_buffer_end_ptr - 1;
+		for (std::size_t thread_num = this->m_thread_count; (thread_num > 0)
+			&& (this->m_elastic.m_active_thread_count.load(std::memory_order_relaxed) > target_thread_count); thread_num--)
+		{
+			_cool_thmq_tblk* ptr = this->m_thread_blocks_data_ptr + thread_num - 1;
+			bool retiring = false;
 
-			if (this->m_last_task_ptr != next_task_ptr_m1)
 			{
-				this->m_next_task_ptr = next_task_ptr_m1;
-
-				new (static_cast<void*>(this->m_next_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_next_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
+				std::lock_guard<std::mutex> lock(ptr->m_mutex);
 
-				this->m_next_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
+				if ((ptr->m_elastic_state == 0) && this->m_elastic.try_retire(target_thread_count))
 				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
-
-						xCOOL_THREADS_TRY
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
-
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_size);
-					}
-				};
+					ptr->m_elastic_state = 1;
+					retiring = true;
+				}
+			}
 
-				break;
+			if (retiring)
+			{
+				ptr->m_condition_var.notify_one();
 			}
 		}
-		xCOOL_THREADS_CATCH(...) {}
 
-		std::this_thread::yield();
+		while ((this->m_elastic.m_active_thread_count.load(std::memory_order_relaxed) < target_thread_count) && this->start_stopped_thread()) {}
 	}
-
-	this->m_condition_var.notify_one();
+	xCOOL_THREADS_CATCH(...) {}
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::delete_threads() noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+	this->fire_timers(true);
+	this->delete_threads_detail(this->m_thread_count, this->m_thread_count);
+}
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::async : task arguments alignment too large");
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::safety_refresh() noexcept
+{
+	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
+	if (this->m_can_refresh.exchange(false, std::memory_order_acquire))
 	{
-		assert(false && "cool::threads_sq<...>::async : task arguments size or alignment too large");
-		std::terminate();
-	}
+		_cool_thmq_tblk* ptr = this->m_thread_blocks_data_ptr;
 
-	while (true)
-	{
-		xCOOL_THREADS_TRY
+		for (std::size_t k = 0; k < this->m_thread_count; k++)
 		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
-
-			_cool_thsq_task* last_task_ptr_p1 = (this->m_last_task_ptr + 1 != this->m_task_buffer_end_ptr) ? this->m_last_task_ptr + 1 : this->m_task_buffer_data_ptr;
-
-			if (last_task_ptr_p1 != this->m_next_task_ptr)
-			{
-				new (static_cast<void*>(this->m_last_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(&target);
-
-				this->m_last_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
-				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
-
-						xCOOL_THREADS_TRY
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
-
-						static_cast<cool::async_end*>(_task_ptr->m_address_data.m_target_ptr)->decr_awaited();
-
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_size);
-					}
-				};
-
-				this->m_last_task_ptr = last_task_ptr_p1;
-
-				break;
-			}
+			(ptr + k)->m_condition_var.notify_one();
 		}
-		xCOOL_THREADS_CATCH(...) {}
 
-		std::this_thread::yield();
+		this->m_can_refresh.store(true, std::memory_order_release);
 	}
-
-	this->m_condition_var.notify_one();
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+#ifdef COOL_THREADS_STATS
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::threads_stats cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::stats() noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
-
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::priority_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::priority_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::priority_async : task arguments alignment too large");
+	cool::threads_stats stats;
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
+	if (this->m_thread_blocks_data_ptr != nullptr)
 	{
-		assert(false && "cool::threads_sq<...>::priority_async : task arguments size or alignment too large");
-		std::terminate();
+		for (std::size_t k = 0; k < this->m_thread_count; k++)
+		{
+			(this->m_thread_blocks_data_ptr + k)->m_stats.add_to(stats);
+		}
 	}
 
-	while (true)
-	{
-		xCOOL_THREADS_TRY
-		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
+	stats.m_try_async_failures = this->m_submit_stats.m_try_async_failures.load(std::memory_order_relaxed);
+	stats.m_full_queue_retries = this->m_submit_stats.m_full_queue_retries.load(std::memory_order_relaxed);
 
-			_cool_thsq_task* next_task_ptr_m1 = (this->m_next_task_ptr != this->m_task_buffer_data_ptr) ? this->m_next_task_ptr - 1 : this->m_task_buffer_end_ptr - 1;
+	for (std::size_t k = 0; (this->m_thread_blocks_data_ptr != nullptr) && (k < this->m_thread_count); k++)
+	{
+		typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block* ptr = this->m_thread_blocks_data_ptr + k;
 
-			if (this->m_last_task_ptr != next_task_ptr_m1)
+		while (true)
+		{
+			xCOOL_THREADS_TRY
 			{
-				this->m_next_task_ptr = next_task_ptr_m1;
+				std::lock_guard<std::mutex> lock(ptr->m_mutex);
 
-				new (static_cast<void*>(this->m_next_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_next_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_next_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(&target);
-
-				this->m_next_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
+				if (ptr->m_task_buffer_data_ptr != nullptr)
 				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
-
-						xCOOL_THREADS_TRY
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
-
-						static_cast<cool::async_end*>(_task_ptr->m_address_data.m_target_ptr)->decr_awaited();
-
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_size);
-					}
-				};
-
+					std::ptrdiff_t depth = ptr->m_last_task_ptr - ptr->m_next_task_ptr;
+					stats.m_queue_depth += static_cast<std::size_t>((depth >= 0) ? depth : depth + (ptr->m_task_buffer_end_ptr - ptr->m_task_buffer_data_ptr));
+					stats.m_queue_depth += ptr->m_priority_task_count;
+				}
 				break;
 			}
+			xCOOL_THREADS_CATCH(...) {}
 		}
-		xCOOL_THREADS_CATCH(...) {}
-
-		std::this_thread::yield();
 	}
 
-	this->m_condition_var.notify_one();
+	return stats;
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::reset_stats() noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
-
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::async : task arguments alignment too large");
-
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_sq<...>::async : task arguments size or alignment too large");
-		std::terminate();
-	}
-
-	while (true)
+	if (this->m_thread_blocks_data_ptr != nullptr)
 	{
-		xCOOL_THREADS_TRY
+		for (std::size_t k = 0; k < this->m_thread_count; k++)
 		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
-
-			_cool_thsq_task* last_task_ptr_p1 = (this->m_last_task_ptr + 1 != this->m_task_buffer_end_ptr) ? this->m_last_task_ptr + 1 : this->m_task_buffer_data_ptr;
-
-			if (last_task_ptr_p1 != this->m_next_task_ptr)
-			{
-				target.m_parent_ptr->m_tasks_awaited.fetch_add(1, std::memory_order_relaxed);
-
-				new (static_cast<void*>(this->m_last_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-
-				this->m_last_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
-				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+			(this->m_thread_blocks_data_ptr + k)->m_stats.reset();
+		}
+	}
 
-						xCOOL_THREADS_TRY
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
+	this->m_submit_stats.m_try_async_failures.store(0, std::memory_order_relaxed);
+	this->m_submit_stats.m_full_queue_retries.store(0, std::memory_order_relaxed);
+}
+#endif // COOL_THREADS_STATS
 
-						static_cast<cool::async_end*>(_task_ptr->m_address_data.m_target_ptr)->decr_awaited();
+#ifdef COOL_THREADS_TRACE
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class ostream_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::write_chrome_trace(ostream_Ty& os) const
+{
+	bool first = true;
 
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
+	os << "{\"traceEvents\":[";
 
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_size);
-					}
-				};
+	if (this->m_thread_blocks_data_ptr != nullptr)
+	{
+		for (std::size_t k = 0; k < this->m_thread_count; k++)
+		{
+			(this->m_thread_blocks_data_ptr + k)->m_stats.write_chrome_trace(os, k, first);
+		}
+	}
 
-				this->m_last_task_ptr = last_task_ptr_p1;
+	os << "\n]}\n";
+}
+#endif // COOL_THREADS_TRACE
 
-				break;
-			}
-		}
-		xCOOL_THREADS_CATCH(...) {}
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::thread::id cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_id(std::size_t thread_number) const noexcept
+{
+	return (this->m_thread_blocks_data_ptr + thread_number)->m_thread.get_id();
+}
 
-		std::this_thread::yield();
-	}
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::_thread_const_iterator_proxy<cool::_thread_iterator<cool::_thread_mq_id<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>> cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_ids() const noexcept
+{
+	return cool::_thread_const_iterator_proxy<cool::_thread_iterator<cool::_thread_mq_id<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>>(this->m_thread_blocks_data_ptr, this->m_thread_blocks_data_ptr + this->m_thread_count);
+}
 
-	this->m_condition_var.notify_one();
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline int cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_cpu(std::size_t thread_number) const noexcept
+{
+	return (this->m_thread_blocks_data_ptr + thread_number)->m_cpu;
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline int cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_numa_node(std::size_t thread_number) const noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+	return (this->m_thread_blocks_data_ptr + thread_number)->m_numa_node;
+}
+
+#ifdef COOL_THREADS_NATIVE_HANDLE
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::thread::native_handle_type cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_native_handle(std::size_t thread_number)
+{
+	return (this->m_thread_blocks_data_ptr + thread_number)->m_thread.native_handle();
+}
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::priority_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::priority_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::priority_async : task arguments alignment too large");
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::_thread_iterator_proxy<cool::_thread_iterator<cool::_thread_mq_native_handle<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>> cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_native_handles() noexcept
+{
+	return cool::_thread_iterator_proxy<cool::_thread_iterator<cool::_thread_mq_native_handle<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>>(this->m_thread_blocks_data_ptr, this->m_thread_blocks_data_ptr + this->m_thread_count);
+}
+#endif // COOL_THREADS_NATIVE_HANDLE
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::uint16_t cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::default_dispatch_interval(std::uint16_t new_thread_count) noexcept
+{
+	if (new_thread_count == 0)
 	{
-		assert(false && "cool::threads_sq<...>::priority_async : task arguments size or alignment too large");
-		std::terminate();
+		return 0;
 	}
 
-	while (true)
-	{
-		xCOOL_THREADS_TRY
-		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
+	std::uint16_t max_dispatch_interval;
 
-			_cool_thsq_task* next_task_ptr_m1 = (this->m_next_task_ptr != this->m_task_buffer_data_ptr) ? this->m_next_task_ptr - 1 : this->m_task_buffer_end_ptr - 1;
+	{
+		using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
 
-			if (this->m_last_task_ptr != next_task_ptr_m1)
-			{
-				target.m_parent_ptr->m_tasks_awaited.fetch_add(1, std::memory_order_relaxed);
+		_cool_thmq_uintX _max_dispatch_interval = static_cast<_cool_thmq_uintX>(-1) / static_cast<_cool_thmq_uintX>(new_thread_count);
+		_cool_thmq_uintX _new_thread_count_d2 = static_cast<_cool_thmq_uintX>(new_thread_count) / 2;
+		max_dispatch_interval = (_max_dispatch_interval < _new_thread_count_d2) ?
+			static_cast<std::uint16_t>(_max_dispatch_interval) : static_cast<std::uint16_t>(_new_thread_count_d2);
+		max_dispatch_interval = (max_dispatch_interval < 32) ? max_dispatch_interval : 32;
+	}
 
-				this->m_next_task_ptr = next_task_ptr_m1;
+	std::uint16_t sqr = 0;
 
-				new (static_cast<void*>(this->m_next_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_next_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_next_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
+	while ((sqr < max_dispatch_interval) && (sqr * sqr <= new_thread_count))
+	{
+		sqr++;
+	}
 
-				this->m_next_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
+	if (sqr == 0)
+	{
+		return 0;
+	}
+	else
+	{
+		for (std::uint16_t ret = sqr; ret > 2; ret--)
+		{
+			for (std::uint16_t divisor = ret; (ret % divisor != 0) || (new_thread_count % divisor != 0); divisor--)
+			{
+				if (divisor <= 2)
 				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
-
-						xCOOL_THREADS_TRY
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
-
-						static_cast<cool::async_end*>(_task_ptr->m_address_data.m_target_ptr)->decr_awaited();
-
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_size);
-					}
-				};
+					return ret;
+				}
+			}
+		}
 
-				break;
+		for (std::uint16_t ret = sqr; ret < max_dispatch_interval; ret++)
+		{
+			for (std::uint16_t divisor = ret; (ret % divisor != 0) || (new_thread_count % divisor != 0); divisor--)
+			{
+				if (divisor <= 2)
+				{
+					return ret;
+				}
 			}
 		}
-		xCOOL_THREADS_CATCH(...) {}
 
-		std::this_thread::yield();
+		return ((new_thread_count % 2 != 0) && (2 <= max_dispatch_interval)) ? 2 : 1;
 	}
-
-	this->m_condition_var.notify_one();
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
-inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class fill_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::push_batch(fill_Ty& fill, std::size_t task_count, bool run_pending) noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::async : task arguments alignment too large");
+	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
+	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_sq<...>::async : task arguments size or alignment too large");
-		std::terminate();
-	}
+	constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
 
-	while (true)
+	_cool_thmq_uint2X N = static_cast<_cool_thmq_uint2X>(this->m_thread_dispatch.fetch_add(this->m_dispatch_interval, std::memory_order_relaxed));
+	_cool_thmq_uint2X b = (N * this->m_mod_a) >> uintX_bitcount;
+	std::size_t thread_num = static_cast<std::size_t>(N - ((((N - b) >> 1) + b) >> this->m_mod_k) * this->m_mod_D);
+
+	// the batch is split evenly between the threads, each share being written under a single lock
+
+	std::size_t tasks_per_thread = task_count / this->m_thread_count + static_cast<std::size_t>(task_count % this->m_thread_count != 0);
+	std::size_t tasks_pushed = 0;
+
+	std::size_t full_queue_counter = this->m_thread_count;
+
+	while (tasks_pushed < task_count)
 	{
+		_cool_thmq_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
+		std::size_t tasks_pushed_now = 0;
+
 		xCOOL_THREADS_TRY
 		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
-
-			_cool_thsq_task* last_task_ptr_p1 = (this->m_last_task_ptr + 1 != this->m_task_buffer_end_ptr) ? this->m_last_task_ptr + 1 : this->m_task_buffer_data_ptr;
+			std::unique_lock<std::mutex> lock(current_thread_ptr->m_mutex, std::try_to_lock);
 
-			if (last_task_ptr_p1 != this->m_next_task_ptr)
+			if (lock.owns_lock())
 			{
-				new (static_cast<void*>(this->m_last_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-				this->m_last_task_ptr->m_address_data.m_offset = target.m_offset;
+				bool notification_required = (current_thread_ptr->m_last_task_ptr == current_thread_ptr->m_next_task_ptr);
 
-				this->m_last_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
+				while ((tasks_pushed_now < tasks_per_thread) && (tasks_pushed + tasks_pushed_now < task_count))
 				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+					_cool_thmq_task* last_task_ptr_p1 = (current_thread_ptr->m_last_task_ptr + 1 != current_thread_ptr->m_task_buffer_end_ptr) ?
+						current_thread_ptr->m_last_task_ptr + 1 : current_thread_ptr->m_task_buffer_data_ptr;
 
-						cool::async_result<return_Ty>& target_ref = *static_cast<cool::async_result<return_Ty>*>(_task_ptr->m_address_data.m_target_ptr);
+					if ((last_task_ptr_p1 == current_thread_ptr->m_next_task_ptr) || (current_thread_ptr->m_elastic_state != 0)
+						|| !fill(current_thread_ptr->m_last_task_ptr, tasks_pushed + tasks_pushed_now, &current_thread_ptr->m_arg_slab))
+					{
+						break;
+					}
 
-						xCOOL_THREADS_TRY
-						{
-							*(target_ref.m_stored_values_ptr + _task_ptr->m_address_data.m_offset) = cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
+					current_thread_ptr->m_last_task_ptr = last_task_ptr_p1;
+					current_thread_ptr->m_has_task.store(true, std::memory_order_relaxed);
+					tasks_pushed_now++;
+				}
 
-						target_ref.decr_awaited();
+				bool growth_required = this->saturated(current_thread_ptr);
+				lock.unlock();
 
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
+				if (notification_required && (tasks_pushed_now != 0))
+				{
+					current_thread_ptr->m_condition_var.notify_one();
+				}
 
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_and_offset_size);
-					}
-				};
+				if (growth_required)
+				{
+					this->grow_threads();
+				}
+			}
+		}
+		xCOOL_THREADS_CATCH(...) {}
 
-				this->m_last_task_ptr = last_task_ptr_p1;
+		if (tasks_pushed_now != 0)
+		{
+			tasks_pushed += tasks_pushed_now;
+			full_queue_counter = this->m_thread_count;
+		}
+		else
+		{
+			full_queue_counter--;
+			xCOOL_THREADS_STATS(this->m_submit_stats.m_full_queue_retries.fetch_add(1, std::memory_order_relaxed);)
 
-				break;
+			if (full_queue_counter == 0)
+			{
+				if (!run_pending || !this->run_pending_task())
+				{
+					std::this_thread::yield();
+				}
+				full_queue_counter = this->m_thread_count;
 			}
 		}
-		xCOOL_THREADS_CATCH(...) {}
 
-		std::this_thread::yield();
+		thread_num = (thread_num != 0) ? thread_num - 1 : this->m_thread_count - 1;
 	}
-
-	this->m_condition_var.notify_one();
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
-inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class fill_Ty>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::push_on_node(fill_Ty& fill, int numa_node) noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::priority_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::priority_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::priority_async : task arguments alignment too large");
+	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
+	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
+	constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
+
+	_cool_thmq_uint2X N = static_cast<_cool_thmq_uint2X>(this->m_thread_dispatch.fetch_add(this->m_dispatch_interval, std::memory_order_relaxed));
+	_cool_thmq_uint2X b = (N * this->m_mod_a) >> uintX_bitcount;
+	std::size_t thread_num = static_cast<std::size_t>(N - ((((N - b) >> 1) + b) >> this->m_mod_k) * this->m_mod_D);
+
+	// threads of other nodes are skipped, unless no thread lives on 'numa_node'
+
+	std::size_t node_thread_count = 0;
+
+	for (std::size_t k = 0; k < this->m_thread_count; k++)
 	{
-		assert(false && "cool::threads_sq<...>::priority_async : task arguments size or alignment too large");
-		std::terminate();
+		node_thread_count += static_cast<std::size_t>((this->m_thread_blocks_data_ptr + k)->m_numa_node == numa_node);
 	}
 
+	bool any_node = (numa_node < 0) || (node_thread_count == 0);
+	std::size_t full_queue_counter = this->m_thread_count;
+
 	while (true)
 	{
-		xCOOL_THREADS_TRY
-		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
-
-			_cool_thsq_task* next_task_ptr_m1 = (this->m_next_task_ptr != this->m_task_buffer_data_ptr) ? this->m_next_task_ptr - 1 : this->m_task_buffer_end_ptr - 1;
+		_cool_thmq_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
 
-			if (this->m_last_task_ptr != next_task_ptr_m1)
+		if (any_node || (current_thread_ptr->m_numa_node == numa_node))
+		{
+			xCOOL_THREADS_TRY
 			{
-				this->m_next_task_ptr = next_task_ptr_m1;
+				std::unique_lock<std::mutex> lock(current_thread_ptr->m_mutex, std::try_to_lock);
 
-				new (static_cast<void*>(this->m_next_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_next_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_next_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-				this->m_next_task_ptr->m_address_data.m_offset = target.m_offset;
-
-				this->m_next_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
+				if (lock.owns_lock())
 				{
-					if (_fetch_task_ptr == nullptr)
+					_cool_thmq_task* last_task_ptr_p1 = (current_thread_ptr->m_last_task_ptr + 1 != current_thread_ptr->m_task_buffer_end_ptr) ?
+						current_thread_ptr->m_last_task_ptr + 1 : current_thread_ptr->m_task_buffer_data_ptr;
+
+					if ((last_task_ptr_p1 != current_thread_ptr->m_next_task_ptr) && (current_thread_ptr->m_elastic_state == 0)
+						&& fill(current_thread_ptr->m_last_task_ptr, &current_thread_ptr->m_arg_slab))
 					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
 
-						cool::async_result<return_Ty>& target_ref = *static_cast<cool::async_result<return_Ty>*>(_task_ptr->m_address_data.m_target_ptr);
+						bool notification_required = (current_thread_ptr->m_last_task_ptr == current_thread_ptr->m_next_task_ptr);
+						current_thread_ptr->m_last_task_ptr = last_task_ptr_p1;
+						current_thread_ptr->m_has_task.store(true, std::memory_order_relaxed);
+						bool growth_required = this->saturated(current_thread_ptr);
+						lock.unlock();
 
-						xCOOL_THREADS_TRY
+						if (notification_required)
 						{
-							*(target_ref.m_stored_values_ptr + _task_ptr->m_address_data.m_offset) = cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
+							current_thread_ptr->m_condition_var.notify_one();
 						}
-						xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
+
+						if (growth_required)
 						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
+							this->grow_threads();
 						}
 
-						target_ref.decr_awaited();
-
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
+						return;
 					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
+				}
+			}
+			xCOOL_THREADS_CATCH(...) {}
+		}
 
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_and_offset_size);
-					}
-				};
+		full_queue_counter--;
+		xCOOL_THREADS_STATS(this->m_submit_stats.m_full_queue_retries.fetch_add(1, std::memory_order_relaxed);)
 
-				break;
-			}
+		if (full_queue_counter == 0)
+		{
+			std::this_thread::yield();
+			full_queue_counter = this->m_thread_count;
 		}
-		xCOOL_THREADS_CATCH(...) {}
 
-		std::this_thread::yield();
+		thread_num = (thread_num != 0) ? thread_num - 1 : this->m_thread_count - 1;
 	}
-
-	this->m_condition_var.notify_one();
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
-inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class fill_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::push_local(fill_Ty& fill, bool evict) noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
-
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::async : task arguments alignment too large");
+	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
+	if (this->local_queue_size == 0)
 	{
-		assert(false && "cool::threads_sq<...>::async : task arguments size or alignment too large");
-		std::terminate();
+		return false;
 	}
 
-	while (true)
-	{
-		xCOOL_THREADS_TRY
-		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
-
-			_cool_thsq_task* last_task_ptr_p1 = (this->m_last_task_ptr + 1 != this->m_task_buffer_end_ptr) ? this->m_last_task_ptr + 1 : this->m_task_buffer_data_ptr;
-
-			if (last_task_ptr_p1 != this->m_next_task_ptr)
-			{
-				target.m_parent_ptr->m_tasks_awaited.fetch_add(1, std::memory_order_relaxed);
-
-				new (static_cast<void*>(this->m_last_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-				this->m_last_task_ptr->m_address_data.m_offset = target.m_offset;
-
-				this->m_last_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
-				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
-
-						cool::async_result<return_Ty>& target_ref = *static_cast<cool::async_result<return_Ty>*>(_task_ptr->m_address_data.m_target_ptr);
-
-						xCOOL_THREADS_TRY
-						{
-							*(target_ref.m_stored_values_ptr + _task_ptr->m_address_data.m_offset) = cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
-
-						target_ref.decr_awaited();
+	_cool_thmq_tblk* local_thread_block_ptr = this->this_thread_block();
 
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_and_offset_size);
-					}
-				};
-
-				this->m_last_task_ptr = last_task_ptr_p1;
-
-				break;
-			}
-		}
-		xCOOL_THREADS_CATCH(...) {}
+	if ((local_thread_block_ptr == nullptr) || (local_thread_block_ptr->m_parent_ptr != this))
+	{
+		return false;
+	}
 
-		std::this_thread::yield();
+	if (local_thread_block_ptr->deque_push(fill))
+	{
+		this->wake_idle_thread();
+		return true;
 	}
 
-	this->m_condition_var.notify_one();
-}
+	if (!evict)
+	{
+		return false;
+	}
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
-inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::priority_async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
-{
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+	// the oldest task of a full deque is the least likely to be cache hot and would otherwise wait for the thread to
+	// run all the newer ones, it is handed over to the queue of another thread which is woken up for it, a thread of
+	// the object must not wait for space or for a lock as all threads could do so, each other queue is tried once and
+	// the task is run in place if none takes it, which may refill the deque with the tasks it submits
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::priority_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::priority_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::priority_async : task arguments alignment too large");
+	std::size_t thread_count = this->m_thread_count;
+	std::size_t local_thread_num = static_cast<std::size_t>(local_thread_block_ptr - this->m_thread_blocks_data_ptr);
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_sq<...>::priority_async : task arguments size or alignment too large");
-		std::terminate();
-	}
+	_cool_thmq_task evicted_task;
 
-	while (true)
+	do
 	{
-		xCOOL_THREADS_TRY
+		if (local_thread_block_ptr->deque_steal(&evicted_task))
 		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
-
-			_cool_thsq_task* next_task_ptr_m1 = (this->m_next_task_ptr != this->m_task_buffer_data_ptr) ? this->m_next_task_ptr - 1 : this->m_task_buffer_end_ptr - 1;
+			bool transferred = false;
+			std::size_t thread_num = local_thread_num;
 
-			if (this->m_last_task_ptr != next_task_ptr_m1)
+			for (std::size_t n = thread_count - 1; (n > 0) && !transferred; n--)
 			{
-				target.m_parent_ptr->m_tasks_awaited.fetch_add(1, std::memory_order_relaxed);
-
-				this->m_next_task_ptr = next_task_ptr_m1;
+				thread_num = (thread_num + 1 != thread_count) ? thread_num + 1 : 0;
 
-				new (static_cast<void*>(this->m_next_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_next_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_next_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-				this->m_next_task_ptr->m_address_data.m_offset = target.m_offset;
+				_cool_thmq_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
 
-				this->m_next_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
+				xCOOL_THREADS_TRY
 				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+					std::unique_lock<std::mutex> lock(current_thread_ptr->m_mutex, std::try_to_lock);
 
-						cool::async_result<return_Ty>& target_ref = *static_cast<cool::async_result<return_Ty>*>(_task_ptr->m_address_data.m_target_ptr);
+					if (lock.owns_lock())
+					{
+						_cool_thmq_task* last_task_ptr_p1 = (current_thread_ptr->m_last_task_ptr + 1 != current_thread_ptr->m_task_buffer_end_ptr) ?
+							current_thread_ptr->m_last_task_ptr + 1 : current_thread_ptr->m_task_buffer_data_ptr;
 
-						xCOOL_THREADS_TRY
+						if ((last_task_ptr_p1 != current_thread_ptr->m_next_task_ptr) && (current_thread_ptr->m_elastic_state == 0))
 						{
-							*(target_ref.m_stored_values_ptr + _task_ptr->m_address_data.m_offset) = cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
+							evicted_task.m_address_data.m_callable(current_thread_ptr->m_last_task_ptr, &evicted_task);
 
-						target_ref.decr_awaited();
+							bool notification_required = !(current_thread_ptr->has_task());
+							current_thread_ptr->m_last_task_ptr = last_task_ptr_p1;
+							current_thread_ptr->m_has_task.store(true, std::memory_order_relaxed);
+							bool growth_required = this->saturated(current_thread_ptr);
+							lock.unlock();
 
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
+							if (notification_required)
+							{
+								current_thread_ptr->m_condition_var.notify_one();
+							}
 
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_and_offset_size);
+							if (growth_required)
+							{
+								this->grow_threads();
+							}
+
+							transferred = true;
+						}
 					}
-				};
+				}
+				xCOOL_THREADS_CATCH(...) {}
+			}
 
-				break;
+			if (!transferred)
+			{
+				xCOOL_THREADS_TRY
+				{
+					evicted_task.m_address_data.m_callable(&evicted_task, nullptr);
+				}
+				xCOOL_THREADS_CATCH(...) {}
 			}
 		}
-		xCOOL_THREADS_CATCH(...) {}
+		else
+		{
+			return false; // nothing to evict, the deque is empty or raced, 'fill' may have failed : the task goes to the queues
+		}
+	} while (!local_thread_block_ptr->deque_push(fill));
 
-		std::this_thread::yield();
-	}
+	this->wake_idle_thread();
 
-	this->m_condition_var.notify_one();
+	return true;
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::run_pending_task() noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
-
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::try_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::try_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::try_async : task arguments alignment too large");
-
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_sq<...>::try_async : task arguments size or alignment too large");
-		std::terminate();
-	}
-
-	while (true)
-	{
-		xCOOL_THREADS_TRY
-		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
+	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
 
-			_cool_thsq_task* last_task_ptr_p1 = (this->m_last_task_ptr + 1 != this->m_task_buffer_end_ptr) ? this->m_last_task_ptr + 1 : this->m_task_buffer_data_ptr;
+	_cool_thmq_task current_task;
 
-			if (last_task_ptr_p1 != this->m_next_task_ptr)
-			{
-				new (static_cast<void*>(this->m_last_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
+	_cool_thmq_tblk* local_thread_block_ptr = this->this_thread_block();
+	bool local_thread = (local_thread_block_ptr != nullptr) && (local_thread_block_ptr->m_parent_ptr == this);
 
-				this->m_last_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
-				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+	bool found = local_thread && local_thread_block_ptr->deque_pop(&current_task);
 
-						xCOOL_THREADS_TRY
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception & xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
+	// then the queues and the local deques of all threads, starting with the queue of the calling thread if it is one of the object
 
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
+	std::size_t thread_count = this->m_thread_count;
+	std::size_t thread_num = local_thread ? static_cast<std::size_t>(local_thread_block_ptr - this->m_thread_blocks_data_ptr) : 0;
 
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_size);
-					}
-				};
+	for (std::size_t n = thread_count; (n > 0) && !found; n--)
+	{
+		_cool_thmq_tblk* ptr = this->m_thread_blocks_data_ptr + thread_num;
 
-				this->m_last_task_ptr = last_task_ptr_p1;
+		{
+			std::unique_lock<std::mutex> lock(ptr->m_mutex, std::try_to_lock);
 
-				break;
-			}
-			else
+			if (lock.owns_lock() && ptr->has_task())
 			{
-				return false;
+				ptr->pop_task(&current_task);
+				found = true;
 			}
 		}
-		xCOOL_THREADS_CATCH(...) {}
+
+		if (!found && (ptr != local_thread_block_ptr))
+		{
+			found = ptr->deque_steal(&current_task);
+		}
+
+		thread_num = (thread_num + 1 != thread_count) ? thread_num + 1 : 0;
+	}
+
+	if (!found)
+	{
+		return false;
 	}
 
-	this->m_condition_var.notify_one();
+	xCOOL_THREADS_TRY
+	{
+		current_task.m_address_data.m_callable(&current_task, nullptr);
+	}
+	xCOOL_THREADS_CATCH(...) {}
 
 	return true;
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class fill_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::push_priority(fill_Ty& fill, unsigned int priority, bool wait_for_space) noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
+	using _cool_thmq_lane = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_lane;
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::try_priority_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::try_priority_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::try_priority_async : task arguments alignment too large");
+	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
+	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_sq<...>::try_priority_async : task arguments size or alignment too large");
-		std::terminate();
-	}
+	constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
+
+	_cool_thmq_uint2X N = static_cast<_cool_thmq_uint2X>(this->m_thread_dispatch.fetch_add(this->m_dispatch_interval, std::memory_order_relaxed));
+	_cool_thmq_uint2X b = (N * this->m_mod_a) >> uintX_bitcount;
+	std::size_t thread_num = static_cast<std::size_t>(N - ((((N - b) >> 1) + b) >> this->m_mod_k) * this->m_mod_D);
+
+	unsigned int lane = (priority < this->m_lane_count) ? priority : this->m_lane_count;
+	std::size_t full_queue_counter = this->m_thread_count;
 
 	while (true)
 	{
+		_cool_thmq_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
+
 		xCOOL_THREADS_TRY
 		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
-
-			_cool_thsq_task* next_task_ptr_m1 = (this->m_next_task_ptr != this->m_task_buffer_data_ptr) ? this->m_next_task_ptr - 1 : this->m_task_buffer_end_ptr - 1;
+			std::unique_lock<std::mutex> lock(current_thread_ptr->m_mutex, std::try_to_lock);
 
-			if (this->m_last_task_ptr != next_task_ptr_m1)
+			if (lock.owns_lock())
 			{
-				this->m_next_task_ptr = next_task_ptr_m1;
+				// lane 0 is the regular queue
 
-				new (static_cast<void*>(this->m_next_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_next_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
+				_cool_thmq_lane* lane_ptr = (lane != 0) ? current_thread_ptr->m_lanes_ptr + lane - 1 : nullptr;
 
-				this->m_next_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
+				_cool_thmq_task*& last_task_ptr = (lane_ptr != nullptr) ? lane_ptr->m_last_task_ptr : current_thread_ptr->m_last_task_ptr;
+				_cool_thmq_task* next_task_ptr = (lane_ptr != nullptr) ? lane_ptr->m_next_task_ptr : current_thread_ptr->m_next_task_ptr;
+				_cool_thmq_task* task_buffer_data_ptr = (lane_ptr != nullptr) ? lane_ptr->m_task_buffer_data_ptr : current_thread_ptr->m_task_buffer_data_ptr;
+				_cool_thmq_task* task_buffer_end_ptr = (lane_ptr != nullptr) ? lane_ptr->m_task_buffer_end_ptr : current_thread_ptr->m_task_buffer_end_ptr;
+
+				_cool_thmq_task* last_task_ptr_p1 = (last_task_ptr + 1 != task_buffer_end_ptr) ? last_task_ptr + 1 : task_buffer_data_ptr;
+
+				if ((last_task_ptr_p1 != next_task_ptr) && (current_thread_ptr->m_elastic_state == 0) && fill(last_task_ptr, &current_thread_ptr->m_arg_slab))
 				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
 
-						xCOOL_THREADS_TRY
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception & xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
+					bool notification_required = !(current_thread_ptr->has_task());
+					last_task_ptr = last_task_ptr_p1;
+					current_thread_ptr->m_priority_task_count += static_cast<std::size_t>(lane_ptr != nullptr);
+					current_thread_ptr->m_has_task.store(true, std::memory_order_relaxed);
+					bool growth_required = this->saturated(current_thread_ptr);
+					lock.unlock();
 
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
+					if (notification_required)
 					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
+						current_thread_ptr->m_condition_var.notify_one();
+					}
 
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_size);
+					if (growth_required)
+					{
+						this->grow_threads();
 					}
-				};
 
-				break;
-			}
-			else
-			{
-				return false;
+					return true;
+				}
+				else
+				{
+					full_queue_counter--;
+					xCOOL_THREADS_STATS(this->m_submit_stats.m_full_queue_retries.fetch_add(1, std::memory_order_relaxed);)
+
+					if (full_queue_counter == 0)
+					{
+						if (!wait_for_space)
+						{
+							xCOOL_THREADS_STATS(this->m_submit_stats.m_try_async_failures.fetch_add(1, std::memory_order_relaxed);)
+							return false;
+						}
+
+						std::this_thread::yield();
+						full_queue_counter = this->m_thread_count;
+					}
+				}
 			}
 		}
 		xCOOL_THREADS_CATCH(...) {}
-	}
-
-	this->m_condition_var.notify_one();
 
-	return true;
+		thread_num = (thread_num != 0) ? thread_num - 1 : this->m_thread_count - 1;
+	}
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::launch_thread(std::size_t thread_num)
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::try_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::try_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::try_async : task arguments alignment too large");
+	_cool_thmq_tblk* thread_blocks_data_ptr = this->m_thread_blocks_data_ptr;
+	cool::_threads_base::_elastic_control* elastic_ptr = &this->m_elastic;
+	cool::_threads_base::_timer_wheel<_cool_thmq_task>* timers_ptr = &this->m_timer_wheel;
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_sq<...>::try_async : task arguments size or alignment too large");
-		std::terminate();
-	}
+	std::size_t thread_count = this->m_thread_count;
+	std::size_t task_buffer_size_per_thread = this->m_task_buffer_size_per_thread;
+	unsigned int pop_rounds = this->m_pop_rounds;
+	unsigned int spin_count = this->m_spin_count;
+	unsigned int yield_count = this->m_yield_count;
 
-	while (true)
+	if (pop_rounds == 0)
 	{
-		xCOOL_THREADS_TRY
+		_cool_thmq_tblk* ptr = thread_blocks_data_ptr + thread_num;
+
+		ptr->m_thread = std::thread([this, ptr, elastic_ptr, timers_ptr, spin_count, yield_count, task_buffer_size_per_thread]()
 		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
+			if (!(ptr->start_thread(task_buffer_size_per_thread, elastic_ptr)))
+			{
+				return;
+			}
 
-			_cool_thsq_task* last_task_ptr_p1 = (this->m_last_task_ptr + 1 != this->m_task_buffer_end_ptr) ? this->m_last_task_ptr + 1 : this->m_task_buffer_data_ptr;
+			this->this_thread_block() = ptr;
 
-			if (last_task_ptr_p1 != this->m_next_task_ptr)
+			while (true)
 			{
-				new (static_cast<void*>(this->m_last_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(&target);
-
-				this->m_last_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
+				xCOOL_THREADS_TRY
 				{
-					if (_fetch_task_ptr == nullptr)
+					_cool_thmq_task current_task;
+
+					this->fire_timers(false);
+
+					// the tasks queued by this thread on its local deque are run first, the newest first
+
+					if (!(ptr->deque_pop(&current_task)))
 					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+						std::unique_lock<std::mutex> lock(ptr->m_mutex, std::defer_lock);
 
-						xCOOL_THREADS_TRY
+						bool timer_service = ptr->wait_for_task(lock, spin_count, yield_count, elastic_ptr, timers_ptr);
+
+						while (timer_service && !(ptr->has_task()))
 						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
+							lock.unlock();
+							this->fire_timers(false);
+							timer_service = ptr->wait_for_task(lock, spin_count, yield_count, elastic_ptr, timers_ptr);
 						}
-						xCOOL_THREADS_CATCH(const std::exception & xCOOL_THREADS_EXCEPTION)
+
+						if (ptr->has_task())
 						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
+							ptr->pop_task(&current_task);
+						}
+						else
+						{
+							this->this_thread_block() = nullptr;
+							return;
 						}
 
-						static_cast<cool::async_end*>(_task_ptr->m_address_data.m_target_ptr)->decr_awaited();
-
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_size);
+						if (timer_service)
+						{
+							lock.unlock();
+							this->hand_over_timers();
+						}
 					}
-				};
-
-				this->m_last_task_ptr = last_task_ptr_p1;
 
-				break;
+					xCOOL_THREADS_STATS(std::int64_t task_start = cool::_threads_base::stats_now();)
+					current_task.m_address_data.m_callable(&current_task, nullptr);
+					xCOOL_THREADS_STATS(ptr->m_stats.record_task(task_start, current_task.m_address_data.m_function_ptr);)
+				}
+				xCOOL_THREADS_CATCH(...) {}
 			}
-			else
+		});
+	}
+	else if (pop_rounds == 1)
+	{
+		(thread_blocks_data_ptr + thread_num)->m_thread = std::thread([this, thread_blocks_data_ptr, elastic_ptr, timers_ptr, thread_num, thread_count, spin_count, yield_count, task_buffer_size_per_thread]()
+		{
+			if (!((thread_blocks_data_ptr + thread_num)->start_thread(task_buffer_size_per_thread, elastic_ptr)))
 			{
-				return false;
+				return;
 			}
-		}
-		xCOOL_THREADS_CATCH(...) {}
-	}
 
-	this->m_condition_var.notify_one();
+			this->this_thread_block() = thread_blocks_data_ptr + thread_num;
 
-	return true;
-}
+			while (true)
+			{
+				xCOOL_THREADS_TRY
+				{
+					_cool_thmq_task current_task;
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
-{
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+					this->fire_timers(false);
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::try_priority_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::try_priority_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::try_priority_async : task arguments alignment too large");
+					bool ongoing = [&]() -> bool
+					{
+						// the tasks queued by this thread on its local deque are run first, the newest first, the local deques
+						// of the other threads are probed along with their queues
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_sq<...>::try_priority_async : task arguments size or alignment too large");
-		std::terminate();
-	}
+						if ((thread_blocks_data_ptr + thread_num)->deque_pop(&current_task))
+						{
+							return true; // return from lambda, sets variable 'ongoing' as true
+						}
 
-	while (true)
-	{
-		xCOOL_THREADS_TRY
-		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
+						for (std::size_t k = thread_num; k < thread_count; k++)
+						{
+							_cool_thmq_tblk* ptr = thread_blocks_data_ptr + k;
+
+							std::unique_lock<std::mutex> lock(ptr->m_mutex, std::try_to_lock);
+
+							if (lock.owns_lock() && ptr->has_task())
+							{
+								ptr->pop_task(&current_task);
+
+								xCOOL_THREADS_STATS((thread_blocks_data_ptr + thread_num)->m_stats.m_probe_hits.fetch_add(1, std::memory_order_relaxed);)
+
+								return true; // return from lambda, sets variable 'ongoing' as true
+							}
+
+							if ((k != thread_num) && ptr->deque_steal(&current_task))
+							{
+								xCOOL_THREADS_STATS((thread_blocks_data_ptr + thread_num)->m_stats.m_probe_hits.fetch_add(1, std::memory_order_relaxed);)
+
+								return true; // return from lambda, sets variable 'ongoing' as true
+							}
+						}
+
+						for (std::size_t k = 0; k < thread_num; k++)
+						{
+							_cool_thmq_tblk* ptr = thread_blocks_data_ptr + k;
 
-			_cool_thsq_task* next_task_ptr_m1 = (this->m_next_task_ptr != this->m_task_buffer_data_ptr) ? this->m_next_task_ptr - 1 : this->m_task_buffer_end_ptr - 1;
+							std::unique_lock<std::mutex> lock(ptr->m_mutex, std::try_to_lock);
 
-			if (this->m_last_task_ptr != next_task_ptr_m1)
-			{
-				this->m_next_task_ptr = next_task_ptr_m1;
+							if (lock.owns_lock() && ptr->has_task())
+							{
+								ptr->pop_task(&current_task);
 
-				new (static_cast<void*>(this->m_next_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_next_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_next_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(&target);
+								xCOOL_THREADS_STATS((thread_blocks_data_ptr + thread_num)->m_stats.m_probe_hits.fetch_add(1, std::memory_order_relaxed);)
 
-				this->m_next_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
-				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+								return true; // return from lambda, sets variable 'ongoing' as true
+							}
 
-						xCOOL_THREADS_TRY
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception & xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
+							if ((k != thread_num) && ptr->deque_steal(&current_task))
+							{
+								xCOOL_THREADS_STATS((thread_blocks_data_ptr + thread_num)->m_stats.m_probe_hits.fetch_add(1, std::memory_order_relaxed);)
+
+								return true; // return from lambda, sets variable 'ongoing' as true
+							}
 						}
 
-						static_cast<cool::async_end*>(_task_ptr->m_address_data.m_target_ptr)->decr_awaited();
+						{
+							xCOOL_THREADS_STATS((thread_blocks_data_ptr + thread_num)->m_stats.m_probe_misses.fetch_add(1, std::memory_order_relaxed);)
 
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
+							_cool_thmq_tblk* ptr = thread_blocks_data_ptr + thread_num;
 
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_size);
-					}
-				};
+							std::unique_lock<std::mutex> lock(ptr->m_mutex, std::defer_lock);
 
-				break;
-			}
-			else
-			{
-				return false;
-			}
-		}
-		xCOOL_THREADS_CATCH(...) {}
-	}
+							bool timer_service = ptr->wait_for_task(lock, spin_count, yield_count, elastic_ptr, timers_ptr);
 
-	this->m_condition_var.notify_one();
+							while (timer_service && !(ptr->has_task()))
+							{
+								lock.unlock();
+								this->fire_timers(false);
+								timer_service = ptr->wait_for_task(lock, spin_count, yield_count, elastic_ptr, timers_ptr);
+							}
 
-	return true;
-}
+							if (ptr->has_task())
+							{
+								ptr->pop_task(&current_task);
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
-{
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+								if (timer_service)
+								{
+									lock.unlock();
+									this->hand_over_timers();
+								}
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::try_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::try_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::try_async : task arguments alignment too large");
+								return true; // return from lambda, sets variable 'ongoing' as true
+							}
+							else
+							{
+								return false; // return from lambda, sets variable 'ongoing' as false
+							}
+						}
+					}();
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_sq<...>::try_async : task arguments size or alignment too large");
-		std::terminate();
+					if (ongoing)
+					{
+						xCOOL_THREADS_STATS(std::int64_t task_start = cool::_threads_base::stats_now();)
+						current_task.m_address_data.m_callable(&current_task, nullptr);
+						xCOOL_THREADS_STATS((thread_blocks_data_ptr + thread_num)->m_stats.record_task(task_start, current_task.m_address_data.m_function_ptr);)
+					}
+					else
+					{
+						this->this_thread_block() = nullptr;
+						return;
+					}
+				}
+				xCOOL_THREADS_CATCH(...) {}
+			}
+		});
 	}
-
-	while (true)
+	else
 	{
-		xCOOL_THREADS_TRY
+		(thread_blocks_data_ptr + thread_num)->m_thread = std::thread([this, thread_blocks_data_ptr, elastic_ptr, timers_ptr, thread_num, thread_count, pop_rounds, spin_count, yield_count, task_buffer_size_per_thread]()
 		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
+			if (!((thread_blocks_data_ptr + thread_num)->start_thread(task_buffer_size_per_thread, elastic_ptr)))
+			{
+				return;
+			}
 
-			_cool_thsq_task* last_task_ptr_p1 = (this->m_last_task_ptr + 1 != this->m_task_buffer_end_ptr) ? this->m_last_task_ptr + 1 : this->m_task_buffer_data_ptr;
+			this->this_thread_block() = thread_blocks_data_ptr + thread_num;
 
-			if (last_task_ptr_p1 != this->m_next_task_ptr)
+			while (true)
 			{
-				target.m_parent_ptr->m_tasks_awaited.fetch_add(1, std::memory_order_relaxed);
+				xCOOL_THREADS_TRY
+				{
+					_cool_thmq_task current_task;
 
-				new (static_cast<void*>(this->m_last_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
+					this->fire_timers(false);
 
-				this->m_last_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
-				{
-					if (_fetch_task_ptr == nullptr)
+					bool ongoing = [&]() -> bool
 					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+						// the tasks queued by this thread on its local deque are run first, the newest first, the local deques
+						// of the other threads are probed along with their queues
 
-						xCOOL_THREADS_TRY
+						if ((thread_blocks_data_ptr + thread_num)->deque_pop(&current_task))
 						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
+							return true; // return from lambda, sets variable 'ongoing' as true
 						}
-						xCOOL_THREADS_CATCH(const std::exception & xCOOL_THREADS_EXCEPTION)
+
+						for (unsigned int n = pop_rounds; n > 0; n--)
 						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
+							for (std::size_t k = thread_num; k < thread_count; k++)
+							{
+								_cool_thmq_tblk* ptr = thread_blocks_data_ptr + k;
 
-						static_cast<cool::async_end*>(_task_ptr->m_address_data.m_target_ptr)->decr_awaited();
+								std::unique_lock<std::mutex> lock(ptr->m_mutex, std::try_to_lock);
 
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
+								if (lock.owns_lock() && ptr->has_task())
+								{
+									ptr->pop_task(&current_task);
 
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_size);
-					}
-				};
+									xCOOL_THREADS_STATS((thread_blocks_data_ptr + thread_num)->m_stats.m_probe_hits.fetch_add(1, std::memory_order_relaxed);)
 
-				this->m_last_task_ptr = last_task_ptr_p1;
+									return true; // return from lambda, sets variable 'ongoing' as true
+								}
 
-				break;
-			}
-			else
-			{
-				return false;
-			}
-		}
-		xCOOL_THREADS_CATCH(...) {}
-	}
+								if ((k != thread_num) && ptr->deque_steal(&current_task))
+								{
+									xCOOL_THREADS_STATS((thread_blocks_data_ptr + thread_num)->m_stats.m_probe_hits.fetch_add(1, std::memory_order_relaxed);)
 
-	this->m_condition_var.notify_one();
+									return true; // return from lambda, sets variable 'ongoing' as true
+								}
+							}
 
-	return true;
-}
+							for (std::size_t k = 0; k < thread_num; k++)
+							{
+								_cool_thmq_tblk* ptr = thread_blocks_data_ptr + k;
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
-{
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+								std::unique_lock<std::mutex> lock(ptr->m_mutex, std::try_to_lock);
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::try_priority_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::try_priority_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::try_priority_async : task arguments alignment too large");
+								if (lock.owns_lock() && ptr->has_task())
+								{
+									ptr->pop_task(&current_task);
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_sq<...>::try_priority_async : task arguments size or alignment too large");
-		std::terminate();
-	}
+									xCOOL_THREADS_STATS((thread_blocks_data_ptr + thread_num)->m_stats.m_probe_hits.fetch_add(1, std::memory_order_relaxed);)
 
-	while (true)
-	{
-		xCOOL_THREADS_TRY
-		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
+									return true; // return from lambda, sets variable 'ongoing' as true
+								}
 
-			_cool_thsq_task* next_task_ptr_m1 = (this->m_next_task_ptr != this->m_task_buffer_data_ptr) ? this->m_next_task_ptr - 1 : this->m_task_buffer_end_ptr - 1;
+								if ((k != thread_num) && ptr->deque_steal(&current_task))
+								{
+									xCOOL_THREADS_STATS((thread_blocks_data_ptr + thread_num)->m_stats.m_probe_hits.fetch_add(1, std::memory_order_relaxed);)
 
-			if (this->m_last_task_ptr != next_task_ptr_m1)
-			{
-				target.m_parent_ptr->m_tasks_awaited.fetch_add(1, std::memory_order_relaxed);
+									return true; // return from lambda, sets variable 'ongoing' as true
+								}
+							}
+						}
 
-				this->m_next_task_ptr = next_task_ptr_m1;
+						{
+							xCOOL_THREADS_STATS((thread_blocks_data_ptr + thread_num)->m_stats.m_probe_misses.fetch_add(1, std::memory_order_relaxed);)
 
-				new (static_cast<void*>(this->m_next_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_next_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_next_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
+							_cool_thmq_tblk* ptr = thread_blocks_data_ptr + thread_num;
 
-				this->m_next_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
-				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+							std::unique_lock<std::mutex> lock(ptr->m_mutex, std::defer_lock);
 
-						xCOOL_THREADS_TRY
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception & xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
+							bool timer_service = ptr->wait_for_task(lock, spin_count, yield_count, elastic_ptr, timers_ptr);
+
+							while (timer_service && !(ptr->has_task()))
+							{
+								lock.unlock();
+								this->fire_timers(false);
+								timer_service = ptr->wait_for_task(lock, spin_count, yield_count, elastic_ptr, timers_ptr);
+							}
+
+							if (ptr->has_task())
+							{
+								ptr->pop_task(&current_task);
+
+								if (timer_service)
+								{
+									lock.unlock();
+									this->hand_over_timers();
+								}
 
-						static_cast<cool::async_end*>(_task_ptr->m_address_data.m_target_ptr)->decr_awaited();
+								return true; // return from lambda, sets variable 'ongoing' as true
+							}
+							else
+							{
+								return false; // return from lambda, sets variable 'ongoing' as false
+							}
+						}
+					}();
 
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
+					if (ongoing)
+					{
+						xCOOL_THREADS_STATS(std::int64_t task_start = cool::_threads_base::stats_now();)
+						current_task.m_address_data.m_callable(&current_task, nullptr);
+						xCOOL_THREADS_STATS((thread_blocks_data_ptr + thread_num)->m_stats.record_task(task_start, current_task.m_address_data.m_function_ptr);)
 					}
 					else
 					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_size);
+						this->this_thread_block() = nullptr;
+						return;
 					}
-				};
-
-				break;
-			}
-			else
-			{
-				return false;
+				}
+				xCOOL_THREADS_CATCH(...) {}
 			}
-		}
-		xCOOL_THREADS_CATCH(...) {}
+		});
 	}
-
-	this->m_condition_var.notify_one();
-
-	return true;
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
-inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::start_stopped_thread() noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
-
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::try_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::try_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::try_async : task arguments alignment too large");
+	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_sq<...>::try_async : task arguments size or alignment too large");
-		std::terminate();
-	}
+	// a retiring thread that has not left yet is kept, otherwise the first stopped block gets a new thread
 
-	while (true)
+	for (int pass = 0; pass < 2; pass++)
 	{
-		xCOOL_THREADS_TRY
+		for (std::size_t thread_num = 0; thread_num < this->m_thread_count; thread_num++)
 		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
+			_cool_thmq_tblk* ptr = this->m_thread_blocks_data_ptr + thread_num;
+			int elastic_state = 0;
 
-			_cool_thsq_task* last_task_ptr_p1 = (this->m_last_task_ptr + 1 != this->m_task_buffer_end_ptr) ? this->m_last_task_ptr + 1 : this->m_task_buffer_data_ptr;
+			while (true)
+			{
+				xCOOL_THREADS_TRY
+				{
+					std::lock_guard<std::mutex> lock(ptr->m_mutex);
+
+					elastic_state = ptr->m_elastic_state;
+
+					if ((elastic_state == 1) && (pass == 0))
+					{
+						ptr->m_elastic_state = 0;
+						this->m_elastic.m_active_thread_count.fetch_add(1, std::memory_order_relaxed);
+					}
+					else if ((elastic_state == 2) && (pass == 1) && !(ptr->m_stop_threads))
+					{
+						ptr->m_elastic_state = 3;
+						this->m_elastic.m_active_thread_count.fetch_add(1, std::memory_order_relaxed);
+					}
+					break;
+				}
+				xCOOL_THREADS_CATCH(...) {}
+			}
 
-			if (last_task_ptr_p1 != this->m_next_task_ptr)
+			if ((elastic_state == 1) && (pass == 0))
 			{
-				new (static_cast<void*>(this->m_last_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-				this->m_last_task_ptr->m_address_data.m_offset = target.m_offset;
+				return true;
+			}
+			else if ((elastic_state == 2) && (pass == 1))
+			{
+				// the previous thread of the block, if any, has returned or is about to
+
+				bool thread_started = false;
 
-				this->m_last_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
+				xCOOL_THREADS_TRY
 				{
-					if (_fetch_task_ptr == nullptr)
+					if (ptr->m_thread.joinable())
 					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+						ptr->m_thread.join();
+					}
 
-						cool::async_result<return_Ty>& target_ref = *static_cast<cool::async_result<return_Ty>*>(_task_ptr->m_address_data.m_target_ptr);
+					this->launch_thread(thread_num);
+					thread_started = true;
+				}
+				xCOOL_THREADS_CATCH(...) {}
 
+				if (!thread_started)
+				{
+					while (true)
+					{
 						xCOOL_THREADS_TRY
 						{
-							*(target_ref.m_stored_values_ptr + _task_ptr->m_address_data.m_offset) = cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception & xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
+							std::lock_guard<std::mutex> lock(ptr->m_mutex);
+							ptr->m_elastic_state = 2;
+							this->m_elastic.m_active_thread_count.fetch_sub(1, std::memory_order_relaxed);
+							break;
 						}
-
-						target_ref.decr_awaited();
-
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_and_offset_size);
+						xCOOL_THREADS_CATCH(...) {}
 					}
-				};
-
-				this->m_last_task_ptr = last_task_ptr_p1;
+				}
 
-				break;
-			}
-			else
-			{
-				return false;
+				return thread_started;
 			}
 		}
-		xCOOL_THREADS_CATCH(...) {}
 	}
 
-	this->m_condition_var.notify_one();
-
-	return true;
+	return false;
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
-inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::grow_threads() noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
-
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::try_priority_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::try_priority_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::try_priority_async : task arguments alignment too large");
-
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
+	xCOOL_THREADS_TRY
 	{
-		assert(false && "cool::threads_sq<...>::try_priority_async : task arguments size or alignment too large");
-		std::terminate();
+		std::unique_lock<std::mutex> control_lock(this->m_elastic.m_mutex, std::try_to_lock);
+
+		if (control_lock.owns_lock() && !this->m_elastic.m_closed
+			&& (this->m_elastic.m_active_thread_count.load(std::memory_order_relaxed) < this->m_thread_count))
+		{
+			this->start_stopped_thread();
+		}
 	}
+	xCOOL_THREADS_CATCH(...) {}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class fill_Ty>
+inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::push_timer(fill_Ty& fill, std::int64_t deadline_ns) noexcept
+{
+	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thmq_timer = typename cool::_threads_base::_timer_wheel<_cool_thmq_task>::_timer;
+
+	bool wake_up_required = false;
 
 	while (true)
 	{
 		xCOOL_THREADS_TRY
 		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
+			std::lock_guard<std::mutex> timer_lock(this->m_timer_wheel.m_mutex);
 
-			_cool_thsq_task* next_task_ptr_m1 = (this->m_next_task_ptr != this->m_task_buffer_data_ptr) ? this->m_next_task_ptr - 1 : this->m_task_buffer_end_ptr - 1;
+			_cool_thmq_timer* timer_ptr = this->m_timer_wheel.acquire();
 
-			if (this->m_last_task_ptr != next_task_ptr_m1)
+			if (timer_ptr == nullptr)
 			{
-				this->m_next_task_ptr = next_task_ptr_m1;
-
-				new (static_cast<void*>(this->m_next_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_next_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_next_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-				this->m_next_task_ptr->m_address_data.m_offset = target.m_offset;
-
-				this->m_next_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
-				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
-
-						cool::async_result<return_Ty>& target_ref = *static_cast<cool::async_result<return_Ty>*>(_task_ptr->m_address_data.m_target_ptr);
-
-						xCOOL_THREADS_TRY
-						{
-							*(target_ref.m_stored_values_ptr + _task_ptr->m_address_data.m_offset) = cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception & xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
-
-						target_ref.decr_awaited();
-
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_and_offset_size);
-					}
-				};
-
-				break;
+				return false;
 			}
-			else
+
+			if (!fill(&timer_ptr->m_task, &this->m_timer_wheel.m_arg_slab))
 			{
+				this->m_timer_wheel.release(timer_ptr);
 				return false;
 			}
+
+			wake_up_required = this->m_timer_wheel.schedule(timer_ptr, deadline_ns);
+			break;
 		}
 		xCOOL_THREADS_CATCH(...) {}
 	}
 
-	this->m_condition_var.notify_one();
+	if (wake_up_required)
+	{
+		this->wake_timer_keeper();
+	}
 
 	return true;
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
-inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::fire_timers(bool flush) noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
-
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::try_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::try_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::try_async : task arguments alignment too large");
+	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thmq_timers = cool::_threads_base::_timer_wheel<_cool_thmq_task>;
+	using _cool_thmq_timer = typename _cool_thmq_timers::_timer;
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
+	if ((this->m_timer_wheel.m_timer_count.load(std::memory_order_relaxed) == 0)
+		|| (!flush && (_cool_thmq_timers::now_ns() < this->m_timer_wheel.m_next_deadline_ns.load(std::memory_order_relaxed))))
 	{
-		assert(false && "cool::threads_sq<...>::try_async : task arguments size or alignment too large");
-		std::terminate();
+		return;
 	}
 
 	while (true)
 	{
 		xCOOL_THREADS_TRY
 		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
+			// a thread that finds the timers locked leaves them to the thread holding the lock
 
-			_cool_thsq_task* last_task_ptr_p1 = (this->m_last_task_ptr + 1 != this->m_task_buffer_end_ptr) ? this->m_last_task_ptr + 1 : this->m_task_buffer_data_ptr;
+			std::unique_lock<std::mutex> timer_lock(this->m_timer_wheel.m_mutex, std::defer_lock);
 
-			if (last_task_ptr_p1 != this->m_next_task_ptr)
+			if (flush)
 			{
-				target.m_parent_ptr->m_tasks_awaited.fetch_add(1, std::memory_order_relaxed);
+				timer_lock.lock();
+			}
+			else if (!timer_lock.try_lock())
+			{
+				return;
+			}
 
-				new (static_cast<void*>(this->m_last_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-				this->m_last_task_ptr->m_address_data.m_offset = target.m_offset;
+			_cool_thmq_timer* timer_ptr = this->m_timer_wheel.expire(flush ? _cool_thmq_timers::no_deadline : _cool_thmq_timers::now_ns());
 
-				this->m_last_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
+			while (timer_ptr != nullptr)
+			{
+				_cool_thmq_timer* next_ptr = timer_ptr->m_next_ptr;
+
+				auto fill = [timer_ptr](_cool_thmq_task* task_ptr, cool::_threads_base::_arg_slab*) -> bool
 				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+					timer_ptr->m_task.m_address_data.m_callable(task_ptr, &timer_ptr->m_task);
+					return true;
+				};
 
-						cool::async_result<return_Ty>& target_ref = *static_cast<cool::async_result<return_Ty>*>(_task_ptr->m_address_data.m_target_ptr);
+				if (!(this->push_priority(fill, 0, flush)))
+				{
+					this->m_timer_wheel.postpone(timer_ptr); // all queues are full, the rest is queued on a later call
+					return;
+				}
 
-						xCOOL_THREADS_TRY
-						{
-							*(target_ref.m_stored_values_ptr + _task_ptr->m_address_data.m_offset) = cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception & xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
+				this->m_timer_wheel.release(timer_ptr);
+				timer_ptr = next_ptr;
+			}
 
-						target_ref.decr_awaited();
+			return;
+		}
+		xCOOL_THREADS_CATCH(...) {}
+	}
+}
 
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::wake_timer_keeper() noexcept
+{
+	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
 
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_and_offset_size);
-					}
-				};
+	// locking orders the new deadline before the predicate checks of the parked threads
 
-				this->m_last_task_ptr = last_task_ptr_p1;
+	for (std::size_t thread_num = 0; thread_num < this->m_thread_count; thread_num++)
+	{
+		_cool_thmq_tblk* ptr = this->m_thread_blocks_data_ptr + thread_num;
 
-				break;
-			}
-			else
+		while (true)
+		{
+			xCOOL_THREADS_TRY
 			{
-				return false;
+				std::lock_guard<std::mutex> lock(ptr->m_mutex);
+				break;
 			}
+			xCOOL_THREADS_CATCH(...) {}
 		}
-		xCOOL_THREADS_CATCH(...) {}
-	}
 
-	this->m_condition_var.notify_one();
-
-	return true;
+		ptr->m_condition_var.notify_one();
+	}
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
-inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_priority_async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::hand_over_timers() noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
-
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_sq<...>::try_priority_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thsq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_sq<...>::try_priority_async : task arguments size too large");
-	static_assert((alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task)) || !_arg_type_static_check, "cool::threads_sq<...>::try_priority_async : task arguments alignment too large");
+	this->fire_timers(false);
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
+	if ((this->m_timer_wheel.m_timer_count.load(std::memory_order_relaxed) != 0) && !(this->m_timer_wheel.m_keeper.load(std::memory_order_relaxed)))
 	{
-		assert(false && "cool::threads_sq<...>::try_priority_async : task arguments size or alignment too large");
-		std::terminate();
+		this->wake_timer_keeper();
 	}
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline void cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::delete_threads_detail(std::size_t threads_constructed, std::size_t threads_launched) noexcept
+{
+	bool was_good = this->m_good.exchange(false, std::memory_order_seq_cst);
 
 	while (true)
 	{
 		xCOOL_THREADS_TRY
 		{
-			std::lock_guard<std::mutex> lock(this->m_mutex);
+			std::lock_guard<std::mutex> control_lock(this->m_elastic.m_mutex);
+			this->m_elastic.m_closed = true;
+			break;
+		}
+		xCOOL_THREADS_CATCH(...) {}
+	}
 
-			_cool_thsq_task* next_task_ptr_m1 = (this->m_next_task_ptr != this->m_task_buffer_data_ptr) ? this->m_next_task_ptr - 1 : this->m_task_buffer_end_ptr - 1;
+	_thread_block* ptr = this->m_thread_blocks_data_ptr;
 
-			if (this->m_last_task_ptr != next_task_ptr_m1)
+	if (ptr != nullptr)
+	{
+		for (std::size_t k = 0; k < threads_launched; k++)
+		{
+			while (true)
 			{
-				target.m_parent_ptr->m_tasks_awaited.fetch_add(1, std::memory_order_relaxed);
+				xCOOL_THREADS_TRY
+				{
+					std::lock_guard<std::mutex> lock((ptr + k)->m_mutex);
+					(ptr + k)->m_stop_threads = true;
+					(ptr + k)->m_has_task.store(true, std::memory_order_relaxed); // ends the spin and yield phases of 'wait_for_task'
+					break;
+				}
+				xCOOL_THREADS_CATCH(...) {}
+			}
 
-				this->m_next_task_ptr = next_task_ptr_m1;
+			(ptr + k)->m_condition_var.notify_one();
 
-				new (static_cast<void*>(this->m_next_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::forward<arg_Ty>(args)...);
-				std::memcpy(&(this->m_next_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-				this->m_next_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-				this->m_next_task_ptr->m_address_data.m_offset = target.m_offset;
+			if ((ptr + k)->m_thread.joinable())
+			{
+				std::thread::id thread_id = (ptr + k)->m_thread.get_id();
 
-				this->m_next_task_ptr->m_address_data.m_callable = [](_cool_thsq_task* _task_ptr, _cool_thsq_task* _fetch_task_ptr)
+				xCOOL_THREADS_TRY
 				{
-					if (_fetch_task_ptr == nullptr)
-					{
-						function_Ty function_ptr;
-						std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+					(ptr + k)->m_thread.join();
+				}
+				xCOOL_THREADS_CATCH(const std::system_error& xCOOL_THREADS_SYSTEM_ERROR)
+				{
+					cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::catch_delete_thread_exception(xCOOL_THREADS_SYSTEM_ERROR, thread_id);
+				}
+			}
+		}
+
+		if (was_good)
+		{
+			while (!(this->m_can_refresh.load(std::memory_order_relaxed)) || !(this->m_can_refresh.exchange(false, std::memory_order_acquire)))
+			{
+				std::this_thread::yield();
+			}
+		}
 
-						cool::async_result<return_Ty>& target_ref = *static_cast<cool::async_result<return_Ty>*>(_task_ptr->m_address_data.m_target_ptr);
+		for (std::size_t k = 0; k < threads_constructed; k++)
+		{
+			(ptr + k)->delete_task_buffer();
+			(ptr + k)->~_thread_block();
+		}
 
-						xCOOL_THREADS_TRY
-						{
-							*(target_ref.m_stored_values_ptr + _task_ptr->m_address_data.m_offset) = cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call(
-								function_ptr, std::move(*reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer))
-							);
-						}
-						xCOOL_THREADS_CATCH(const std::exception & xCOOL_THREADS_EXCEPTION)
-						{
-							cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-						}
+		::operator delete(this->m_thread_blocks_unaligned_data_ptr);
+	}
 
-						target_ref.decr_awaited();
+	this->m_timer_wheel.delete_timers();
 
-						reinterpret_cast<_cool_thsq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
-					}
-					else
-					{
-						new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thsq_pack(std::move(*reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-						reinterpret_cast<_cool_thsq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thsq_pack();
+	constexpr std::size_t uintX_bitcount = sizeof(_uintX) * CHAR_BIT;
 
-						std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thsq_task::address_with_target_and_offset_size);
-					}
-				};
+	this->m_dispatch_interval = 1;
+	this->m_mod_k = 0;
+	this->m_mod_a = static_cast<_uint2X>(1) << uintX_bitcount;
+	this->m_mod_D = 1;
+	this->m_thread_count = 0;
+	this->m_thread_blocks_data_ptr = nullptr;
 
-				break;
-			}
-			else
-			{
-				return false;
-			}
-		}
-		xCOOL_THREADS_CATCH(...) {}
-	}
+	this->m_pop_rounds = 0;
+	this->m_elastic.m_active_thread_count.store(0, std::memory_order_relaxed);
 
-	this->m_condition_var.notify_one();
+	this->m_thread_blocks_unaligned_data_ptr = nullptr;
 
-	return true;
+	std::atomic_signal_fence(std::memory_order_release);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::saturated(const _thread_block* block_ptr) const noexcept
+{
+	return (m_elastic.m_grow_queue_depth != 0) && (block_ptr->task_count() >= m_elastic.m_grow_queue_depth)
+		&& (m_elastic.m_active_thread_count.load(std::memory_order_relaxed) < m_thread_count);
+}
+
+
+// threads_ws detail
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::threads_ws::~threads_ws()
+{
+	delete_threads();
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline void cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::_async_end_incr_proxy, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::_async_result_to_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline void cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::_async_result_incr_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	push_task(fill, true);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::no_target_t, function_Ty, arg_Ty ...> fill(cool::no_target, task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::async_end&, function_Ty, arg_Ty ...> fill(target, task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
+inline bool cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::_async_end_incr_proxy, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::_async_result_to_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
+inline bool cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+{
+	cool::_threads_base::_task_fill<_task, _arg_type_static_check, false, cool::_async_result_incr_proxy<return_Ty>, function_Ty, arg_Ty ...> fill(std::move(target), task, std::forward<arg_Ty>(args)...);
+
+	return push_task(fill, false);
 }
 
 template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class ... arg_Ty>
-inline constexpr bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::arg_type_is_valid() noexcept
+inline constexpr bool cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::arg_type_is_valid() noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thsq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+	using _cool_thws_task = typename cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thws_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
 
-	constexpr bool ret = (sizeof(_cool_thsq_pack) <= _arg_buffer_size) && (alignof(_cool_thsq_pack) <= alignof(_cool_thsq_task));
+	constexpr bool ret = (sizeof(_cool_thws_pack) <= _arg_buffer_size) && (alignof(_cool_thws_pack) <= alignof(_cool_thws_task));
 	return ret;
 }
 
 template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline cool::threads_init_result cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::init_new_threads(cool::thread_count new_thread_count, cool::task_buffer_size new_task_buffer_size) noexcept
+inline cool::threads_init_result cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::init_new_threads(
+	cool::thread_count new_thread_count,
+	cool::task_buffer_size new_task_buffer_size,
+	cool::try_pop_count new_try_pop_count) noexcept
 {
-	using _cool_thsq_task = typename cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thws_task = typename cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thws_tblk = typename cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
 
-	assert((reinterpret_cast<std::uintptr_t>(this) % cache_line_size == 0) && "cool::threads_sq<...> : object location must be aligned in memory");
+	assert((reinterpret_cast<std::uintptr_t>(this) % cache_line_size == 0) && "cool::threads_ws<...> : object location must be aligned in memory");
 
 	if (reinterpret_cast<std::uintptr_t>(this) % cache_line_size != 0)
 	{
@@ -2688,7 +8156,6 @@ inline cool::threads_init_result cool::threads_sq<_cache_line_size, _arg_buffer_
 	else
 	{
 		delete_threads();
-		this->m_stop_threads = false;
 	}
 
 	if ((new_thread_count.value() == 0) || (new_task_buffer_size.value() == 0))
@@ -2697,84 +8164,81 @@ inline cool::threads_init_result cool::threads_sq<_cache_line_size, _arg_buffer_
 	}
 
 	std::size_t _new_thread_count = static_cast<std::size_t>(new_thread_count.value());
-	this->m_thread_count = _new_thread_count;
-
-	std::size_t threads_constructed = 0;
-
-	this->m_threads_data_ptr = static_cast<std::thread*>(::operator new(
-		_new_thread_count * sizeof(std::thread) + 2 * cache_line_size, std::nothrow));
-
-	if (this->m_threads_data_ptr == nullptr)
-	{
-		this->delete_threads_detail(threads_constructed);
-		std::atomic_signal_fence(std::memory_order_release);
-		return cool::threads_init_result(cool::threads_init_result::bad_alloc);
-	}
-	else
+	std::size_t task_buffer_size_per_thread = new_task_buffer_size.value() / _new_thread_count;
+	if (_new_thread_count * task_buffer_size_per_thread != new_task_buffer_size.value())
 	{
-		this->m_threads_data_ptr = reinterpret_cast<std::thread*>(
-			reinterpret_cast<char*>(this->m_threads_data_ptr) + cache_line_size);
+		task_buffer_size_per_thread++;
 	}
 
-	constexpr std::size_t task_buffer_padding = (cache_line_size > arg_buffer_align) ? cache_line_size : arg_buffer_align;
-	std::size_t new_task_buffer_size_p1 = new_task_buffer_size.value() + 1;
+	this->m_thread_count = _new_thread_count;
+	this->m_steal_count = (new_try_pop_count.value() != 0) ? new_try_pop_count.value() : 2 * static_cast<unsigned int>(new_thread_count.value());
+	this->m_thread_dispatch.store(0, std::memory_order_relaxed);
+	this->m_idle_count.store(0, std::memory_order_relaxed);
 
-	this->m_task_buffer_unaligned_data_ptr = static_cast<char*>(::operator new(new_task_buffer_size_p1 * sizeof(_cool_thsq_task) + task_buffer_padding + cache_line_size, std::nothrow));
+	std::size_t threads_constructed = 0;
+	std::size_t threads_launched = 0;
 
-	if (this->m_task_buffer_unaligned_data_ptr == nullptr)
-	{
-		this->delete_threads_detail(threads_constructed);
-		std::atomic_signal_fence(std::memory_order_release);
+	this->m_thread_blocks_unaligned_data_ptr = static_cast<char*>(::operator new(
+		_new_thread_count * sizeof(_cool_thws_tblk) + 2 * cache_line_size, std::nothrow));
+
+	if (this->m_thread_blocks_unaligned_data_ptr == nullptr)
+	{
+		this->delete_threads_detail(threads_constructed, threads_launched);
 		return cool::threads_init_result(cool::threads_init_result::bad_alloc);
 	}
 	else
 	{
-		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_task_buffer_unaligned_data_ptr) % static_cast<std::uintptr_t>(task_buffer_padding);
+		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_thread_blocks_unaligned_data_ptr) % static_cast<std::uintptr_t>(cache_line_size);
 
-		this->m_task_buffer_data_ptr = reinterpret_cast<_cool_thsq_task*>(this->m_task_buffer_unaligned_data_ptr
-			+ static_cast<std::size_t>(ptr_remainder != 0) * (task_buffer_padding - static_cast<std::size_t>(ptr_remainder)));
+		this->m_thread_blocks_data_ptr = reinterpret_cast<_cool_thws_tblk*>(this->m_thread_blocks_unaligned_data_ptr
+			+ static_cast<std::size_t>(ptr_remainder != 0) * (cache_line_size - static_cast<std::size_t>(ptr_remainder)));
 	}
 
-	this->m_task_buffer_end_ptr = this->m_task_buffer_data_ptr + new_task_buffer_size_p1;
-	this->m_last_task_ptr = this->m_task_buffer_data_ptr;
-	this->m_next_task_ptr = this->m_task_buffer_data_ptr;
-
-	for (std::size_t k = 0; k < new_task_buffer_size_p1; k++)
+	for (std::size_t thread_num = 0; thread_num < _new_thread_count; thread_num++)
 	{
-		new (this->m_task_buffer_data_ptr + k) _cool_thsq_task();
+		_cool_thws_tblk* ptr = this->m_thread_blocks_data_ptr + thread_num;
+
+		new (ptr) _cool_thws_tblk();
+		ptr->m_parent_ptr = this;
+		ptr->m_thread_num = thread_num;
+		ptr->m_random_state = static_cast<std::uint32_t>(thread_num) + 1;
+
+		if (!(ptr->new_task_buffer(task_buffer_size_per_thread)))
+		{
+			threads_constructed++;
+			this->delete_threads_detail(threads_constructed, threads_launched);
+			return cool::threads_init_result(cool::threads_init_result::bad_alloc);
+		}
+		threads_constructed++;
 	}
 
-	for (std::size_t k = 0; k < _new_thread_count; k++)
+	for (std::size_t thread_num = 0; thread_num < _new_thread_count; thread_num++)
 	{
+		_cool_thws_tblk* ptr = this->m_thread_blocks_data_ptr + thread_num;
+
+		ptr->m_stop_threads = false;
+
 		xCOOL_THREADS_TRY
 		{
-			new (this->m_threads_data_ptr + k) std::thread([this]()
+			ptr->m_thread = std::thread([this, ptr]()
 			{
+				this->this_thread_block() = ptr;
+
 				while (true)
 				{
 					xCOOL_THREADS_TRY
 					{
-						_cool_thsq_task current_task;
+						_cool_thws_task current_task;
 
+						if (this->pop_task(ptr, &current_task))
 						{
-							std::unique_lock<std::mutex> lock(this->m_mutex);
-
-							this->m_condition_var.wait(lock, [this]() -> bool { return (this->m_next_task_ptr != this->m_last_task_ptr) || this->m_stop_threads; });
-
-							if (this->m_next_task_ptr != this->m_last_task_ptr)
-							{
-								this->m_next_task_ptr->m_address_data.m_callable(&current_task, this->m_next_task_ptr);
-
-								this->m_next_task_ptr = (this->m_next_task_ptr + 1 != this->m_task_buffer_end_ptr) ?
-									this->m_next_task_ptr + 1 : this->m_task_buffer_data_ptr;
-							}
-							else
-							{
-								return;
-							}
+							current_task.m_address_data.m_callable(&current_task, nullptr);
+						}
+						else
+						{
+							this->this_thread_block() = nullptr;
+							return;
 						}
-
-						current_task.m_address_data.m_callable(&current_task, nullptr);
 					}
 					xCOOL_THREADS_CATCH(...) {}
 				}
@@ -2782,40 +8246,48 @@ inline cool::threads_init_result cool::threads_sq<_cache_line_size, _arg_buffer_
 		}
 		xCOOL_THREADS_CATCH(...)
 		{
-			this->delete_threads_detail(threads_constructed);
-			std::atomic_signal_fence(std::memory_order_release);
+			this->delete_threads_detail(threads_constructed, threads_launched);
 			return cool::threads_init_result(cool::threads_init_result::bad_thread_creation);
 		}
 
-		threads_constructed++;
+		threads_launched++;
 	}
 
 	std::atomic_signal_fence(std::memory_order_release);
+	this->m_can_refresh.store(true, std::memory_order_release);
 	this->m_good.store(true, std::memory_order_seq_cst);
 	return cool::threads_init_result(cool::threads_init_result::success);
 }
 
 template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline bool cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::good() const noexcept
+inline bool cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::good() const noexcept
 {
 	return this->m_good.load(std::memory_order_seq_cst);
 }
 
 template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline std::size_t cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_count() const noexcept
+inline std::size_t cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_count() const noexcept
 {
 	std::atomic_signal_fence(std::memory_order_acquire);
 	return this->m_thread_count;
 }
 
 template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline std::size_t cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::task_buffer_size() const noexcept
+inline std::size_t cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::task_buffer_size() const noexcept
 {
 	std::atomic_signal_fence(std::memory_order_acquire);
 
-	if (this->m_task_buffer_data_ptr != nullptr)
+	if (this->m_thread_blocks_data_ptr != nullptr)
 	{
-		return static_cast<std::size_t>(this->m_task_buffer_end_ptr - this->m_task_buffer_data_ptr) - 1;
+		if (this->m_thread_blocks_data_ptr->m_task_buffer_data_ptr != nullptr)
+		{
+			return static_cast<std::size_t>((this->m_thread_blocks_data_ptr->m_task_buffer_end_ptr
+				- this->m_thread_blocks_data_ptr->m_task_buffer_data_ptr) - 1) * this->m_thread_count;
+		}
+		else
+		{
+			return 0;
+		}
 	}
 	else
 	{
@@ -2824,256 +8296,92 @@ inline std::size_t cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buf
 }
 
 template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::delete_threads() noexcept
+inline unsigned int cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_pop_count() const noexcept
 {
-	this->m_good.store(false, std::memory_order_seq_cst);
-	this->delete_threads_detail(this->m_thread_count);
-	std::atomic_signal_fence(std::memory_order_release);
+	std::atomic_signal_fence(std::memory_order_acquire);
+	return this->m_steal_count;
 }
 
 template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline void cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::safety_refresh() noexcept
+inline void cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::delete_threads() noexcept
 {
-	this->m_condition_var.notify_all();
+	this->delete_threads_detail(this->m_thread_count, this->m_thread_count);
 }
 
 template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline std::thread::id cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_id(std::size_t thread_number) const noexcept
+inline void cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::safety_refresh() noexcept
 {
-	return (this->m_threads_data_ptr + thread_number)->get_id();
-}
+	using _cool_thws_tblk = typename cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline cool::_thread_const_iterator_proxy<cool::_thread_iterator<cool::_thread_sq_id>> cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_ids() const noexcept
-{
-	return cool::_thread_const_iterator_proxy<cool::_thread_iterator<cool::_thread_sq_id>>(this->m_threads_data_ptr, this->m_threads_data_ptr + this->m_thread_count);
+	if (this->m_can_refresh.exchange(false, std::memory_order_acquire))
+	{
+		_cool_thws_tblk* ptr = this->m_thread_blocks_data_ptr;
+
+		for (std::size_t k = 0; k < this->m_thread_count; k++)
+		{
+			(ptr + k)->m_condition_var.notify_one();
+		}
+
+		this->m_can_refresh.store(true, std::memory_order_release);
+	}
 }
 
-#ifdef COOL_THREADS_NATIVE_HANDLE
 template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline std::thread::native_handle_type cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_native_handle(std::size_t thread_number)
+inline std::thread::id cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_id(std::size_t thread_number) const noexcept
 {
-	return (this->m_threads_data_ptr + thread_number)->native_handle();
+	return (this->m_thread_blocks_data_ptr + thread_number)->m_thread.get_id();
 }
 
 template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline cool::_thread_iterator_proxy<cool::_thread_iterator<cool::_thread_sq_native_handle>> cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_native_handles() noexcept
+inline cool::_thread_const_iterator_proxy<cool::_thread_iterator<cool::_thread_ws_id<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>> cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_ids() const noexcept
 {
-	return cool::_thread_iterator_proxy<cool::_thread_iterator<cool::_thread_sq_native_handle>>(this->m_threads_data_ptr, this->m_threads_data_ptr + this->m_thread_count);
+	return cool::_thread_const_iterator_proxy<cool::_thread_iterator<cool::_thread_ws_id<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>>(this->m_thread_blocks_data_ptr, this->m_thread_blocks_data_ptr + this->m_thread_count);
 }
-#endif // COOL_THREADS_NATIVE_HANDLE
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
-inline void cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::delete_threads_detail(std::size_t threads_constructed) noexcept
+#ifdef COOL_THREADS_NATIVE_HANDLE
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline std::thread::native_handle_type cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_native_handle(std::size_t thread_number)
 {
-	constexpr std::size_t cache_line_size = alignof(cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>);
-
-	while (true)
-	{
-		xCOOL_THREADS_TRY
-		{
-			std::unique_lock<std::mutex> lock(this->m_mutex);
-			this->m_stop_threads = true;
-			break;
-		}
-		xCOOL_THREADS_CATCH(...) {}
-	}
-
-	this->m_condition_var.notify_all();
-
-	if (this->m_threads_data_ptr != nullptr)
-	{
-		for (std::size_t k = 0; k < threads_constructed; k++)
-		{
-			if ((this->m_threads_data_ptr + k)->joinable())
-			{
-				std::thread::id thread_id = (this->m_threads_data_ptr + k)->get_id();
-
-				xCOOL_THREADS_TRY
-				{
-					(this->m_threads_data_ptr + k)->join();
-				}
-				xCOOL_THREADS_CATCH(const std::system_error& xCOOL_THREADS_SYSTEM_ERROR)
-				{
-					cool::_threads_sq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::catch_delete_thread_exception(xCOOL_THREADS_SYSTEM_ERROR, thread_id);
-				}
-			}
-			(this->m_threads_data_ptr + k)->~thread();
-		}
-
-		::operator delete(reinterpret_cast<char*>(this->m_threads_data_ptr) - cache_line_size);
-	}
-
-	if (this->m_task_buffer_data_ptr != nullptr)
-	{
-		std::size_t task_buffer_size = static_cast<std::size_t>(this->m_task_buffer_end_ptr - this->m_task_buffer_data_ptr);
-		for (std::size_t k = 0; k < task_buffer_size; k++)
-		{
-			(this->m_task_buffer_data_ptr + k)->~_task();
-		}
-
-		::operator delete(this->m_task_buffer_unaligned_data_ptr);
-	}
-
-	this->m_threads_data_ptr = nullptr;
-	this->m_thread_count = 0;
-
-	this->m_task_buffer_data_ptr = nullptr;
-	this->m_task_buffer_end_ptr = nullptr;
-	this->m_last_task_ptr = nullptr;
-	this->m_next_task_ptr = nullptr;
-
-	this->m_task_buffer_unaligned_data_ptr = nullptr;
+	return (this->m_thread_blocks_data_ptr + thread_number)->m_thread.native_handle();
 }
 
-
-// threads_mq detail
-
 template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::threads_mq::~threads_mq()
+inline cool::_thread_iterator_proxy<cool::_thread_iterator<cool::_thread_ws_native_handle<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>> cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_native_handles() noexcept
 {
-	delete_threads();
+	return cool::_thread_iterator_proxy<cool::_thread_iterator<cool::_thread_ws_native_handle<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>>(this->m_thread_blocks_data_ptr, this->m_thread_blocks_data_ptr + this->m_thread_count);
 }
+#endif // COOL_THREADS_NATIVE_HANDLE
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class fill_Ty>
+inline bool cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::push_task(fill_Ty& fill, bool wait_for_space) noexcept
 {
-	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
-	using _cool_thmq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
-
-	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
-	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
-
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_mq<...>::async : task must be a function pointer");
-	static_assert((sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_mq<...>::async : task arguments size too large");
-	static_assert((alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task)) || !_arg_type_static_check, "cool::threads_mq<...>::async : task arguments alignment too large");
-
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_mq<...>::async : task arguments size or alignment too large");
-		std::terminate();
-	}
-
-	constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
-
-	_cool_thmq_uint2X N = static_cast<_cool_thmq_uint2X>(this->m_thread_dispatch.fetch_add(this->m_dispatch_interval, std::memory_order_relaxed));
-	_cool_thmq_uint2X b = (N * this->m_mod_a) >> uintX_bitcount;
-	std::size_t thread_num = static_cast<std::size_t>(N - ((((N - b) >> 1) + b) >> this->m_mod_k) * this->m_mod_D);
+	using _cool_thws_task = typename cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thws_tblk = typename cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
 
-	std::size_t full_queue_counter = this->m_thread_count;
+	_cool_thws_tblk* local_thread_block_ptr = this->this_thread_block();
+	bool local_thread = (local_thread_block_ptr != nullptr) && (local_thread_block_ptr->m_parent_ptr == this);
+	std::size_t thread_num;
 
-	while (true)
+	if (local_thread)
 	{
-		_cool_thmq_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
-
-		xCOOL_THREADS_TRY
+		if (local_thread_block_ptr->deque_push(fill))
 		{
-			std::unique_lock<std::mutex> lock(current_thread_ptr->m_mutex, std::try_to_lock);
-
-			if (lock.owns_lock())
-			{
-				_cool_thmq_task* last_task_ptr_p1 = (current_thread_ptr->m_last_task_ptr + 1 != current_thread_ptr->m_task_buffer_end_ptr) ?
-					current_thread_ptr->m_last_task_ptr + 1 : current_thread_ptr->m_task_buffer_data_ptr;
-
-				if (last_task_ptr_p1 != current_thread_ptr->m_next_task_ptr)
-				{
-					new (static_cast<void*>(current_thread_ptr->m_last_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::forward<arg_Ty>(args)...);
-					std::memcpy(&(current_thread_ptr->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_callable = [](_cool_thmq_task* _task_ptr, _cool_thmq_task* _fetch_task_ptr)
-					{
-						if (_fetch_task_ptr == nullptr)
-						{
-							function_Ty function_ptr;
-							std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
-
-							xCOOL_THREADS_TRY
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-									function_ptr, std::move(*reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer))
-								);
-							}
-							xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-							}
-
-							reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
-						}
-						else
-						{
-							new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::move(*reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-							reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
-
-							std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thmq_task::address_size);
-						}
-					};
-
-					bool notification_required = (current_thread_ptr->m_last_task_ptr == current_thread_ptr->m_next_task_ptr);
-					current_thread_ptr->m_last_task_ptr = last_task_ptr_p1;
-					lock.unlock();
-
-					if (notification_required)
-					{
-						current_thread_ptr->m_condition_var.notify_one();
-					}
-
-					return;
-				}
-			}
-			else
-			{
-				full_queue_counter--;
-
-				if (full_queue_counter == 0)
-				{
-					std::this_thread::yield();
-					full_queue_counter = this->m_thread_count;
-				}
-			}
+			this->wake_idle_thread();
+			return true;
 		}
-		xCOOL_THREADS_CATCH(...) {}
-
-		thread_num = (thread_num != 0) ? thread_num - 1 : this->m_thread_count - 1;
-	}
-}
-
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
-{
-	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
-	using _cool_thmq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
-
-	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
-	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
-
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_mq<...>::async : task must be a function pointer");
-	static_assert((sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_mq<...>::async : task arguments size too large");
-	static_assert((alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task)) || !_arg_type_static_check, "cool::threads_mq<...>::async : task arguments alignment too large");
-
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_mq<...>::async : task arguments size or alignment too large");
-		std::terminate();
-	}
-
-	constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
 
-	_cool_thmq_uint2X N = static_cast<_cool_thmq_uint2X>(this->m_thread_dispatch.fetch_add(this->m_dispatch_interval, std::memory_order_relaxed));
-	_cool_thmq_uint2X b = (N * this->m_mod_a) >> uintX_bitcount;
-	std::size_t thread_num = static_cast<std::size_t>(N - ((((N - b) >> 1) + b) >> this->m_mod_k) * this->m_mod_D);
+		thread_num = local_thread_block_ptr->m_thread_num;
+	}
+	else
+	{
+		thread_num = this->m_thread_dispatch.fetch_add(1, std::memory_order_relaxed) % this->m_thread_count;
+	}
 
 	std::size_t full_queue_counter = this->m_thread_count;
 
 	while (true)
 	{
-		_cool_thmq_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
+		_cool_thws_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
 
 		xCOOL_THREADS_TRY
 		{
@@ -3081,45 +8389,12 @@ inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_ali
 
 			if (lock.owns_lock())
 			{
-				_cool_thmq_task* last_task_ptr_p1 = (current_thread_ptr->m_last_task_ptr + 1 != current_thread_ptr->m_task_buffer_end_ptr) ?
+				_cool_thws_task* last_task_ptr_p1 = (current_thread_ptr->m_last_task_ptr + 1 != current_thread_ptr->m_task_buffer_end_ptr) ?
 					current_thread_ptr->m_last_task_ptr + 1 : current_thread_ptr->m_task_buffer_data_ptr;
 
 				if (last_task_ptr_p1 != current_thread_ptr->m_next_task_ptr)
 				{
-					new (static_cast<void*>(current_thread_ptr->m_last_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::forward<arg_Ty>(args)...);
-					std::memcpy(&(current_thread_ptr->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(&target);
-
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_callable = [](_cool_thmq_task* _task_ptr, _cool_thmq_task* _fetch_task_ptr)
-					{
-						if (_fetch_task_ptr == nullptr)
-						{
-							function_Ty function_ptr;
-							std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
-
-							xCOOL_THREADS_TRY
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-									function_ptr, std::move(*reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer))
-								);
-							}
-							xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-							}
-
-							static_cast<cool::async_end*>(_task_ptr->m_address_data.m_target_ptr)->decr_awaited();
-
-							reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
-						}
-						else
-						{
-							new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::move(*reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-							reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
-
-							std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thmq_task::address_with_target_size);
-						}
-					};
+					fill(current_thread_ptr->m_last_task_ptr, nullptr);
 
 					bool notification_required = (current_thread_ptr->m_last_task_ptr == current_thread_ptr->m_next_task_ptr);
 					current_thread_ptr->m_last_task_ptr = last_task_ptr_p1;
@@ -3130,17 +8405,41 @@ inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_ali
 						current_thread_ptr->m_condition_var.notify_one();
 					}
 
-					return;
+					this->wake_idle_thread();
+
+					return true;
+				}
+			}
+
+			// a queue that is full or locked counts as a failed attempt, 'try_async' gives up once every queue has been tried
+
+			full_queue_counter--;
+
+			if (full_queue_counter == 0)
+			{
+				if (!wait_for_space)
+				{
+					return false;
 				}
 				else
 				{
-					full_queue_counter--;
+					// a thread of this threads_ws object waiting for space could deadlock if all threads do so, the task is run in place instead
 
-					if (full_queue_counter == 0)
+					if (local_thread)
 					{
-						std::this_thread::yield();
-						full_queue_counter = this->m_thread_count;
+						if (lock.owns_lock())
+						{
+							lock.unlock();
+						}
+
+						_cool_thws_task local_task;
+						fill(&local_task, nullptr);
+						local_task.m_address_data.m_callable(&local_task, nullptr);
+						return true;
 					}
+
+					std::this_thread::yield();
+					full_queue_counter = this->m_thread_count;
 				}
 			}
 		}
@@ -3150,1702 +8449,1571 @@ inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_ali
 	}
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline bool cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::run_pending_task() noexcept
 {
-	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
-	using _cool_thmq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
-
-	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
-	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
+	using _cool_thws_tblk = typename cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_mq<...>::async : task must be a function pointer");
-	static_assert((sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_mq<...>::async : task arguments size too large");
-	static_assert((alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task)) || !_arg_type_static_check, "cool::threads_mq<...>::async : task arguments alignment too large");
+	_task current_task;
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_mq<...>::async : task arguments size or alignment too large");
-		std::terminate();
-	}
+	_cool_thws_tblk* local_thread_block_ptr = this->this_thread_block();
+	bool local_thread = (local_thread_block_ptr != nullptr) && (local_thread_block_ptr->m_parent_ptr == this);
 
-	constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
+	bool found = local_thread && local_thread_block_ptr->deque_pop(&current_task);
 
-	_cool_thmq_uint2X N = static_cast<_cool_thmq_uint2X>(this->m_thread_dispatch.fetch_add(this->m_dispatch_interval, std::memory_order_relaxed));
-	_cool_thmq_uint2X b = (N * this->m_mod_a) >> uintX_bitcount;
-	std::size_t thread_num = static_cast<std::size_t>(N - ((((N - b) >> 1) + b) >> this->m_mod_k) * this->m_mod_D);
+	// then the task buffers and the deques of all threads, starting with the calling thread if it is one of the object
 
-	std::size_t full_queue_counter = this->m_thread_count;
+	std::size_t thread_count = this->m_thread_count;
+	std::size_t thread_num = local_thread ? static_cast<std::size_t>(local_thread_block_ptr - this->m_thread_blocks_data_ptr) : 0;
 
-	while (true)
+	for (std::size_t n = thread_count; (n > 0) && !found; n--)
 	{
-		_cool_thmq_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
-			
-		xCOOL_THREADS_TRY
-		{
-			std::unique_lock<std::mutex> lock(current_thread_ptr->m_mutex, std::try_to_lock);
-
-			if (lock.owns_lock())
-			{
-				_cool_thmq_task* last_task_ptr_p1 = (current_thread_ptr->m_last_task_ptr + 1 != current_thread_ptr->m_task_buffer_end_ptr) ?
-					current_thread_ptr->m_last_task_ptr + 1 : current_thread_ptr->m_task_buffer_data_ptr;
-
-				if (last_task_ptr_p1 != current_thread_ptr->m_next_task_ptr)
-				{
-					target.m_parent_ptr->m_tasks_awaited.fetch_add(1, std::memory_order_relaxed);
-
-					new (static_cast<void*>(current_thread_ptr->m_last_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::forward<arg_Ty>(args)...);
-					std::memcpy(&(current_thread_ptr->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_callable = [](_cool_thmq_task* _task_ptr, _cool_thmq_task* _fetch_task_ptr)
-					{
-						if (_fetch_task_ptr == nullptr)
-						{
-							function_Ty function_ptr;
-							std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
-
-							xCOOL_THREADS_TRY
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-									function_ptr, std::move(*reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer))
-								);
-							}
-							xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-							}
-
-							static_cast<cool::async_end*>(_task_ptr->m_address_data.m_target_ptr)->decr_awaited();
+		_cool_thws_tblk* ptr = this->m_thread_blocks_data_ptr + thread_num;
 
-							reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
-						}
-						else
-						{
-							new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::move(*reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-							reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
-
-							std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thmq_task::address_with_target_size);
-						}
-					};
+		if (ptr != local_thread_block_ptr)
+		{
+			found = ptr->deque_steal(&current_task);
+		}
 
-					bool notification_required = (current_thread_ptr->m_last_task_ptr == current_thread_ptr->m_next_task_ptr);
-					current_thread_ptr->m_last_task_ptr = last_task_ptr_p1;
-					lock.unlock();
+		if (!found)
+		{
+			std::unique_lock<std::mutex> lock(ptr->m_mutex, std::try_to_lock);
 
-					if (notification_required)
-					{
-						current_thread_ptr->m_condition_var.notify_one();
-					}
+			if (lock.owns_lock() && (ptr->m_next_task_ptr != ptr->m_last_task_ptr))
+			{
+				ptr->m_next_task_ptr->m_address_data.m_callable(&current_task, ptr->m_next_task_ptr);
 
-					return;
-				}
-				else
-				{
-					full_queue_counter--;
+				ptr->m_next_task_ptr = (ptr->m_next_task_ptr + 1 != ptr->m_task_buffer_end_ptr) ?
+					ptr->m_next_task_ptr + 1 : ptr->m_task_buffer_data_ptr;
 
-					if (full_queue_counter == 0)
-					{
-						std::this_thread::yield();
-						full_queue_counter = this->m_thread_count;
-					}
-				}
+				found = true;
 			}
 		}
-		xCOOL_THREADS_CATCH(...) {}
 
-		thread_num = (thread_num != 0) ? thread_num - 1 : this->m_thread_count - 1;
+		thread_num = (thread_num + 1 != thread_count) ? thread_num + 1 : 0;
 	}
-}
-
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
-inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
-{
-	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
-	using _cool_thmq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
 
-	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
-	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
-
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_mq<...>::async : task must be a function pointer");
-	static_assert((sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_mq<...>::async : task arguments size too large");
-	static_assert((alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task)) || !_arg_type_static_check, "cool::threads_mq<...>::async : task arguments alignment too large");
+	if (!found)
+	{
+		return false;
+	}
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
+	xCOOL_THREADS_TRY
 	{
-		assert(false && "cool::threads_mq<...>::async : task arguments size or alignment too large");
-		std::terminate();
+		current_task.m_address_data.m_callable(&current_task, nullptr);
 	}
+	xCOOL_THREADS_CATCH(...) {}
 
-	constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
+	return true;
+}
 
-	_cool_thmq_uint2X N = static_cast<_cool_thmq_uint2X>(this->m_thread_dispatch.fetch_add(this->m_dispatch_interval, std::memory_order_relaxed));
-	_cool_thmq_uint2X b = (N * this->m_mod_a) >> uintX_bitcount;
-	std::size_t thread_num = static_cast<std::size_t>(N - ((((N - b) >> 1) + b) >> this->m_mod_k) * this->m_mod_D);
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline void cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::delete_threads_detail(std::size_t threads_constructed, std::size_t threads_launched) noexcept
+{
+	bool was_good = this->m_good.exchange(false, std::memory_order_seq_cst);
 
-	std::size_t full_queue_counter = this->m_thread_count;
+	_thread_block* ptr = this->m_thread_blocks_data_ptr;
 
-	while (true)
+	if (ptr != nullptr)
 	{
-		_cool_thmq_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
-
-		xCOOL_THREADS_TRY
+		for (std::size_t k = 0; k < threads_launched; k++)
 		{
-			std::unique_lock<std::mutex> lock(current_thread_ptr->m_mutex, std::try_to_lock);
-
-			if (lock.owns_lock())
+			while (true)
 			{
-				_cool_thmq_task* last_task_ptr_p1 = (current_thread_ptr->m_last_task_ptr + 1 != current_thread_ptr->m_task_buffer_end_ptr) ?
-					current_thread_ptr->m_last_task_ptr + 1 : current_thread_ptr->m_task_buffer_data_ptr;
-
-				if (last_task_ptr_p1 != current_thread_ptr->m_next_task_ptr)
+				xCOOL_THREADS_TRY
 				{
-					new (static_cast<void*>(current_thread_ptr->m_last_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::forward<arg_Ty>(args)...);
-					std::memcpy(&(current_thread_ptr->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_offset = target.m_offset;
-
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_callable = [](_cool_thmq_task* _task_ptr, _cool_thmq_task* _fetch_task_ptr)
-					{
-						if (_fetch_task_ptr == nullptr)
-						{
-							function_Ty function_ptr;
-							std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+					std::lock_guard<std::mutex> lock((ptr + k)->m_mutex);
+					(ptr + k)->m_stop_threads = true;
+					break;
+				}
+				xCOOL_THREADS_CATCH(...) {}
+			}
 
-							cool::async_result<return_Ty>& target_ref = *static_cast<cool::async_result<return_Ty>*>(_task_ptr->m_address_data.m_target_ptr);
+			(ptr + k)->m_condition_var.notify_one();
 
-							xCOOL_THREADS_TRY
-							{
-								*(target_ref.m_stored_values_ptr + _task_ptr->m_address_data.m_offset) = cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call(
-									function_ptr, std::move(*reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer))
-								);
-							}
-							xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-							}
+			if ((ptr + k)->m_thread.joinable())
+			{
+				std::thread::id thread_id = (ptr + k)->m_thread.get_id();
 
-							target_ref.decr_awaited();
+				xCOOL_THREADS_TRY
+				{
+					(ptr + k)->m_thread.join();
+				}
+				xCOOL_THREADS_CATCH(const std::system_error& xCOOL_THREADS_SYSTEM_ERROR)
+				{
+					cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::catch_delete_thread_exception(xCOOL_THREADS_SYSTEM_ERROR, thread_id);
+				}
+			}
+		}
 
-							reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
-						}
-						else
-						{
-							new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::move(*reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-							reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
+		// the tasks still queued once the threads have stopped (e.g. pushed to the queue of a thread that had already left) are
+		// run by the calling thread, which acts as the first thread so that the tasks they queue end up in its deque
 
-							std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thmq_task::address_with_target_and_offset_size);
-						}
-					};
+		if (was_good)
+		{
+			_thread_block* previous_thread_block_ptr = this->this_thread_block();
+			this->this_thread_block() = ptr;
 
-					bool notification_required = (current_thread_ptr->m_last_task_ptr == current_thread_ptr->m_next_task_ptr);
-					current_thread_ptr->m_last_task_ptr = last_task_ptr_p1;
-					lock.unlock();
+			while (true)
+			{
+				xCOOL_THREADS_TRY
+				{
+					_task current_task;
 
-					if (notification_required)
+					if (this->pop_task(ptr, &current_task))
 					{
-						current_thread_ptr->m_condition_var.notify_one();
+						current_task.m_address_data.m_callable(&current_task, nullptr);
 					}
-
-					return;
-				}
-				else
-				{
-					full_queue_counter--;
-
-					if (full_queue_counter == 0)
+					else
 					{
-						std::this_thread::yield();
-						full_queue_counter = this->m_thread_count;
+						break;
 					}
 				}
+				xCOOL_THREADS_CATCH(...) {}
 			}
-		}
-		xCOOL_THREADS_CATCH(...) {}
-
-		thread_num = (thread_num != 0) ? thread_num - 1 : this->m_thread_count - 1;
-	}
-}
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
-inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
-{
-	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
-	using _cool_thmq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+			this->this_thread_block() = previous_thread_block_ptr;
 
-	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
-	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
+			while (!(this->m_can_refresh.load(std::memory_order_relaxed)) || !(this->m_can_refresh.exchange(false, std::memory_order_acquire)))
+			{
+				std::this_thread::yield();
+			}
+		}
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_mq<...>::async : task must be a function pointer");
-	static_assert((sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_mq<...>::async : task arguments size too large");
-	static_assert((alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task)) || !_arg_type_static_check, "cool::threads_mq<...>::async : task arguments alignment too large");
+		for (std::size_t k = 0; k < threads_constructed; k++)
+		{
+			(ptr + k)->delete_task_buffer();
+			(ptr + k)->~_thread_block();
+		}
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_mq<...>::async : task arguments size or alignment too large");
-		std::terminate();
+		::operator delete(this->m_thread_blocks_unaligned_data_ptr);
 	}
 
-	constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
+	this->m_thread_count = 0;
+	this->m_thread_blocks_data_ptr = nullptr;
 
-	_cool_thmq_uint2X N = static_cast<_cool_thmq_uint2X>(this->m_thread_dispatch.fetch_add(this->m_dispatch_interval, std::memory_order_relaxed));
-	_cool_thmq_uint2X b = (N * this->m_mod_a) >> uintX_bitcount;
-	std::size_t thread_num = static_cast<std::size_t>(N - ((((N - b) >> 1) + b) >> this->m_mod_k) * this->m_mod_D);
+	this->m_steal_count = 0;
 
-	std::size_t full_queue_counter = this->m_thread_count;
+	this->m_thread_blocks_unaligned_data_ptr = nullptr;
+
+	std::atomic_signal_fence(std::memory_order_release);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::pop_task(_thread_block* thread_block_ptr, _task* target_ptr)
+{
+	_thread_block* ptr = thread_block_ptr;
 
 	while (true)
 	{
-		_cool_thmq_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
+		// own deque first, LIFO
 
-		xCOOL_THREADS_TRY
+		if (ptr->deque_pop(target_ptr))
 		{
-			std::unique_lock<std::mutex> lock(current_thread_ptr->m_mutex, std::try_to_lock);
+			return true;
+		}
 
-			if (lock.owns_lock())
+		// then own task buffer, the remaining tasks are moved to the deque where they can be stolen without locking
+
+		{
+			std::unique_lock<std::mutex> lock(ptr->m_mutex);
+
+			if (ptr->m_next_task_ptr != ptr->m_last_task_ptr)
 			{
-				_cool_thmq_task* last_task_ptr_p1 = (current_thread_ptr->m_last_task_ptr + 1 != current_thread_ptr->m_task_buffer_end_ptr) ?
-					current_thread_ptr->m_last_task_ptr + 1 : current_thread_ptr->m_task_buffer_data_ptr;
+				ptr->m_next_task_ptr->m_address_data.m_callable(target_ptr, ptr->m_next_task_ptr);
 
-				if (last_task_ptr_p1 != current_thread_ptr->m_next_task_ptr)
-				{
-					target.m_parent_ptr->m_tasks_awaited.fetch_add(1, std::memory_order_relaxed);
+				ptr->m_next_task_ptr = (ptr->m_next_task_ptr + 1 != ptr->m_task_buffer_end_ptr) ?
+					ptr->m_next_task_ptr + 1 : ptr->m_task_buffer_data_ptr;
+
+				bool transfered = false;
 
-					new (static_cast<void*>(current_thread_ptr->m_last_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::forward<arg_Ty>(args)...);
-					std::memcpy(&(current_thread_ptr->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_offset = target.m_offset;
+				auto transfer = [ptr](_task* slot_task_ptr, cool::_threads_base::_arg_slab*)
+				{
+					ptr->m_next_task_ptr->m_address_data.m_callable(slot_task_ptr, ptr->m_next_task_ptr);
+				};
 
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_callable = [](_cool_thmq_task* _task_ptr, _cool_thmq_task* _fetch_task_ptr)
-					{
-						if (_fetch_task_ptr == nullptr)
-						{
-							function_Ty function_ptr;
-							std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+				while ((ptr->m_next_task_ptr != ptr->m_last_task_ptr) && ptr->deque_push(transfer))
+				{
+					ptr->m_next_task_ptr = (ptr->m_next_task_ptr + 1 != ptr->m_task_buffer_end_ptr) ?
+						ptr->m_next_task_ptr + 1 : ptr->m_task_buffer_data_ptr;
 
-							cool::async_result<return_Ty>& target_ref = *static_cast<cool::async_result<return_Ty>*>(_task_ptr->m_address_data.m_target_ptr);
+					transfered = true;
+				}
 
-							xCOOL_THREADS_TRY
-							{
-								*(target_ref.m_stored_values_ptr + _task_ptr->m_address_data.m_offset) = cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call(
-									function_ptr, std::move(*reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer))
-								);
-							}
-							xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-							}
+				lock.unlock();
 
-							target_ref.decr_awaited();
+				if (transfered)
+				{
+					this->wake_idle_thread();
+				}
 
-							reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
-						}
-						else
-						{
-							new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::move(*reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-							reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
+				return true;
+			}
+		}
 
-							std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thmq_task::address_with_target_and_offset_size);
-						}
-					};
+		// then steal from random threads
 
-					bool notification_required = (current_thread_ptr->m_last_task_ptr == current_thread_ptr->m_next_task_ptr);
-					current_thread_ptr->m_last_task_ptr = last_task_ptr_p1;
-					lock.unlock();
+		if (this->m_thread_count > 1)
+		{
+			for (unsigned int n = this->m_steal_count; n > 0; n--)
+			{
+				_thread_block* victim_ptr = this->m_thread_blocks_data_ptr + ptr->victim(this->m_thread_count);
 
-					if (notification_required)
+				if (victim_ptr->deque_steal(target_ptr))
+				{
+					if (!victim_ptr->deque_empty())
 					{
-						current_thread_ptr->m_condition_var.notify_one();
+						this->wake_idle_thread();
 					}
 
-					return;
+					return true;
 				}
-				else
+
+				std::unique_lock<std::mutex> lock(victim_ptr->m_mutex, std::try_to_lock);
+
+				if (lock.owns_lock() && (victim_ptr->m_next_task_ptr != victim_ptr->m_last_task_ptr))
 				{
-					full_queue_counter--;
+					victim_ptr->m_next_task_ptr->m_address_data.m_callable(target_ptr, victim_ptr->m_next_task_ptr);
 
-					if (full_queue_counter == 0)
-					{
-						std::this_thread::yield();
-						full_queue_counter = this->m_thread_count;
-					}
+					victim_ptr->m_next_task_ptr = (victim_ptr->m_next_task_ptr + 1 != victim_ptr->m_task_buffer_end_ptr) ?
+						victim_ptr->m_next_task_ptr + 1 : victim_ptr->m_task_buffer_data_ptr;
+
+					return true;
 				}
 			}
 		}
-		xCOOL_THREADS_CATCH(...) {}
-
-		thread_num = (thread_num != 0) ? thread_num - 1 : this->m_thread_count - 1;
-	}
-}
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::no_target_t, function_Ty task, arg_Ty&& ... args) noexcept
-{
-	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
-	using _cool_thmq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+		// then wait, after declaring the thread idle and checking again every thread so that no push can be missed
 
-	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
-	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
+		ptr->m_idle.store(true, std::memory_order_seq_cst);
+		this->m_idle_count.fetch_add(1, std::memory_order_seq_cst);
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_mq<...>::try_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_mq<...>::try_async : task arguments size too large");
-	static_assert((alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task)) || !_arg_type_static_check, "cool::threads_mq<...>::try_async : task arguments alignment too large");
+		bool task_found = false;
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_mq<...>::try_async : task arguments size or alignment too large");
-		std::terminate();
-	}
+		for (std::size_t k = 0; k < this->m_thread_count; k++)
+		{
+			_thread_block* other_ptr = this->m_thread_blocks_data_ptr + k;
 
-	constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
+			if (other_ptr->deque_steal(target_ptr))
+			{
+				ptr->m_idle.store(false, std::memory_order_relaxed);
+				this->m_idle_count.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
 
-	_cool_thmq_uint2X N = static_cast<_cool_thmq_uint2X>(this->m_thread_dispatch.fetch_add(this->m_dispatch_interval, std::memory_order_relaxed));
-	_cool_thmq_uint2X b = (N * this->m_mod_a) >> uintX_bitcount;
-	std::size_t thread_num = static_cast<std::size_t>(N - ((((N - b) >> 1) + b) >> this->m_mod_k) * this->m_mod_D);
+			if (!other_ptr->deque_empty())
+			{
+				task_found = true;
+				break;
+			}
 
-	std::size_t full_queue_counter = this->m_thread_count;
+			std::lock_guard<std::mutex> lock(other_ptr->m_mutex);
 
-	while (true)
-	{
-		_cool_thmq_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
+			if (other_ptr->m_next_task_ptr != other_ptr->m_last_task_ptr)
+			{
+				other_ptr->m_next_task_ptr->m_address_data.m_callable(target_ptr, other_ptr->m_next_task_ptr);
 
-		xCOOL_THREADS_TRY
-		{
-			std::unique_lock<std::mutex> lock(current_thread_ptr->m_mutex, std::try_to_lock);
+				other_ptr->m_next_task_ptr = (other_ptr->m_next_task_ptr + 1 != other_ptr->m_task_buffer_end_ptr) ?
+					other_ptr->m_next_task_ptr + 1 : other_ptr->m_task_buffer_data_ptr;
 
-			if (lock.owns_lock())
-			{
-				_cool_thmq_task* last_task_ptr_p1 = (current_thread_ptr->m_last_task_ptr + 1 != current_thread_ptr->m_task_buffer_end_ptr) ?
-					current_thread_ptr->m_last_task_ptr + 1 : current_thread_ptr->m_task_buffer_data_ptr;
+				ptr->m_idle.store(false, std::memory_order_relaxed);
+				this->m_idle_count.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
 
-				if (last_task_ptr_p1 != current_thread_ptr->m_next_task_ptr)
-				{
-					new (static_cast<void*>(current_thread_ptr->m_last_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::forward<arg_Ty>(args)...);
-					std::memcpy(&(current_thread_ptr->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
+		if (!task_found)
+		{
+			std::unique_lock<std::mutex> lock(ptr->m_mutex);
 
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_callable = [](_cool_thmq_task* _task_ptr, _cool_thmq_task* _fetch_task_ptr)
-					{
-						if (_fetch_task_ptr == nullptr)
-						{
-							function_Ty function_ptr;
-							std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+			ptr->m_condition_var.wait(lock, [ptr]() -> bool { return (ptr->m_next_task_ptr != ptr->m_last_task_ptr) || ptr->m_wake || ptr->m_stop_threads; });
 
-							xCOOL_THREADS_TRY
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-									function_ptr, std::move(*reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer))
-								);
-							}
-							xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-							}
+			ptr->m_wake = false;
 
-							reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
-						}
-						else
-						{
-							new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::move(*reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-							reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
+			if ((ptr->m_next_task_ptr == ptr->m_last_task_ptr) && ptr->m_stop_threads)
+			{
+				ptr->m_idle.store(false, std::memory_order_relaxed);
+				this->m_idle_count.fetch_sub(1, std::memory_order_relaxed);
+				return false;
+			}
+		}
 
-							std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thmq_task::address_size);
-						}
-					};
+		ptr->m_idle.store(false, std::memory_order_relaxed);
+		this->m_idle_count.fetch_sub(1, std::memory_order_relaxed);
+	}
+}
 
-					bool notification_required = (current_thread_ptr->m_last_task_ptr == current_thread_ptr->m_next_task_ptr);
-					current_thread_ptr->m_last_task_ptr = last_task_ptr_p1;
-					lock.unlock();
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline void cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::wake_idle_thread()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
 
-					if (notification_required)
-					{
-						current_thread_ptr->m_condition_var.notify_one();
-					}
+	if (this->m_idle_count.load(std::memory_order_acquire) != 0)
+	{
+		for (std::size_t k = 0; k < this->m_thread_count; k++)
+		{
+			_thread_block* ptr = this->m_thread_blocks_data_ptr + k;
 
-					return true;
-				}
-				else
+			if (ptr->m_idle.load(std::memory_order_relaxed) && ptr->m_idle.exchange(false, std::memory_order_acquire))
+			{
+				while (true)
 				{
-					full_queue_counter--;
-
-					if (full_queue_counter == 0)
+					xCOOL_THREADS_TRY
 					{
-						return false;
+						std::lock_guard<std::mutex> lock(ptr->m_mutex);
+						ptr->m_wake = true;
+						break;
 					}
+					xCOOL_THREADS_CATCH(...) {}
 				}
+
+				ptr->m_condition_var.notify_one();
+
+				return;
 			}
 		}
-		xCOOL_THREADS_CATCH(...) {}
-
-		thread_num = (thread_num != 0) ? thread_num - 1 : this->m_thread_count - 1;
 	}
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::async_end& target, function_Ty task, arg_Ty&& ... args) noexcept
+inline cool::threads_init_result::operator bool() const noexcept
 {
-	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
-	using _cool_thmq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+	return m_result == threads_init_result::success;
+}
 
-	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
-	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
+inline bool cool::threads_init_result::good() const noexcept
+{
+	return m_result == threads_init_result::success;
+}
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_mq<...>::try_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_mq<...>::try_async : task arguments size too large");
-	static_assert((alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task)) || !_arg_type_static_check, "cool::threads_mq<...>::try_async : task arguments alignment too large");
+inline int cool::threads_init_result::value() const noexcept
+{
+	return m_result;
+}
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
+inline const char* cool::threads_init_result::message() const noexcept
+{
+	switch (m_result)
 	{
-		assert(false && "cool::threads_mq<...>::try_async : task arguments size or alignment too large");
-		std::terminate();
+	case threads_init_result::success: return "cool threads init success"; break;
+	case threads_init_result::bad_align: return "cool threads init failed : bad alignment of threads_sq/threads_lq/threads_mq/threads_ws object"; break;
+	case threads_init_result::bad_parameters: return "cool threads init failed : bad parameters"; break;
+	case threads_init_result::bad_alloc: return "cool threads init failed : bad allocation"; break;
+	case threads_init_result::bad_thread_creation: return "cool threads init failed : bad thread creation"; break;
+	default: return "cool threads init result undefined"; break;
 	}
+}
 
-	constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
+inline cool::threads_init_result::threads_init_result(int result) noexcept : m_result(result) {}
 
-	_cool_thmq_uint2X N = static_cast<_cool_thmq_uint2X>(this->m_thread_dispatch.fetch_add(this->m_dispatch_interval, std::memory_order_relaxed));
-	_cool_thmq_uint2X b = (N * this->m_mod_a) >> uintX_bitcount;
-	std::size_t thread_num = static_cast<std::size_t>(N - ((((N - b) >> 1) + b) >> this->m_mod_k) * this->m_mod_D);
+inline void cool::threads_exception_handler::set_on_exception(void(*on_exception)(const std::exception&, void(*)(void), std::thread::id, void*), void* exception_arg_ptr) noexcept
+{
+	cool::_threads_base::exception_handler handler{ on_exception, exception_arg_ptr };
+	cool::_threads_base::get_exception_handler().store(handler, std::memory_order_seq_cst);
+}
 
-	std::size_t full_queue_counter = this->m_thread_count;
+inline void cool::threads_exception_handler::set_on_delete_thread_exception(void(*on_delete_thread_exception)(const std::system_error&, std::thread::id, void*), void* delete_thread_exception_arg_ptr) noexcept
+{
+	cool::_threads_base::delete_thread_exception_handler handler{ on_delete_thread_exception, delete_thread_exception_arg_ptr };
+	cool::_threads_base::get_delete_thread_exception_handler().store(handler, std::memory_order_seq_cst);
+}
 
-	while (true)
-	{
-		_cool_thmq_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
+inline void cool::threads_exception_handler::clear() noexcept
+{
+	cool::_threads_base::exception_handler handler{ nullptr, nullptr };
+	cool::_threads_base::get_exception_handler().store(handler, std::memory_order_seq_cst);
 
-		xCOOL_THREADS_TRY
-		{
-			std::unique_lock<std::mutex> lock(current_thread_ptr->m_mutex, std::try_to_lock);
+	cool::_threads_base::delete_thread_exception_handler delete_thread_handler{ nullptr, nullptr };
+	cool::_threads_base::get_delete_thread_exception_handler().store(delete_thread_handler, std::memory_order_seq_cst);
+}
 
-			if (lock.owns_lock())
-			{
-				_cool_thmq_task* last_task_ptr_p1 = (current_thread_ptr->m_last_task_ptr + 1 != current_thread_ptr->m_task_buffer_end_ptr) ?
-					current_thread_ptr->m_last_task_ptr + 1 : current_thread_ptr->m_task_buffer_data_ptr;
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_lane::new_task_buffer(std::size_t new_task_buffer_size) noexcept
+{
+	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
 
-				if (last_task_ptr_p1 != current_thread_ptr->m_next_task_ptr)
-				{
-					new (static_cast<void*>(current_thread_ptr->m_last_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::forward<arg_Ty>(args)...);
-					std::memcpy(&(current_thread_ptr->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(&target);
+	constexpr std::size_t cache_line_size = alignof(cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>);
+	constexpr std::size_t arg_buffer_align = alignof(_cool_thmq_task);
 
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_callable = [](_cool_thmq_task* _task_ptr, _cool_thmq_task* _fetch_task_ptr)
-					{
-						if (_fetch_task_ptr == nullptr)
-						{
-							function_Ty function_ptr;
-							std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+	constexpr std::size_t task_buffer_padding = (cache_line_size > arg_buffer_align) ? cache_line_size : arg_buffer_align;
+	std::size_t new_task_buffer_size_p1 = new_task_buffer_size + 1;
 
-							xCOOL_THREADS_TRY
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-									function_ptr, std::move(*reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer))
-								);
-							}
-							xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-							}
+	m_task_buffer_unaligned_data_ptr = static_cast<char*>(::operator new(new_task_buffer_size_p1 * sizeof(_cool_thmq_task) + task_buffer_padding + cache_line_size, std::nothrow));
 
-							static_cast<cool::async_end*>(_task_ptr->m_address_data.m_target_ptr)->decr_awaited();
+	if (m_task_buffer_unaligned_data_ptr == nullptr)
+	{
+		return false;
+	}
+	else
+	{
+		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_task_buffer_unaligned_data_ptr) % static_cast<std::uintptr_t>(task_buffer_padding);
 
-							reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
-						}
-						else
-						{
-							new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::move(*reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-							reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
+		m_task_buffer_data_ptr = reinterpret_cast<_cool_thmq_task*>(m_task_buffer_unaligned_data_ptr
+			+ static_cast<std::size_t>(ptr_remainder != 0) * (task_buffer_padding - static_cast<std::size_t>(ptr_remainder)));
+	}
 
-							std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thmq_task::address_with_target_size);
-						}
-					};
+	m_task_buffer_end_ptr = m_task_buffer_data_ptr + new_task_buffer_size_p1;
+	m_last_task_ptr = m_task_buffer_data_ptr;
+	m_next_task_ptr = m_task_buffer_data_ptr;
 
-					bool notification_required = (current_thread_ptr->m_last_task_ptr == current_thread_ptr->m_next_task_ptr);
-					current_thread_ptr->m_last_task_ptr = last_task_ptr_p1;
-					lock.unlock();
+	for (std::size_t k = 0; k < new_task_buffer_size_p1; k++)
+	{
+		new (m_task_buffer_data_ptr + k) _cool_thmq_task();
+	}
 
-					if (notification_required)
-					{
-						current_thread_ptr->m_condition_var.notify_one();
-					}
+	return true;
+}
 
-					return true;
-				}
-				else
-				{
-					full_queue_counter--;
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline void cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_lane::delete_task_buffer() noexcept
+{
+	if (m_task_buffer_data_ptr != nullptr)
+	{
+		std::size_t task_buffer_size_p1 = static_cast<std::size_t>(m_task_buffer_end_ptr - m_task_buffer_data_ptr);
 
-					if (full_queue_counter == 0)
-					{
-						return false;
-					}
-				}
-			}
+		for (std::size_t k = 0; k < task_buffer_size_p1; k++)
+		{
+			(m_task_buffer_data_ptr + k)->~_task();
 		}
-		xCOOL_THREADS_CATCH(...) {}
 
-		thread_num = (thread_num != 0) ? thread_num - 1 : this->m_thread_count - 1;
+		::operator delete(m_task_buffer_unaligned_data_ptr);
 	}
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class function_Ty, class ... arg_Ty>
-inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_end_incr_proxy target, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::new_task_buffer(std::size_t new_task_buffer_size) noexcept
 {
 	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
-	using _cool_thmq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
 
-	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
-	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
+	constexpr std::size_t cache_line_size = alignof(cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>);
+	constexpr std::size_t arg_buffer_align = alignof(_cool_thmq_task);
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_mq<...>::try_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_mq<...>::try_async : task arguments size too large");
-	static_assert((alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task)) || !_arg_type_static_check, "cool::threads_mq<...>::try_async : task arguments alignment too large");
+	constexpr std::size_t task_buffer_padding = (cache_line_size > arg_buffer_align) ? cache_line_size : arg_buffer_align;
+	std::size_t new_task_buffer_size_p1 = new_task_buffer_size + 1;
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
+	m_task_buffer_unaligned_data_ptr = static_cast<char*>(::operator new(new_task_buffer_size_p1 * sizeof(_cool_thmq_task) + task_buffer_padding + cache_line_size, std::nothrow));
+
+	if (m_task_buffer_unaligned_data_ptr == nullptr)
 	{
-		assert(false && "cool::threads_mq<...>::try_async : task arguments size or alignment too large");
-		std::terminate();
+		return false;
 	}
+	else
+	{
+		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_task_buffer_unaligned_data_ptr) % static_cast<std::uintptr_t>(task_buffer_padding);
 
-	constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
+		m_task_buffer_data_ptr = reinterpret_cast<_cool_thmq_task*>(m_task_buffer_unaligned_data_ptr
+			+ static_cast<std::size_t>(ptr_remainder != 0) * (task_buffer_padding - static_cast<std::size_t>(ptr_remainder)));
+	}
 
-	_cool_thmq_uint2X N = static_cast<_cool_thmq_uint2X>(this->m_thread_dispatch.fetch_add(this->m_dispatch_interval, std::memory_order_relaxed));
-	_cool_thmq_uint2X b = (N * this->m_mod_a) >> uintX_bitcount;
-	std::size_t thread_num = static_cast<std::size_t>(N - ((((N - b) >> 1) + b) >> this->m_mod_k) * this->m_mod_D);
+	m_task_buffer_end_ptr = m_task_buffer_data_ptr + new_task_buffer_size_p1;
+	m_last_task_ptr = m_task_buffer_data_ptr;
+	m_next_task_ptr = m_task_buffer_data_ptr;
 
-	std::size_t full_queue_counter = this->m_thread_count;
+	for (std::size_t k = 0; k < new_task_buffer_size_p1; k++)
+	{
+		new (m_task_buffer_data_ptr + k) _cool_thmq_task();
+	}
 
-	while (true)
+	if (m_lane_count != 0)
 	{
-		_cool_thmq_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
+		m_lanes_ptr = new (std::nothrow) _lane[m_lane_count];
 
-		xCOOL_THREADS_TRY
+		if (m_lanes_ptr == nullptr)
 		{
-			std::unique_lock<std::mutex> lock(current_thread_ptr->m_mutex, std::try_to_lock);
+			return false;
+		}
 
-			if (lock.owns_lock())
+		for (unsigned int k = 0; k < m_lane_count; k++)
+		{
+			if (!((m_lanes_ptr + k)->new_task_buffer(new_task_buffer_size)))
 			{
-				_cool_thmq_task* last_task_ptr_p1 = (current_thread_ptr->m_last_task_ptr + 1 != current_thread_ptr->m_task_buffer_end_ptr) ?
-					current_thread_ptr->m_last_task_ptr + 1 : current_thread_ptr->m_task_buffer_data_ptr;
-
-				if (last_task_ptr_p1 != current_thread_ptr->m_next_task_ptr)
-				{
-					target.m_parent_ptr->m_tasks_awaited.fetch_add(1, std::memory_order_relaxed);
-
-					new (static_cast<void*>(current_thread_ptr->m_last_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::forward<arg_Ty>(args)...);
-					std::memcpy(&(current_thread_ptr->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_callable = [](_cool_thmq_task* _task_ptr, _cool_thmq_task* _fetch_task_ptr)
-					{
-						if (_fetch_task_ptr == nullptr)
-						{
-							function_Ty function_ptr;
-							std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
-
-							xCOOL_THREADS_TRY
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call_no_return(
-									function_ptr, std::move(*reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer))
-								);
-							}
-							xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-							}
-
-							static_cast<cool::async_end*>(_task_ptr->m_address_data.m_target_ptr)->decr_awaited();
-
-							reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
-						}
-						else
-						{
-							new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::move(*reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-							reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
+				return false;
+			}
+		}
+	}
 
-							std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thmq_task::address_with_target_size);
-						}
-					};
+	return true;
+}
 
-					bool notification_required = (current_thread_ptr->m_last_task_ptr == current_thread_ptr->m_next_task_ptr);
-					current_thread_ptr->m_last_task_ptr = last_task_ptr_p1;
-					lock.unlock();
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline void cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::delete_task_buffer() noexcept
+{
+	if (m_task_buffer_data_ptr != nullptr)
+	{
+		std::size_t task_buffer_size_p1 = static_cast<std::size_t>(m_task_buffer_end_ptr - m_task_buffer_data_ptr);
 
-					if (notification_required)
-					{
-						current_thread_ptr->m_condition_var.notify_one();
-					}
+		for (std::size_t k = 0; k < task_buffer_size_p1; k++)
+		{
+			(m_task_buffer_data_ptr + k)->~_task();
+		}
 
-					return true;
-				}
-				else
-				{
-					full_queue_counter--;
+		::operator delete(m_task_buffer_unaligned_data_ptr);
+	}
 
-					if (full_queue_counter == 0)
-					{
-						return false;
-					}
-				}
-			}
+	if (m_lanes_ptr != nullptr)
+	{
+		for (unsigned int k = 0; k < m_lane_count; k++)
+		{
+			(m_lanes_ptr + k)->delete_task_buffer();
 		}
-		xCOOL_THREADS_CATCH(...) {}
 
-		thread_num = (thread_num != 0) ? thread_num - 1 : this->m_thread_count - 1;
+		delete[] m_lanes_ptr;
+		m_lanes_ptr = nullptr;
 	}
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
-inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_result_to_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::has_task() const noexcept
 {
-	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
-	using _cool_thmq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+	return (m_next_task_ptr != m_last_task_ptr) || (m_priority_task_count != 0);
+}
 
-	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
-	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline std::size_t cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::task_count() const noexcept
+{
+	std::size_t regular_task_count = (m_last_task_ptr >= m_next_task_ptr) ? static_cast<std::size_t>(m_last_task_ptr - m_next_task_ptr)
+		: static_cast<std::size_t>((m_task_buffer_end_ptr - m_task_buffer_data_ptr) - (m_next_task_ptr - m_last_task_ptr));
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_mq<...>::try_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_mq<...>::try_async : task arguments size too large");
-	static_assert((alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task)) || !_arg_type_static_check, "cool::threads_mq<...>::try_async : task arguments alignment too large");
+	return regular_task_count + m_priority_task_count;
+}
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline void cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::pop_task(_task* target_ptr)
+{
+	if (m_priority_task_count == 0)
 	{
-		assert(false && "cool::threads_mq<...>::try_async : task arguments size or alignment too large");
-		std::terminate();
+		m_next_task_ptr->m_address_data.m_callable(target_ptr, m_next_task_ptr);
+		m_next_task_ptr = (m_next_task_ptr + 1 != m_task_buffer_end_ptr) ? m_next_task_ptr + 1 : m_task_buffer_data_ptr;
+		m_skip_count = 0;
+		m_has_task.store(has_task(), std::memory_order_relaxed);
+		return;
 	}
 
-	constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
+	unsigned int top_priority = m_lane_count;
 
-	_cool_thmq_uint2X N = static_cast<_cool_thmq_uint2X>(this->m_thread_dispatch.fetch_add(this->m_dispatch_interval, std::memory_order_relaxed));
-	_cool_thmq_uint2X b = (N * this->m_mod_a) >> uintX_bitcount;
-	std::size_t thread_num = static_cast<std::size_t>(N - ((((N - b) >> 1) + b) >> this->m_mod_k) * this->m_mod_D);
+	while ((m_lanes_ptr + top_priority - 1)->m_next_task_ptr == (m_lanes_ptr + top_priority - 1)->m_last_task_ptr)
+	{
+		top_priority--;
+	}
 
-	std::size_t full_queue_counter = this->m_thread_count;
+	bool regular_pending = (m_next_task_ptr != m_last_task_ptr);
+	unsigned int priority = top_priority;
 
-	while (true)
-	{
-		_cool_thmq_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
+	// aging : the lowest lane below 'top_priority' that has been passed over 'm_aging_interval' times is served first
 
-		xCOOL_THREADS_TRY
+	if (m_aging_interval != 0)
+	{
+		if (regular_pending && (m_skip_count >= m_aging_interval))
 		{
-			std::unique_lock<std::mutex> lock(current_thread_ptr->m_mutex, std::try_to_lock);
-
-			if (lock.owns_lock())
+			priority = 0;
+		}
+		else
+		{
+			for (unsigned int k = 1; k < top_priority; k++)
 			{
-				_cool_thmq_task* last_task_ptr_p1 = (current_thread_ptr->m_last_task_ptr + 1 != current_thread_ptr->m_task_buffer_end_ptr) ?
-					current_thread_ptr->m_last_task_ptr + 1 : current_thread_ptr->m_task_buffer_data_ptr;
+				_lane* lane_ptr = m_lanes_ptr + k - 1;
 
-				if (last_task_ptr_p1 != current_thread_ptr->m_next_task_ptr)
+				if ((lane_ptr->m_next_task_ptr != lane_ptr->m_last_task_ptr) && (lane_ptr->m_skip_count >= m_aging_interval))
 				{
-					new (static_cast<void*>(current_thread_ptr->m_last_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::forward<arg_Ty>(args)...);
-					std::memcpy(&(current_thread_ptr->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_offset = target.m_offset;
+					priority = k;
+					break;
+				}
+			}
+		}
 
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_callable = [](_cool_thmq_task* _task_ptr, _cool_thmq_task* _fetch_task_ptr)
-					{
-						if (_fetch_task_ptr == nullptr)
-						{
-							function_Ty function_ptr;
-							std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+		if (regular_pending && (priority != 0))
+		{
+			m_skip_count++;
+		}
 
-							cool::async_result<return_Ty>& target_ref = *static_cast<cool::async_result<return_Ty>*>(_task_ptr->m_address_data.m_target_ptr);
+		for (unsigned int k = 1; k < top_priority; k++)
+		{
+			_lane* lane_ptr = m_lanes_ptr + k - 1;
 
-							xCOOL_THREADS_TRY
-							{
-								*(target_ref.m_stored_values_ptr + _task_ptr->m_address_data.m_offset) = cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call(
-									function_ptr, std::move(*reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer))
-								);
-							}
-							xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-							}
+			if ((k != priority) && (lane_ptr->m_next_task_ptr != lane_ptr->m_last_task_ptr))
+			{
+				lane_ptr->m_skip_count++;
+			}
+		}
+	}
 
-							target_ref.decr_awaited();
+	if (priority == 0)
+	{
+		m_next_task_ptr->m_address_data.m_callable(target_ptr, m_next_task_ptr);
+		m_next_task_ptr = (m_next_task_ptr + 1 != m_task_buffer_end_ptr) ? m_next_task_ptr + 1 : m_task_buffer_data_ptr;
+		m_skip_count = 0;
+	}
+	else
+	{
+		_lane* lane_ptr = m_lanes_ptr + priority - 1;
 
-							reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
-						}
-						else
-						{
-							new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::move(*reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-							reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
+		lane_ptr->m_next_task_ptr->m_address_data.m_callable(target_ptr, lane_ptr->m_next_task_ptr);
+		lane_ptr->m_next_task_ptr = (lane_ptr->m_next_task_ptr + 1 != lane_ptr->m_task_buffer_end_ptr) ? lane_ptr->m_next_task_ptr + 1 : lane_ptr->m_task_buffer_data_ptr;
+		lane_ptr->m_skip_count = 0;
+		m_priority_task_count--;
+	}
 
-							std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thmq_task::address_with_target_and_offset_size);
-						}
-					};
+	m_has_task.store(has_task(), std::memory_order_relaxed);
+}
 
-					bool notification_required = (current_thread_ptr->m_last_task_ptr == current_thread_ptr->m_next_task_ptr);
-					current_thread_ptr->m_last_task_ptr = last_task_ptr_p1;
-					lock.unlock();
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::wait_for_task(std::unique_lock<std::mutex>& lock, unsigned int spin_count, unsigned int yield_count,
+	cool::_threads_base::_elastic_control* elastic_ptr, cool::_threads_base::_timer_wheel<_task>* timers_ptr)
+{
+	using _cool_thmq_timers = cool::_threads_base::_timer_wheel<_task>;
 
-					if (notification_required)
-					{
-						current_thread_ptr->m_condition_var.notify_one();
-					}
+	// the spin and yield phases poll 'm_has_task' and only take the mutex once a task is seen, so that they do not make the
+	// submitters trying to lock the block fail and spill their tasks to other blocks
 
-					return true;
-				}
-				else
-				{
-					full_queue_counter--;
+	for (unsigned int n = spin_count; n > 0; n--)
+	{
+		if (m_has_task.load(std::memory_order_relaxed))
+		{
+			lock.lock();
 
-					if (full_queue_counter == 0)
-					{
-						return false;
-					}
-				}
+			if (has_task())
+			{
+				m_spin_hits.fetch_add(1, std::memory_order_relaxed);
+				return false;
 			}
+			else if (m_stop_threads)
+			{
+				return false;
+			}
+
+			lock.unlock();
 		}
-		xCOOL_THREADS_CATCH(...) {}
 
-		thread_num = (thread_num != 0) ? thread_num - 1 : this->m_thread_count - 1;
+		cool::_threads_base::cpu_pause();
 	}
-}
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class return_Ty, class function_Ty, class ... arg_Ty>
-inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_async(cool::_async_result_incr_proxy<return_Ty> target, function_Ty task, arg_Ty&& ... args) noexcept
-{
-	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
-	using _cool_thmq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
+	for (unsigned int n = yield_count; n > 0; n--)
+	{
+		if (m_has_task.load(std::memory_order_relaxed))
+		{
+			lock.lock();
 
-	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
-	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
+			if (has_task())
+			{
+				m_yield_hits.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			else if (m_stop_threads)
+			{
+				return false;
+			}
 
-	static_assert(std::is_pointer<function_Ty>::value && std::is_function<typename std::remove_pointer<function_Ty>::type>::value,
-		"cool::threads_mq<...>::try_async : task must be a function pointer");
-	static_assert((sizeof(_cool_thmq_pack) <= _arg_buffer_size) || !_arg_type_static_check, "cool::threads_mq<...>::try_async : task arguments size too large");
-	static_assert((alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task)) || !_arg_type_static_check, "cool::threads_mq<...>::try_async : task arguments alignment too large");
+			lock.unlock();
+		}
 
-	constexpr bool doom = !arg_type_is_valid<arg_Ty ...>();
-	if (doom)
-	{
-		assert(false && "cool::threads_mq<...>::try_async : task arguments size or alignment too large");
-		std::terminate();
+		std::this_thread::yield();
 	}
 
-	constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
+	lock.lock();
 
-	_cool_thmq_uint2X N = static_cast<_cool_thmq_uint2X>(this->m_thread_dispatch.fetch_add(this->m_dispatch_interval, std::memory_order_relaxed));
-	_cool_thmq_uint2X b = (N * this->m_mod_a) >> uintX_bitcount;
-	std::size_t thread_num = static_cast<std::size_t>(N - ((((N - b) >> 1) + b) >> this->m_mod_k) * this->m_mod_D);
+	// a retiring thread leaves once its queue is empty, an idle thread leaves after 'm_idle_timeout_ms' if the pool can shrink,
+	// one idle thread at a time keeps the timers by parking until their next deadline
 
-	std::size_t full_queue_counter = this->m_thread_count;
+	bool keeper = false;
+	bool timer_service = false;
+	std::int64_t keeper_deadline_ns = _cool_thmq_timers::no_deadline;
 
-	while (true)
+	auto wake_up = [this, timers_ptr, &keeper, &keeper_deadline_ns]() -> bool {
+		return has_task() || m_stop_threads || (m_elastic_state == 1) || m_wake
+			|| (keeper ? (timers_ptr->m_next_deadline_ns.load(std::memory_order_relaxed) < keeper_deadline_ns)
+				: ((timers_ptr->m_timer_count.load(std::memory_order_relaxed) != 0) && !(timers_ptr->m_keeper.load(std::memory_order_relaxed))));
+	};
+
+	std::chrono::steady_clock::time_point idle_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(elastic_ptr->m_idle_timeout_ms);
+
+	while (!has_task() && !m_stop_threads)
 	{
-		_cool_thmq_tblk* current_thread_ptr = this->m_thread_blocks_data_ptr + thread_num;
+		if (m_elastic_state == 1)
+		{
+			m_elastic_state = 2;
+			return false;
+		}
 
-		xCOOL_THREADS_TRY
+		// the tasks held in the local deques of threads that are blocked (e.g. waiting with 'finish()') are stolen here
+
+		if ((local_queue_size != 0) && idle_steal())
 		{
-			std::unique_lock<std::mutex> lock(current_thread_ptr->m_mutex, std::try_to_lock);
+			break;
+		}
 
-			if (lock.owns_lock())
+		m_parks.fetch_add(1, std::memory_order_relaxed);
+
+		keeper = (timers_ptr->m_timer_count.load(std::memory_order_relaxed) != 0) && !(timers_ptr->m_keeper.exchange(true, std::memory_order_relaxed));
+		keeper_deadline_ns = keeper ? timers_ptr->m_next_deadline_ns.load(std::memory_order_relaxed) : _cool_thmq_timers::no_deadline;
+
+		bool timed_out = false;
+
+		if ((elastic_ptr->m_idle_timeout_ms == 0) && (keeper_deadline_ns == _cool_thmq_timers::no_deadline))
+		{
+			m_condition_var.wait(lock, wake_up);
+		}
+		else
+		{
+			std::chrono::steady_clock::time_point wake_time = _cool_thmq_timers::wake_time(keeper_deadline_ns);
+
+			if ((elastic_ptr->m_idle_timeout_ms != 0) && ((keeper_deadline_ns == _cool_thmq_timers::no_deadline) || (idle_deadline < wake_time)))
 			{
-				_cool_thmq_task* last_task_ptr_p1 = (current_thread_ptr->m_last_task_ptr + 1 != current_thread_ptr->m_task_buffer_end_ptr) ?
-					current_thread_ptr->m_last_task_ptr + 1 : current_thread_ptr->m_task_buffer_data_ptr;
+				wake_time = idle_deadline;
+			}
 
-				if (last_task_ptr_p1 != current_thread_ptr->m_next_task_ptr)
-				{
-					target.m_parent_ptr->m_tasks_awaited.fetch_add(1, std::memory_order_relaxed);
+			timed_out = !(m_condition_var.wait_until(lock, wake_time, wake_up));
+		}
+
+		if (local_queue_size != 0)
+		{
+			m_wake = false;
+			m_idle.store(false, std::memory_order_relaxed);
+			m_parent_ptr->m_idle_count.fetch_sub(1, std::memory_order_relaxed);
+		}
 
-					new (static_cast<void*>(current_thread_ptr->m_last_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::forward<arg_Ty>(args)...);
-					std::memcpy(&(current_thread_ptr->m_last_task_ptr->m_address_data.m_function_ptr), &task, sizeof(void(*)(void)));
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_target_ptr = static_cast<void*>(target.m_parent_ptr);
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_offset = target.m_offset;
+		if (keeper)
+		{
+			keeper = false;
+			timers_ptr->m_keeper.store(false, std::memory_order_relaxed);
 
-					current_thread_ptr->m_last_task_ptr->m_address_data.m_callable = [](_cool_thmq_task* _task_ptr, _cool_thmq_task* _fetch_task_ptr)
-					{
-						if (_fetch_task_ptr == nullptr)
-						{
-							function_Ty function_ptr;
-							std::memcpy(&function_ptr, &(_task_ptr->m_address_data.m_function_ptr), sizeof(void(*)(void)));
+			if (_cool_thmq_timers::now_ns() >= timers_ptr->m_next_deadline_ns.load(std::memory_order_relaxed))
+			{
+				return true;
+			}
+
+			timer_service = has_task() && (timers_ptr->m_timer_count.load(std::memory_order_relaxed) != 0);
+		}
 
-							cool::async_result<return_Ty>& target_ref = *static_cast<cool::async_result<return_Ty>*>(_task_ptr->m_address_data.m_target_ptr);
+		if (timed_out && (elastic_ptr->m_idle_timeout_ms != 0) && (std::chrono::steady_clock::now() >= idle_deadline)
+			&& elastic_ptr->try_retire(elastic_ptr->m_min_thread_count))
+		{
+			m_elastic_state = 2;
+			return false;
+		}
+	}
 
-							xCOOL_THREADS_TRY
-							{
-								*(target_ref.m_stored_values_ptr + _task_ptr->m_address_data.m_offset) = cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::call(
-									function_ptr, std::move(*reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer))
-								);
-							}
-							xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
-							{
-								cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::catch_exception(xCOOL_THREADS_EXCEPTION, _task_ptr->m_address_data.m_function_ptr);
-							}
+	return timer_service;
+}
 
-							target_ref.decr_awaited();
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::start_thread(std::size_t new_task_buffer_size, cool::_threads_base::_elastic_control* elastic_ptr) noexcept
+{
+	if (m_cpu >= 0)
+	{
+		cool::_threads_base::pin_this_thread(m_cpu);
+		m_numa_node = cool::_threads_base::this_thread_numa_node();
+	}
 
-							reinterpret_cast<_cool_thmq_pack*>(_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
-						}
-						else
-						{
-							new (static_cast<void*>(_task_ptr->m_arg_buffer)) _cool_thmq_pack(std::move(*reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)));
-							reinterpret_cast<_cool_thmq_pack*>(_fetch_task_ptr->m_arg_buffer)->~_cool_thmq_pack();
+	bool task_buffer_allocated = true;
 
-							std::memcpy(&_task_ptr->m_address_data, &_fetch_task_ptr->m_address_data, _cool_thmq_task::address_with_target_and_offset_size);
-						}
-					};
+	while (true)
+	{
+		xCOOL_THREADS_TRY
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
 
-					bool notification_required = (current_thread_ptr->m_last_task_ptr == current_thread_ptr->m_next_task_ptr);
-					current_thread_ptr->m_last_task_ptr = last_task_ptr_p1;
-					lock.unlock();
+			if ((m_cpu >= 0) && (m_task_buffer_data_ptr == nullptr))
+			{
+				task_buffer_allocated = new_task_buffer(new_task_buffer_size);
+			}
 
-					if (notification_required)
-					{
-						current_thread_ptr->m_condition_var.notify_one();
-					}
+			// a thread started by an elastic pool opens its block to tasks, or gives it back if the allocation failed
 
-					return true;
+			if (m_elastic_state == 3)
+			{
+				if (task_buffer_allocated)
+				{
+					m_elastic_state = 0;
 				}
 				else
 				{
-					full_queue_counter--;
-
-					if (full_queue_counter == 0)
-					{
-						return false;
-					}
+					delete_task_buffer();
+					m_task_buffer_data_ptr = nullptr;
+					m_elastic_state = 2;
+					elastic_ptr->m_active_thread_count.fetch_sub(1, std::memory_order_relaxed);
 				}
 			}
+			break;
 		}
 		xCOOL_THREADS_CATCH(...) {}
-
-		thread_num = (thread_num != 0) ? thread_num - 1 : this->m_thread_count - 1;
 	}
-}
-
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check> template <class ... arg_Ty>
-inline constexpr bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::arg_type_is_valid() noexcept
-{
-	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thmq_pack = std::tuple<typename std::decay<arg_Ty>::type ...>;
 
-	constexpr bool ret = (sizeof(_cool_thmq_pack) <= _arg_buffer_size) && (alignof(_cool_thmq_pack) <= alignof(_cool_thmq_task));
-	return ret;
+	m_start_state.store(task_buffer_allocated ? 1 : 2, std::memory_order_release);
+	return task_buffer_allocated;
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline cool::threads_init_result cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::init_new_threads(
-	cool::thread_count new_thread_count,
-	cool::task_buffer_size new_task_buffer_size,
-	cool::try_pop_count new_try_pop_count,
-	cool::dispatch_interval new_dispatch_interval) noexcept
-{
-	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
-	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
 
-	using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
-	using _cool_thmq_uint2X = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uint2X;
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> template <class fill_Ty>
+inline bool cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::deque_push(fill_Ty& fill) noexcept
+{
+	constexpr std::ptrdiff_t deque_mask = static_cast<std::ptrdiff_t>(local_queue_size) - 1;
 
-	assert((reinterpret_cast<std::uintptr_t>(this) % cache_line_size == 0) && "cool::threads_mq<...> : object location must be aligned in memory");
+	std::ptrdiff_t bottom = m_deque_bottom.load(std::memory_order_relaxed);
+	std::ptrdiff_t top = m_deque_top.load(std::memory_order_acquire);
 
-	if (reinterpret_cast<std::uintptr_t>(this) % cache_line_size != 0)
-	{
-		return cool::threads_init_result(cool::threads_init_result::bad_align);
-	}
-	else
-	{
-		delete_threads();
-	}
+	_deque_slot* slot_ptr = m_deque_data + (bottom & deque_mask);
 
-	if ((new_thread_count.value() == 0) || (new_task_buffer_size.value() == 0))
-	{
-		return cool::threads_init_result(cool::threads_init_result::bad_parameters);
-	}
+	// a slot is only reusable once the thread that took it has finished moving the task out
 
-	if (new_dispatch_interval.value() != 0)
-	{
-		this->m_dispatch_interval = static_cast<_cool_thmq_uintX>(new_dispatch_interval.value());
-	}
-	else
+	if ((bottom - top > deque_mask) || slot_ptr->m_full.load(std::memory_order_acquire) || !fill(&(slot_ptr->m_task), &m_local_arg_slab))
 	{
-		this->m_dispatch_interval = static_cast<_cool_thmq_uintX>(default_dispatch_interval(new_thread_count.value()));
+		return false;
 	}
 
-	if (new_thread_count.value() != 1)
-	{
-		constexpr _cool_thmq_uintX uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
+	slot_ptr->m_full.store(true, std::memory_order_relaxed);
 
-		_cool_thmq_uint2X mod_D = static_cast<_cool_thmq_uint2X>(new_thread_count.value());
+	std::atomic_thread_fence(std::memory_order_release);
+	m_deque_bottom.store(bottom + 1, std::memory_order_relaxed);
 
-		_cool_thmq_uintX i = 0;
-		while ((static_cast<_cool_thmq_uint2X>(1) << i) < static_cast<_cool_thmq_uint2X>(new_thread_count.value()))
-		{
-			i++;
-		}
+	return true;
+}
 
-		_cool_thmq_uintX temp = uintX_bitcount + i;
-		_cool_thmq_uint2X mod_a = (static_cast<_cool_thmq_uint2X>(1) << temp) / mod_D;
-		if ((mod_a * mod_D) != (static_cast<_cool_thmq_uint2X>(1) << temp))
-		{
-			mod_a++;
-		}
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::deque_pop(_task* target_ptr) noexcept
+{
+	constexpr std::ptrdiff_t deque_mask = static_cast<std::ptrdiff_t>(local_queue_size) - 1;
 
-		this->m_mod_k = i - 1;
-		this->m_mod_a = mod_a - (static_cast<_cool_thmq_uint2X>(1) << uintX_bitcount);
-		this->m_mod_D = mod_D;
-	}
-	else
-	{
-		constexpr std::size_t uintX_bitcount = sizeof(_cool_thmq_uintX) * CHAR_BIT;
+	std::ptrdiff_t bottom = m_deque_bottom.load(std::memory_order_relaxed);
 
-		this->m_mod_k = 0;
-		this->m_mod_a = static_cast<_cool_thmq_uint2X>(1) << uintX_bitcount;
-		this->m_mod_D = 1;
-	}
+	// only the thread of the block moves 'm_deque_bottom' and 'm_deque_top' never decreases : an empty deque is detected without a fence
 
-	std::size_t _new_thread_count = static_cast<std::size_t>(new_thread_count.value());
-	std::size_t task_buffer_size_per_thread = new_task_buffer_size.value() / _new_thread_count;
-	if (_new_thread_count * task_buffer_size_per_thread != new_task_buffer_size.value())
+	if ((local_queue_size == 0) || (bottom <= m_deque_top.load(std::memory_order_relaxed)))
 	{
-		task_buffer_size_per_thread++;
+		return false;
 	}
 
-	this->m_thread_count = _new_thread_count;
+	bottom--;
+	m_deque_bottom.store(bottom, std::memory_order_relaxed);
 
-	unsigned int _new_pop_rounds = new_try_pop_count.value() / static_cast<unsigned int>(new_thread_count.value());
-	if ((static_cast<unsigned int>(new_thread_count.value()) * _new_pop_rounds != new_try_pop_count.value())
-		&& (static_cast<unsigned int>(new_thread_count.value()) * (_new_pop_rounds + 1) >= new_try_pop_count.value()))
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	std::ptrdiff_t top = m_deque_top.load(std::memory_order_relaxed);
+
+	if (top <= bottom)
 	{
-		_new_pop_rounds++;
-	}
+		if (top == bottom)
+		{
+			bool won = m_deque_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			m_deque_bottom.store(bottom + 1, std::memory_order_relaxed);
 
-	this->m_pop_rounds = _new_pop_rounds;
-	
+			if (!won)
+			{
+				return false;
+			}
+		}
 
-	std::size_t threads_constructed = 0;
-	std::size_t threads_launched = 0;
+		_deque_slot* slot_ptr = m_deque_data + (bottom & deque_mask);
 
-	this->m_thread_blocks_unaligned_data_ptr = static_cast<char*>(::operator new(
-		_new_thread_count * sizeof(_cool_thmq_tblk) + 2 * cache_line_size, std::nothrow));
+		slot_ptr->m_task.m_address_data.m_callable(target_ptr, &(slot_ptr->m_task));
+		slot_ptr->m_full.store(false, std::memory_order_release);
 
-	if (this->m_thread_blocks_unaligned_data_ptr == nullptr)
-	{
-		this->delete_threads_detail(threads_constructed, threads_launched);
-		return cool::threads_init_result(cool::threads_init_result::bad_alloc);
+		return true;
 	}
 	else
 	{
-		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_thread_blocks_unaligned_data_ptr) % static_cast<std::uintptr_t>(cache_line_size);
-
-		this->m_thread_blocks_data_ptr = reinterpret_cast<_cool_thmq_tblk*>(this->m_thread_blocks_unaligned_data_ptr
-			+ static_cast<std::size_t>(ptr_remainder != 0) * (cache_line_size - static_cast<std::size_t>(ptr_remainder)));
-	}
-
-	for (std::size_t thread_num = 0; thread_num < _new_thread_count; thread_num++)
-	{
-		new (this->m_thread_blocks_data_ptr + thread_num) _cool_thmq_tblk();
-		if (!((this->m_thread_blocks_data_ptr + thread_num)->new_task_buffer(task_buffer_size_per_thread)))
-		{
-			this->delete_threads_detail(threads_constructed, threads_launched);
-			return cool::threads_init_result(cool::threads_init_result::bad_alloc);
-		}
-		threads_constructed++;
+		m_deque_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return false;
 	}
+}
 
-	for (std::size_t thread_num = 0; thread_num < _new_thread_count; thread_num++)
-	{
-		(this->m_thread_blocks_data_ptr + thread_num)->m_stop_threads = false;
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::deque_steal(_task* target_ptr) noexcept
+{
+	constexpr std::ptrdiff_t deque_mask = static_cast<std::ptrdiff_t>(local_queue_size) - 1;
 
-		xCOOL_THREADS_TRY
-		{
-			if (_new_pop_rounds == 0)
-			{
-				_cool_thmq_tblk* ptr = this->m_thread_blocks_data_ptr + thread_num;
+	// the threads probing the queues skip an empty deque without a fence, a task pushed meanwhile is found by a thread that parks,
+	// as it checks every deque after declaring itself idle and 'push_local' wakes up an idle thread (see 'idle_steal')
 
-				ptr->m_thread = std::thread([ptr]()
-				{
-					while (true)
-					{
-						xCOOL_THREADS_TRY
-						{
-							_cool_thmq_task current_task;
+	if ((local_queue_size == 0) || (m_deque_bottom.load(std::memory_order_relaxed) <= m_deque_top.load(std::memory_order_relaxed)))
+	{
+		return false;
+	}
 
-							{
-								std::unique_lock<std::mutex> lock(ptr->m_mutex);
+	std::ptrdiff_t top = m_deque_top.load(std::memory_order_acquire);
 
-								ptr->m_condition_var.wait(lock, [ptr]() -> bool { return (ptr->m_next_task_ptr != ptr->m_last_task_ptr) || ptr->m_stop_threads; });
+	std::atomic_thread_fence(std::memory_order_seq_cst);
 
-								if (ptr->m_next_task_ptr != ptr->m_last_task_ptr)
-								{
-									ptr->m_next_task_ptr->m_address_data.m_callable(&current_task, ptr->m_next_task_ptr);
+	std::ptrdiff_t bottom = m_deque_bottom.load(std::memory_order_acquire);
 
-									ptr->m_next_task_ptr = (ptr->m_next_task_ptr + 1 != ptr->m_task_buffer_end_ptr) ?
-										ptr->m_next_task_ptr + 1 : ptr->m_task_buffer_data_ptr;
-								}
-								else
-								{
-									return;
-								}
-							}
+	if (top < bottom)
+	{
+		_deque_slot* slot_ptr = m_deque_data + (top & deque_mask);
 
-							current_task.m_address_data.m_callable(&current_task, nullptr);
-						}
-						xCOOL_THREADS_CATCH(...) {}
-					}
-				});
-			}
-			else if (_new_pop_rounds == 1)
-			{
-				_cool_thmq_tblk* thread_blocks_data_ptr = this->m_thread_blocks_data_ptr;
+		if (m_deque_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			slot_ptr->m_task.m_address_data.m_callable(target_ptr, &(slot_ptr->m_task));
+			slot_ptr->m_full.store(false, std::memory_order_release);
 
-				(thread_blocks_data_ptr + thread_num)->m_thread = std::thread([thread_blocks_data_ptr, thread_num, _new_thread_count]()
-				{
-					while (true)
-					{
-						xCOOL_THREADS_TRY
-						{
-							_cool_thmq_task current_task;
+			return true;
+		}
+	}
 
-							bool ongoing = [&]() -> bool
-							{
-								for (std::size_t k = thread_num; k < _new_thread_count; k++)
-								{
-									_cool_thmq_tblk* ptr = thread_blocks_data_ptr + k;
+	return false;
+}
 
-									std::unique_lock<std::mutex> lock(ptr->m_mutex, std::try_to_lock);
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::idle_steal() noexcept
+{
+	m_idle.store(true, std::memory_order_seq_cst);
+	m_parent_ptr->m_idle_count.fetch_add(1, std::memory_order_seq_cst);
 
-									if (lock.owns_lock() && (ptr->m_next_task_ptr != ptr->m_last_task_ptr))
-									{
-										ptr->m_next_task_ptr->m_address_data.m_callable(&current_task, ptr->m_next_task_ptr);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
 
-										ptr->m_next_task_ptr = (ptr->m_next_task_ptr + 1 != ptr->m_task_buffer_end_ptr) ?
-											ptr->m_next_task_ptr + 1 : ptr->m_task_buffer_data_ptr;
+	_thread_block* thread_blocks_data_ptr = m_parent_ptr->m_thread_blocks_data_ptr;
+	std::size_t thread_count = m_parent_ptr->m_thread_count;
 
-										return true; // return from lambda, sets variable 'ongoing' as true
-									}
-								}
+	for (std::size_t k = 0; k < thread_count; k++)
+	{
+		_thread_block* ptr = thread_blocks_data_ptr + k;
 
-								for (std::size_t k = 0; k < thread_num; k++)
-								{
-									_cool_thmq_tblk* ptr = thread_blocks_data_ptr + k;
+		// a failed steal on a deque that is not empty lost the task to another thread, the next one is tried
 
-									std::unique_lock<std::mutex> lock(ptr->m_mutex, std::try_to_lock);
+		while (ptr->m_deque_bottom.load(std::memory_order_relaxed) > ptr->m_deque_top.load(std::memory_order_relaxed))
+		{
+			if (ptr->deque_steal(m_last_task_ptr))
+			{
+				m_last_task_ptr = (m_last_task_ptr + 1 != m_task_buffer_end_ptr) ? m_last_task_ptr + 1 : m_task_buffer_data_ptr;
+				m_has_task.store(true, std::memory_order_relaxed);
 
-									if (lock.owns_lock() && (ptr->m_next_task_ptr != ptr->m_last_task_ptr))
-									{
-										ptr->m_next_task_ptr->m_address_data.m_callable(&current_task, ptr->m_next_task_ptr);
+				m_idle.store(false, std::memory_order_relaxed);
+				m_parent_ptr->m_idle_count.fetch_sub(1, std::memory_order_relaxed);
 
-										ptr->m_next_task_ptr = (ptr->m_next_task_ptr + 1 != ptr->m_task_buffer_end_ptr) ?
-											ptr->m_next_task_ptr + 1 : ptr->m_task_buffer_data_ptr;
+				return true;
+			}
+		}
+	}
 
-										return true; // return from lambda, sets variable 'ongoing' as true
-									}
-								}
+	return false;
+}
 
-								{
-									_cool_thmq_tblk* ptr = thread_blocks_data_ptr + thread_num;
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline void cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::wake_idle_thread()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
 
-									std::unique_lock<std::mutex> lock(ptr->m_mutex);
+	if (this->m_idle_count.load(std::memory_order_acquire) != 0)
+	{
+		for (std::size_t k = 0; k < this->m_thread_count; k++)
+		{
+			_thread_block* ptr = this->m_thread_blocks_data_ptr + k;
 
-									ptr->m_condition_var.wait(lock, [ptr]() -> bool { return (ptr->m_next_task_ptr != ptr->m_last_task_ptr) || ptr->m_stop_threads; });
+			if (ptr->m_idle.load(std::memory_order_relaxed) && ptr->m_idle.exchange(false, std::memory_order_acquire))
+			{
+				while (true)
+				{
+					xCOOL_THREADS_TRY
+					{
+						std::lock_guard<std::mutex> lock(ptr->m_mutex);
+						ptr->m_wake = true;
+						break;
+					}
+					xCOOL_THREADS_CATCH(...) {}
+				}
 
-									if (ptr->m_next_task_ptr != ptr->m_last_task_ptr)
-									{
-										ptr->m_next_task_ptr->m_address_data.m_callable(&current_task, ptr->m_next_task_ptr);
+				ptr->m_condition_var.notify_one();
 
-										ptr->m_next_task_ptr = (ptr->m_next_task_ptr + 1 != ptr->m_task_buffer_end_ptr) ?
-											ptr->m_next_task_ptr + 1 : ptr->m_task_buffer_data_ptr;
+				return;
+			}
+		}
+	}
+}
 
-										return true; // return from lambda, sets variable 'ongoing' as true
-									}
-									else
-									{
-										return false; // return from lambda, sets variable 'ongoing' as false
-									}
-								}
-							}();
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::new_task_buffer(std::size_t new_task_buffer_size) noexcept
+{
+	using _cool_thws_task = typename cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+	using _cool_thws_slot = typename cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_deque_slot;
 
-							if (ongoing)
-							{
-								current_task.m_address_data.m_callable(&current_task, nullptr);
-							}
-							else
-							{
-								return;
-							}
-						}
-						xCOOL_THREADS_CATCH(...) {}
-					}
-				});
-			}
-			else
-			{
-				_cool_thmq_tblk* thread_blocks_data_ptr = this->m_thread_blocks_data_ptr;
+	constexpr std::size_t cache_line_size = alignof(cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>);
+	constexpr std::size_t arg_buffer_align = alignof(_cool_thws_task);
 
-				(thread_blocks_data_ptr + thread_num)->m_thread = std::thread([thread_blocks_data_ptr, thread_num, _new_thread_count, _new_pop_rounds]()
-				{
-					while (true)
-					{
-						xCOOL_THREADS_TRY
-						{
-							_cool_thmq_task current_task;
+	constexpr std::size_t task_buffer_padding = (cache_line_size > arg_buffer_align) ? cache_line_size : arg_buffer_align;
+	std::size_t new_task_buffer_size_p1 = new_task_buffer_size + 1;
 
-							bool ongoing = [&]() -> bool
-							{
-								for (unsigned int n = _new_pop_rounds; n > 0; n--)
-								{
-									for (std::size_t k = thread_num; k < _new_thread_count; k++)
-									{
-										_cool_thmq_tblk* ptr = thread_blocks_data_ptr + k;
+	std::size_t new_deque_size = 2;
+	while (new_deque_size < new_task_buffer_size)
+	{
+		new_deque_size *= 2;
+	}
 
-										std::unique_lock<std::mutex> lock(ptr->m_mutex, std::try_to_lock);
+	m_task_buffer_unaligned_data_ptr = static_cast<char*>(::operator new(new_task_buffer_size_p1 * sizeof(_cool_thws_task) + task_buffer_padding + cache_line_size, std::nothrow));
 
-										if (lock.owns_lock() && (ptr->m_next_task_ptr != ptr->m_last_task_ptr))
-										{
-											ptr->m_next_task_ptr->m_address_data.m_callable(&current_task, ptr->m_next_task_ptr);
+	if (m_task_buffer_unaligned_data_ptr == nullptr)
+	{
+		return false;
+	}
+	else
+	{
+		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_task_buffer_unaligned_data_ptr) % static_cast<std::uintptr_t>(task_buffer_padding);
 
-											ptr->m_next_task_ptr = (ptr->m_next_task_ptr + 1 != ptr->m_task_buffer_end_ptr) ?
-												ptr->m_next_task_ptr + 1 : ptr->m_task_buffer_data_ptr;
+		m_task_buffer_data_ptr = reinterpret_cast<_cool_thws_task*>(m_task_buffer_unaligned_data_ptr
+			+ static_cast<std::size_t>(ptr_remainder != 0) * (task_buffer_padding - static_cast<std::size_t>(ptr_remainder)));
+	}
 
-											return true; // return from lambda, sets variable 'ongoing' as true
-										}
-									}
+	m_deque_unaligned_data_ptr = static_cast<char*>(::operator new(new_deque_size * sizeof(_cool_thws_slot) + task_buffer_padding + cache_line_size, std::nothrow));
 
-									for (std::size_t k = 0; k < thread_num; k++)
-									{
-										_cool_thmq_tblk* ptr = thread_blocks_data_ptr + k;
+	if (m_deque_unaligned_data_ptr == nullptr)
+	{
+		::operator delete(m_task_buffer_unaligned_data_ptr);
+		m_task_buffer_unaligned_data_ptr = nullptr;
+		m_task_buffer_data_ptr = nullptr;
+		return false;
+	}
+	else
+	{
+		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_deque_unaligned_data_ptr) % static_cast<std::uintptr_t>(task_buffer_padding);
 
-										std::unique_lock<std::mutex> lock(ptr->m_mutex, std::try_to_lock);
+		m_deque_data_ptr = reinterpret_cast<_cool_thws_slot*>(m_deque_unaligned_data_ptr
+			+ static_cast<std::size_t>(ptr_remainder != 0) * (task_buffer_padding - static_cast<std::size_t>(ptr_remainder)));
+	}
 
-										if (lock.owns_lock() && (ptr->m_next_task_ptr != ptr->m_last_task_ptr))
-										{
-											ptr->m_next_task_ptr->m_address_data.m_callable(&current_task, ptr->m_next_task_ptr);
+	m_task_buffer_end_ptr = m_task_buffer_data_ptr + new_task_buffer_size_p1;
+	m_last_task_ptr = m_task_buffer_data_ptr;
+	m_next_task_ptr = m_task_buffer_data_ptr;
 
-											ptr->m_next_task_ptr = (ptr->m_next_task_ptr + 1 != ptr->m_task_buffer_end_ptr) ?
-												ptr->m_next_task_ptr + 1 : ptr->m_task_buffer_data_ptr;
+	for (std::size_t k = 0; k < new_task_buffer_size_p1; k++)
+	{
+		new (m_task_buffer_data_ptr + k) _cool_thws_task();
+	}
 
-											return true; // return from lambda, sets variable 'ongoing' as true
-										}
-									}
-								}
+	m_deque_mask = static_cast<std::ptrdiff_t>(new_deque_size - 1);
+	m_deque_top.store(0, std::memory_order_relaxed);
+	m_deque_bottom.store(0, std::memory_order_relaxed);
 
-								{
-									_cool_thmq_tblk* ptr = thread_blocks_data_ptr + thread_num;
+	for (std::size_t k = 0; k < new_deque_size; k++)
+	{
+		new (m_deque_data_ptr + k) _cool_thws_slot();
+	}
 
-									std::unique_lock<std::mutex> lock(ptr->m_mutex);
+	return true;
+}
 
-									ptr->m_condition_var.wait(lock, [ptr]() -> bool { return (ptr->m_next_task_ptr != ptr->m_last_task_ptr) || ptr->m_stop_threads; });
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline void cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::delete_task_buffer() noexcept
+{
+	if (m_task_buffer_data_ptr != nullptr)
+	{
+		std::size_t task_buffer_size_p1 = static_cast<std::size_t>(m_task_buffer_end_ptr - m_task_buffer_data_ptr);
 
-									if (ptr->m_next_task_ptr != ptr->m_last_task_ptr)
-									{
-										ptr->m_next_task_ptr->m_address_data.m_callable(&current_task, ptr->m_next_task_ptr);
+		for (std::size_t k = 0; k < task_buffer_size_p1; k++)
+		{
+			(m_task_buffer_data_ptr + k)->~_task();
+		}
 
-										ptr->m_next_task_ptr = (ptr->m_next_task_ptr + 1 != ptr->m_task_buffer_end_ptr) ?
-											ptr->m_next_task_ptr + 1 : ptr->m_task_buffer_data_ptr;
+		::operator delete(m_task_buffer_unaligned_data_ptr);
+	}
 
-										return true; // return from lambda, sets variable 'ongoing' as true
-									}
-									else
-									{
-										return false; // return from lambda, sets variable 'ongoing' as false
-									}
-								}
-							}();
+	if (m_deque_data_ptr != nullptr)
+	{
+		std::size_t deque_size = static_cast<std::size_t>(m_deque_mask) + 1;
 
-							if (ongoing)
-							{
-								current_task.m_address_data.m_callable(&current_task, nullptr);
-							}
-							else
-							{
-								return;
-							}
-						}
-						xCOOL_THREADS_CATCH(...) {}
-					}
-				});
-			}
-		}
-		xCOOL_THREADS_CATCH(...)
+		for (std::size_t k = 0; k < deque_size; k++)
 		{
-			this->delete_threads_detail(threads_constructed, threads_launched);
-			return cool::threads_init_result(cool::threads_init_result::bad_thread_creation);
+			(m_deque_data_ptr + k)->~_deque_slot();
 		}
 
-		threads_launched++;
+		::operator delete(m_deque_unaligned_data_ptr);
 	}
-
-	std::atomic_signal_fence(std::memory_order_release);
-	this->m_can_refresh.store(true, std::memory_order_release);
-	this->m_good.store(true, std::memory_order_seq_cst);
-	return cool::threads_init_result(cool::threads_init_result::success);
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline bool cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::good() const noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align> template <class fill_Ty>
+inline bool cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::deque_push(fill_Ty& fill) noexcept
 {
-	return this->m_good.load(std::memory_order_seq_cst);
-}
+	std::ptrdiff_t bottom = m_deque_bottom.load(std::memory_order_relaxed);
+	std::ptrdiff_t top = m_deque_top.load(std::memory_order_acquire);
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline std::size_t cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_count() const noexcept
-{
-	std::atomic_signal_fence(std::memory_order_acquire);
-	return this->m_thread_count;
+	_deque_slot* slot_ptr = m_deque_data_ptr + (bottom & m_deque_mask);
+
+	// a slot is only reusable once the thread that took it has finished moving the task out
+
+	if ((bottom - top > m_deque_mask) || slot_ptr->m_full.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+
+	fill(&(slot_ptr->m_task), nullptr);
+	slot_ptr->m_full.store(true, std::memory_order_relaxed);
+
+	std::atomic_thread_fence(std::memory_order_release);
+	m_deque_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+	return true;
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline std::size_t cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::task_buffer_size() const noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::deque_pop(_task* target_ptr) noexcept
 {
-	std::atomic_signal_fence(std::memory_order_acquire);
+	std::ptrdiff_t bottom = m_deque_bottom.load(std::memory_order_relaxed) - 1;
+	m_deque_bottom.store(bottom, std::memory_order_relaxed);
 
-	if (this->m_thread_blocks_data_ptr != nullptr)
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	std::ptrdiff_t top = m_deque_top.load(std::memory_order_relaxed);
+
+	if (top <= bottom)
 	{
-		if (this->m_thread_blocks_data_ptr->m_task_buffer_data_ptr != nullptr)
-		{
-			return static_cast<std::size_t>((this->m_thread_blocks_data_ptr->m_task_buffer_end_ptr
-				- this->m_thread_blocks_data_ptr->m_task_buffer_data_ptr) - 1) * this->m_thread_count;
-		}
-		else
+		if (top == bottom)
 		{
-			return 0;
+			bool won = m_deque_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			m_deque_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+			if (!won)
+			{
+				return false;
+			}
 		}
+
+		_deque_slot* slot_ptr = m_deque_data_ptr + (bottom & m_deque_mask);
+
+		slot_ptr->m_task.m_address_data.m_callable(target_ptr, &(slot_ptr->m_task));
+		slot_ptr->m_full.store(false, std::memory_order_release);
+
+		return true;
 	}
 	else
 	{
-		return 0;
+		m_deque_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return false;
 	}
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline unsigned int cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::try_pop_count() const noexcept
-{
-	std::atomic_signal_fence(std::memory_order_acquire);
-	return this->m_pop_rounds * static_cast<unsigned int>(this->m_thread_count);
-}
-
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline std::uint16_t cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::dispatch_interval() const noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::deque_steal(_task* target_ptr) noexcept
 {
-	std::atomic_signal_fence(std::memory_order_acquire);
-	return static_cast<std::uint16_t>(this->m_dispatch_interval);
-}
+	std::ptrdiff_t top = m_deque_top.load(std::memory_order_acquire);
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::delete_threads() noexcept
-{
-	this->delete_threads_detail(this->m_thread_count, this->m_thread_count);
-}
+	std::atomic_thread_fence(std::memory_order_seq_cst);
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline void cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::safety_refresh() noexcept
-{
-	using _cool_thmq_tblk = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block;
+	std::ptrdiff_t bottom = m_deque_bottom.load(std::memory_order_acquire);
 
-	if (this->m_can_refresh.exchange(false, std::memory_order_acquire))
+	if (top < bottom)
 	{
-		_cool_thmq_tblk* ptr = this->m_thread_blocks_data_ptr;
+		_deque_slot* slot_ptr = m_deque_data_ptr + (top & m_deque_mask);
 
-		for (std::size_t k = 0; k < this->m_thread_count; k++)
+		if (m_deque_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
 		{
-			(ptr + k)->m_condition_var.notify_one();
-		}
+			slot_ptr->m_task.m_address_data.m_callable(target_ptr, &(slot_ptr->m_task));
+			slot_ptr->m_full.store(false, std::memory_order_release);
 
-		this->m_can_refresh.store(true, std::memory_order_release);
+			return true;
+		}
 	}
+
+	return false;
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline std::thread::id cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_id(std::size_t thread_number) const noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline bool cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::deque_empty() const noexcept
 {
-	return (this->m_thread_blocks_data_ptr + thread_number)->m_thread.get_id();
+	std::ptrdiff_t top = m_deque_top.load(std::memory_order_seq_cst);
+	std::ptrdiff_t bottom = m_deque_bottom.load(std::memory_order_seq_cst);
+
+	return bottom <= top;
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline cool::_thread_const_iterator_proxy<cool::_thread_iterator<cool::_thread_mq_id<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>> cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_ids() const noexcept
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
+inline std::size_t cool::_threads_ws_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::victim(std::size_t thread_count) noexcept
 {
-	return cool::_thread_const_iterator_proxy<cool::_thread_iterator<cool::_thread_mq_id<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>>(this->m_thread_blocks_data_ptr, this->m_thread_blocks_data_ptr + this->m_thread_count);
+	// xorshift32, never returns the thread itself
+
+	std::uint32_t state = m_random_state;
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	m_random_state = state;
+
+	std::size_t ret = static_cast<std::size_t>(state) % (thread_count - 1);
+
+	return (ret < m_thread_num) ? ret : ret + 1;
 }
 
-#ifdef COOL_THREADS_NATIVE_HANDLE
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline std::thread::native_handle_type cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_native_handle(std::size_t thread_number)
+
+// _async_completion detail
+
+inline void cool::_async_completion::add(std::size_t number_of_tasks) noexcept
 {
-	return (this->m_thread_blocks_data_ptr + thread_number)->m_thread.native_handle();
+	m_state.fetch_add(static_cast<std::ptrdiff_t>(number_of_tasks) * unit, std::memory_order_acq_rel);
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline cool::_thread_iterator_proxy<cool::_thread_iterator<cool::_thread_mq_native_handle<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>> cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::thread_native_handles() noexcept
+inline void cool::_async_completion::incr() noexcept
 {
-	return cool::_thread_iterator_proxy<cool::_thread_iterator<cool::_thread_mq_native_handle<_cache_line_size, _arg_buffer_size, _arg_buffer_align>>>(this->m_thread_blocks_data_ptr, this->m_thread_blocks_data_ptr + this->m_thread_count);
+	m_state.fetch_add(unit, std::memory_order_relaxed);
 }
-#endif // COOL_THREADS_NATIVE_HANDLE
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
-inline std::uint16_t cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>::default_dispatch_interval(std::uint16_t new_thread_count) noexcept
+inline bool cool::_async_completion::sub(std::size_t number_of_tasks) noexcept
 {
-	if (new_thread_count == 0)
+	std::ptrdiff_t _number_of_tasks = static_cast<std::ptrdiff_t>(number_of_tasks);
+	std::ptrdiff_t prev = m_state.fetch_sub(_number_of_tasks * unit, std::memory_order_acq_rel);
+	std::ptrdiff_t prev_count = count(prev);
+
+	if ((prev_count > 0) && (prev_count <= _number_of_tasks))
 	{
-		return 0;
+		on_finished(prev);
+		return true;
+	}
+	else
+	{
+		return false;
 	}
+}
 
-	std::uint16_t max_dispatch_interval;
+inline bool cool::_async_completion::set(std::ptrdiff_t number_of_tasks) noexcept
+{
+	std::ptrdiff_t prev = m_state.load(std::memory_order_relaxed);
 
-	{
-		using _cool_thmq_uintX = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_uintX;
+	while (!m_state.compare_exchange_weak(prev, number_of_tasks * unit + (prev & flag_mask), std::memory_order_acq_rel, std::memory_order_relaxed)) {}
 
-		_cool_thmq_uintX _max_dispatch_interval = static_cast<_cool_thmq_uintX>(-1) / static_cast<_cool_thmq_uintX>(new_thread_count);
-		_cool_thmq_uintX _new_thread_count_d2 = static_cast<_cool_thmq_uintX>(new_thread_count) / 2;
-		max_dispatch_interval = (_max_dispatch_interval < _new_thread_count_d2) ?
-			static_cast<std::uint16_t>(_max_dispatch_interval) : static_cast<std::uint16_t>(_new_thread_count_d2);
-		max_dispatch_interval = (max_dispatch_interval < 32) ? max_dispatch_interval : 32;
+	if ((count(prev) > 0) && (number_of_tasks <= 0))
+	{
+		on_finished(prev);
+		return true;
+	}
+	else
+	{
+		return false;
 	}
+}
 
-	std::uint16_t sqr = 0;
+inline std::ptrdiff_t cool::_async_completion::get() const noexcept
+{
+	return count(m_state.load(std::memory_order_acquire));
+}
 
-	while ((sqr < max_dispatch_interval) && (sqr * sqr <= new_thread_count))
+inline bool cool::_async_completion::decr() noexcept
+{
+	std::ptrdiff_t prev = m_state.fetch_sub(unit, std::memory_order_acq_rel);
+
+	if (count(prev) == 1)
 	{
-		sqr++;
+		on_finished(prev);
+		return true;
+	}
+	else
+	{
+		return false;
 	}
+}
 
-	if (sqr == 0)
+inline void cool::_async_completion::wake() noexcept
+{
+	wake_all();
+}
+
+inline void cool::_async_completion::wait(std::size_t spin_count) noexcept
+{
+	std::ptrdiff_t state = m_state.load(std::memory_order_acquire);
+
+	for (std::size_t spin = 0; (spin < spin_count) && !done(state); spin++)
 	{
-		return 0;
+		cool::_threads_base::cpu_pause();
+		state = m_state.load(std::memory_order_acquire);
 	}
-	else
+
+	while (!done(state))
 	{
-		for (std::uint16_t ret = sqr; ret > 2; ret--)
+		if ((state & waiting_flag) == 0)
 		{
-			for (std::uint16_t divisor = ret; (ret % divisor != 0) || (new_thread_count % divisor != 0); divisor--)
+			if (!m_state.compare_exchange_weak(state, state | waiting_flag, std::memory_order_acq_rel, std::memory_order_acquire))
 			{
-				if (divisor <= 2)
-				{
-					return ret;
-				}
+				continue;
 			}
-		}
 
-		for (std::uint16_t ret = sqr; ret < max_dispatch_interval; ret++)
-		{
-			for (std::uint16_t divisor = ret; (ret % divisor != 0) || (new_thread_count % divisor != 0); divisor--)
-			{
-				if (divisor <= 2)
-				{
-					return ret;
-				}
-			}
+			state |= waiting_flag;
 		}
 
-		return ((new_thread_count % 2 != 0) && (2 <= max_dispatch_interval)) ? 2 : 1;
+		wait_on(state);
+		state = m_state.load(std::memory_order_acquire);
 	}
+
+	// the flag is left to the last waiter as the thread completing the counter does not touch the word again unless it collects waiters
+
+	while (((state & waiting_flag) != 0) && (count(state) <= 0)
+		&& !m_state.compare_exchange_weak(state, state & ~waiting_flag, std::memory_order_relaxed, std::memory_order_relaxed)) {}
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
-inline void cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::delete_threads_detail(std::size_t threads_constructed, std::size_t threads_launched) noexcept
+template <class threads_Ty>
+inline void cool::_async_completion::wait_helping(threads_Ty& threads) noexcept
 {
-	bool was_good = this->m_good.exchange(false, std::memory_order_seq_cst);
+	// once no task has been found 'help_poll_count' times in a row the thread sleeps as in 'wait', the tasks queued later
+	// are run by the other threads, which also steal those left in the local deque of this thread
 
-	_thread_block* ptr = this->m_thread_blocks_data_ptr;
+	unsigned int empty_polls = 0;
 
-	if (ptr != nullptr)
+	while (!finished())
 	{
-		for (std::size_t k = 0; k < threads_launched; k++)
+		if (threads.run_pending_task())
 		{
-			while (true)
-			{
-				xCOOL_THREADS_TRY
-				{
-					std::lock_guard<std::mutex> lock((ptr + k)->m_mutex);
-					(ptr + k)->m_stop_threads = true;
-					break;
-				}
-				xCOOL_THREADS_CATCH(...) {}
-			}
-
-			(ptr + k)->m_condition_var.notify_one();
-
-			if ((ptr + k)->m_thread.joinable())
-			{
-				std::thread::id thread_id = (ptr + k)->m_thread.get_id();
-
-				xCOOL_THREADS_TRY
-				{
-					(ptr + k)->m_thread.join();
-				}
-				xCOOL_THREADS_CATCH(const std::system_error& xCOOL_THREADS_SYSTEM_ERROR)
-				{
-					cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::catch_delete_thread_exception(xCOOL_THREADS_SYSTEM_ERROR, thread_id);
-				}
-			}
+			empty_polls = 0;
+		}
+		else if (++empty_polls < help_poll_count)
+		{
+			std::this_thread::yield();
+		}
+		else
+		{
+			wait(0);
+			return;
 		}
+	}
+}
+
+inline bool cool::_async_completion::finished() const noexcept
+{
+	return done(m_state.load(std::memory_order_acquire));
+}
 
-		if (was_good)
+inline bool cool::_async_completion::add_waiter(cool::_async_waiter* waiter_ptr) noexcept
+{
+	std::ptrdiff_t state = m_state.load(std::memory_order_relaxed);
+
+	while (true)
+	{
+		if (count(state) <= 0)
 		{
-			while (!(this->m_can_refresh.load(std::memory_order_relaxed)) || !(this->m_can_refresh.exchange(false, std::memory_order_acquire)))
-			{
-				std::this_thread::yield();
-			}
+			return false;
 		}
-
-		for (std::size_t k = 0; k < threads_constructed; k++)
+		else if ((state & lock_flag) != 0)
 		{
-			(ptr + k)->delete_task_buffer();
-			(ptr + k)->~_thread_block();
+			std::this_thread::yield();
+			state = m_state.load(std::memory_order_relaxed);
+		}
+		else if (m_state.compare_exchange_weak(state, state | lock_flag, std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			break;
 		}
-
-		::operator delete(this->m_thread_blocks_unaligned_data_ptr);
 	}
 
-	constexpr std::size_t uintX_bitcount = sizeof(_uintX) * CHAR_BIT;
-
-	this->m_dispatch_interval = 1;
-	this->m_mod_k = 0;
-	this->m_mod_a = static_cast<_uint2X>(1) << uintX_bitcount;
-	this->m_mod_D = 1;
-	this->m_thread_count = 0;
-	this->m_thread_blocks_data_ptr = nullptr;
-
-	this->m_pop_rounds = 0;
+	waiter_ptr->m_next_ptr = m_waiter_ptr;
+	m_waiter_ptr = waiter_ptr;
 
-	this->m_thread_blocks_unaligned_data_ptr = nullptr;
+	// if the counter has been completed in the meantime the completing thread waits for the lock and collects the waiter
 
-	std::atomic_signal_fence(std::memory_order_release);
-}
+	state = m_state.load(std::memory_order_relaxed);
+	while (!m_state.compare_exchange_weak(state, (state & ~lock_flag) | list_flag, std::memory_order_release, std::memory_order_relaxed)) {}
 
-inline cool::threads_init_result::operator bool() const noexcept
-{
-	return m_result == threads_init_result::success;
+	return true;
 }
 
-inline bool cool::threads_init_result::good() const noexcept
+inline std::ptrdiff_t cool::_async_completion::count(std::ptrdiff_t state) noexcept
 {
-	return m_result == threads_init_result::success;
+	return (state & ~flag_mask) / unit;
 }
 
-inline int cool::threads_init_result::value() const noexcept
+inline bool cool::_async_completion::done(std::ptrdiff_t state) noexcept
 {
-	return m_result;
+	return (count(state) <= 0) && ((state & (lock_flag | list_flag)) == 0);
 }
 
-inline const char* cool::threads_init_result::message() const noexcept
+inline void cool::_async_completion::on_finished(std::ptrdiff_t state) noexcept
 {
-	switch (m_result)
+	if ((state & (lock_flag | list_flag)) == 0)
 	{
-	case threads_init_result::success: return "cool threads init success"; break;
-	case threads_init_result::bad_align: return "cool threads init failed : bad alignment of threads_sq/threads_mq object"; break;
-	case threads_init_result::bad_parameters: return "cool threads init failed : bad parameters"; break;
-	case threads_init_result::bad_alloc: return "cool threads init failed : bad allocation"; break;
-	case threads_init_result::bad_thread_creation: return "cool threads init failed : bad thread creation"; break;
-	default: return "cool threads init result undefined"; break;
+		if ((state & waiting_flag) != 0)
+		{
+			wake_all();
+		}
+
+		return;
 	}
-}
 
-inline cool::threads_init_result::threads_init_result(int result) noexcept : m_result(result) {}
+	state = m_state.load(std::memory_order_relaxed);
 
-inline void cool::threads_exception_handler::set_on_exception(void(*on_exception)(const std::exception&, void(*)(void), std::thread::id, void*), void* exception_arg_ptr) noexcept
-{
-	cool::_threads_base::exception_handler handler{ on_exception, exception_arg_ptr };
-	cool::_threads_base::get_exception_handler().store(handler, std::memory_order_seq_cst);
-}
+	while (true)
+	{
+		if ((state & lock_flag) != 0)
+		{
+			std::this_thread::yield();
+			state = m_state.load(std::memory_order_relaxed);
+		}
+		else if (m_state.compare_exchange_weak(state, state | lock_flag, std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			break;
+		}
+	}
 
-inline void cool::threads_exception_handler::set_on_delete_thread_exception(void(*on_delete_thread_exception)(const std::system_error&, std::thread::id, void*), void* delete_thread_exception_arg_ptr) noexcept
-{
-	cool::_threads_base::delete_thread_exception_handler handler{ on_delete_thread_exception, delete_thread_exception_arg_ptr };
-	cool::_threads_base::get_delete_thread_exception_handler().store(handler, std::memory_order_seq_cst);
-}
+	cool::_async_waiter* waiter_ptr = m_waiter_ptr;
+	m_waiter_ptr = nullptr;
 
-inline void cool::threads_exception_handler::clear() noexcept
-{
-	cool::_threads_base::exception_handler handler{ nullptr, nullptr };
-	cool::_threads_base::get_exception_handler().store(handler, std::memory_order_seq_cst);
+	// last access to the object before the waiters are called, the object may be destroyed from then on
 
-	cool::_threads_base::delete_thread_exception_handler delete_thread_handler{ nullptr, nullptr };
-	cool::_threads_base::get_delete_thread_exception_handler().store(delete_thread_handler, std::memory_order_seq_cst);
+	if ((m_state.fetch_and(~flag_mask, std::memory_order_acq_rel) & waiting_flag) != 0)
+	{
+		wake_all();
+	}
+
+	while (waiter_ptr != nullptr)
+	{
+		cool::_async_waiter* next_waiter_ptr = waiter_ptr->m_next_ptr;
+		waiter_ptr->m_callback(waiter_ptr->m_object_ptr);
+		waiter_ptr = next_waiter_ptr;
+	}
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
-inline bool cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::new_task_buffer(std::size_t new_task_buffer_size) noexcept
+// 'wait_on' returns once the word differs from 'state' (or spuriously), 'wake_all' only uses the address of the word and not its
+// content so that it can be called after the object has been destroyed (a futex wake on a stale address is at worst spurious)
+
+inline void cool::_async_completion::wait_on(std::ptrdiff_t state) noexcept
 {
-	using _cool_thmq_task = typename cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_task;
+#if defined(xCOOL_THREADS_FUTEX)
+	static_assert(sizeof(std::atomic<std::ptrdiff_t>) == sizeof(std::ptrdiff_t), "cool::_async_completion : unexpected atomic layout");
 
-	constexpr std::size_t cache_line_size = alignof(cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>);
-	constexpr std::size_t arg_buffer_align = alignof(_cool_thmq_task);
+	// the futex word is the low half of the state, which changes with every update of the counter
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	constexpr std::size_t low_half_offset = sizeof(std::ptrdiff_t) - sizeof(std::uint32_t);
+#else
+	constexpr std::size_t low_half_offset = 0;
+#endif
+	futex_wait(reinterpret_cast<unsigned char*>(&m_state) + low_half_offset, static_cast<std::uint32_t>(state));
+#elif defined(xCOOL_THREADS_ATOMIC_WAIT)
+	_park_slot& slot = park_slot(&m_state);
 
-	constexpr std::size_t task_buffer_padding = (cache_line_size > arg_buffer_align) ? cache_line_size : arg_buffer_align;
-	std::size_t new_task_buffer_size_p1 = new_task_buffer_size + 1;
+	// the epoch is read before the word : if it is read after 'wake_all' bumped it the new state is visible and the wait is skipped
 
-	m_task_buffer_unaligned_data_ptr = static_cast<char*>(::operator new(new_task_buffer_size_p1 * sizeof(_cool_thmq_task) + task_buffer_padding + cache_line_size, std::nothrow));
+	std::uint32_t epoch = slot.m_epoch.load(std::memory_order_acquire);
 
-	if (m_task_buffer_unaligned_data_ptr == nullptr)
+	if (m_state.load(std::memory_order_acquire) == state)
 	{
-		return false;
+		slot.m_epoch.wait(epoch, std::memory_order_acquire);
 	}
-	else
+#else
+	_park_slot& slot = park_slot(&m_state);
+
+	while (true)
 	{
-		std::uintptr_t ptr_remainder = reinterpret_cast<std::uintptr_t>(this->m_task_buffer_unaligned_data_ptr) % static_cast<std::uintptr_t>(task_buffer_padding);
+		xCOOL_THREADS_TRY
+		{
+			std::unique_lock<std::mutex> lock(slot.m_mutex);
 
-		m_task_buffer_data_ptr = reinterpret_cast<_cool_thmq_task*>(m_task_buffer_unaligned_data_ptr
-			+ static_cast<std::size_t>(ptr_remainder != 0) * (task_buffer_padding - static_cast<std::size_t>(ptr_remainder)));
+			if (m_state.load(std::memory_order_acquire) == state)
+			{
+				slot.m_condition_var.wait(lock);
+			}
+			break;
+		}
+		xCOOL_THREADS_CATCH(...) {}
 	}
+#endif
+}
 
-	m_task_buffer_end_ptr = m_task_buffer_data_ptr + new_task_buffer_size_p1;
-	m_last_task_ptr = m_task_buffer_data_ptr;
-	m_next_task_ptr = m_task_buffer_data_ptr;
+inline void cool::_async_completion::wake_all() noexcept
+{
+#if defined(xCOOL_THREADS_FUTEX)
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+	constexpr std::size_t low_half_offset = sizeof(std::ptrdiff_t) - sizeof(std::uint32_t);
+#else
+	constexpr std::size_t low_half_offset = 0;
+#endif
+	futex_wake(reinterpret_cast<unsigned char*>(&m_state) + low_half_offset, INT_MAX);
+#elif defined(xCOOL_THREADS_ATOMIC_WAIT)
+	_park_slot& slot = park_slot(&m_state);
+
+	slot.m_epoch.fetch_add(1, std::memory_order_release);
+	slot.m_epoch.notify_all();
+#else
+	_park_slot& slot = park_slot(&m_state);
+
+	// taking the mutex once orders the wake up after the check of a waiter that is about to sleep
 
-	for (std::size_t k = 0; k < new_task_buffer_size_p1; k++)
+	while (true)
 	{
-		new (m_task_buffer_data_ptr + k) _cool_thmq_task();
+		xCOOL_THREADS_TRY
+		{
+			std::lock_guard<std::mutex> lock(slot.m_mutex);
+			break;
+		}
+		xCOOL_THREADS_CATCH(...) {}
 	}
 
-	return true;
+	slot.m_condition_var.notify_all();
+#endif
 }
 
-template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align>
-inline void cool::_threads_mq_data<_cache_line_size, _arg_buffer_size, _arg_buffer_align>::_thread_block::delete_task_buffer() noexcept
+#if defined(xCOOL_THREADS_FUTEX)
+inline void cool::_async_completion::futex_wait(void* word_ptr, std::uint32_t value) noexcept
 {
-	if (m_task_buffer_data_ptr != nullptr)
-	{
-		std::size_t task_buffer_size_p1 = static_cast<std::size_t>(m_task_buffer_end_ptr - m_task_buffer_data_ptr);
+	syscall(SYS_futex, word_ptr, FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
+}
 
-		for (std::size_t k = 0; k < task_buffer_size_p1; k++)
-		{
-			(m_task_buffer_data_ptr + k)->~_task();
-		}
+inline void cool::_async_completion::futex_wake(void* word_ptr, int count) noexcept
+{
+	syscall(SYS_futex, word_ptr, FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+#else // defined(xCOOL_THREADS_FUTEX)
+inline cool::_async_completion::_park_slot& cool::_async_completion::park_slot(const void* address) noexcept
+{
+	static _park_slot park_slots[park_slot_count];
 
-		::operator delete(m_task_buffer_unaligned_data_ptr);
-	}
+	std::uintptr_t hash = reinterpret_cast<std::uintptr_t>(address) / alignof(std::atomic<std::ptrdiff_t>);
+	hash ^= hash >> 7;
+
+	return park_slots[hash % park_slot_count];
 }
+#endif // !defined(xCOOL_THREADS_FUTEX)
 
 
 // async_end detail
 
 inline void cool::async_end::add_awaited(std::size_t number_of_tasks) noexcept
 {
-	m_tasks_awaited.fetch_add(static_cast<std::ptrdiff_t>(number_of_tasks), std::memory_order_seq_cst);
+	m_completion.add(number_of_tasks);
 }
 
 inline bool cool::async_end::sub_awaited(std::size_t number_of_tasks) noexcept
 {
-	std::ptrdiff_t _number_of_tasks = static_cast<std::ptrdiff_t>(number_of_tasks);
-	std::ptrdiff_t prev = m_tasks_awaited.fetch_sub(_number_of_tasks, std::memory_order_seq_cst);
-
-	if ((prev > 0) && (prev <= _number_of_tasks))
-	{
-		while (true)
-		{
-			xCOOL_THREADS_TRY
-			{
-				std::lock_guard<std::mutex> lock(m_finish_mutex);
-				m_finish_condition_var.notify_all();
-				return true;
-			}
-			xCOOL_THREADS_CATCH(...) {}
-		}
-	}
-	else
-	{
-		return false;
-	}
+	return m_completion.sub(number_of_tasks);
 }
 
 inline bool cool::async_end::set_awaited(std::ptrdiff_t number_of_tasks) noexcept
 {
-	std::ptrdiff_t prev = m_tasks_awaited.exchange(number_of_tasks, std::memory_order_seq_cst);
-
-	if ((prev > 0) && (number_of_tasks <= 0))
-	{
-		while (true)
-		{
-			xCOOL_THREADS_TRY
-			{
-				std::lock_guard<std::mutex> lock(m_finish_mutex);
-				m_finish_condition_var.notify_all();
-				return true;
-			}
-			xCOOL_THREADS_CATCH(...) {}
-		}
-	}
-	else
-	{
-		return false;
-	}
+	return m_completion.set(number_of_tasks);
 }
 
 inline std::ptrdiff_t cool::async_end::get_awaited() const noexcept
 {
-	return m_tasks_awaited.load(std::memory_order_seq_cst);
+	return m_completion.get();
 }
 
 inline bool cool::async_end::decr_awaited() noexcept
 {
-	if (m_tasks_awaited.fetch_sub(1, std::memory_order_seq_cst) == 1)
-	{
-		while (true)
-		{
-			xCOOL_THREADS_TRY
-			{
-				std::lock_guard<std::mutex> lock(m_finish_mutex);
-				m_finish_condition_var.notify_all();
-				return true;
-			}
-			xCOOL_THREADS_CATCH(...) {}
-		}
-	}
-	else
-	{
-		return false;
-	}
+	return m_completion.decr();
 }
 
 inline void cool::async_end::notify() noexcept
 {
-	while (true)
-	{
-		xCOOL_THREADS_TRY
-		{
-			std::lock_guard<std::mutex> lock(m_finish_mutex);
-			m_finish_condition_var.notify_all();
-			return;
-		}
-		xCOOL_THREADS_CATCH(...) {}
-	}
+	m_completion.wake();
 }
 
-inline void cool::async_end::finish() noexcept
+inline void cool::async_end::finish(std::size_t spin_count) noexcept
 {
-	while (m_tasks_awaited.load(std::memory_order_seq_cst) > 0)
-	{
-		xCOOL_THREADS_TRY
-		{
-			std::unique_lock<std::mutex> lock(m_finish_mutex);
-
-			if (m_tasks_awaited.load(std::memory_order_relaxed) > 0)
-			{
-				m_finish_condition_var.wait(lock);
-			}
-			else
-			{
-				return;
-			}
-		}
-		xCOOL_THREADS_CATCH(...) {}
-	}
+	m_completion.wait(spin_count);
 }
 
 inline bool cool::async_end::finished() const noexcept
 {
-	return m_tasks_awaited.load(std::memory_order_seq_cst) <= 0;
+	return m_completion.finished();
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::async_end::finish(cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept
+{
+	m_completion.wait_helping(threads);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::async_end::finish(cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept
+{
+	m_completion.wait_helping(threads);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::async_end::finish(cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept
+{
+	m_completion.wait_helping(threads);
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::async_end::finish(cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept
+{
+	m_completion.wait_helping(threads);
 }
 
 inline cool::_async_end_incr_proxy cool::async_end::try_incr_awaited() noexcept
@@ -4853,9 +10021,39 @@ inline cool::_async_end_incr_proxy cool::async_end::try_incr_awaited() noexcept
 	return cool::_async_end_incr_proxy(this);
 }
 
+#ifdef xCOOL_THREADS_COROUTINES
+inline cool::_finish_awaiter<cool::async_end, void> cool::async_end::operator co_await() noexcept
+{
+	return cool::_finish_awaiter<cool::async_end, void>(this, nullptr);
+}
+#endif // xCOOL_THREADS_COROUTINES
+
 inline void cool::async_end::safety_refresh() noexcept
 {
-	m_finish_condition_var.notify_all();
+	m_completion.wake();
+}
+
+inline bool cool::async_end::add_waiter(cool::_async_waiter* waiter_ptr) noexcept
+{
+	return m_completion.add_waiter(waiter_ptr);
+}
+
+
+// cancel_token detail
+
+inline void cool::cancel_token::cancel() noexcept
+{
+	m_cancelled.store(true, std::memory_order_relaxed);
+}
+
+inline bool cool::cancel_token::cancelled() const noexcept
+{
+	return m_cancelled.load(std::memory_order_relaxed);
+}
+
+inline void cool::cancel_token::reset() noexcept
+{
+	m_cancelled.store(false, std::memory_order_relaxed);
 }
 
 
@@ -4870,62 +10068,25 @@ inline cool::async_result<return_Ty>::async_result(return_Ty* storage_ptr) noexc
 template <class return_Ty>
 inline void cool::async_result<return_Ty>::add_awaited(std::size_t number_of_tasks) noexcept
 {
-	m_tasks_awaited.fetch_add(number_of_tasks, std::memory_order_seq_cst);
-}
-
-template <class return_Ty>
-inline bool cool::async_result<return_Ty>::sub_awaited(std::size_t number_of_tasks) noexcept
-{
-	std::ptrdiff_t _number_of_tasks = static_cast<std::ptrdiff_t>(number_of_tasks);
-	std::ptrdiff_t prev = m_tasks_awaited.fetch_sub(_number_of_tasks, std::memory_order_seq_cst);
-
-	if ((prev > 0) && (prev <= _number_of_tasks))
-	{
-		while (true)
-		{
-			xCOOL_THREADS_TRY
-			{
-				std::lock_guard<std::mutex> lock(m_finish_mutex);
-				m_finish_condition_var.notify_all();
-				return true;
-			}
-			xCOOL_THREADS_CATCH(...) {}
-		}
-	}
-	else
-	{
-		return false;
-	}
+	m_completion.add(number_of_tasks);
 }
 
 template <class return_Ty>
-inline bool cool::async_result<return_Ty>::set_awaited(std::ptrdiff_t number_of_tasks) noexcept
+inline bool cool::async_result<return_Ty>::sub_awaited(std::size_t number_of_tasks) noexcept
 {
-	std::ptrdiff_t prev = m_tasks_awaited.exchange(number_of_tasks, std::memory_order_seq_cst);
+	return m_completion.sub(number_of_tasks);
+}
 
-	if ((prev > 0) && (number_of_tasks <= 0))
-	{
-		while (true)
-		{
-			xCOOL_THREADS_TRY
-			{
-				std::lock_guard<std::mutex> lock(m_finish_mutex);
-				m_finish_condition_var.notify_all();
-				return true;
-			}
-			xCOOL_THREADS_CATCH(...) {}
-		}
-	}
-	else
-	{
-		return false;
-	}
+template <class return_Ty>
+inline bool cool::async_result<return_Ty>::set_awaited(std::ptrdiff_t number_of_tasks) noexcept
+{
+	return m_completion.set(number_of_tasks);
 }
 
 template <class return_Ty>
 inline std::ptrdiff_t cool::async_result<return_Ty>::get_awaited() const noexcept
 {
-	return m_tasks_awaited.load(std::memory_order_seq_cst);
+	return m_completion.get();
 }
 
 template <class return_Ty>
@@ -4937,66 +10098,49 @@ inline cool::_async_result_to_proxy<return_Ty> cool::async_result<return_Ty>::to
 template <class return_Ty>
 inline bool cool::async_result<return_Ty>::decr_awaited() noexcept
 {
-	if (m_tasks_awaited.fetch_sub(1, std::memory_order_seq_cst) == 1)
-	{
-		while (true)
-		{
-			xCOOL_THREADS_TRY
-			{
-				std::lock_guard<std::mutex> lock(m_finish_mutex);
-				m_finish_condition_var.notify_all();
-				return true;
-			}
-			xCOOL_THREADS_CATCH(...) {}
-		}
-	}
-	else
-	{
-		return false;
-	}
+	return m_completion.decr();
 }
 
 template <class return_Ty>
 inline void cool::async_result<return_Ty>::notify() noexcept
 {
-	while (true)
-	{
-		xCOOL_THREADS_TRY
-		{
-			std::lock_guard<std::mutex> lock(m_finish_mutex);
-			m_finish_condition_var.notify_all();
-			return;
-		}
-		xCOOL_THREADS_CATCH(...) {}
-	}
+	m_completion.wake();
 }
 
 template <class return_Ty>
-inline void cool::async_result<return_Ty>::finish() noexcept
+inline void cool::async_result<return_Ty>::finish(std::size_t spin_count) noexcept
 {
-	while (m_tasks_awaited.load(std::memory_order_seq_cst) > 0)
-	{
-		xCOOL_THREADS_TRY
-		{
-			std::unique_lock<std::mutex> lock(m_finish_mutex);
-
-			if (m_tasks_awaited.load(std::memory_order_relaxed) > 0)
-			{
-				m_finish_condition_var.wait(lock);
-			}
-			else
-			{
-				return;
-			}
-		}
-		xCOOL_THREADS_CATCH(...) {}
-	}
+	m_completion.wait(spin_count);
 }
 
 template <class return_Ty>
 inline bool cool::async_result<return_Ty>::finished() const noexcept
 {
-	return m_tasks_awaited.load(std::memory_order_seq_cst) <= 0;
+	return m_completion.finished();
+}
+
+template <class return_Ty> template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::async_result<return_Ty>::finish(cool::threads_sq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept
+{
+	m_completion.wait_helping(threads);
+}
+
+template <class return_Ty> template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::async_result<return_Ty>::finish(cool::threads_mq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept
+{
+	m_completion.wait_helping(threads);
+}
+
+template <class return_Ty> template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::async_result<return_Ty>::finish(cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept
+{
+	m_completion.wait_helping(threads);
+}
+
+template <class return_Ty> template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline void cool::async_result<return_Ty>::finish(cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& threads) noexcept
+{
+	m_completion.wait_helping(threads);
 }
 
 template <class return_Ty>
@@ -5096,10 +10240,89 @@ inline void cool::async_result<return_Ty>::clear_unchecked() noexcept
 	m_stored_values_ptr = nullptr;
 }
 
+#ifdef xCOOL_THREADS_COROUTINES
+template <class return_Ty>
+inline cool::_finish_awaiter<cool::async_result<return_Ty>, void> cool::async_result<return_Ty>::operator co_await() noexcept
+{
+	return cool::_finish_awaiter<cool::async_result<return_Ty>, void>(this, nullptr);
+}
+#endif // xCOOL_THREADS_COROUTINES
+
+#ifndef COOL_THREADS_NO_EXCEPTIONS
+template <class return_Ty>
+inline void cool::async_result<return_Ty>::capture_exceptions(bool enable, std::exception_ptr* exception_storage_ptr) noexcept
+{
+	m_capture_exceptions = enable;
+	m_exceptions_ptr = enable ? exception_storage_ptr : nullptr;
+}
+
+template <class return_Ty>
+inline bool cool::async_result<return_Ty>::has_exception() const noexcept
+{
+	return m_exception_captured.load(std::memory_order_relaxed);
+}
+
+template <class return_Ty>
+inline std::exception_ptr cool::async_result<return_Ty>::get_exception() const noexcept
+{
+	return m_first_exception;
+}
+
+template <class return_Ty>
+inline void cool::async_result<return_Ty>::rethrow_exception() const
+{
+	if (m_first_exception)
+	{
+		std::rethrow_exception(m_first_exception);
+	}
+}
+
+template <class return_Ty>
+inline void cool::async_result<return_Ty>::clear_exceptions() noexcept
+{
+	m_first_exception = nullptr;
+	m_exception_captured.store(false, std::memory_order_relaxed);
+}
+#endif // COOL_THREADS_NO_EXCEPTIONS
+
 template <class return_Ty>
 inline void cool::async_result<return_Ty>::safety_refresh() noexcept
 {
-	m_finish_condition_var.notify_all();
+	m_completion.wake();
+}
+
+template <class return_Ty>
+inline bool cool::async_result<return_Ty>::add_waiter(cool::_async_waiter* waiter_ptr) noexcept
+{
+	return m_completion.add_waiter(waiter_ptr);
+}
+
+template <class return_Ty>
+inline bool cool::async_result<return_Ty>::capture_exception(std::size_t offset) noexcept
+{
+#ifndef COOL_THREADS_NO_EXCEPTIONS
+	if (!m_capture_exceptions)
+	{
+		return false;
+	}
+
+	std::exception_ptr exception = std::current_exception();
+
+	if (m_exceptions_ptr != nullptr)
+	{
+		*(m_exceptions_ptr + offset) = exception;
+	}
+
+	if (!m_exception_captured.exchange(true, std::memory_order_relaxed))
+	{
+		m_first_exception = std::move(exception);
+	}
+
+	return true;
+#else // COOL_THREADS_NO_EXCEPTIONS
+	static_cast<void>(offset);
+	return false;
+#endif // COOL_THREADS_NO_EXCEPTIONS
 }
 
 template <class return_Ty>
@@ -5114,6 +10337,235 @@ inline void cool::safety_refresh_proxy::safety_refresh() const noexcept
 }
 
 
+// async_node detail
+
+template <class threads_Ty, std::size_t _max_predecessor_count>
+inline cool::async_node<threads_Ty, _max_predecessor_count>::async_node(threads_Ty& threads) noexcept : m_threads_ptr(&threads)
+{
+	m_end.add_awaited(1);
+}
+
+template <class threads_Ty, std::size_t _max_predecessor_count>
+inline cool::async_node<threads_Ty, _max_predecessor_count>::~async_node()
+{
+	if (m_callable != nullptr)
+	{
+		m_callable(this, false, false);
+	}
+}
+
+template <class threads_Ty, std::size_t _max_predecessor_count> template <class function_Ty, class ... arg_Ty>
+inline void cool::async_node<threads_Ty, _max_predecessor_count>::set_task(function_Ty task, arg_Ty&& ... args) noexcept
+{
+	using _cool_anode_traits = cool::_threads_base::_task_traits<function_Ty>;
+	using _cool_anode_pack = typename _cool_anode_traits::template pack<std::tuple<typename std::decay<arg_Ty>::type ...>>;
+
+	static_assert(_cool_anode_traits::valid, "cool::async_node<...>::set_task : task must be a function pointer or a nothrow move constructible callable");
+	static_assert(sizeof(_cool_anode_pack) <= threads_Ty::arg_buffer_size, "cool::async_node<...>::set_task : task arguments size too large");
+	static_assert(alignof(_cool_anode_pack) <= threads_Ty::arg_buffer_align, "cool::async_node<...>::set_task : task arguments alignment too large");
+
+	if (m_callable != nullptr)
+	{
+		m_callable(this, false, false);
+	}
+
+	m_function_ptr = _cool_anode_traits::address(task);
+	_cool_anode_traits::template construct<_cool_anode_pack>(m_arg_buffer, nullptr, std::move(task), std::forward<arg_Ty>(args)...);
+
+	m_callable = [](cool::async_node<threads_Ty, _max_predecessor_count>* node_ptr, bool submit, bool wait_for_space)
+	{
+		if (submit)
+		{
+			_cool_anode_pack pack(std::move(*reinterpret_cast<_cool_anode_pack*>(node_ptr->m_arg_buffer)));
+			reinterpret_cast<_cool_anode_pack*>(node_ptr->m_arg_buffer)->~_cool_anode_pack();
+
+			if (!cool::async_node<threads_Ty, _max_predecessor_count>::template queue<function_Ty>(node_ptr->m_threads_ptr, node_ptr->m_end,
+				node_ptr->m_function_ptr, pack, wait_for_space))
+			{
+				// queues full, 'pack' is left untouched by 'try_async' and the task runs on the releasing thread
+
+				if (!node_ptr->m_end.m_cancelled.load(std::memory_order_relaxed))
+				{
+					xCOOL_THREADS_TRY
+					{
+						_cool_anode_traits::call_no_return(node_ptr->m_function_ptr, std::move(pack));
+					}
+					xCOOL_THREADS_CATCH(const std::exception& xCOOL_THREADS_EXCEPTION)
+					{
+						cool::_threads_base::catch_exception(xCOOL_THREADS_EXCEPTION, node_ptr->m_function_ptr);
+					}
+				}
+
+				node_ptr->m_end.decr_awaited();
+			}
+		}
+		else
+		{
+			reinterpret_cast<_cool_anode_pack*>(node_ptr->m_arg_buffer)->~_cool_anode_pack();
+		}
+	};
+}
+
+template <class threads_Ty, std::size_t _max_predecessor_count>
+inline bool cool::async_node<threads_Ty, _max_predecessor_count>::depends_on(cool::async_end& predecessor) noexcept
+{
+	if (m_waiter_count >= _max_predecessor_count)
+	{
+		return false;
+	}
+
+	cool::_async_waiter* waiter_ptr = m_waiters + m_waiter_count;
+	waiter_ptr->m_callback = [](void* object_ptr) { static_cast<cool::async_node<threads_Ty, _max_predecessor_count>*>(object_ptr)->release(false); };
+	waiter_ptr->m_object_ptr = static_cast<void*>(this);
+
+	m_predecessors_awaited.fetch_add(1, std::memory_order_relaxed);
+
+	if (predecessor.add_waiter(waiter_ptr))
+	{
+		m_waiter_count++;
+	}
+	else
+	{
+		m_predecessors_awaited.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	return true;
+}
+
+template <class threads_Ty, std::size_t _max_predecessor_count> template <class return_Ty>
+inline bool cool::async_node<threads_Ty, _max_predecessor_count>::depends_on(cool::async_result<return_Ty>& predecessor) noexcept
+{
+	if (m_waiter_count >= _max_predecessor_count)
+	{
+		return false;
+	}
+
+	cool::_async_waiter* waiter_ptr = m_waiters + m_waiter_count;
+	waiter_ptr->m_callback = [](void* object_ptr) { static_cast<cool::async_node<threads_Ty, _max_predecessor_count>*>(object_ptr)->release(false); };
+	waiter_ptr->m_object_ptr = static_cast<void*>(this);
+
+	m_predecessors_awaited.fetch_add(1, std::memory_order_relaxed);
+
+	if (predecessor.add_waiter(waiter_ptr))
+	{
+		m_waiter_count++;
+	}
+	else
+	{
+		m_predecessors_awaited.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	return true;
+}
+
+template <class threads_Ty, std::size_t _max_predecessor_count> template <class threads_Ty2, std::size_t _max_predecessor_count2>
+inline bool cool::async_node<threads_Ty, _max_predecessor_count>::depends_on(cool::async_node<threads_Ty2, _max_predecessor_count2>& predecessor) noexcept
+{
+	return depends_on(predecessor.m_end);
+}
+
+template <class threads_Ty, std::size_t _max_predecessor_count>
+inline void cool::async_node<threads_Ty, _max_predecessor_count>::submit() noexcept
+{
+	release(true);
+}
+
+template <class threads_Ty, std::size_t _max_predecessor_count>
+inline void cool::async_node<threads_Ty, _max_predecessor_count>::finish() noexcept
+{
+	m_end.finish();
+}
+
+template <class threads_Ty, std::size_t _max_predecessor_count>
+inline bool cool::async_node<threads_Ty, _max_predecessor_count>::finished() const noexcept
+{
+	return m_end.finished();
+}
+
+template <class threads_Ty, std::size_t _max_predecessor_count>
+inline void cool::async_node<threads_Ty, _max_predecessor_count>::release(bool wait_for_space) noexcept
+{
+	if (m_predecessors_awaited.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		void(*callable)(cool::async_node<threads_Ty, _max_predecessor_count>*, bool, bool) = m_callable;
+		m_callable = nullptr;
+
+		if (callable != nullptr)
+		{
+			callable(this, true, wait_for_space);
+		}
+		else
+		{
+			m_end.decr_awaited();
+		}
+	}
+}
+
+
+#ifdef xCOOL_THREADS_COROUTINES
+// coroutine detail
+
+template <class threads_Ty>
+inline bool cool::_schedule_awaiter<threads_Ty>::await_ready() const noexcept
+{
+	return false;
+}
+
+template <class threads_Ty>
+inline bool cool::_schedule_awaiter<threads_Ty>::await_suspend(std::coroutine_handle<> handle) noexcept
+{
+	// the coroutine may be resumed, and the awaiter destroyed, as soon as the task is queued
+
+	return m_threads_ptr->try_async(cool::no_target, &cool::_schedule_awaiter<threads_Ty>::resume, handle.address());
+}
+
+template <class threads_Ty>
+inline void cool::_schedule_awaiter<threads_Ty>::await_resume() const noexcept {}
+
+template <class threads_Ty>
+inline void cool::_schedule_awaiter<threads_Ty>::resume(void* handle_address)
+{
+	std::coroutine_handle<>::from_address(handle_address).resume();
+}
+
+template <class target_Ty, class threads_Ty>
+inline bool cool::_finish_awaiter<target_Ty, threads_Ty>::await_ready() const noexcept
+{
+	return m_target_ptr->finished();
+}
+
+template <class target_Ty, class threads_Ty>
+inline bool cool::_finish_awaiter<target_Ty, threads_Ty>::await_suspend(std::coroutine_handle<> handle) noexcept
+{
+	m_handle = handle;
+	m_waiter.m_callback = &cool::_finish_awaiter<target_Ty, threads_Ty>::on_finished;
+	m_waiter.m_object_ptr = static_cast<void*>(this);
+
+	return m_target_ptr->add_waiter(&m_waiter); // false if 'target' has finished in the meantime, the coroutine then goes on
+}
+
+template <class target_Ty, class threads_Ty>
+inline void cool::_finish_awaiter<target_Ty, threads_Ty>::await_resume() const noexcept {}
+
+template <class target_Ty, class threads_Ty>
+inline void cool::_finish_awaiter<target_Ty, threads_Ty>::on_finished(void* awaiter_ptr) noexcept
+{
+	cool::_finish_awaiter<target_Ty, threads_Ty>* ptr = static_cast<cool::_finish_awaiter<target_Ty, threads_Ty>*>(awaiter_ptr);
+	std::coroutine_handle<> handle = ptr->m_handle;
+
+	if constexpr (!std::is_void<threads_Ty>::value)
+	{
+		if (ptr->m_threads_ptr->try_async(cool::no_target, &cool::_schedule_awaiter<threads_Ty>::resume, handle.address()))
+		{
+			return;
+		}
+	}
+
+	handle.resume();
+}
+#endif // xCOOL_THREADS_COROUTINES
+
+
 // safety_refresh_proxy detail
 
 template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
@@ -5134,6 +10586,24 @@ inline cool::safety_refresh_proxy::safety_refresh_proxy(cool::threads_mq<_cache_
 	};
 }
 
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::safety_refresh_proxy::safety_refresh_proxy(cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& rhs) noexcept : m_object_ptr(&rhs)
+{
+	m_callable = [](void* object_ptr)
+	{
+		reinterpret_cast<cool::threads_ws<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>*>(object_ptr)->safety_refresh();
+	};
+}
+
+template <std::size_t _cache_line_size, std::size_t _arg_buffer_size, std::size_t _arg_buffer_align, bool _arg_type_static_check>
+inline cool::safety_refresh_proxy::safety_refresh_proxy(cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>& rhs) noexcept : m_object_ptr(&rhs)
+{
+	m_callable = [](void* object_ptr)
+	{
+		reinterpret_cast<cool::threads_lq<_cache_line_size, _arg_buffer_size, _arg_buffer_align, _arg_type_static_check>*>(object_ptr)->safety_refresh();
+	};
+}
+
 inline cool::safety_refresh_proxy::safety_refresh_proxy(cool::async_end& rhs) noexcept : m_object_ptr(&rhs)
 {
 	m_callable = [](void* object_ptr)
@@ -0,0 +1,380 @@
+// cool_tests.cpp
+// License <http://unlicense.org/> (statement below at the end of the file)
+
+// regression tests of cool_threads.hpp, cool_parallel.hpp and cool_queues.hpp, run by ctest : the program prints every failed check
+// and returns a non zero value if any check failed
+
+// usage : tests
+
+#define COOL_QUEUES_ATOMIC
+#define COOL_QUEUES_THREAD
+
+#include "cool_threads.hpp"
+#include "cool_parallel.hpp"
+#include "cool_queues.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+
+#define xCOOL_TESTS_CHECK(condition) do { if (!(condition)) { std::printf("  failed : %s (line %d)\n", #condition, __LINE__); failed_check_count++; } } while (false)
+
+
+namespace
+{
+	constexpr std::size_t cache_line_size = 64;
+	constexpr std::size_t arg_buffer_size = 48;
+
+	// small task buffers so that the queues are full most of the time, which is when a thread of the pool waiting on
+	// 'finish(threads)' or running 'cool::parallel' could wait on itself
+
+	constexpr std::size_t small_task_buffer_size = 4;
+
+	using threads_sq_type = cool::threads_sq<cache_line_size, arg_buffer_size>;
+	using threads_lq_type = cool::threads_lq<cache_line_size, arg_buffer_size>;
+	using threads_mq_type = cool::threads_mq<cache_line_size, arg_buffer_size>;
+	using threads_ws_type = cool::threads_ws<cache_line_size, arg_buffer_size>;
+
+	int failed_check_count = 0;
+
+	std::atomic<long> task_counter{ 0 };
+
+	void increment_counter()
+	{
+		task_counter.fetch_add(1, std::memory_order_relaxed);
+	}
+
+
+	// nested waits
+
+	template <class threads_Ty> void test_nested_finish(threads_Ty& threads)
+	{
+		constexpr int outer_task_count = 32;
+		constexpr int inner_task_count = 32;
+
+		task_counter.store(0, std::memory_order_relaxed);
+
+		cool::async_end outer_end;
+
+		for (int i = 0; i < outer_task_count; i++)
+		{
+			threads.async(outer_end.try_incr_awaited(), [&threads]()
+			{
+				cool::async_end inner_end;
+
+				for (int j = 0; j < inner_task_count; j++)
+				{
+					threads.async(inner_end.try_incr_awaited(), increment_counter);
+				}
+
+				inner_end.finish(threads);
+			});
+		}
+
+		outer_end.finish(threads);
+
+		xCOOL_TESTS_CHECK(task_counter.load(std::memory_order_relaxed) == outer_task_count * inner_task_count);
+	}
+
+	template <class threads_Ty> void test_nested_parallel(threads_Ty& threads)
+	{
+		constexpr int outer_task_count = 16;
+		constexpr long value_count = 4096;
+
+		std::vector<long> values(static_cast<std::size_t>(value_count));
+		std::iota(values.begin(), values.end(), 1L);
+
+		std::atomic<int> good_count{ 0 };
+		cool::async_end outer_end;
+
+		for (int i = 0; i < outer_task_count; i++)
+		{
+			threads.async(outer_end.try_incr_awaited(), [&threads, &values, &good_count]()
+			{
+				std::vector<long> sorted(values.rbegin(), values.rend());
+				cool::parallel::sort(threads, sorted.begin(), sorted.end());
+
+				if ((cool::parallel::reduce(threads, values.begin(), values.end(), 0L) == value_count * (value_count + 1) / 2)
+					&& std::is_sorted(sorted.begin(), sorted.end()))
+				{
+					good_count.fetch_add(1, std::memory_order_relaxed);
+				}
+			});
+		}
+
+		outer_end.finish(threads);
+
+		xCOOL_TESTS_CHECK(good_count.load(std::memory_order_relaxed) == outer_task_count);
+	}
+
+	template <class threads_Ty> void test_threads(const char* name)
+	{
+		for (std::uint16_t thread_count : { std::uint16_t(1), std::uint16_t(3) })
+		{
+			std::printf("%s thread_count=%u task_buffer_size=%zu\n", name, static_cast<unsigned int>(thread_count), small_task_buffer_size);
+
+			alignas(cache_line_size) threads_Ty threads;
+			xCOOL_TESTS_CHECK(threads.init_new_threads(cool::thread_count(thread_count), cool::task_buffer_size(small_task_buffer_size)));
+
+			if (threads.good())
+			{
+				test_nested_finish(threads);
+				test_nested_parallel(threads);
+			}
+		}
+	}
+
+
+	// queues
+
+	// a thread that transferred nothing yields so that the tests also progress with a single cpu
+
+	template <class queue_Ty> void test_try_push_pop_n(const char* name, std::size_t producer_count, std::size_t consumer_count)
+	{
+		std::printf("%s try_push_n / try_pop_n\n", name);
+
+		constexpr std::size_t item_buffer_size = 16;
+		static constexpr std::size_t batch_size = 5;
+		static constexpr std::uint32_t item_count_per_producer = 20000;
+
+		queue_Ty queue;
+		xCOOL_TESTS_CHECK(queue.init_queue_new_buffer(cool::item_buffer_size(item_buffer_size)));
+
+		// single thread : the transfers stop at full and empty, queue_mpmc may hold one more item than 'item_buffer_size'
+
+		{
+			std::uint32_t items[item_buffer_size + batch_size];
+			std::iota(items, items + item_buffer_size + batch_size, std::uint32_t(0));
+
+			std::size_t pushed = 0;
+			for (std::size_t count; (count = queue.try_push_n(items + pushed, batch_size)) != 0; pushed += count) {}
+			xCOOL_TESTS_CHECK((pushed == item_buffer_size) || (pushed == item_buffer_size + 1));
+
+			std::uint32_t popped_items[item_buffer_size + batch_size];
+			std::size_t popped = 0;
+			for (std::size_t count; (count = queue.try_pop_n(popped_items + popped, batch_size)) != 0; popped += count) {}
+			xCOOL_TESTS_CHECK(popped == pushed);
+			xCOOL_TESTS_CHECK(std::equal(items, items + pushed, popped_items));
+		}
+
+		// concurrent : every item is popped once
+
+		std::atomic<std::uint64_t> popped_sum{ 0 };
+		std::atomic<std::uint64_t> popped_count{ 0 };
+		const std::uint64_t item_count = static_cast<std::uint64_t>(producer_count) * item_count_per_producer;
+
+		std::vector<std::thread> thread_vector;
+
+		for (std::size_t p = 0; p < producer_count; p++)
+		{
+			thread_vector.emplace_back([&queue]()
+			{
+				std::uint32_t items[batch_size];
+				std::uint32_t next = 1;
+
+				while (next <= item_count_per_producer)
+				{
+					std::size_t count = std::min<std::size_t>(batch_size, item_count_per_producer - next + 1);
+					for (std::size_t k = 0; k < count; k++)
+					{
+						items[k] = next + static_cast<std::uint32_t>(k);
+					}
+
+					std::size_t pushed = queue.try_push_n(items, count);
+					next += static_cast<std::uint32_t>(pushed);
+
+					if (pushed == 0)
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+
+		for (std::size_t c = 0; c < consumer_count; c++)
+		{
+			thread_vector.emplace_back([&queue, &popped_sum, &popped_count, item_count]()
+			{
+				std::uint32_t items[batch_size];
+
+				while (popped_count.load(std::memory_order_relaxed) < item_count)
+				{
+					std::size_t popped = queue.try_pop_n(items, batch_size);
+
+					if (popped != 0)
+					{
+						popped_sum.fetch_add(std::accumulate(items, items + popped, std::uint64_t(0)), std::memory_order_relaxed);
+						popped_count.fetch_add(popped, std::memory_order_relaxed);
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+
+		for (std::thread& thread_ref : thread_vector)
+		{
+			thread_ref.join();
+		}
+
+		xCOOL_TESTS_CHECK(popped_count.load() == item_count);
+		xCOOL_TESTS_CHECK(popped_sum.load() == static_cast<std::uint64_t>(producer_count) * item_count_per_producer * (item_count_per_producer + 1) / 2);
+	}
+
+	void test_spsc_in_place()
+	{
+		std::printf("queue_spsc begin_push / commit_push / begin_pop / release_pop\n");
+
+		constexpr std::uint32_t item_count = 20000;
+
+		cool::queue_spsc<std::uint32_t, cache_line_size> queue;
+		xCOOL_TESTS_CHECK(queue.init_queue_new_buffer(cool::item_buffer_size(8)));
+
+		xCOOL_TESTS_CHECK(queue.begin_pop() == nullptr);
+
+		std::thread producer([&queue]()
+		{
+			for (std::uint32_t next = 1; next <= item_count; )
+			{
+				std::uint32_t* slot_ptr = queue.begin_push();
+
+				if (slot_ptr != nullptr)
+				{
+					*slot_ptr = next++;
+					queue.commit_push();
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		std::uint32_t expected = 1;
+		bool in_order = true;
+
+		while (expected <= item_count)
+		{
+			const std::uint32_t* item_ptr = queue.begin_pop();
+
+			if (item_ptr != nullptr)
+			{
+				in_order = in_order && (*item_ptr == expected);
+				expected++;
+				queue.release_pop();
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		producer.join();
+
+		xCOOL_TESTS_CHECK(in_order);
+		xCOOL_TESTS_CHECK(queue.begin_pop() == nullptr);
+	}
+
+	void test_spsc_bytes_in_place()
+	{
+		std::printf("queue_spsc_bytes begin_push / commit_push / begin_pop / release_pop\n");
+
+		constexpr std::uint32_t message_count = 20000;
+		constexpr std::size_t max_message_size = 40;
+
+		cool::queue_spsc_bytes<cache_line_size> queue;
+		xCOOL_TESTS_CHECK(queue.init_queue_new_buffer(cool::item_buffer_size(256)));
+
+		// message i holds 1 + i % 'max_message_size' bytes of value i % 251
+
+		std::thread producer([&queue]()
+		{
+			for (std::uint32_t next = 0; next < message_count; )
+			{
+				void* message_ptr = queue.begin_push(max_message_size);
+
+				if (message_ptr != nullptr)
+				{
+					std::size_t byte_count = 1 + next % max_message_size;
+					std::memset(message_ptr, static_cast<int>(next % 251), byte_count);
+					queue.commit_push(byte_count);
+					next++;
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		std::uint32_t expected = 0;
+		bool in_order = true;
+
+		while (expected < message_count)
+		{
+			std::size_t byte_count = 0;
+			const void* message_ptr = queue.begin_pop(byte_count);
+
+			if (message_ptr != nullptr)
+			{
+				const unsigned char* byte_ptr = static_cast<const unsigned char*>(message_ptr);
+				in_order = in_order && (byte_count == 1 + expected % max_message_size)
+					&& std::all_of(byte_ptr, byte_ptr + byte_count, [expected](unsigned char b) { return b == expected % 251; });
+				expected++;
+				queue.release_pop();
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		producer.join();
+
+		xCOOL_TESTS_CHECK(in_order);
+	}
+}
+
+
+int main()
+{
+	test_threads<threads_sq_type>("threads_sq");
+	test_threads<threads_lq_type>("threads_lq");
+	test_threads<threads_mq_type>("threads_mq");
+	test_threads<threads_ws_type>("threads_ws");
+
+	test_try_push_pop_n<cool::queue_spsc<std::uint32_t, cache_line_size>>("queue_spsc", 1, 1);
+	test_try_push_pop_n<cool::queue_mpmc<std::uint32_t, cache_line_size>>("queue_mpmc", 2, 2);
+	test_spsc_in_place();
+	test_spsc_bytes_in_place();
+
+	if (failed_check_count != 0)
+	{
+		std::printf("%d failed check(s)\n", failed_check_count);
+		return 1;
+	}
+
+	std::printf("all checks passed\n");
+	return 0;
+}
+
+
+// cool_tests.cpp
+//
+// This is free software released into the public domain.
+//
+// Anyone is free to copy, modify, publish, use, compile, sell, or
+// distribute this software for any purpose and by any means.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND.
+// IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+// OTHER LIABILITY IN CONNECTION WITH THE SOFTWARE.